@@ -60,7 +60,13 @@ if [ "$TARGET" == "genesys2" ]; then
     FUSESOC_TARGET="genesys2_synth"
 fi
 
-fusesoc --cores-root=. run --target=${FUSESOC_TARGET} --build komandara:core:k10 --MEM_INIT=${K10_MEMINIT_HEX} --BOOT_ADDR=2147483648
+# K10_TRACE_BUF=1 ./build.sh genesys2 adds the k10_trace_buf commit-trace ring
+FUSESOC_PARAMS=""
+if [ "${K10_TRACE_BUF:-0}" == "1" ]; then
+    FUSESOC_PARAMS="--TRACE_BUF=true"
+fi
+
+fusesoc --cores-root=. run --target=${FUSESOC_TARGET} --build komandara:core:k10 --MEM_INIT=${K10_MEMINIT_HEX} --BOOT_ADDR=2147483648 ${FUSESOC_PARAMS}
 
 if [ "$TARGET" == "sim" ]; then
     SIM_BIN="build/komandara_core_k10_0.1.0/sim-verilator/Vk10_tb"
@@ -0,0 +1,358 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Komandara — komandara_axi4_xbar Performance Bench (Verilator)
+// ============================================================================
+// C++ masters and slaves around tb_axi4_xbar_perf; traffic, checks and the
+// report come from komandara_bus_perf.h (see there for the options).
+//
+// Masters issue INCR bursts of 32-bit beats (--burst), one address phase
+// at a time, each transaction with its own ID, and match B / R by ID.
+// Slaves take W only after its AW, return B --latency cycles after WLAST
+// and the first R beat --latency cycles after AR, one beat per cycle
+// unless stalled.
+//
+// --outstanding defaults to 1 here: komandara_axi4_xbar holds a slave's
+// grant until B / RLAST and routes a master's responses from one slave, so
+// more than one transaction per master to different slaves is not
+// supported by it.  Larger values are accepted for experiments.
+// ============================================================================
+
+#include "Vtb_axi4_xbar_perf.h"
+#include "komandara_bus_perf.h"
+
+using namespace bus_perf;
+
+class Axi4Bench {
+public:
+    Axi4Bench(Vtb_axi4_xbar_perf* dut, const Options& o, TrafficGen& gen,
+              PerfStats& st, unsigned n_masters, unsigned n_slaves, unsigned id_width)
+        : m_dut(dut), m_opt(o), m_gen(gen), m_st(st), m_id_w(id_width),
+          m_mst(n_masters), m_slv(n_slaves) {}
+
+    void reset() {
+        m_dut->rst_ni = 0;
+        for (int i = 0; i < 5; i++) {
+            m_dut->clk_i = 0;
+            m_dut->eval();
+            m_dut->clk_i = 1;
+            m_dut->eval();
+        }
+        m_dut->rst_ni = 1;
+    }
+
+    void drive(uint64_t cycle) {
+        auto* d = m_dut;
+        d->clk_i = 0;
+
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            if (!ms.busy) {
+                Txn* h = m_gen.head(m);
+                int id = -1;
+                if (h && ms.wr.size() + ms.rd.size() < m_opt.outstanding) id = free_id(ms);
+                if (id >= 0) {
+                    ms.cur     = *h;
+                    ms.cur.id  = unsigned(id);
+                    ms.busy    = true;
+                    ms.aw_done = false;
+                    ms.w_beats = 0;
+                    m_gen.pop(m);
+                }
+            }
+            const Txn& c = ms.cur;
+            ms.awvalid = ms.busy && c.write && !ms.aw_done;
+            ms.wvalid  = ms.busy && c.write && ms.w_beats < c.beats;
+            ms.arvalid = ms.busy && !c.write;
+
+            set_elem(d->s_axi_awid_i,    m, m_id_w, c.id);
+            set_elem(d->s_axi_awaddr_i,  m, 32, c.addr);
+            set_elem(d->s_axi_awlen_i,   m, 8,  c.beats - 1);
+            set_elem(d->s_axi_awsize_i,  m, 3,  2);
+            set_elem(d->s_axi_awburst_i, m, 2,  1);
+            set_elem(d->s_axi_awvalid_i, m, 1,  ms.awvalid);
+            set_elem(d->s_axi_wdata_i,   m, 32, f_wdata(c.addr + 4 * ms.w_beats));
+            set_elem(d->s_axi_wstrb_i,   m, 4,  0xF);
+            set_elem(d->s_axi_wlast_i,   m, 1,  ms.w_beats + 1 == c.beats);
+            set_elem(d->s_axi_wvalid_i,  m, 1,  ms.wvalid);
+            set_elem(d->s_axi_bready_i,  m, 1,  1);
+            set_elem(d->s_axi_arid_i,    m, m_id_w, c.id);
+            set_elem(d->s_axi_araddr_i,  m, 32, c.addr);
+            set_elem(d->s_axi_arlen_i,   m, 8,  c.beats - 1);
+            set_elem(d->s_axi_arsize_i,  m, 3,  2);
+            set_elem(d->s_axi_arburst_i, m, 2,  1);
+            set_elem(d->s_axi_arvalid_i, m, 1,  ms.arvalid);
+            set_elem(d->s_axi_rready_i,  m, 1,  1);
+        }
+
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            const bool rdy = slave_ready(m_gen, m_opt);
+            sl.awready = rdy && sl.aw.size() < MAX_PENDING;
+            sl.wready  = rdy && !sl.aw.empty();
+            sl.arready = rdy && sl.r.size() < MAX_PENDING;
+            sl.bvalid  = !sl.b.empty() && sl.b.front().t <= cycle;
+            sl.rvalid  = !sl.r.empty() && sl.r.front().t <= cycle;
+
+            const Burst* r = sl.r.empty() ? nullptr : &sl.r.front();
+            set_elem(d->m_axi_awready_i, s, 1, sl.awready);
+            set_elem(d->m_axi_wready_i,  s, 1, sl.wready);
+            set_elem(d->m_axi_bid_i,     s, m_id_w, sl.b.empty() ? 0 : sl.b.front().id);
+            set_elem(d->m_axi_bresp_i,   s, 2, 0);
+            set_elem(d->m_axi_bvalid_i,  s, 1, sl.bvalid);
+            set_elem(d->m_axi_arready_i, s, 1, sl.arready);
+            set_elem(d->m_axi_rid_i,     s, m_id_w, r ? r->id : 0);
+            set_elem(d->m_axi_rdata_i,   s, 32, r ? f_rdata(r->addr + 4 * sl.r_beat) : 0);
+            set_elem(d->m_axi_rresp_i,   s, 2, 0);
+            set_elem(d->m_axi_rlast_i,   s, 1, r && sl.r_beat + 1 == r->beats);
+            set_elem(d->m_axi_rvalid_i,  s, 1, sl.rvalid);
+        }
+
+        d->eval();
+    }
+
+    void sample(uint64_t) {
+        const auto* d = m_dut;
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            ms.aw_fire = ms.awvalid && get_elem(d->s_axi_awready_o, m, 1);
+            ms.w_fire  = ms.wvalid  && get_elem(d->s_axi_wready_o,  m, 1);
+            ms.ar_fire = ms.arvalid && get_elem(d->s_axi_arready_o, m, 1);
+            ms.b_fire  = get_elem(d->s_axi_bvalid_o, m, 1);
+            ms.b_id    = unsigned(get_elem(d->s_axi_bid_o, m, m_id_w));
+            ms.b_resp  = unsigned(get_elem(d->s_axi_bresp_o, m, 2));
+            ms.r_fire  = get_elem(d->s_axi_rvalid_o, m, 1);
+            ms.r_id    = unsigned(get_elem(d->s_axi_rid_o, m, m_id_w));
+            ms.r_resp  = unsigned(get_elem(d->s_axi_rresp_o, m, 2));
+            ms.r_last  = get_elem(d->s_axi_rlast_o, m, 1);
+            ms.r_data  = uint32_t(get_elem(d->s_axi_rdata_o, m, 32));
+        }
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            sl.aw_fire = sl.awready && get_elem(d->m_axi_awvalid_o, s, 1);
+            sl.aw_in   = {uint32_t(get_elem(d->m_axi_awaddr_o, s, 32)),
+                          unsigned(get_elem(d->m_axi_awlen_o, s, 8)) + 1,
+                          unsigned(get_elem(d->m_axi_awid_o, s, m_id_w)), 0};
+            sl.aw_size  = unsigned(get_elem(d->m_axi_awsize_o, s, 3));
+            sl.aw_burst = unsigned(get_elem(d->m_axi_awburst_o, s, 2));
+            sl.w_fire  = sl.wready && get_elem(d->m_axi_wvalid_o, s, 1);
+            sl.w_data  = uint32_t(get_elem(d->m_axi_wdata_o, s, 32));
+            sl.w_last  = get_elem(d->m_axi_wlast_o, s, 1);
+            sl.ar_fire = sl.arready && get_elem(d->m_axi_arvalid_o, s, 1);
+            sl.ar_in   = {uint32_t(get_elem(d->m_axi_araddr_o, s, 32)),
+                          unsigned(get_elem(d->m_axi_arlen_o, s, 8)) + 1,
+                          unsigned(get_elem(d->m_axi_arid_o, s, m_id_w)), 0};
+            sl.ar_size  = unsigned(get_elem(d->m_axi_arsize_o, s, 3));
+            sl.ar_burst = unsigned(get_elem(d->m_axi_arburst_o, s, 2));
+            sl.b_fire  = sl.bvalid && get_elem(d->m_axi_bready_o, s, 1);
+            sl.r_fire  = sl.rvalid && get_elem(d->m_axi_rready_o, s, 1);
+        }
+    }
+
+    void tick() {
+        m_dut->clk_i = 1;
+        m_dut->eval();
+    }
+
+    void update(uint64_t cycle) {
+        for (unsigned m = 0; m < m_mst.size(); m++) update_master(m, cycle);
+        for (unsigned s = 0; s < m_slv.size(); s++) update_slave(s, cycle);
+    }
+
+    bool idle() const {
+        for (const Master& ms : m_mst) {
+            if (ms.busy || !ms.wr.empty() || !ms.rd.empty()) return false;
+        }
+        for (const Slave& sl : m_slv) {
+            if (!sl.aw.empty() || !sl.b.empty() || !sl.r.empty()) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_PENDING = 8;   // per slave channel
+
+    struct Master {
+        bool             busy = false;     // cur is being presented
+        bool             aw_done = false;
+        unsigned         w_beats = 0;      // W beats accepted for cur
+        Txn              cur;
+        std::deque<Txn>  wr, rd;           // waiting for B / R, any order
+        bool awvalid = false, wvalid = false, arvalid = false;
+        bool aw_fire = false, w_fire = false, ar_fire = false;
+        bool b_fire = false, r_fire = false, r_last = false;
+        unsigned b_id = 0, b_resp = 0, r_id = 0, r_resp = 0;
+        uint32_t r_data = 0;
+    };
+
+    struct Burst {
+        uint32_t addr;
+        unsigned beats;
+        unsigned id;
+        uint64_t t;     // first cycle the (first) response may be presented
+    };
+
+    struct Slave {
+        std::deque<Burst> aw;              // accepted, W still to come
+        unsigned          w_beat = 0;      // W beats taken for aw.front()
+        std::deque<Burst> b, r;
+        unsigned          r_beat = 0;      // R beats sent for r.front()
+        bool awready = false, wready = false, arready = false;
+        bool bvalid = false, rvalid = false;
+        bool aw_fire = false, w_fire = false, ar_fire = false;
+        bool b_fire = false, r_fire = false, w_last = false;
+        Burst aw_in{}, ar_in{};
+        unsigned aw_size = 0, aw_burst = 0, ar_size = 0, ar_burst = 0;
+        uint32_t w_data = 0;
+    };
+
+    int free_id(const Master& ms) const {
+        const unsigned n_ids = 1u << m_id_w;
+        for (unsigned id = 0; id < n_ids; id++) {
+            bool used = false;
+            for (const Txn& t : ms.wr) used |= t.id == id;
+            for (const Txn& t : ms.rd) used |= t.id == id;
+            if (!used) return int(id);
+        }
+        return -1;
+    }
+
+    static std::deque<Txn>::iterator find_id(std::deque<Txn>& q, unsigned id) {
+        return std::find_if(q.begin(), q.end(), [id](const Txn& t) { return t.id == id; });
+    }
+
+    void update_master(unsigned m, uint64_t cycle) {
+        Master& ms = m_mst[m];
+        if (ms.aw_fire) ms.aw_done = true;
+        if (ms.w_fire)  ms.w_beats++;
+        if (ms.busy && ms.cur.write && ms.aw_done && ms.w_beats == ms.cur.beats) {
+            ms.wr.push_back(ms.cur);
+            ms.busy = false;
+        }
+        if (ms.ar_fire) {
+            ms.rd.push_back(ms.cur);
+            ms.busy = false;
+        }
+        if (ms.b_fire) {
+            auto it = find_id(ms.wr, ms.b_id);
+            if (it == ms.wr.end()) {
+                m_st.error("M%u: B with unknown ID %u", m, ms.b_id);
+            } else {
+                if (ms.b_resp != 0) m_st.error("M%u: BRESP %u", m, ms.b_resp);
+                m_st.beat(*it, it->beats);
+                m_st.complete(*it, cycle);
+                ms.wr.erase(it);
+            }
+        }
+        if (ms.r_fire) {
+            auto it = find_id(ms.rd, ms.r_id);
+            if (it == ms.rd.end()) {
+                m_st.error("M%u: R with unknown ID %u", m, ms.r_id);
+                return;
+            }
+            const uint32_t a = it->addr + 4 * it->done;
+            if (ms.r_resp != 0) m_st.error("M%u: RRESP %u", m, ms.r_resp);
+            if (ms.r_data != f_rdata(a)) {
+                m_st.error("M%u: read 0x%08x got 0x%08x, exp 0x%08x", m, a, ms.r_data, f_rdata(a));
+            }
+            it->done++;
+            m_st.beat(*it);
+            if (ms.r_last != (it->done == it->beats)) {
+                m_st.error("M%u: RLAST %d at beat %u of %u", m, ms.r_last, it->done, it->beats);
+            }
+            if (ms.r_last) {
+                m_st.complete(*it, cycle);
+                ms.rd.erase(it);
+            }
+        }
+    }
+
+    void update_slave(unsigned s, uint64_t cycle) {
+        Slave& sl = m_slv[s];
+        if (sl.aw_fire) {
+            if (addr_slave(sl.aw_in.addr) != s) m_st.error("S%u: AW 0x%08x misrouted", s, sl.aw_in.addr);
+            if (sl.aw_size != 2 || sl.aw_burst != 1) m_st.error("S%u: AWSIZE/AWBURST", s);
+            sl.aw.push_back(sl.aw_in);
+        }
+        if (sl.w_fire) {
+            // wready is only set with an AW queued before this cycle
+            const Burst& w = sl.aw.front();
+            const uint32_t a = w.addr + 4 * sl.w_beat;
+            if (sl.w_data != f_wdata(a)) {
+                m_st.error("S%u: W for 0x%08x got 0x%08x, exp 0x%08x", s, a, sl.w_data, f_wdata(a));
+            }
+            sl.w_beat++;
+            if (sl.w_last != (sl.w_beat == w.beats)) {
+                m_st.error("S%u: WLAST %d at beat %u of %u", s, sl.w_last, sl.w_beat, w.beats);
+            }
+            if (sl.w_last) {
+                sl.b.push_back({w.addr, w.beats, w.id, cycle + m_opt.latency});
+                sl.aw.pop_front();
+                sl.w_beat = 0;
+            }
+        }
+        if (sl.ar_fire) {
+            if (addr_slave(sl.ar_in.addr) != s) m_st.error("S%u: AR 0x%08x misrouted", s, sl.ar_in.addr);
+            if (sl.ar_size != 2 || sl.ar_burst != 1) m_st.error("S%u: ARSIZE/ARBURST", s);
+            Burst r = sl.ar_in;
+            r.t = cycle + m_opt.latency;
+            sl.r.push_back(r);
+        }
+        if (sl.b_fire) sl.b.pop_front();
+        if (sl.r_fire && ++sl.r_beat == sl.r.front().beats) {
+            sl.r.pop_front();
+            sl.r_beat = 0;
+        }
+    }
+
+    Vtb_axi4_xbar_perf* m_dut;
+    const Options&      m_opt;
+    TrafficGen&         m_gen;
+    PerfStats&          m_st;
+    unsigned            m_id_w;
+    std::vector<Master> m_mst;
+    std::vector<Slave>  m_slv;
+};
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    Options o;
+    o.outstanding = 1;   // see the header comment
+    const int rc = parse_options(argc, argv, o, true);
+    if (rc != 0) return rc == 1 ? 0 : rc;
+
+    auto dut = std::make_unique<Vtb_axi4_xbar_perf>();
+    dut->eval();
+    const unsigned n_masters = dut->o_n_masters;
+    const unsigned n_slaves  = dut->o_n_slaves;
+    const unsigned id_width  = dut->o_id_width;
+    if (o.masters > n_masters || o.hot_slave >= n_slaves) {
+        fprintf(stderr, "ERROR: built with %u masters x %u slaves\n", n_masters, n_slaves);
+        return 2;
+    }
+    if (o.outstanding > (1u << id_width)) {
+        fprintf(stderr, "ERROR: --outstanding > 2^ID_WIDTH (%u)\n", 1u << id_width);
+        return 2;
+    }
+
+    TrafficGen gen(o, n_masters, n_slaves);
+    PerfStats  st(n_masters, n_slaves);
+    Axi4Bench  bench(dut.get(), o, gen, st, n_masters, n_slaves, id_width);
+
+    const int ret = run(bench, "komandara_axi4_xbar", o, gen, st);
+    dut->final();
+    return ret;
+}
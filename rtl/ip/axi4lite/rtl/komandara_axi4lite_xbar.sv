@@ -22,7 +22,17 @@
 //   - Selectable arbitration: round-robin or fixed-priority
 //   - Independent write and read paths per slave (full duplex)
 //   - Non-blocking: parallel paths to different slaves
-//   - 1-cycle grant acquisition, then transparent forwarding
+//   - Up to MAX_OUTSTANDING transactions in flight per slave and per master
+//     on each of the read and write paths
+//   - Address / write-data phases pipelined through komandara_skid_buffer;
+//     a new AW / AR is granted every cycle the slave side can take one
+//
+// Ordering (AXI4-Lite has no IDs):
+//   - Each slave answers in order, so every slave keeps a FIFO of the
+//     granted master indices per path (AR → R, AW → W → B) and routes
+//     R / W / B by its head.
+//   - A master only issues to a different slave once all its responses on
+//     that path are back, so its own responses cannot be reordered.
 //
 // Address Map: SLAVE_ADDR_BASE / SLAVE_ADDR_MASK (packed flat vectors).
 //   Slave s matches if: (addr & mask_s) == base_s
@@ -36,6 +46,7 @@ module komandara_axi4lite_xbar #(
     parameter int ADDR_WIDTH  = 32,
     parameter int DATA_WIDTH  = 32,
     parameter bit ROUND_ROBIN = 1'b1,
+    parameter int MAX_OUTSTANDING = 4,   // per slave and per master, >= 1
     // Flat packed address map: {slave[N-1] ... slave[0]}, each ADDR_WIDTH bits
     parameter bit [N_SLAVES*ADDR_WIDTH-1:0] SLAVE_ADDR_BASE = '0,
     parameter bit [N_SLAVES*ADDR_WIDTH-1:0] SLAVE_ADDR_MASK = '0
@@ -101,6 +112,8 @@ module komandara_axi4lite_xbar #(
     localparam int STRB_WIDTH = DATA_WIDTH / 8;
     localparam int M_IDX_W    = (N_MASTERS > 1) ? $clog2(N_MASTERS) : 1;
     localparam int S_IDX_W    = (N_SLAVES  > 1) ? $clog2(N_SLAVES)  : 1;
+    localparam int PTR_W      = (MAX_OUTSTANDING > 1) ? $clog2(MAX_OUTSTANDING) : 1;
+    localparam int CNT_W      = $clog2(MAX_OUTSTANDING + 1);
 
     // ====================================================================
     // Address Decode — unpack flat parameters
@@ -133,22 +146,49 @@ module komandara_axi4lite_xbar #(
         assign w_rd_target[m] = f_decode(s_axi_araddr_i[m]);
     end
 
+    // Ordering-FIFO pointer increment (depth need not be a power of two)
+    function automatic logic [PTR_W-1:0] f_ptr_inc(input logic [PTR_W-1:0] ptr);
+        return (ptr == PTR_W'(MAX_OUTSTANDING - 1)) ? '0 : ptr + PTR_W'(1);
+    endfunction
+
     // ====================================================================
-    // Per-Slave Write Path
+    // Per-Master Ordering State
     // ====================================================================
-    typedef enum logic {WR_IDLE, WR_ACTIVE} wr_state_e;
-
-    wr_state_e       r_wr_state [N_SLAVES];
-    logic [M_IDX_W-1:0] r_wr_gnt_idx [N_SLAVES]; // Granted master index
+    // Outstanding count and current target slave per master and path. A
+    // request may go out while the master has nothing outstanding, or has
+    // less than MAX_OUTSTANDING to the slave it is already talking to.
+    logic [CNT_W-1:0]   r_wr_cnt [N_MASTERS];
+    logic [S_IDX_W-1:0] r_wr_slv [N_MASTERS];
+    logic [CNT_W-1:0]   r_rd_cnt [N_MASTERS];
+    logic [S_IDX_W-1:0] r_rd_slv [N_MASTERS];
+
+    logic w_wr_ok [N_MASTERS];
+    logic w_rd_ok [N_MASTERS];
+
+    for (genvar m = 0; m < N_MASTERS; m++) begin : gen_mst_ok
+        assign w_wr_ok[m] = (r_wr_cnt[m] == '0)
+                         || ((r_wr_slv[m] == w_wr_target[m])
+                             && (r_wr_cnt[m] != CNT_W'(MAX_OUTSTANDING)));
+        assign w_rd_ok[m] = (r_rd_cnt[m] == '0)
+                         || ((r_rd_slv[m] == w_rd_target[m])
+                             && (r_rd_cnt[m] != CNT_W'(MAX_OUTSTANDING)));
+    end
 
+    // ====================================================================
+    // Per-Slave Write Path
+    // ====================================================================
     // Arbiter request/grant wires
     logic [N_MASTERS-1:0] w_wr_req   [N_SLAVES];
     logic [N_MASTERS-1:0] w_wr_gnt   [N_SLAVES];
-    logic                 w_wr_valid  [N_SLAVES];
-    logic                 w_wr_advance[N_SLAVES];
+    logic                 w_wr_valid [N_SLAVES];
 
-    // B handshake detection per slave
-    logic w_wr_b_done [N_SLAVES];
+    logic               w_aw_rdy   [N_SLAVES]; // slave side can take an AW
+    logic               w_aw_acc   [N_SLAVES]; // AW accepted this cycle
+    logic               w_w_vld    [N_SLAVES]; // a W is expected
+    logic [M_IDX_W-1:0] w_w_idx    [N_SLAVES]; // ... from this master
+    logic               w_w_rdy    [N_SLAVES]; // W skid buffer has room
+    logic               w_b_vld    [N_SLAVES]; // a B is expected
+    logic [M_IDX_W-1:0] w_b_idx    [N_SLAVES]; // ... for this master
 
     for (genvar s = 0; s < N_SLAVES; s++) begin : gen_wr_slv
 
@@ -156,10 +196,10 @@ module komandara_axi4lite_xbar #(
         for (genvar m = 0; m < N_MASTERS; m++) begin : gen_wr_req
             assign w_wr_req[s][m] = s_axi_awvalid_i[m]
                                   && (w_wr_target[m] == S_IDX_W'(s))
-                                  && (r_wr_state[s] == WR_IDLE);
+                                  && w_wr_ok[m];
         end
 
-        // ---- Arbiter ----
+        // ---- Arbiter (re-arbitrates every cycle) ----
         komandara_arbiter #(
             .N_REQ       (N_MASTERS),
             .ROUND_ROBIN (ROUND_ROBIN)
@@ -167,7 +207,7 @@ module komandara_axi4lite_xbar #(
             .clk_i     (clk_i),
             .rst_ni    (rst_ni),
             .req_i     (w_wr_req[s]),
-            .advance_i (w_wr_advance[s]),
+            .advance_i (w_aw_acc[s]),
             .gnt_o     (w_wr_gnt[s]),
             .valid_o   (w_wr_valid[s])
         );
@@ -180,66 +220,110 @@ module komandara_axi4lite_xbar #(
                 if (w_wr_gnt[s][i]) w_arb_idx = M_IDX_W'(i);
         end
 
-        // ---- B handshake ----
-        assign w_wr_b_done[s] = (r_wr_state[s] == WR_ACTIVE)
-                              && m_axi_bvalid_i[s]
-                              && s_axi_bready_i[r_wr_gnt_idx[s]];
+        // ---- Ordering FIFOs: W and B master indices ----
+        logic [M_IDX_W-1:0] r_wq     [MAX_OUTSTANDING];
+        logic [PTR_W-1:0]   r_wq_wp, r_wq_rp;
+        logic [CNT_W-1:0]   r_wq_cnt;
+        logic [M_IDX_W-1:0] r_bq     [MAX_OUTSTANDING];
+        logic [PTR_W-1:0]   r_bq_wp, r_bq_rp;
+        logic [CNT_W-1:0]   r_bq_cnt;
+
+        logic w_aw_skid_rdy;
+        logic w_w_acc;
+        logic w_wq_push;
+        logic w_wq_pop;
+        logic w_b_done;
+
+        assign w_aw_rdy[s] = w_aw_skid_rdy && (r_bq_cnt != CNT_W'(MAX_OUTSTANDING));
+        assign w_aw_acc[s] = w_wr_valid[s] && w_aw_rdy[s];
+
+        // The W for an AW accepted this cycle may pass in the same cycle
+        assign w_w_vld[s]  = (r_wq_cnt != '0) || w_aw_acc[s];
+        assign w_w_idx[s]  = (r_wq_cnt != '0) ? r_wq[r_wq_rp] : w_arb_idx;
+        assign w_w_acc     = w_w_vld[s] && s_axi_wvalid_i[w_w_idx[s]] && w_w_rdy[s];
 
-        assign w_wr_advance[s] = w_wr_b_done[s];
+        assign w_wq_push   = w_aw_acc[s] && !(w_w_acc && (r_wq_cnt == '0));
+        assign w_wq_pop    = w_w_acc && (r_wq_cnt != '0);
+
+        assign w_b_vld[s]  = (r_bq_cnt != '0);
+        assign w_b_idx[s]  = r_bq[r_bq_rp];
+        assign w_b_done    = w_b_vld[s] && m_axi_bvalid_i[s] && s_axi_bready_i[w_b_idx[s]];
 
-        // ---- State machine ----
         always_ff @(posedge clk_i or negedge rst_ni) begin
             if (!rst_ni) begin
-                r_wr_state[s]   <= WR_IDLE;
-                r_wr_gnt_idx[s] <= '0;
+                r_wq_wp  <= '0;
+                r_wq_rp  <= '0;
+                r_wq_cnt <= '0;
+                r_bq_wp  <= '0;
+                r_bq_rp  <= '0;
+                r_bq_cnt <= '0;
             end else begin
-                case (r_wr_state[s])
-                    WR_IDLE: begin
-                        if (w_wr_valid[s]) begin
-                            r_wr_state[s]   <= WR_ACTIVE;
-                            r_wr_gnt_idx[s] <= w_arb_idx;
-                        end
-                    end
-                    WR_ACTIVE: begin
-                        if (w_wr_b_done[s])
-                            r_wr_state[s] <= WR_IDLE;
-                    end
-                    default: r_wr_state[s] <= WR_IDLE;
+                if (w_wq_push) r_wq_wp <= f_ptr_inc(r_wq_wp);
+                if (w_wq_pop)  r_wq_rp <= f_ptr_inc(r_wq_rp);
+                case ({w_wq_push, w_wq_pop})
+                    2'b10:   r_wq_cnt <= r_wq_cnt + 1'b1;
+                    2'b01:   r_wq_cnt <= r_wq_cnt - 1'b1;
+                    default: ;
+                endcase
+
+                if (w_aw_acc[s]) r_bq_wp <= f_ptr_inc(r_bq_wp);
+                if (w_b_done)    r_bq_rp <= f_ptr_inc(r_bq_rp);
+                case ({w_aw_acc[s], w_b_done})
+                    2'b10:   r_bq_cnt <= r_bq_cnt + 1'b1;
+                    2'b01:   r_bq_cnt <= r_bq_cnt - 1'b1;
+                    default: ;
                 endcase
             end
         end
 
-        // ---- Forward AW from granted master → slave ----
-        assign m_axi_awvalid_o[s] = (r_wr_state[s] == WR_ACTIVE)
-                                   ? s_axi_awvalid_i[r_wr_gnt_idx[s]] : 1'b0;
-        assign m_axi_awaddr_o[s]  = s_axi_awaddr_i[r_wr_gnt_idx[s]];
-        assign m_axi_awprot_o[s]  = s_axi_awprot_i[r_wr_gnt_idx[s]];
-
-        // ---- Forward W from granted master → slave ----
-        assign m_axi_wvalid_o[s] = (r_wr_state[s] == WR_ACTIVE)
-                                  ? s_axi_wvalid_i[r_wr_gnt_idx[s]] : 1'b0;
-        assign m_axi_wdata_o[s]  = s_axi_wdata_i[r_wr_gnt_idx[s]];
-        assign m_axi_wstrb_o[s]  = s_axi_wstrb_i[r_wr_gnt_idx[s]];
-
-        // ---- Forward B ready from granted master → slave ----
-        assign m_axi_bready_o[s] = (r_wr_state[s] == WR_ACTIVE)
-                                  ? s_axi_bready_i[r_wr_gnt_idx[s]] : 1'b0;
+        always_ff @(posedge clk_i) begin
+            if (w_wq_push)   r_wq[r_wq_wp] <= w_arb_idx;
+            if (w_aw_acc[s]) r_bq[r_bq_wp] <= w_arb_idx;
+        end
+
+        // ---- AW: granted master → skid buffer → slave ----
+        komandara_skid_buffer #(
+            .DATA_WIDTH (ADDR_WIDTH + 3)
+        ) u_aw_skid (
+            .clk_i     (clk_i),
+            .rst_ni    (rst_ni),
+            .s_data_i  ({s_axi_awprot_i[w_arb_idx], s_axi_awaddr_i[w_arb_idx]}),
+            .s_valid_i (w_aw_acc[s]),
+            .s_ready_o (w_aw_skid_rdy),
+            .m_data_o  ({m_axi_awprot_o[s], m_axi_awaddr_o[s]}),
+            .m_valid_o (m_axi_awvalid_o[s]),
+            .m_ready_i (m_axi_awready_i[s])
+        );
+
+        // ---- W: master at the head of the W FIFO → skid buffer → slave ----
+        komandara_skid_buffer #(
+            .DATA_WIDTH (DATA_WIDTH + STRB_WIDTH)
+        ) u_w_skid (
+            .clk_i     (clk_i),
+            .rst_ni    (rst_ni),
+            .s_data_i  ({s_axi_wstrb_i[w_w_idx[s]], s_axi_wdata_i[w_w_idx[s]]}),
+            .s_valid_i (w_w_acc),
+            .s_ready_o (w_w_rdy[s]),
+            .m_data_o  ({m_axi_wstrb_o[s], m_axi_wdata_o[s]}),
+            .m_valid_o (m_axi_wvalid_o[s]),
+            .m_ready_i (m_axi_wready_i[s])
+        );
+
+        // ---- B ready from the master at the head of the B FIFO ----
+        assign m_axi_bready_o[s] = w_b_vld[s] && s_axi_bready_i[w_b_idx[s]];
     end
 
     // ====================================================================
     // Per-Slave Read Path
     // ====================================================================
-    typedef enum logic {RD_IDLE, RD_ACTIVE} rd_state_e;
-
-    rd_state_e          r_rd_state [N_SLAVES];
-    logic [M_IDX_W-1:0] r_rd_gnt_idx [N_SLAVES];
-
     logic [N_MASTERS-1:0] w_rd_req   [N_SLAVES];
     logic [N_MASTERS-1:0] w_rd_gnt   [N_SLAVES];
-    logic                 w_rd_valid  [N_SLAVES];
-    logic                 w_rd_advance[N_SLAVES];
+    logic                 w_rd_valid [N_SLAVES];
 
-    logic w_rd_r_done [N_SLAVES];
+    logic               w_ar_rdy   [N_SLAVES]; // slave side can take an AR
+    logic               w_ar_acc   [N_SLAVES]; // AR accepted this cycle
+    logic               w_r_vld    [N_SLAVES]; // an R is expected
+    logic [M_IDX_W-1:0] w_r_idx    [N_SLAVES]; // ... for this master
 
     for (genvar s = 0; s < N_SLAVES; s++) begin : gen_rd_slv
 
@@ -247,10 +331,10 @@ module komandara_axi4lite_xbar #(
         for (genvar m = 0; m < N_MASTERS; m++) begin : gen_rd_req
             assign w_rd_req[s][m] = s_axi_arvalid_i[m]
                                   && (w_rd_target[m] == S_IDX_W'(s))
-                                  && (r_rd_state[s] == RD_IDLE);
+                                  && w_rd_ok[m];
         end
 
-        // ---- Arbiter ----
+        // ---- Arbiter (re-arbitrates every cycle) ----
         komandara_arbiter #(
             .N_REQ       (N_MASTERS),
             .ROUND_ROBIN (ROUND_ROBIN)
@@ -258,7 +342,7 @@ module komandara_axi4lite_xbar #(
             .clk_i     (clk_i),
             .rst_ni    (rst_ni),
             .req_i     (w_rd_req[s]),
-            .advance_i (w_rd_advance[s]),
+            .advance_i (w_ar_acc[s]),
             .gnt_o     (w_rd_gnt[s]),
             .valid_o   (w_rd_valid[s])
         );
@@ -270,48 +354,61 @@ module komandara_axi4lite_xbar #(
                 if (w_rd_gnt[s][i]) w_rd_arb_idx = M_IDX_W'(i);
         end
 
-        // ---- R handshake ----
-        assign w_rd_r_done[s] = (r_rd_state[s] == RD_ACTIVE)
-                              && m_axi_rvalid_i[s]
-                              && s_axi_rready_i[r_rd_gnt_idx[s]];
+        // ---- Ordering FIFO: R master indices ----
+        logic [M_IDX_W-1:0] r_rq     [MAX_OUTSTANDING];
+        logic [PTR_W-1:0]   r_rq_wp, r_rq_rp;
+        logic [CNT_W-1:0]   r_rq_cnt;
 
-        assign w_rd_advance[s] = w_rd_r_done[s];
+        logic w_ar_skid_rdy;
+        logic w_r_done;
+
+        assign w_ar_rdy[s] = w_ar_skid_rdy && (r_rq_cnt != CNT_W'(MAX_OUTSTANDING));
+        assign w_ar_acc[s] = w_rd_valid[s] && w_ar_rdy[s];
+
+        assign w_r_vld[s]  = (r_rq_cnt != '0);
+        assign w_r_idx[s]  = r_rq[r_rq_rp];
+        assign w_r_done    = w_r_vld[s] && m_axi_rvalid_i[s] && s_axi_rready_i[w_r_idx[s]];
 
-        // ---- State machine ----
         always_ff @(posedge clk_i or negedge rst_ni) begin
             if (!rst_ni) begin
-                r_rd_state[s]   <= RD_IDLE;
-                r_rd_gnt_idx[s] <= '0;
+                r_rq_wp  <= '0;
+                r_rq_rp  <= '0;
+                r_rq_cnt <= '0;
             end else begin
-                case (r_rd_state[s])
-                    RD_IDLE: begin
-                        if (w_rd_valid[s]) begin
-                            r_rd_state[s]   <= RD_ACTIVE;
-                            r_rd_gnt_idx[s] <= w_rd_arb_idx;
-                        end
-                    end
-                    RD_ACTIVE: begin
-                        if (w_rd_r_done[s])
-                            r_rd_state[s] <= RD_IDLE;
-                    end
-                    default: r_rd_state[s] <= RD_IDLE;
+                if (w_ar_acc[s]) r_rq_wp <= f_ptr_inc(r_rq_wp);
+                if (w_r_done)    r_rq_rp <= f_ptr_inc(r_rq_rp);
+                case ({w_ar_acc[s], w_r_done})
+                    2'b10:   r_rq_cnt <= r_rq_cnt + 1'b1;
+                    2'b01:   r_rq_cnt <= r_rq_cnt - 1'b1;
+                    default: ;
                 endcase
             end
         end
 
-        // ---- Forward AR from granted master → slave ----
-        assign m_axi_arvalid_o[s] = (r_rd_state[s] == RD_ACTIVE)
-                                   ? s_axi_arvalid_i[r_rd_gnt_idx[s]] : 1'b0;
-        assign m_axi_araddr_o[s]  = s_axi_araddr_i[r_rd_gnt_idx[s]];
-        assign m_axi_arprot_o[s]  = s_axi_arprot_i[r_rd_gnt_idx[s]];
+        always_ff @(posedge clk_i) begin
+            if (w_ar_acc[s]) r_rq[r_rq_wp] <= w_rd_arb_idx;
+        end
+
+        // ---- AR: granted master → skid buffer → slave ----
+        komandara_skid_buffer #(
+            .DATA_WIDTH (ADDR_WIDTH + 3)
+        ) u_ar_skid (
+            .clk_i     (clk_i),
+            .rst_ni    (rst_ni),
+            .s_data_i  ({s_axi_arprot_i[w_rd_arb_idx], s_axi_araddr_i[w_rd_arb_idx]}),
+            .s_valid_i (w_ar_acc[s]),
+            .s_ready_o (w_ar_skid_rdy),
+            .m_data_o  ({m_axi_arprot_o[s], m_axi_araddr_o[s]}),
+            .m_valid_o (m_axi_arvalid_o[s]),
+            .m_ready_i (m_axi_arready_i[s])
+        );
 
-        // ---- Forward R ready from granted master → slave ----
-        assign m_axi_rready_o[s] = (r_rd_state[s] == RD_ACTIVE)
-                                  ? s_axi_rready_i[r_rd_gnt_idx[s]] : 1'b0;
+        // ---- R ready from the master at the head of the R FIFO ----
+        assign m_axi_rready_o[s] = w_r_vld[s] && s_axi_rready_i[w_r_idx[s]];
     end
 
     // ====================================================================
-    // Per-Master Response Routing (Write)
+    // Per-Master Handshakes & Response Routing (Write)
     // ====================================================================
     for (genvar m = 0; m < N_MASTERS; m++) begin : gen_wr_mst
 
@@ -322,19 +419,36 @@ module komandara_axi4lite_xbar #(
             s_axi_bresp_o[m]   = 2'b00;
 
             for (int s = 0; s < N_SLAVES; s++) begin
-                if (r_wr_state[s] == WR_ACTIVE
-                    && r_wr_gnt_idx[s] == M_IDX_W'(m)) begin
-                    s_axi_awready_o[m] = m_axi_awready_i[s];
-                    s_axi_wready_o[m]  = m_axi_wready_i[s];
+                if (w_wr_gnt[s][m] && w_aw_rdy[s])
+                    s_axi_awready_o[m] = 1'b1;
+                if (w_w_vld[s] && w_w_idx[s] == M_IDX_W'(m) && w_w_rdy[s])
+                    s_axi_wready_o[m]  = 1'b1;
+                if (w_b_vld[s] && w_b_idx[s] == M_IDX_W'(m)) begin
                     s_axi_bvalid_o[m]  = m_axi_bvalid_i[s];
                     s_axi_bresp_o[m]   = m_axi_bresp_i[s];
                 end
             end
         end
+
+        always_ff @(posedge clk_i or negedge rst_ni) begin
+            if (!rst_ni) begin
+                r_wr_cnt[m] <= '0;
+                r_wr_slv[m] <= '0;
+            end else begin
+                if (s_axi_awvalid_i[m] && s_axi_awready_o[m])
+                    r_wr_slv[m] <= w_wr_target[m];
+                case ({s_axi_awvalid_i[m] && s_axi_awready_o[m],
+                       s_axi_bvalid_o[m]  && s_axi_bready_i[m]})
+                    2'b10:   r_wr_cnt[m] <= r_wr_cnt[m] + 1'b1;
+                    2'b01:   r_wr_cnt[m] <= r_wr_cnt[m] - 1'b1;
+                    default: ;
+                endcase
+            end
+        end
     end
 
     // ====================================================================
-    // Per-Master Response Routing (Read)
+    // Per-Master Handshakes & Response Routing (Read)
     // ====================================================================
     for (genvar m = 0; m < N_MASTERS; m++) begin : gen_rd_mst
 
@@ -345,15 +459,31 @@ module komandara_axi4lite_xbar #(
             s_axi_rresp_o[m]   = 2'b00;
 
             for (int s = 0; s < N_SLAVES; s++) begin
-                if (r_rd_state[s] == RD_ACTIVE
-                    && r_rd_gnt_idx[s] == M_IDX_W'(m)) begin
-                    s_axi_arready_o[m] = m_axi_arready_i[s];
+                if (w_rd_gnt[s][m] && w_ar_rdy[s])
+                    s_axi_arready_o[m] = 1'b1;
+                if (w_r_vld[s] && w_r_idx[s] == M_IDX_W'(m)) begin
                     s_axi_rvalid_o[m]  = m_axi_rvalid_i[s];
                     s_axi_rdata_o[m]   = m_axi_rdata_i[s];
                     s_axi_rresp_o[m]   = m_axi_rresp_i[s];
                 end
             end
         end
+
+        always_ff @(posedge clk_i or negedge rst_ni) begin
+            if (!rst_ni) begin
+                r_rd_cnt[m] <= '0;
+                r_rd_slv[m] <= '0;
+            end else begin
+                if (s_axi_arvalid_i[m] && s_axi_arready_o[m])
+                    r_rd_slv[m] <= w_rd_target[m];
+                case ({s_axi_arvalid_i[m] && s_axi_arready_o[m],
+                       s_axi_rvalid_o[m]  && s_axi_rready_i[m]})
+                    2'b10:   r_rd_cnt[m] <= r_rd_cnt[m] + 1'b1;
+                    2'b01:   r_rd_cnt[m] <= r_rd_cnt[m] - 1'b1;
+                    default: ;
+                endcase
+            end
+        end
     end
 
 endmodule
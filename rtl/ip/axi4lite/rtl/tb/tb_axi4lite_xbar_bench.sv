@@ -0,0 +1,374 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Testbench: AXI4-Lite Crossbar Throughput Benchmark (2M × 2S)
+// ============================================================================
+// The K10 SoC AXI path: two komandara_bus2axi4lite bridges (0: "dbus",
+// 1: "ibus") into komandara_axi4lite_xbar, with two komandara_axi4lite_slave
+// register files behind it. Each bridge is driven by a traffic generator
+// that keeps i_req high, so every cycle without a grant is lost bandwidth.
+//
+// Reports sustained beats per cycle (responses returned to the simple bus)
+// per master and in total for:
+//   1. write streams, disjoint slaves
+//   2. read streams, disjoint slaves (data checked)
+//   3. ibus read stream + dbus read/write mix, disjoint slaves
+//   4. both read streams into one slave (arbitration / fairness)
+//
+// No VIP needed: runs on xsim or verilator --binary --timing.
+// ============================================================================
+
+`timescale 1ns / 1ps
+
+module tb_axi4lite_xbar_bench;
+
+    // --------------------------------------------------------
+    // Parameters
+    // --------------------------------------------------------
+    localparam int ADDR_WIDTH  = 32;
+    localparam int DATA_WIDTH  = 32;
+    localparam int N_MASTERS   = 2;
+    localparam int N_SLAVES    = 2;
+    localparam int CLK_PERIOD  = 10;
+    localparam int REG_COUNT   = 16;
+    localparam int OUTSTANDING = 4;
+    localparam int WINDOW      = 1000;   // measured cycles per scenario
+
+    // Address map: Slave 0 at 0x0000_0000, Slave 1 at 0x0001_0000
+    localparam bit [2*32-1:0] SLV_BASE = {32'h0001_0000, 32'h0000_0000};
+    localparam bit [2*32-1:0] SLV_MASK = {32'hFFFF_0000, 32'hFFFF_0000};
+
+    // Generator modes
+    localparam logic [1:0] GEN_OFF   = 2'd0;
+    localparam logic [1:0] GEN_READ  = 2'd1;
+    localparam logic [1:0] GEN_WRITE = 2'd2;
+    localparam logic [1:0] GEN_MIX   = 2'd3;   // write, read, write, ...
+
+    // --------------------------------------------------------
+    // Clock & Reset
+    // --------------------------------------------------------
+    logic aclk    = 1'b0;
+    logic aresetn = 1'b0;
+    always #(CLK_PERIOD/2) aclk = ~aclk;
+
+    // --------------------------------------------------------
+    // Simple bus (generator ↔ bridge)
+    // --------------------------------------------------------
+    logic        b_req    [N_MASTERS];
+    logic        b_we     [N_MASTERS];
+    logic [31:0] b_addr   [N_MASTERS];
+    logic [31:0] b_wdata  [N_MASTERS];
+    logic        b_gnt    [N_MASTERS];
+    logic        b_rvalid [N_MASTERS];
+    logic [31:0] b_rdata  [N_MASTERS];
+    logic        b_err    [N_MASTERS];
+
+    // --------------------------------------------------------
+    // AXI wires: bridges ↔ crossbar ↔ slaves
+    // --------------------------------------------------------
+    logic [N_MASTERS-1:0][31:0] ma_awaddr, ma_wdata, ma_araddr, ma_rdata;
+    logic [N_MASTERS-1:0][2:0]  ma_awprot, ma_arprot;
+    logic [N_MASTERS-1:0][3:0]  ma_wstrb;
+    logic [N_MASTERS-1:0][1:0]  ma_bresp, ma_rresp;
+    logic [N_MASTERS-1:0]       ma_awvalid, ma_awready, ma_wvalid, ma_wready;
+    logic [N_MASTERS-1:0]       ma_bvalid, ma_bready, ma_arvalid, ma_arready;
+    logic [N_MASTERS-1:0]       ma_rvalid, ma_rready;
+
+    logic [N_SLAVES-1:0][31:0]  sa_awaddr, sa_wdata, sa_araddr, sa_rdata;
+    logic [N_SLAVES-1:0][2:0]   sa_awprot, sa_arprot;
+    logic [N_SLAVES-1:0][3:0]   sa_wstrb;
+    logic [N_SLAVES-1:0][1:0]   sa_bresp, sa_rresp;
+    logic [N_SLAVES-1:0]        sa_awvalid, sa_awready, sa_wvalid, sa_wready;
+    logic [N_SLAVES-1:0]        sa_bvalid, sa_bready, sa_arvalid, sa_arready;
+    logic [N_SLAVES-1:0]        sa_rvalid, sa_rready;
+
+    // --------------------------------------------------------
+    // Bridges
+    // --------------------------------------------------------
+    for (genvar m = 0; m < N_MASTERS; m++) begin : gen_bridge
+        komandara_bus2axi4lite #(
+            .ADDR_WIDTH      (ADDR_WIDTH),
+            .DATA_WIDTH      (DATA_WIDTH),
+            .MAX_OUTSTANDING (OUTSTANDING)
+        ) u_bridge (
+            .i_clk         (aclk),
+            .i_rst_n       (aresetn),
+            .i_req         (b_req[m]),
+            .i_we          (b_we[m]),
+            .i_addr        (b_addr[m]),
+            .i_wdata       (b_wdata[m]),
+            .i_wstrb       (4'hF),
+            .o_gnt         (b_gnt[m]),
+            .o_rvalid      (b_rvalid[m]),
+            .o_rdata       (b_rdata[m]),
+            .o_err         (b_err[m]),
+            .m_axi_awaddr  (ma_awaddr[m]),
+            .m_axi_awprot  (ma_awprot[m]),
+            .m_axi_awvalid (ma_awvalid[m]),
+            .m_axi_awready (ma_awready[m]),
+            .m_axi_wdata   (ma_wdata[m]),
+            .m_axi_wstrb   (ma_wstrb[m]),
+            .m_axi_wvalid  (ma_wvalid[m]),
+            .m_axi_wready  (ma_wready[m]),
+            .m_axi_bresp   (ma_bresp[m]),
+            .m_axi_bvalid  (ma_bvalid[m]),
+            .m_axi_bready  (ma_bready[m]),
+            .m_axi_araddr  (ma_araddr[m]),
+            .m_axi_arprot  (ma_arprot[m]),
+            .m_axi_arvalid (ma_arvalid[m]),
+            .m_axi_arready (ma_arready[m]),
+            .m_axi_rdata   (ma_rdata[m]),
+            .m_axi_rresp   (ma_rresp[m]),
+            .m_axi_rvalid  (ma_rvalid[m]),
+            .m_axi_rready  (ma_rready[m])
+        );
+    end
+
+    // --------------------------------------------------------
+    // DUT — AXI4-Lite Crossbar (2M × 2S)
+    // --------------------------------------------------------
+    komandara_axi4lite_xbar #(
+        .N_MASTERS       (N_MASTERS),
+        .N_SLAVES        (N_SLAVES),
+        .ADDR_WIDTH      (ADDR_WIDTH),
+        .DATA_WIDTH      (DATA_WIDTH),
+        .ROUND_ROBIN     (1'b1),
+        .MAX_OUTSTANDING (OUTSTANDING),
+        .SLAVE_ADDR_BASE (SLV_BASE),
+        .SLAVE_ADDR_MASK (SLV_MASK)
+    ) u_xbar (
+        .clk_i           (aclk),
+        .rst_ni          (aresetn),
+        .s_axi_awaddr_i  (ma_awaddr),
+        .s_axi_awprot_i  (ma_awprot),
+        .s_axi_awvalid_i (ma_awvalid),
+        .s_axi_awready_o (ma_awready),
+        .s_axi_wdata_i   (ma_wdata),
+        .s_axi_wstrb_i   (ma_wstrb),
+        .s_axi_wvalid_i  (ma_wvalid),
+        .s_axi_wready_o  (ma_wready),
+        .s_axi_bresp_o   (ma_bresp),
+        .s_axi_bvalid_o  (ma_bvalid),
+        .s_axi_bready_i  (ma_bready),
+        .s_axi_araddr_i  (ma_araddr),
+        .s_axi_arprot_i  (ma_arprot),
+        .s_axi_arvalid_i (ma_arvalid),
+        .s_axi_arready_o (ma_arready),
+        .s_axi_rdata_o   (ma_rdata),
+        .s_axi_rresp_o   (ma_rresp),
+        .s_axi_rvalid_o  (ma_rvalid),
+        .s_axi_rready_i  (ma_rready),
+        .m_axi_awaddr_o  (sa_awaddr),
+        .m_axi_awprot_o  (sa_awprot),
+        .m_axi_awvalid_o (sa_awvalid),
+        .m_axi_awready_i (sa_awready),
+        .m_axi_wdata_o   (sa_wdata),
+        .m_axi_wstrb_o   (sa_wstrb),
+        .m_axi_wvalid_o  (sa_wvalid),
+        .m_axi_wready_i  (sa_wready),
+        .m_axi_bresp_i   (sa_bresp),
+        .m_axi_bvalid_i  (sa_bvalid),
+        .m_axi_bready_o  (sa_bready),
+        .m_axi_araddr_o  (sa_araddr),
+        .m_axi_arprot_o  (sa_arprot),
+        .m_axi_arvalid_o (sa_arvalid),
+        .m_axi_arready_i (sa_arready),
+        .m_axi_rdata_i   (sa_rdata),
+        .m_axi_rresp_i   (sa_rresp),
+        .m_axi_rvalid_i  (sa_rvalid),
+        .m_axi_rready_o  (sa_rready)
+    );
+
+    // --------------------------------------------------------
+    // Target Slaves
+    // --------------------------------------------------------
+    for (genvar s = 0; s < N_SLAVES; s++) begin : gen_slave
+        komandara_axi4lite_slave #(
+            .ADDR_WIDTH(ADDR_WIDTH), .DATA_WIDTH(DATA_WIDTH), .REG_COUNT(REG_COUNT)
+        ) u_slv (
+            .clk_i(aclk), .rst_ni(aresetn),
+            .s_axi_awaddr_i(sa_awaddr[s]), .s_axi_awprot_i(sa_awprot[s]),
+            .s_axi_awvalid_i(sa_awvalid[s]), .s_axi_awready_o(sa_awready[s]),
+            .s_axi_wdata_i(sa_wdata[s]), .s_axi_wstrb_i(sa_wstrb[s]),
+            .s_axi_wvalid_i(sa_wvalid[s]), .s_axi_wready_o(sa_wready[s]),
+            .s_axi_bresp_o(sa_bresp[s]), .s_axi_bvalid_o(sa_bvalid[s]),
+            .s_axi_bready_i(sa_bready[s]),
+            .s_axi_araddr_i(sa_araddr[s]), .s_axi_arprot_i(sa_arprot[s]),
+            .s_axi_arvalid_i(sa_arvalid[s]), .s_axi_arready_o(sa_arready[s]),
+            .s_axi_rdata_o(sa_rdata[s]), .s_axi_rresp_o(sa_rresp[s]),
+            .s_axi_rvalid_o(sa_rvalid[s]), .s_axi_rready_i(sa_rready[s])
+        );
+    end
+
+    // --------------------------------------------------------
+    // Traffic generators
+    // --------------------------------------------------------
+    // Each generator walks the REG_COUNT registers of its target slave.
+    // Writes store f_pattern(master, reg); with r_check set, every read
+    // response is compared against that pattern.
+    logic [1:0]  r_mode    [N_MASTERS];
+    logic [31:0] r_base    [N_MASTERS];
+    logic        r_check   [N_MASTERS];
+    int unsigned r_idx     [N_MASTERS];   // next register
+    int unsigned r_issued  [N_MASTERS];
+    int unsigned r_beats   [N_MASTERS];   // responses returned
+    int unsigned r_pending [N_MASTERS];
+
+    int pass_count = 0;
+    int fail_count = 0;
+
+    function automatic logic [31:0] f_pattern(int m, int unsigned idx);
+        return 32'hA500_0000 | (32'(m) << 16) | 32'(idx);
+    endfunction
+
+    for (genvar m = 0; m < N_MASTERS; m++) begin : gen_traffic
+        int unsigned q_rd_idx [$];   // register index of each outstanding read
+        logic        q_is_rd  [$];   // request type, in order
+
+        assign b_req[m]   = (r_mode[m] != GEN_OFF);
+        assign b_we[m]    = (r_mode[m] == GEN_WRITE)
+                         || ((r_mode[m] == GEN_MIX) && !r_issued[m][0]);
+        assign b_addr[m]  = r_base[m] + (r_idx[m] << 2);
+        assign b_wdata[m] = f_pattern(m, r_idx[m]);
+
+        always @(posedge aclk) begin
+            if (b_req[m] && b_gnt[m]) begin
+                q_is_rd.push_back(!b_we[m]);
+                q_rd_idx.push_back(r_idx[m]);
+                r_idx[m]    <= (r_idx[m] + 1) % REG_COUNT;
+                r_issued[m] <= r_issued[m] + 1;
+            end
+            if (b_rvalid[m]) begin
+                logic        is_rd;
+                int unsigned idx;
+                is_rd = q_is_rd.pop_front();
+                idx   = q_rd_idx.pop_front();
+                r_beats[m] <= r_beats[m] + 1;
+                if (b_err[m]) begin
+                    $error("[GEN%0d] error response", m);
+                    fail_count++;
+                end else if (is_rd && r_check[m]) begin
+                    if (b_rdata[m] !== f_pattern(m, idx)) begin
+                        $error("[GEN%0d] reg %0d: got 0x%08h, exp 0x%08h",
+                               m, idx, b_rdata[m], f_pattern(m, idx));
+                        fail_count++;
+                    end else begin
+                        pass_count++;
+                    end
+                end
+            end
+            r_pending[m] <= r_pending[m] + 32'(b_req[m] && b_gnt[m]) - 32'(b_rvalid[m]);
+        end
+    end
+
+    // --------------------------------------------------------
+    // Helpers
+    // --------------------------------------------------------
+    task automatic wait_idle();
+        do @(posedge aclk); while (r_pending[0] != 0 || r_pending[1] != 0);
+        @(posedge aclk);
+    endtask
+
+    task automatic run(string name,
+                       logic [1:0] mode0, logic [31:0] base0,
+                       logic [1:0] mode1, logic [31:0] base1,
+                       bit check);
+        int unsigned b0, b1;
+        real bpc0, bpc1;
+
+        r_idx[0]   = 0;
+        r_idx[1]   = 0;
+        r_base[0]  = base0;
+        r_base[1]  = base1;
+        r_check[0] = check;
+        r_check[1] = check;
+        r_mode[0]  = mode0;
+        r_mode[1]  = mode1;
+
+        // Warm up, then measure over WINDOW cycles
+        repeat (16) @(posedge aclk);
+        b0 = r_beats[0];
+        b1 = r_beats[1];
+        repeat (WINDOW) @(posedge aclk);
+        b0 = r_beats[0] - b0;
+        b1 = r_beats[1] - b1;
+
+        r_mode[0] = GEN_OFF;
+        r_mode[1] = GEN_OFF;
+        wait_idle();
+
+        bpc0 = real'(b0) / real'(WINDOW);
+        bpc1 = real'(b1) / real'(WINDOW);
+        $display("  %-28s dbus %.2f  ibus %.2f  total %.2f beats/cycle",
+                 name, bpc0, bpc1, bpc0 + bpc1);
+        if (r_issued[0] + r_issued[1] != r_beats[0] + r_beats[1]) begin
+            $error("[%s] %0d requests, %0d responses", name,
+                   r_issued[0] + r_issued[1], r_beats[0] + r_beats[1]);
+            fail_count++;
+        end
+    endtask
+
+    // ========================================================
+    // Main Sequence
+    // ========================================================
+    initial begin
+        $display("=============================================");
+        $display("  Komandara AXI4-Lite Crossbar Benchmark");
+        $display("  2 bridges × 2 slaves, %0d outstanding", OUTSTANDING);
+        $display("=============================================");
+
+        for (int m = 0; m < N_MASTERS; m++) begin
+            r_mode[m]    = GEN_OFF;
+            r_base[m]    = '0;
+            r_check[m]   = 1'b0;
+            r_idx[m]     = 0;
+            r_issued[m]  = 0;
+            r_beats[m]   = 0;
+            r_pending[m] = 0;
+        end
+
+        aresetn = 1'b0;
+        repeat (20) @(posedge aclk);
+        aresetn = 1'b1;
+        repeat (10) @(posedge aclk);
+
+        // dbus → S1, ibus → S0 throughout, except the contention case
+        run("1. write, disjoint",
+            GEN_WRITE, 32'h0001_0000, GEN_WRITE, 32'h0000_0000, 1'b0);
+        run("2. read,  disjoint",
+            GEN_READ,  32'h0001_0000, GEN_READ,  32'h0000_0000, 1'b1);
+        run("3. ibus read + dbus mix",
+            GEN_MIX,   32'h0001_0000, GEN_READ,  32'h0000_0000, 1'b0);
+        run("4. read,  both → S0",
+            GEN_READ,  32'h0000_0000, GEN_READ,  32'h0000_0000, 1'b0);
+
+        repeat (20) @(posedge aclk);
+        $display("=============================================");
+        $display("  Results: %0d PASSED, %0d FAILED", pass_count, fail_count);
+        if (fail_count == 0)
+            $display("  >>> ALL TESTS PASSED <<<");
+        else
+            $display("  >>> SOME TESTS FAILED <<<");
+        $display("=============================================");
+        $finish;
+    end
+
+    initial begin
+        #10_000_000;
+        $error("[TIMEOUT] 10 ms");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,285 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Komandara — komandara_axi4lite_xbar Performance Bench (Verilator)
+// ============================================================================
+// C++ masters and slaves around tb_axi4lite_xbar_perf; traffic, checks and
+// the report come from komandara_bus_perf.h (see there for the options).
+//
+// Masters issue in order, AW and W together, with up to --outstanding
+// transactions in flight, and match B / R to them in order (AXI4-Lite has
+// no IDs, so the crossbar must keep each master's responses in order).
+// Slaves accept AW / W / AR whenever they are not stalled and return B / R
+// --latency cycles later, in order.
+// ============================================================================
+
+#include "Vtb_axi4lite_xbar_perf.h"
+#include "komandara_bus_perf.h"
+
+using namespace bus_perf;
+
+class Axi4LiteBench {
+public:
+    Axi4LiteBench(Vtb_axi4lite_xbar_perf* dut, const Options& o, TrafficGen& gen,
+                  PerfStats& st, unsigned n_masters, unsigned n_slaves)
+        : m_dut(dut), m_opt(o), m_gen(gen), m_st(st),
+          m_mst(n_masters), m_slv(n_slaves) {}
+
+    void reset() {
+        m_dut->rst_ni = 0;
+        for (int i = 0; i < 5; i++) {
+            m_dut->clk_i = 0;
+            m_dut->eval();
+            m_dut->clk_i = 1;
+            m_dut->eval();
+        }
+        m_dut->rst_ni = 1;
+    }
+
+    void drive(uint64_t cycle) {
+        auto* d = m_dut;
+        d->clk_i = 0;
+
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            if (!ms.busy) {
+                Txn* h = m_gen.head(m);
+                if (h && ms.wr.size() + ms.rd.size() < m_opt.outstanding) {
+                    ms.cur     = *h;
+                    ms.busy    = true;
+                    ms.aw_done = false;
+                    ms.w_done  = false;
+                    m_gen.pop(m);
+                }
+            }
+            ms.awvalid = ms.busy && ms.cur.write && !ms.aw_done;
+            ms.wvalid  = ms.busy && ms.cur.write && !ms.w_done;
+            ms.arvalid = ms.busy && !ms.cur.write;
+
+            set_elem(d->s_axi_awaddr_i,  m, 32, ms.cur.addr);
+            set_elem(d->s_axi_awprot_i,  m, 3,  0);
+            set_elem(d->s_axi_awvalid_i, m, 1,  ms.awvalid);
+            set_elem(d->s_axi_wdata_i,   m, 32, f_wdata(ms.cur.addr));
+            set_elem(d->s_axi_wstrb_i,   m, 4,  0xF);
+            set_elem(d->s_axi_wvalid_i,  m, 1,  ms.wvalid);
+            set_elem(d->s_axi_bready_i,  m, 1,  1);
+            set_elem(d->s_axi_araddr_i,  m, 32, ms.cur.addr);
+            set_elem(d->s_axi_arprot_i,  m, 3,  0);
+            set_elem(d->s_axi_arvalid_i, m, 1,  ms.arvalid);
+            set_elem(d->s_axi_rready_i,  m, 1,  1);
+        }
+
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            const bool rdy = slave_ready(m_gen, m_opt);
+            sl.awready = rdy && sl.aw.size() < MAX_PENDING;
+            sl.wready  = rdy && sl.w.size()  < MAX_PENDING;
+            sl.arready = rdy && sl.r.size()  < MAX_PENDING;
+            sl.bvalid  = !sl.b.empty() && sl.b.front().t <= cycle;
+            sl.rvalid  = !sl.r.empty() && sl.r.front().t <= cycle;
+
+            set_elem(d->m_axi_awready_i, s, 1,  sl.awready);
+            set_elem(d->m_axi_wready_i,  s, 1,  sl.wready);
+            set_elem(d->m_axi_bresp_i,   s, 2,  0);
+            set_elem(d->m_axi_bvalid_i,  s, 1,  sl.bvalid);
+            set_elem(d->m_axi_arready_i, s, 1,  sl.arready);
+            set_elem(d->m_axi_rdata_i,   s, 32, sl.rvalid ? f_rdata(sl.r.front().addr) : 0);
+            set_elem(d->m_axi_rresp_i,   s, 2,  0);
+            set_elem(d->m_axi_rvalid_i,  s, 1,  sl.rvalid);
+        }
+
+        d->eval();
+    }
+
+    void sample(uint64_t) {
+        const auto* d = m_dut;
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            ms.aw_fire = ms.awvalid && get_elem(d->s_axi_awready_o, m, 1);
+            ms.w_fire  = ms.wvalid  && get_elem(d->s_axi_wready_o,  m, 1);
+            ms.ar_fire = ms.arvalid && get_elem(d->s_axi_arready_o, m, 1);
+            ms.b_fire  = get_elem(d->s_axi_bvalid_o, m, 1);
+            ms.b_resp  = unsigned(get_elem(d->s_axi_bresp_o, m, 2));
+            ms.r_fire  = get_elem(d->s_axi_rvalid_o, m, 1);
+            ms.r_resp  = unsigned(get_elem(d->s_axi_rresp_o, m, 2));
+            ms.r_data  = uint32_t(get_elem(d->s_axi_rdata_o, m, 32));
+        }
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            sl.aw_fire = sl.awready && get_elem(d->m_axi_awvalid_o, s, 1);
+            sl.aw_addr = uint32_t(get_elem(d->m_axi_awaddr_o, s, 32));
+            sl.w_fire  = sl.wready && get_elem(d->m_axi_wvalid_o, s, 1);
+            sl.w_data  = uint32_t(get_elem(d->m_axi_wdata_o, s, 32));
+            sl.w_strb  = unsigned(get_elem(d->m_axi_wstrb_o, s, 4));
+            sl.ar_fire = sl.arready && get_elem(d->m_axi_arvalid_o, s, 1);
+            sl.ar_addr = uint32_t(get_elem(d->m_axi_araddr_o, s, 32));
+            sl.b_fire  = sl.bvalid && get_elem(d->m_axi_bready_o, s, 1);
+            sl.r_fire  = sl.rvalid && get_elem(d->m_axi_rready_o, s, 1);
+        }
+    }
+
+    void tick() {
+        m_dut->clk_i = 1;
+        m_dut->eval();
+    }
+
+    void update(uint64_t cycle) {
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            if (ms.aw_fire) ms.aw_done = true;
+            if (ms.w_fire)  ms.w_done  = true;
+            if (ms.busy && ms.cur.write && ms.aw_done && ms.w_done) {
+                ms.wr.push_back(ms.cur);
+                ms.busy = false;
+            }
+            if (ms.ar_fire) {
+                ms.rd.push_back(ms.cur);
+                ms.busy = false;
+            }
+            if (ms.b_fire) {
+                if (ms.wr.empty()) {
+                    m_st.error("M%u: B with no write outstanding", m);
+                } else {
+                    const Txn t = ms.wr.front();
+                    ms.wr.pop_front();
+                    if (ms.b_resp != 0) m_st.error("M%u: BRESP %u", m, ms.b_resp);
+                    m_st.beat(t);
+                    m_st.complete(t, cycle);
+                }
+            }
+            if (ms.r_fire) {
+                if (ms.rd.empty()) {
+                    m_st.error("M%u: R with no read outstanding", m);
+                } else {
+                    const Txn t = ms.rd.front();
+                    ms.rd.pop_front();
+                    if (ms.r_resp != 0) m_st.error("M%u: RRESP %u", m, ms.r_resp);
+                    if (ms.r_data != f_rdata(t.addr)) {
+                        m_st.error("M%u: read 0x%08x got 0x%08x, exp 0x%08x (reordered?)",
+                                   m, t.addr, ms.r_data, f_rdata(t.addr));
+                    }
+                    m_st.beat(t);
+                    m_st.complete(t, cycle);
+                }
+            }
+        }
+
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            if (sl.aw_fire) {
+                if (addr_slave(sl.aw_addr) != s) {
+                    m_st.error("S%u: AW 0x%08x misrouted", s, sl.aw_addr);
+                }
+                sl.aw.push_back(sl.aw_addr);
+            }
+            if (sl.w_fire) {
+                if (sl.w_strb != 0xF) m_st.error("S%u: WSTRB 0x%x", s, sl.w_strb);
+                sl.w.push_back(sl.w_data);
+            }
+            while (!sl.aw.empty() && !sl.w.empty()) {
+                const uint32_t a = sl.aw.front();
+                if (sl.w.front() != f_wdata(a)) {
+                    m_st.error("S%u: W for 0x%08x got 0x%08x, exp 0x%08x",
+                               s, a, sl.w.front(), f_wdata(a));
+                }
+                sl.aw.pop_front();
+                sl.w.pop_front();
+                sl.b.push_back({a, cycle + m_opt.latency});
+            }
+            if (sl.ar_fire) {
+                if (addr_slave(sl.ar_addr) != s) {
+                    m_st.error("S%u: AR 0x%08x misrouted", s, sl.ar_addr);
+                }
+                sl.r.push_back({sl.ar_addr, cycle + m_opt.latency});
+            }
+            if (sl.b_fire) sl.b.pop_front();
+            if (sl.r_fire) sl.r.pop_front();
+        }
+    }
+
+    bool idle() const {
+        for (const Master& ms : m_mst) {
+            if (ms.busy || !ms.wr.empty() || !ms.rd.empty()) return false;
+        }
+        for (const Slave& sl : m_slv) {
+            if (!sl.aw.empty() || !sl.w.empty() || !sl.b.empty() || !sl.r.empty()) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_PENDING = 8;   // per slave channel
+
+    struct Master {
+        bool             busy = false;     // cur is being presented
+        bool             aw_done = false;
+        bool             w_done  = false;
+        Txn              cur;
+        std::deque<Txn>  wr, rd;           // waiting for B / R
+        bool awvalid = false, wvalid = false, arvalid = false;
+        bool aw_fire = false, w_fire = false, ar_fire = false;
+        bool b_fire = false, r_fire = false;
+        unsigned b_resp = 0, r_resp = 0;
+        uint32_t r_data = 0;
+    };
+
+    struct Rsp {
+        uint32_t addr;
+        uint64_t t;     // first cycle the response may be presented
+    };
+
+    struct Slave {
+        std::deque<uint32_t> aw, w;        // accepted, not yet paired
+        std::deque<Rsp>      b, r;
+        bool awready = false, wready = false, arready = false;
+        bool bvalid = false, rvalid = false;
+        bool aw_fire = false, w_fire = false, ar_fire = false;
+        bool b_fire = false, r_fire = false;
+        uint32_t aw_addr = 0, w_data = 0, ar_addr = 0;
+        unsigned w_strb = 0;
+    };
+
+    Vtb_axi4lite_xbar_perf* m_dut;
+    const Options&          m_opt;
+    TrafficGen&             m_gen;
+    PerfStats&              m_st;
+    std::vector<Master>     m_mst;
+    std::vector<Slave>      m_slv;
+};
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    Options o;
+    const int rc = parse_options(argc, argv, o, false);
+    if (rc != 0) return rc == 1 ? 0 : rc;
+
+    auto dut = std::make_unique<Vtb_axi4lite_xbar_perf>();
+    dut->eval();
+    const unsigned n_masters = dut->o_n_masters;
+    const unsigned n_slaves  = dut->o_n_slaves;
+    if (o.masters > n_masters || o.hot_slave >= n_slaves) {
+        fprintf(stderr, "ERROR: built with %u masters x %u slaves\n", n_masters, n_slaves);
+        return 2;
+    }
+
+    TrafficGen    gen(o, n_masters, n_slaves);
+    PerfStats     st(n_masters, n_slaves);
+    Axi4LiteBench bench(dut.get(), o, gen, st, n_masters, n_slaves);
+
+    const int ret = run(bench, "komandara_axi4lite_xbar", o, gen, st);
+    dut->final();
+    return ret;
+}
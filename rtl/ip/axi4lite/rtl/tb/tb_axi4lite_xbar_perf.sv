@@ -0,0 +1,138 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Verilator wrapper: komandara_axi4lite_xbar for tb_axi4lite_xbar_perf.cpp
+// ============================================================================
+// Same ports as the crossbar, with a generated address map (slave s at
+// s << 16) and the master / slave counts as outputs for the C++ side.
+// ============================================================================
+
+module tb_axi4lite_xbar_perf #(
+    parameter int N_MASTERS       = 2,
+    parameter int N_SLAVES        = 2,
+    parameter int MAX_OUTSTANDING = 4,
+    parameter bit ROUND_ROBIN     = 1'b1
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+
+    output logic [7:0] o_n_masters,
+    output logic [7:0] o_n_slaves,
+
+    input  logic [N_MASTERS-1:0][31:0] s_axi_awaddr_i,
+    input  logic [N_MASTERS-1:0][2:0]  s_axi_awprot_i,
+    input  logic [N_MASTERS-1:0]       s_axi_awvalid_i,
+    output logic [N_MASTERS-1:0]       s_axi_awready_o,
+    input  logic [N_MASTERS-1:0][31:0] s_axi_wdata_i,
+    input  logic [N_MASTERS-1:0][3:0]  s_axi_wstrb_i,
+    input  logic [N_MASTERS-1:0]       s_axi_wvalid_i,
+    output logic [N_MASTERS-1:0]       s_axi_wready_o,
+    output logic [N_MASTERS-1:0][1:0]  s_axi_bresp_o,
+    output logic [N_MASTERS-1:0]       s_axi_bvalid_o,
+    input  logic [N_MASTERS-1:0]       s_axi_bready_i,
+    input  logic [N_MASTERS-1:0][31:0] s_axi_araddr_i,
+    input  logic [N_MASTERS-1:0][2:0]  s_axi_arprot_i,
+    input  logic [N_MASTERS-1:0]       s_axi_arvalid_i,
+    output logic [N_MASTERS-1:0]       s_axi_arready_o,
+    output logic [N_MASTERS-1:0][31:0] s_axi_rdata_o,
+    output logic [N_MASTERS-1:0][1:0]  s_axi_rresp_o,
+    output logic [N_MASTERS-1:0]       s_axi_rvalid_o,
+    input  logic [N_MASTERS-1:0]       s_axi_rready_i,
+
+    output logic [N_SLAVES-1:0][31:0]  m_axi_awaddr_o,
+    output logic [N_SLAVES-1:0][2:0]   m_axi_awprot_o,
+    output logic [N_SLAVES-1:0]        m_axi_awvalid_o,
+    input  logic [N_SLAVES-1:0]        m_axi_awready_i,
+    output logic [N_SLAVES-1:0][31:0]  m_axi_wdata_o,
+    output logic [N_SLAVES-1:0][3:0]   m_axi_wstrb_o,
+    output logic [N_SLAVES-1:0]        m_axi_wvalid_o,
+    input  logic [N_SLAVES-1:0]        m_axi_wready_i,
+    input  logic [N_SLAVES-1:0][1:0]   m_axi_bresp_i,
+    input  logic [N_SLAVES-1:0]        m_axi_bvalid_i,
+    output logic [N_SLAVES-1:0]        m_axi_bready_o,
+    output logic [N_SLAVES-1:0][31:0]  m_axi_araddr_o,
+    output logic [N_SLAVES-1:0][2:0]   m_axi_arprot_o,
+    output logic [N_SLAVES-1:0]        m_axi_arvalid_o,
+    input  logic [N_SLAVES-1:0]        m_axi_arready_i,
+    input  logic [N_SLAVES-1:0][31:0]  m_axi_rdata_i,
+    input  logic [N_SLAVES-1:0][1:0]   m_axi_rresp_i,
+    input  logic [N_SLAVES-1:0]        m_axi_rvalid_i,
+    output logic [N_SLAVES-1:0]        m_axi_rready_o
+);
+
+    // Address map: slave s at s << 16, 64 KB each
+    function automatic bit [N_SLAVES*32-1:0] f_base();
+        for (int s = 0; s < N_SLAVES; s++) f_base[s*32 +: 32] = 32'(s) << 16;
+    endfunction
+    function automatic bit [N_SLAVES*32-1:0] f_mask();
+        for (int s = 0; s < N_SLAVES; s++) f_mask[s*32 +: 32] = 32'hFFFF_0000;
+    endfunction
+
+    assign o_n_masters = 8'(N_MASTERS);
+    assign o_n_slaves  = 8'(N_SLAVES);
+
+    komandara_axi4lite_xbar #(
+        .N_MASTERS       (N_MASTERS),
+        .N_SLAVES        (N_SLAVES),
+        .ADDR_WIDTH      (32),
+        .DATA_WIDTH      (32),
+        .ROUND_ROBIN     (ROUND_ROBIN),
+        .MAX_OUTSTANDING (MAX_OUTSTANDING),
+        .SLAVE_ADDR_BASE (f_base()),
+        .SLAVE_ADDR_MASK (f_mask())
+    ) u_xbar (
+        .clk_i           (clk_i),
+        .rst_ni          (rst_ni),
+        .s_axi_awaddr_i  (s_axi_awaddr_i),
+        .s_axi_awprot_i  (s_axi_awprot_i),
+        .s_axi_awvalid_i (s_axi_awvalid_i),
+        .s_axi_awready_o (s_axi_awready_o),
+        .s_axi_wdata_i   (s_axi_wdata_i),
+        .s_axi_wstrb_i   (s_axi_wstrb_i),
+        .s_axi_wvalid_i  (s_axi_wvalid_i),
+        .s_axi_wready_o  (s_axi_wready_o),
+        .s_axi_bresp_o   (s_axi_bresp_o),
+        .s_axi_bvalid_o  (s_axi_bvalid_o),
+        .s_axi_bready_i  (s_axi_bready_i),
+        .s_axi_araddr_i  (s_axi_araddr_i),
+        .s_axi_arprot_i  (s_axi_arprot_i),
+        .s_axi_arvalid_i (s_axi_arvalid_i),
+        .s_axi_arready_o (s_axi_arready_o),
+        .s_axi_rdata_o   (s_axi_rdata_o),
+        .s_axi_rresp_o   (s_axi_rresp_o),
+        .s_axi_rvalid_o  (s_axi_rvalid_o),
+        .s_axi_rready_i  (s_axi_rready_i),
+        .m_axi_awaddr_o  (m_axi_awaddr_o),
+        .m_axi_awprot_o  (m_axi_awprot_o),
+        .m_axi_awvalid_o (m_axi_awvalid_o),
+        .m_axi_awready_i (m_axi_awready_i),
+        .m_axi_wdata_o   (m_axi_wdata_o),
+        .m_axi_wstrb_o   (m_axi_wstrb_o),
+        .m_axi_wvalid_o  (m_axi_wvalid_o),
+        .m_axi_wready_i  (m_axi_wready_i),
+        .m_axi_bresp_i   (m_axi_bresp_i),
+        .m_axi_bvalid_i  (m_axi_bvalid_i),
+        .m_axi_bready_o  (m_axi_bready_o),
+        .m_axi_araddr_o  (m_axi_araddr_o),
+        .m_axi_arprot_o  (m_axi_arprot_o),
+        .m_axi_arvalid_o (m_axi_arvalid_o),
+        .m_axi_arready_i (m_axi_arready_i),
+        .m_axi_rdata_i   (m_axi_rdata_i),
+        .m_axi_rresp_i   (m_axi_rresp_i),
+        .m_axi_rvalid_i  (m_axi_rvalid_i),
+        .m_axi_rready_o  (m_axi_rready_o)
+    );
+
+endmodule : tb_axi4lite_xbar_perf
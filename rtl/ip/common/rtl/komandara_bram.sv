@@ -66,8 +66,10 @@ module komandara_bram #(
     // -----------------------------------------------------------------------
     // Memory array  — written to infer True Dual-Port BRAM
     // -----------------------------------------------------------------------
+    // public_flat_rw: lets the Verilator driver backdoor-load images
+    // (checkpoint restore, batch runs) without going through the ports.
     (* ram_style = "block" *)   // Xilinx synthesis attribute
-    logic [DATA_WIDTH-1:0] r_mem [0:DEPTH-1];
+    logic [DATA_WIDTH-1:0] r_mem [0:DEPTH-1] /* verilator public_flat_rw */;
 
     initial begin
 `ifndef SYNTHESIS
@@ -16,17 +16,26 @@
 // Komandara — Simple Bus → AXI4-Lite Master Bridge
 // ============================================================================
 // Converts the simple request/response bus interface used by the K10 core
-// into an AXI4-Lite master interface via komandara_axi4lite_master.
+// into an AXI4-Lite master interface.
 //
 // Core bus:   req/gnt + rvalid/rdata  (1-cycle handshake, multi-cycle response)
 // AXI4-Lite:  Full AW/W/B and AR/R channels.
 //
+//   - Up to MAX_OUTSTANDING requests in flight.  A request is granted in
+//     the same cycle a response is returned, so there is no idle bubble
+//     between back-to-back requests.
+//   - AW, W and AR go out through komandara_skid_buffer (zero latency when
+//     the slave is ready); B and R come back through skid buffers.
+//   - Reads and writes may finish in any order on AXI; a FIFO of the
+//     request types returns the responses to the core in request order.
+//
 // Shared infrastructure — not tied to any specific core version.
 // ============================================================================
 
 module komandara_bus2axi4lite #(
-    parameter int ADDR_WIDTH = 32,
-    parameter int DATA_WIDTH = 32
+    parameter int ADDR_WIDTH      = 32,
+    parameter int DATA_WIDTH      = 32,
+    parameter int MAX_OUTSTANDING = 2    // >= 1
 )(
     input  logic                       i_clk,
     input  logic                       i_rst_n,
@@ -69,114 +78,150 @@ module komandara_bus2axi4lite #(
     output logic                       m_axi_rready
 );
 
+    localparam int STRB_WIDTH = DATA_WIDTH / 8;
+    localparam int PTR_W      = (MAX_OUTSTANDING > 1) ? $clog2(MAX_OUTSTANDING) : 1;
+    localparam int CNT_W      = $clog2(MAX_OUTSTANDING + 1);
+
     // -----------------------------------------------------------------------
-    // State machine
+    // Response order FIFO (1 = write, 0 = read)
     // -----------------------------------------------------------------------
-    typedef enum logic [1:0] {
-        ST_IDLE,
-        ST_WAIT_RSP
-    } state_e;
+    logic             r_ord_we [MAX_OUTSTANDING];
+    logic [PTR_W-1:0] r_ord_wp;
+    logic [PTR_W-1:0] r_ord_rp;
+    logic [CNT_W-1:0] r_ord_cnt;
 
-    state_e r_state, w_state_next;
+    logic             w_head_we;
+    logic             w_rsp_fire;
 
-    // Note: r_we removed (unused at present; the master module handles
-    //       write-enable from cmd_we directly).
+    assign w_head_we = r_ord_we[r_ord_rp];
 
     // -----------------------------------------------------------------------
-    // Command → AXI4-Lite master module
+    // Request channels: AW / W / AR skid buffers
     // -----------------------------------------------------------------------
-    logic        w_cmd_valid;
-    logic        w_cmd_ready;
-
-    logic        w_rsp_valid;
-    logic [DATA_WIDTH-1:0] w_rsp_rdata;
-    logic [1:0]  w_rsp_resp;
-
-    komandara_axi4lite_master #(
-        .ADDR_WIDTH (ADDR_WIDTH),
-        .DATA_WIDTH (DATA_WIDTH)
-    ) u_axi_master (
-        .clk_i            (i_clk),
-        .rst_ni           (i_rst_n),
-        // Command
-        .cmd_valid_i      (w_cmd_valid),
-        .cmd_ready_o      (w_cmd_ready),
-        .cmd_write_i      (i_we),
-        .cmd_addr_i       (i_addr),
-        .cmd_wdata_i      (i_wdata),
-        .cmd_wstrb_i      (i_wstrb),
-        .cmd_prot_i       (3'b000),
-        // Response
-        .rsp_valid_o      (w_rsp_valid),
-        .rsp_ready_i      (1'b1),      // Always accept responses
-        .rsp_rdata_o      (w_rsp_rdata),
-        .rsp_resp_o       (w_rsp_resp),
-        // AXI4-Lite
-        .m_axi_awaddr_o   (m_axi_awaddr),
-        .m_axi_awprot_o   (m_axi_awprot),
-        .m_axi_awvalid_o  (m_axi_awvalid),
-        .m_axi_awready_i  (m_axi_awready),
-        .m_axi_wdata_o    (m_axi_wdata),
-        .m_axi_wstrb_o    (m_axi_wstrb),
-        .m_axi_wvalid_o   (m_axi_wvalid),
-        .m_axi_wready_i   (m_axi_wready),
-        .m_axi_bresp_i    (m_axi_bresp),
-        .m_axi_bvalid_i   (m_axi_bvalid),
-        .m_axi_bready_o   (m_axi_bready),
-        .m_axi_araddr_o   (m_axi_araddr),
-        .m_axi_arprot_o   (m_axi_arprot),
-        .m_axi_arvalid_o  (m_axi_arvalid),
-        .m_axi_arready_i  (m_axi_arready),
-        .m_axi_rdata_i    (m_axi_rdata),
-        .m_axi_rresp_i    (m_axi_rresp),
-        .m_axi_rvalid_i   (m_axi_rvalid),
-        .m_axi_rready_o   (m_axi_rready)
+    logic w_aw_rdy;
+    logic w_w_rdy;
+    logic w_ar_rdy;
+    logic w_slot_free;
+
+    // A slot freed by this cycle's response can be reused at once
+    assign w_slot_free = (r_ord_cnt != CNT_W'(MAX_OUTSTANDING)) || w_rsp_fire;
+
+    always_comb begin
+        o_gnt = 1'b0;
+        if (i_req && w_slot_free) begin
+            o_gnt = i_we ? (w_aw_rdy && w_w_rdy) : w_ar_rdy;
+        end
+    end
+
+    komandara_skid_buffer #(
+        .DATA_WIDTH (ADDR_WIDTH)
+    ) u_aw_skid (
+        .clk_i     (i_clk),
+        .rst_ni    (i_rst_n),
+        .s_data_i  (i_addr),
+        .s_valid_i (o_gnt && i_we),
+        .s_ready_o (w_aw_rdy),
+        .m_data_o  (m_axi_awaddr),
+        .m_valid_o (m_axi_awvalid),
+        .m_ready_i (m_axi_awready)
+    );
+
+    komandara_skid_buffer #(
+        .DATA_WIDTH (DATA_WIDTH + STRB_WIDTH)
+    ) u_w_skid (
+        .clk_i     (i_clk),
+        .rst_ni    (i_rst_n),
+        .s_data_i  ({i_wstrb, i_wdata}),
+        .s_valid_i (o_gnt && i_we),
+        .s_ready_o (w_w_rdy),
+        .m_data_o  ({m_axi_wstrb, m_axi_wdata}),
+        .m_valid_o (m_axi_wvalid),
+        .m_ready_i (m_axi_wready)
+    );
+
+    komandara_skid_buffer #(
+        .DATA_WIDTH (ADDR_WIDTH)
+    ) u_ar_skid (
+        .clk_i     (i_clk),
+        .rst_ni    (i_rst_n),
+        .s_data_i  (i_addr),
+        .s_valid_i (o_gnt && !i_we),
+        .s_ready_o (w_ar_rdy),
+        .m_data_o  (m_axi_araddr),
+        .m_valid_o (m_axi_arvalid),
+        .m_ready_i (m_axi_arready)
     );
 
+    assign m_axi_awprot = 3'b000;
+    assign m_axi_arprot = 3'b000;
+
     // -----------------------------------------------------------------------
-    // FSM — combinational
+    // Response channels: B / R skid buffers
     // -----------------------------------------------------------------------
-    always_comb begin
-        w_state_next = r_state;
-        w_cmd_valid  = 1'b0;
-        o_gnt        = 1'b0;
-        o_rvalid     = 1'b0;
-        o_rdata      = w_rsp_rdata;
-        o_err        = 1'b0;
-
-        unique case (r_state)
-            ST_IDLE: begin
-                if (i_req) begin
-                    w_cmd_valid = 1'b1;
-                    if (w_cmd_ready) begin
-                        o_gnt        = 1'b1;
-                        w_state_next = ST_WAIT_RSP;
-                    end
-                end
-            end
+    logic [1:0]            w_b_resp;
+    logic                  w_b_valid;
+    logic [DATA_WIDTH-1:0] w_r_rdata;
+    logic [1:0]            w_r_resp;
+    logic                  w_r_valid;
+
+    komandara_skid_buffer #(
+        .DATA_WIDTH (2)
+    ) u_b_skid (
+        .clk_i     (i_clk),
+        .rst_ni    (i_rst_n),
+        .s_data_i  (m_axi_bresp),
+        .s_valid_i (m_axi_bvalid),
+        .s_ready_o (m_axi_bready),
+        .m_data_o  (w_b_resp),
+        .m_valid_o (w_b_valid),
+        .m_ready_i ((r_ord_cnt != '0) && w_head_we)
+    );
 
-            ST_WAIT_RSP: begin
-                if (w_rsp_valid) begin
-                    o_rvalid     = 1'b1;
-                    o_rdata      = w_rsp_rdata;
-                    o_err        = (w_rsp_resp != 2'b00);
-                    w_state_next = ST_IDLE;
-                end
-            end
+    komandara_skid_buffer #(
+        .DATA_WIDTH (DATA_WIDTH + 2)
+    ) u_r_skid (
+        .clk_i     (i_clk),
+        .rst_ni    (i_rst_n),
+        .s_data_i  ({m_axi_rresp, m_axi_rdata}),
+        .s_valid_i (m_axi_rvalid),
+        .s_ready_o (m_axi_rready),
+        .m_data_o  ({w_r_resp, w_r_rdata}),
+        .m_valid_o (w_r_valid),
+        .m_ready_i ((r_ord_cnt != '0) && !w_head_we)
+    );
 
-            default: w_state_next = ST_IDLE;
-        endcase
-    end
+    // Responses are always accepted by the core
+    assign w_rsp_fire = (r_ord_cnt != '0) && (w_head_we ? w_b_valid : w_r_valid);
+
+    assign o_rvalid   = w_rsp_fire;
+    assign o_rdata    = w_r_rdata;
+    assign o_err      = w_rsp_fire && ((w_head_we ? w_b_resp : w_r_resp) != 2'b00);
 
     // -----------------------------------------------------------------------
-    // FSM — sequential
+    // Order FIFO — sequential
     // -----------------------------------------------------------------------
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n) begin
-            r_state <= ST_IDLE;
+            r_ord_wp  <= '0;
+            r_ord_rp  <= '0;
+            r_ord_cnt <= '0;
         end else begin
-            r_state <= w_state_next;
+            if (o_gnt) begin
+                r_ord_wp <= (r_ord_wp == PTR_W'(MAX_OUTSTANDING - 1)) ? '0 : r_ord_wp + 1'b1;
+            end
+            if (w_rsp_fire) begin
+                r_ord_rp <= (r_ord_rp == PTR_W'(MAX_OUTSTANDING - 1)) ? '0 : r_ord_rp + 1'b1;
+            end
+            case ({o_gnt, w_rsp_fire})
+                2'b10:   r_ord_cnt <= r_ord_cnt + 1'b1;
+                2'b01:   r_ord_cnt <= r_ord_cnt - 1'b1;
+                default: ;
+            endcase
         end
     end
 
+    always_ff @(posedge i_clk) begin
+        if (o_gnt) r_ord_we[r_ord_wp] <= i_we;
+    end
+
 endmodule : komandara_bus2axi4lite
@@ -17,6 +17,16 @@
 // ============================================================================
 // Routes parallel requests from N_MASTERS down to a single OBI Slave using a
 // Round-Robin (or Fixed Priority) Arbiter.
+//
+// Responses come back in order, so while transactions are outstanding only
+// the master that issued them may add more.  Arbitration reopens when the
+// last one is answered (also in the cycle its rvalid arrives), and a master
+// with transactions in flight does not issue more while another master is
+// waiting, so a pipelining master cannot starve the others.
+//
+// s_lock_i: a master granted with its lock bit set keeps the slave to
+// itself until it drops the bit (K10 LSU atomics: the read and the write
+// of an AMO, LR and SC are not interleaved with other masters' accesses).
 // ============================================================================
 
 module komandara_obi_mux #(
@@ -34,6 +44,7 @@ module komandara_obi_mux #(
     input  logic [N_MASTERS-1:0][ADDR_WIDTH-1:0]  s_addr_i,
     input  logic [N_MASTERS-1:0][DATA_WIDTH-1:0]  s_wdata_i,
     input  logic [N_MASTERS-1:0][DATA_WIDTH/8-1:0]s_wstrb_i,
+    input  logic [N_MASTERS-1:0]                  s_lock_i,
     output logic [N_MASTERS-1:0]                  s_gnt_o,
     output logic [N_MASTERS-1:0]                  s_rvalid_o,
     output logic [N_MASTERS-1:0][DATA_WIDTH-1:0]  s_rdata_o,
@@ -56,11 +67,19 @@ module komandara_obi_mux #(
     logic [7:0]           r_outstanding;
     logic [N_MASTERS-1:0] r_active_master;
     logic [N_MASTERS-1:0] w_allowed_req;
+    logic                 w_drained;      // nothing left in flight after this cycle's rvalid
+    logic                 r_locked;
+    logic [N_MASTERS-1:0] r_lock_master;
+
+    assign w_drained = (r_outstanding == 8'd0) ||
+                       ((r_outstanding == 8'd1) && m_rvalid_i);
 
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (!rst_ni) begin
             r_outstanding   <= 8'd0;
             r_active_master <= '0;
+            r_locked        <= 1'b0;
+            r_lock_master   <= '0;
         end else begin
             case ({(m_gnt_i && m_req_o), m_rvalid_i})
                 2'b10: r_outstanding <= r_outstanding + 1'b1;
@@ -68,19 +87,31 @@ module komandara_obi_mux #(
                 default: ; // 11 or 00 -> no change
             endcase
 
-            // Lock the active master when an outstanding transaction begins
-            if (m_gnt_i && m_req_o && r_outstanding == 8'd0) begin
+            // The active master changes only when nothing of the old one is left
+            if (m_gnt_i && m_req_o && w_drained) begin
                 r_active_master <= w_gnt;
             end
+
+            if (m_gnt_i && m_req_o && |(w_gnt & s_lock_i)) begin
+                r_locked      <= 1'b1;
+                r_lock_master <= w_gnt;
+            end else if (r_locked && !(|(s_lock_i & r_lock_master))) begin
+                r_locked      <= 1'b0;
+            end
         end
     end
 
-    // Only allow new requests from the active master if there are outstanding transactions
+    // Only allow new requests from the active master if there are
+    // outstanding transactions, and none while another master waits
     always_comb begin
-        if (r_outstanding > 0)
-            w_allowed_req = s_req_i & r_active_master;
-        else
+        if (r_locked)
+            w_allowed_req = s_req_i & r_lock_master;
+        else if (w_drained)
             w_allowed_req = s_req_i;
+        else if (|(s_req_i & ~r_active_master))
+            w_allowed_req = '0;
+        else
+            w_allowed_req = s_req_i & r_active_master;
     end
 
     // Grant logic / Arbiter
@@ -0,0 +1,462 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Komandara — Bus Fabric Performance Harness (shared part)
+// ============================================================================
+// Traffic generation, statistics and option parsing shared by the Verilator
+// benches of komandara_axi4_xbar, komandara_axi4lite_xbar and
+// komandara_obi_mux + komandara_obi_xbar.  Each bench supplies the master
+// and slave models for its protocol and calls into this file once a cycle.
+//
+// Traffic patterns (per active master):
+//   random   new transaction with probability --rate % per idle cycle,
+//            uniform target slave, random address and burst length
+//   stream   back-to-back sequential transactions, master m → slave
+//            m % N_SLAVES, fixed --burst length
+//   hotspot  like random, but --hot-pct % of transactions target
+//            --hot-slave
+//
+// Data is checked on the way: writes carry f_wdata(addr) and slaves check
+// it against the address they were given, reads return f_rdata(addr) and
+// masters check it against the address they issued.  A misrouted W or R
+// beat therefore fails the run.
+//
+// Latency is counted from the cycle a transaction is generated (so it
+// includes the wait for an outstanding slot and for arbitration) to its
+// last response beat.
+// ============================================================================
+
+#pragma once
+
+#include "verilated.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace bus_perf {
+
+// Slave s decodes 0x(s)_0000 .. 0x(s)_FFFF (see the tb_*_perf.sv wrappers)
+static constexpr unsigned SLAVE_SHIFT = 16;
+static constexpr unsigned SLAVE_SPAN  = 1u << 12;   // bytes used per slave
+static constexpr uint64_t DRAIN_LIMIT = 100000;     // cycles to finish after the run
+
+inline uint32_t slave_base(unsigned s) { return s << SLAVE_SHIFT; }
+inline unsigned addr_slave(uint32_t a) { return a >> SLAVE_SHIFT; }
+
+inline uint32_t f_wdata(uint32_t addr) { return (addr * 0x9E3779B1u) ^ 0x5A5A0000u; }
+inline uint32_t f_rdata(uint32_t addr) { return (addr * 0x85EBCA6Bu) ^ 0xA5A50000u; }
+
+// ----------------------------------------------------------------------------
+// Packed-array port access
+// ----------------------------------------------------------------------------
+// Verilator maps `logic [N-1:0][W-1:0]` ports to CData / SData / IData /
+// QData or VlWide<> depending on N*W, so the slice helpers work on any of
+// them.
+inline uint64_t bit_mask(unsigned width) {
+    return width >= 64 ? ~0ull : ((1ull << width) - 1);
+}
+
+template <typename T>
+inline uint64_t get_bits(const T& sig, unsigned lsb, unsigned width) {
+    if constexpr (std::is_integral_v<T>) {
+        return (static_cast<uint64_t>(sig) >> lsb) & bit_mask(width);
+    } else {
+        uint64_t v = 0;
+        for (unsigned i = 0; i < width; i++) {
+            const unsigned b = lsb + i;
+            if ((sig[b / 32] >> (b % 32)) & 1u) v |= 1ull << i;
+        }
+        return v;
+    }
+}
+
+template <typename T>
+inline void set_bits(T& sig, unsigned lsb, unsigned width, uint64_t value) {
+    if constexpr (std::is_integral_v<T>) {
+        const uint64_t m = bit_mask(width) << lsb;
+        sig = static_cast<T>((static_cast<uint64_t>(sig) & ~m) | ((value << lsb) & m));
+    } else {
+        for (unsigned i = 0; i < width; i++) {
+            const unsigned b = lsb + i;
+            const uint32_t bit = 1u << (b % 32);
+            if ((value >> i) & 1u) sig[b / 32] |= bit;
+            else                   sig[b / 32] &= ~bit;
+        }
+    }
+}
+
+// Element idx of a packed array of width-bit elements
+template <typename T>
+inline uint64_t get_elem(const T& sig, unsigned idx, unsigned width) {
+    return get_bits(sig, idx * width, width);
+}
+
+template <typename T>
+inline void set_elem(T& sig, unsigned idx, unsigned width, uint64_t value) {
+    set_bits(sig, idx * width, width, value);
+}
+
+// ----------------------------------------------------------------------------
+// Options
+// ----------------------------------------------------------------------------
+enum Pattern { PAT_RANDOM, PAT_STREAM, PAT_HOTSPOT };
+
+struct Options {
+    Pattern  pattern     = PAT_RANDOM;
+    uint64_t cycles      = 100000;   // measured cycles
+    uint64_t seed        = 1;
+    unsigned masters     = 0;        // active masters (0 = all)
+    unsigned rate        = 100;      // % injection probability per idle cycle
+    unsigned read_pct    = 50;       // % reads
+    unsigned burst       = 1;        // max (random) / fixed (stream) beats
+    unsigned hot_slave   = 0;
+    unsigned hot_pct     = 80;
+    unsigned outstanding = 4;        // per master
+    unsigned latency     = 1;        // slave response latency in cycles (>= 1)
+    unsigned stall_pct   = 0;        // % cycles a slave deasserts ready / gnt
+    double   min_bpc     = 0.0;      // fail below this many beats/cycle
+    bool     csv         = false;
+};
+
+inline void usage(const char* prog, bool bursts, unsigned outstanding) {
+    printf("Usage: %s [options]\n"
+           "  --pattern random|stream|hotspot   traffic pattern (default random)\n"
+           "  --cycles <N>        measured cycles (default 100000)\n"
+           "  --seed <S>          RNG seed (default 1)\n"
+           "  --masters <N>       active masters (default: all)\n"
+           "  --rate <P>          injection %% per idle master cycle (default 100)\n"
+           "  --read-pct <P>      %% reads (default 50)\n", prog);
+    if (bursts) {
+        printf("  --burst <N>         beats per burst, max for random (default 1, <= 256)\n");
+    }
+    printf("  --hot-slave <S>     hotspot target slave (default 0)\n"
+           "  --hot-pct <P>       %% of hotspot traffic to it (default 80)\n"
+           "  --outstanding <N>   transactions in flight per master (default %u)\n"
+           "  --latency <N>       slave response latency, cycles (default 1)\n"
+           "  --stall <P>         %% cycles a slave is not ready (default 0)\n"
+           "  --min-bpc <X>       exit 1 if total beats/cycle < X\n"
+           "  --csv               also print one CSV result line\n", outstanding);
+}
+
+// Returns 0 on success, 1 after --help, 2 on a bad option
+inline int parse_options(int argc, char** argv, Options& o, bool bursts) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const bool has_val = i + 1 < argc;
+        if (strcmp(a, "--help") == 0 || strcmp(a, "-h") == 0) {
+            usage(argv[0], bursts, o.outstanding);
+            return 1;
+        } else if (strcmp(a, "--csv") == 0) {
+            o.csv = true;
+        } else if (strcmp(a, "--pattern") == 0 && has_val) {
+            const char* p = argv[++i];
+            if      (strcmp(p, "random") == 0)  o.pattern = PAT_RANDOM;
+            else if (strcmp(p, "stream") == 0)  o.pattern = PAT_STREAM;
+            else if (strcmp(p, "hotspot") == 0) o.pattern = PAT_HOTSPOT;
+            else {
+                fprintf(stderr, "ERROR: unknown pattern '%s'\n", p);
+                return 2;
+            }
+        } else if (strcmp(a, "--cycles") == 0 && has_val)      o.cycles      = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(a, "--seed") == 0 && has_val)          o.seed        = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(a, "--masters") == 0 && has_val)       o.masters     = atoi(argv[++i]);
+        else if (strcmp(a, "--rate") == 0 && has_val)          o.rate        = atoi(argv[++i]);
+        else if (strcmp(a, "--read-pct") == 0 && has_val)      o.read_pct    = atoi(argv[++i]);
+        else if (strcmp(a, "--burst") == 0 && has_val && bursts) o.burst     = atoi(argv[++i]);
+        else if (strcmp(a, "--hot-slave") == 0 && has_val)     o.hot_slave   = atoi(argv[++i]);
+        else if (strcmp(a, "--hot-pct") == 0 && has_val)       o.hot_pct     = atoi(argv[++i]);
+        else if (strcmp(a, "--outstanding") == 0 && has_val)   o.outstanding = atoi(argv[++i]);
+        else if (strcmp(a, "--latency") == 0 && has_val)       o.latency     = atoi(argv[++i]);
+        else if (strcmp(a, "--stall") == 0 && has_val)         o.stall_pct   = atoi(argv[++i]);
+        else if (strcmp(a, "--min-bpc") == 0 && has_val)       o.min_bpc     = atof(argv[++i]);
+        else if (a[0] == '+') {
+            // Verilator plusargs
+        } else {
+            fprintf(stderr, "ERROR: unknown or incomplete option '%s'\n", a);
+            return 2;
+        }
+    }
+    if (o.burst < 1 || o.burst > 256 || o.outstanding < 1 || o.latency < 1 ||
+        o.rate > 100 || o.read_pct > 100 || o.hot_pct > 100 || o.stall_pct >= 100) {
+        fprintf(stderr, "ERROR: option out of range\n");
+        return 2;
+    }
+    return 0;
+}
+
+inline const char* pattern_name(Pattern p) {
+    switch (p) {
+        case PAT_STREAM:  return "stream";
+        case PAT_HOTSPOT: return "hotspot";
+        default:          return "random";
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Transactions
+// ----------------------------------------------------------------------------
+struct Txn {
+    unsigned master = 0;
+    unsigned slave  = 0;
+    bool     write  = false;
+    uint32_t addr   = 0;
+    unsigned beats  = 1;
+    unsigned id     = 0;       // AXI4 only
+    unsigned done   = 0;       // beats completed (data phase progress)
+    uint64_t t_gen  = 0;       // cycle generated
+};
+
+// ----------------------------------------------------------------------------
+// Traffic generator — one backlog slot per master
+// ----------------------------------------------------------------------------
+class TrafficGen {
+public:
+    TrafficGen(const Options& o, unsigned n_masters, unsigned n_slaves)
+        : m_opt(o), m_n_masters(n_masters), m_n_slaves(n_slaves),
+          m_rng(o.seed), m_backlog(n_masters), m_seq(n_masters, 0) {}
+
+    bool active(unsigned m) const {
+        return m_opt.masters == 0 || m < m_opt.masters;
+    }
+
+    // Called once a cycle while the run is on
+    void step(uint64_t cycle) {
+        for (unsigned m = 0; m < m_n_masters; m++) {
+            if (!active(m) || !m_backlog[m].empty()) continue;
+            if (m_opt.pattern != PAT_STREAM && pct() >= m_opt.rate) continue;
+            m_backlog[m].push_back(make(m, cycle));
+        }
+    }
+
+    // Head of a master's backlog (the transaction it should present next)
+    Txn*  head(unsigned m) { return m_backlog[m].empty() ? nullptr : &m_backlog[m].front(); }
+    void  pop(unsigned m)  { m_backlog[m].pop_front(); }
+    bool  empty() const {
+        for (const auto& b : m_backlog) if (!b.empty()) return false;
+        return true;
+    }
+    unsigned pct() { return std::uniform_int_distribution<unsigned>(0, 99)(m_rng); }
+
+private:
+    Txn make(unsigned m, uint64_t cycle) {
+        Txn t;
+        t.master = m;
+        t.t_gen  = cycle;
+        t.write  = pct() >= m_opt.read_pct;
+        if (m_opt.pattern == PAT_STREAM) {
+            t.slave = m % m_n_slaves;
+            t.beats = m_opt.burst;
+            const uint32_t off = (m_seq[m] * t.beats * 4) % SLAVE_SPAN;
+            // Keep a burst inside the span (and so inside a 4 KB boundary)
+            t.addr  = slave_base(t.slave) + (off + t.beats * 4 > SLAVE_SPAN ? 0 : off);
+            m_seq[m]++;
+        } else {
+            if (m_opt.pattern == PAT_HOTSPOT && pct() < m_opt.hot_pct) {
+                t.slave = m_opt.hot_slave % m_n_slaves;
+            } else {
+                t.slave = std::uniform_int_distribution<unsigned>(0, m_n_slaves - 1)(m_rng);
+            }
+            t.beats = std::uniform_int_distribution<unsigned>(1, m_opt.burst)(m_rng);
+            const unsigned words = SLAVE_SPAN / 4 - t.beats + 1;
+            t.addr  = slave_base(t.slave) +
+                      4 * std::uniform_int_distribution<unsigned>(0, words - 1)(m_rng);
+        }
+        return t;
+    }
+
+    const Options&                m_opt;
+    unsigned                      m_n_masters;
+    unsigned                      m_n_slaves;
+    std::mt19937_64               m_rng;
+    std::vector<std::deque<Txn>>  m_backlog;
+    std::vector<uint32_t>         m_seq;
+};
+
+// ----------------------------------------------------------------------------
+// Statistics
+// ----------------------------------------------------------------------------
+class PerfStats {
+public:
+    PerfStats(unsigned n_masters, unsigned n_slaves)
+        : m_beats(n_masters, 0), m_slave_beats(n_slaves, 0), m_txns(n_masters, 0),
+          m_lat(n_masters) {}
+
+    int errors = 0;
+
+    // Measurement window (beats outside it are not counted for throughput)
+    void window(bool on) { m_window = on; }
+
+    void beat(const Txn& t, unsigned n = 1) {
+        if (!m_window) return;
+        m_beats[t.master]      += n;
+        m_slave_beats[t.slave] += n;
+    }
+
+    void complete(const Txn& t, uint64_t cycle) {
+        m_txns[t.master]++;
+        m_lat[t.master].push_back(cycle - t.t_gen);
+    }
+
+    void error(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (errors++ < 10) {
+            va_list ap;
+            va_start(ap, fmt);
+            printf("  [ERROR] ");
+            vprintf(fmt, ap);
+            printf("\n");
+            va_end(ap);
+        }
+    }
+
+    // Prints the report; returns the total beats per cycle
+    double report(const char* dut, const Options& o, const TrafficGen& gen) const {
+        const double cycles = double(o.cycles);
+        uint64_t total = 0;
+        std::vector<uint64_t> all_lat;
+        double sum_x = 0, sum_x2 = 0;
+        unsigned n_act = 0;
+
+        printf("\n=== %s: %s, %zu masters (%u active) x %zu slaves, %llu cycles ===\n",
+               dut, pattern_name(o.pattern), m_beats.size(),
+               o.masters ? o.masters : unsigned(m_beats.size()), m_slave_beats.size(),
+               (unsigned long long)o.cycles);
+        printf("  %-8s %10s %10s %8s %9s %7s %7s\n",
+               "master", "txns", "beats", "b/cyc", "avg_lat", "p99", "max");
+        for (size_t m = 0; m < m_beats.size(); m++) {
+            std::vector<uint64_t> l = m_lat[m];
+            std::sort(l.begin(), l.end());
+            all_lat.insert(all_lat.end(), l.begin(), l.end());
+            total += m_beats[m];
+            if (gen.active(unsigned(m))) {
+                sum_x  += double(m_beats[m]);
+                sum_x2 += double(m_beats[m]) * double(m_beats[m]);
+                n_act++;
+            }
+            printf("  %-8zu %10llu %10llu %8.3f %9.1f %7llu %7llu\n", m,
+                   (unsigned long long)m_txns[m], (unsigned long long)m_beats[m],
+                   double(m_beats[m]) / cycles, mean(l),
+                   (unsigned long long)p99(l), (unsigned long long)(l.empty() ? 0 : l.back()));
+        }
+        std::sort(all_lat.begin(), all_lat.end());
+
+        printf("  slave beats/cycle:");
+        for (size_t s = 0; s < m_slave_beats.size(); s++) {
+            printf(" %zu:%.3f", s, double(m_slave_beats[s]) / cycles);
+        }
+        printf("\n");
+
+        // Jain's index over active masters: 1.0 = equal share
+        const double jain = (n_act && sum_x2 > 0) ? (sum_x * sum_x) / (n_act * sum_x2) : 1.0;
+        const double bpc  = double(total) / cycles;
+        printf("  throughput  %.3f beats/cycle\n", bpc);
+        printf("  latency     avg %.1f  p99 %llu cycles\n", mean(all_lat),
+               (unsigned long long)p99(all_lat));
+        printf("  fairness    %.3f (Jain, active masters)\n", jain);
+        if (o.csv) {
+            printf("CSV,%s,%s,%zu,%u,%zu,%llu,%u,%u,%u,%.4f,%.2f,%llu,%.4f,%d\n",
+                   dut, pattern_name(o.pattern), m_beats.size(), n_act,
+                   m_slave_beats.size(), (unsigned long long)o.cycles, o.burst,
+                   o.outstanding, o.latency, bpc, mean(all_lat),
+                   (unsigned long long)p99(all_lat), jain, errors);
+        }
+        return bpc;
+    }
+
+private:
+    static double mean(const std::vector<uint64_t>& v) {
+        if (v.empty()) return 0.0;
+        double s = 0;
+        for (uint64_t x : v) s += double(x);
+        return s / double(v.size());
+    }
+    static uint64_t p99(const std::vector<uint64_t>& sorted) {
+        if (sorted.empty()) return 0;
+        const size_t i = size_t(std::ceil(0.99 * double(sorted.size()))) - 1;
+        return sorted[std::min(i, sorted.size() - 1)];
+    }
+
+    bool                               m_window = false;
+    std::vector<uint64_t>              m_beats;
+    std::vector<uint64_t>              m_slave_beats;
+    std::vector<uint64_t>              m_txns;
+    std::vector<std::vector<uint64_t>> m_lat;
+};
+
+// ----------------------------------------------------------------------------
+// Run loop
+// ----------------------------------------------------------------------------
+// Bench must provide:
+//   void reset();                  hold reset for a few cycles
+//   void drive(uint64_t cycle);    set all DUT inputs for this cycle, eval
+//   void sample(uint64_t cycle);   read DUT outputs, decide handshakes
+//   void tick();                   posedge + eval
+//   void update(uint64_t cycle);   commit the handshakes decided in sample()
+//   bool idle() const;             nothing in flight
+// Returns the process exit code.
+template <typename Bench>
+int run(Bench& b, const char* dut, const Options& o, TrafficGen& gen, PerfStats& st) {
+    b.reset();
+
+    uint64_t cycle = 0;
+    st.window(true);
+    for (; cycle < o.cycles; cycle++) {
+        gen.step(cycle);
+        b.drive(cycle);
+        b.sample(cycle);
+        b.tick();
+        b.update(cycle);
+    }
+    st.window(false);
+
+    // Drain: no new traffic, everything in flight must finish
+    const uint64_t end = cycle + DRAIN_LIMIT;
+    while (!(gen.empty() && b.idle()) && cycle < end) {
+        b.drive(cycle);
+        b.sample(cycle);
+        b.tick();
+        b.update(cycle);
+        cycle++;
+    }
+    if (!(gen.empty() && b.idle())) {
+        st.error("transactions still in flight %llu cycles after the run (deadlock?)",
+                 (unsigned long long)DRAIN_LIMIT);
+    }
+
+    const double bpc = st.report(dut, o, gen);
+    bool ok = st.errors == 0;
+    if (o.min_bpc > 0.0 && bpc < o.min_bpc) {
+        printf("  [ERROR] throughput %.3f below --min-bpc %.3f\n", bpc, o.min_bpc);
+        ok = false;
+    }
+    printf("\n=== Summary: %s (%d errors) ===\n", ok ? "PASSED" : "FAILED", st.errors);
+    return ok ? 0 : 1;
+}
+
+// Per-slave ready / gnt coin, decided before the cycle's eval
+inline bool slave_ready(TrafficGen& gen, const Options& o) {
+    return o.stall_pct == 0 || gen.pct() >= o.stall_pct;
+}
+
+}  // namespace bus_perf
@@ -0,0 +1,215 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Komandara — OBI Fabric Performance Bench (Verilator)
+// ============================================================================
+// C++ masters and slaves around tb_obi_xbar_perf (komandara_obi_mux in
+// front of komandara_obi_xbar); traffic, checks and the report come from
+// komandara_bus_perf.h (see there for the options; --burst is not used).
+//
+// Masters hold req until gnt, with up to --outstanding requests in flight,
+// and take rvalid in order.  Slaves grant whenever they are not stalled
+// and answer every request exactly --latency cycles later.  The latency is
+// the same on every slave on purpose: komandara_obi_xbar routes responses
+// from whichever slave raises rvalid, so it relies on in-order answers.
+// ============================================================================
+
+#include "Vtb_obi_xbar_perf.h"
+#include "komandara_bus_perf.h"
+
+using namespace bus_perf;
+
+class ObiBench {
+public:
+    ObiBench(Vtb_obi_xbar_perf* dut, const Options& o, TrafficGen& gen,
+             PerfStats& st, unsigned n_masters, unsigned n_slaves)
+        : m_dut(dut), m_opt(o), m_gen(gen), m_st(st),
+          m_mst(n_masters), m_slv(n_slaves) {}
+
+    void reset() {
+        m_dut->rst_ni = 0;
+        for (int i = 0; i < 5; i++) {
+            m_dut->clk_i = 0;
+            m_dut->eval();
+            m_dut->clk_i = 1;
+            m_dut->eval();
+        }
+        m_dut->rst_ni = 1;
+    }
+
+    void drive(uint64_t cycle) {
+        auto* d = m_dut;
+        d->clk_i = 0;
+
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            if (!ms.busy) {
+                Txn* h = m_gen.head(m);
+                if (h && ms.pend.size() < m_opt.outstanding) {
+                    ms.cur  = *h;
+                    ms.busy = true;
+                    m_gen.pop(m);
+                }
+            }
+            set_elem(d->s_req_i,   m, 1,  ms.busy);
+            set_elem(d->s_we_i,    m, 1,  ms.cur.write);
+            set_elem(d->s_addr_i,  m, 32, ms.cur.addr);
+            set_elem(d->s_wdata_i, m, 32, f_wdata(ms.cur.addr));
+            set_elem(d->s_wstrb_i, m, 4,  0xF);
+        }
+
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            sl.gnt    = slave_ready(m_gen, m_opt) && sl.rsp.size() < MAX_PENDING;
+            sl.rvalid = !sl.rsp.empty() && sl.rsp.front().t <= cycle;
+
+            set_elem(d->m_gnt_i,    s, 1,  sl.gnt);
+            set_elem(d->m_rvalid_i, s, 1,  sl.rvalid);
+            set_elem(d->m_rdata_i,  s, 32, sl.rvalid ? sl.rsp.front().rdata : 0);
+            set_elem(d->m_err_i,    s, 1,  0);
+        }
+
+        d->eval();
+    }
+
+    void sample(uint64_t) {
+        const auto* d = m_dut;
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            ms.gnt    = ms.busy && get_elem(d->s_gnt_o, m, 1);
+            ms.rvalid = get_elem(d->s_rvalid_o, m, 1);
+            ms.err    = get_elem(d->s_err_o, m, 1);
+            ms.rdata  = uint32_t(get_elem(d->s_rdata_o, m, 32));
+        }
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            sl.accept = sl.gnt && get_elem(d->m_req_o, s, 1);
+            sl.we     = get_elem(d->m_we_o, s, 1);
+            sl.addr   = uint32_t(get_elem(d->m_addr_o, s, 32));
+            sl.wdata  = uint32_t(get_elem(d->m_wdata_o, s, 32));
+            sl.wstrb  = unsigned(get_elem(d->m_wstrb_o, s, 4));
+        }
+    }
+
+    void tick() {
+        m_dut->clk_i = 1;
+        m_dut->eval();
+    }
+
+    void update(uint64_t cycle) {
+        for (unsigned m = 0; m < m_mst.size(); m++) {
+            Master& ms = m_mst[m];
+            if (ms.rvalid) {
+                if (ms.pend.empty()) {
+                    m_st.error("M%u: rvalid with no request outstanding", m);
+                } else {
+                    const Txn t = ms.pend.front();
+                    ms.pend.pop_front();
+                    if (ms.err) m_st.error("M%u: err for 0x%08x", m, t.addr);
+                    if (!t.write && ms.rdata != f_rdata(t.addr)) {
+                        m_st.error("M%u: read 0x%08x got 0x%08x, exp 0x%08x",
+                                   m, t.addr, ms.rdata, f_rdata(t.addr));
+                    }
+                    m_st.beat(t);
+                    m_st.complete(t, cycle);
+                }
+            }
+            if (ms.gnt) {
+                ms.pend.push_back(ms.cur);
+                ms.busy = false;
+            }
+        }
+
+        for (unsigned s = 0; s < m_slv.size(); s++) {
+            Slave& sl = m_slv[s];
+            if (sl.rvalid) sl.rsp.pop_front();
+            if (!sl.accept) continue;
+            if (addr_slave(sl.addr) != s) m_st.error("S%u: 0x%08x misrouted", s, sl.addr);
+            if (sl.we) {
+                if (sl.wstrb != 0xF) m_st.error("S%u: wstrb 0x%x", s, sl.wstrb);
+                if (sl.wdata != f_wdata(sl.addr)) {
+                    m_st.error("S%u: write 0x%08x got 0x%08x, exp 0x%08x",
+                               s, sl.addr, sl.wdata, f_wdata(sl.addr));
+                }
+            }
+            sl.rsp.push_back({sl.we ? 0u : f_rdata(sl.addr), cycle + m_opt.latency});
+        }
+    }
+
+    bool idle() const {
+        for (const Master& ms : m_mst) {
+            if (ms.busy || !ms.pend.empty()) return false;
+        }
+        for (const Slave& sl : m_slv) {
+            if (!sl.rsp.empty()) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_PENDING = 8;   // per slave
+
+    struct Master {
+        bool            busy = false;      // cur is on req, waiting for gnt
+        Txn             cur;
+        std::deque<Txn> pend;              // granted, waiting for rvalid
+        bool gnt = false, rvalid = false, err = false;
+        uint32_t rdata = 0;
+    };
+
+    struct Rsp {
+        uint32_t rdata;
+        uint64_t t;     // cycle rvalid is raised
+    };
+
+    struct Slave {
+        std::deque<Rsp> rsp;
+        bool gnt = false, rvalid = false, accept = false, we = false;
+        uint32_t addr = 0, wdata = 0;
+        unsigned wstrb = 0;
+    };
+
+    Vtb_obi_xbar_perf*  m_dut;
+    const Options&      m_opt;
+    TrafficGen&         m_gen;
+    PerfStats&          m_st;
+    std::vector<Master> m_mst;
+    std::vector<Slave>  m_slv;
+};
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    Options o;
+    const int rc = parse_options(argc, argv, o, false);
+    if (rc != 0) return rc == 1 ? 0 : rc;
+
+    auto dut = std::make_unique<Vtb_obi_xbar_perf>();
+    dut->eval();
+    const unsigned n_masters = dut->o_n_masters;
+    const unsigned n_slaves  = dut->o_n_slaves;
+    if (o.masters > n_masters || o.hot_slave >= n_slaves) {
+        fprintf(stderr, "ERROR: built with %u masters x %u slaves\n", n_masters, n_slaves);
+        return 2;
+    }
+
+    TrafficGen gen(o, n_masters, n_slaves);
+    PerfStats  st(n_masters, n_slaves);
+    ObiBench   bench(dut.get(), o, gen, st, n_masters, n_slaves);
+
+    const int ret = run(bench, "komandara_obi_mux + komandara_obi_xbar", o, gen, st);
+    dut->final();
+    return ret;
+}
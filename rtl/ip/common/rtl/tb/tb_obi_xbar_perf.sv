@@ -0,0 +1,128 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// Verilator wrapper: OBI fabric for tb_obi_xbar_perf.cpp
+// ============================================================================
+// The K10 SoC data-bus fabric: komandara_obi_mux (N_MASTERS → 1) in front
+// of komandara_obi_xbar (1 → N_SLAVES), with a generated address map (slave
+// s at s << 16) and the master / slave counts as outputs for the C++ side.
+// ============================================================================
+
+module tb_obi_xbar_perf #(
+    parameter int N_MASTERS   = 2,
+    parameter int N_SLAVES    = 2,
+    parameter bit ROUND_ROBIN = 1'b1
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+
+    output logic [7:0] o_n_masters,
+    output logic [7:0] o_n_slaves,
+
+    input  logic [N_MASTERS-1:0]       s_req_i,
+    input  logic [N_MASTERS-1:0]       s_we_i,
+    input  logic [N_MASTERS-1:0][31:0] s_addr_i,
+    input  logic [N_MASTERS-1:0][31:0] s_wdata_i,
+    input  logic [N_MASTERS-1:0][3:0]  s_wstrb_i,
+    output logic [N_MASTERS-1:0]       s_gnt_o,
+    output logic [N_MASTERS-1:0]       s_rvalid_o,
+    output logic [N_MASTERS-1:0][31:0] s_rdata_o,
+    output logic [N_MASTERS-1:0]       s_err_o,
+
+    output logic [N_SLAVES-1:0]        m_req_o,
+    output logic [N_SLAVES-1:0]        m_we_o,
+    output logic [N_SLAVES-1:0][31:0]  m_addr_o,
+    output logic [N_SLAVES-1:0][31:0]  m_wdata_o,
+    output logic [N_SLAVES-1:0][3:0]   m_wstrb_o,
+    input  logic [N_SLAVES-1:0]        m_gnt_i,
+    input  logic [N_SLAVES-1:0]        m_rvalid_i,
+    input  logic [N_SLAVES-1:0][31:0]  m_rdata_i,
+    input  logic [N_SLAVES-1:0]        m_err_i
+);
+
+    // Address map: slave s at s << 16, 64 KB each
+    function automatic logic [N_SLAVES-1:0][31:0] f_base();
+        for (int s = 0; s < N_SLAVES; s++) f_base[s] = 32'(s) << 16;
+    endfunction
+    function automatic logic [N_SLAVES-1:0][31:0] f_mask();
+        for (int s = 0; s < N_SLAVES; s++) f_mask[s] = 32'hFFFF_0000;
+    endfunction
+
+    assign o_n_masters = 8'(N_MASTERS);
+    assign o_n_slaves  = 8'(N_SLAVES);
+
+    logic        w_req, w_we, w_gnt, w_rvalid, w_err;
+    logic [31:0] w_addr, w_wdata, w_rdata;
+    logic [3:0]  w_wstrb;
+
+    komandara_obi_mux #(
+        .N_MASTERS   (N_MASTERS),
+        .ADDR_WIDTH  (32),
+        .DATA_WIDTH  (32),
+        .ROUND_ROBIN (ROUND_ROBIN)
+    ) u_mux (
+        .clk_i      (clk_i),
+        .rst_ni     (rst_ni),
+        .s_req_i    (s_req_i),
+        .s_we_i     (s_we_i),
+        .s_addr_i   (s_addr_i),
+        .s_wdata_i  (s_wdata_i),
+        .s_wstrb_i  (s_wstrb_i),
+        .s_lock_i   ('0),
+        .s_gnt_o    (s_gnt_o),
+        .s_rvalid_o (s_rvalid_o),
+        .s_rdata_o  (s_rdata_o),
+        .s_err_o    (s_err_o),
+        .m_req_o    (w_req),
+        .m_we_o     (w_we),
+        .m_addr_o   (w_addr),
+        .m_wdata_o  (w_wdata),
+        .m_wstrb_o  (w_wstrb),
+        .m_gnt_i    (w_gnt),
+        .m_rvalid_i (w_rvalid),
+        .m_rdata_i  (w_rdata),
+        .m_err_i    (w_err)
+    );
+
+    komandara_obi_xbar #(
+        .N_SLAVES        (N_SLAVES),
+        .ADDR_WIDTH      (32),
+        .DATA_WIDTH      (32),
+        .SLAVE_ADDR_BASE (f_base()),
+        .SLAVE_ADDR_MASK (f_mask())
+    ) u_xbar (
+        .clk_i      (clk_i),
+        .rst_ni     (rst_ni),
+        .s_req_i    (w_req),
+        .s_we_i     (w_we),
+        .s_addr_i   (w_addr),
+        .s_wdata_i  (w_wdata),
+        .s_wstrb_i  (w_wstrb),
+        .s_gnt_o    (w_gnt),
+        .s_rvalid_o (w_rvalid),
+        .s_rdata_o  (w_rdata),
+        .s_err_o    (w_err),
+        .m_req_o    (m_req_o),
+        .m_we_o     (m_we_o),
+        .m_addr_o   (m_addr_o),
+        .m_wdata_o  (m_wdata_o),
+        .m_wstrb_o  (m_wstrb_o),
+        .m_gnt_i    (m_gnt_i),
+        .m_rvalid_i (m_rvalid_i),
+        .m_rdata_i  (m_rdata_i),
+        .m_err_i    (m_err_i)
+    );
+
+endmodule : tb_obi_xbar_perf
@@ -0,0 +1,155 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Branch Predictor  (BTB + 2-bit BHT, used by k10_fetch)
+// ============================================================================
+// Lookup (combinational, on the fetch PC):
+//   - BTB: BP_BTB_ENTRIES direct-mapped entries indexed by pc[N:1], full
+//     tag.  Each entry holds the last taken target and whether the
+//     instruction is a conditional branch.
+//   - BHT: BP_BHT_ENTRIES 2-bit saturating counters.  Indexed by pc[N:1]
+//     XOR the global history (gshare), or by pc[N:1] alone when
+//     BP_GHR_BITS = 0 (bimodal).
+//   A BTB hit predicts taken for jal/jalr, and for a branch whose counter
+//   is 2 or 3.  Everything else is predicted not taken (fall through).
+//
+// Update (from EX, once per resolved instruction):
+//   - taken branch / jump: BTB entry written with the actual target
+//   - conditional branch:  counter at the lookup index moves towards the
+//     outcome; the outcome is shifted into the global history
+//   - BTB hit on an instruction that is not a branch or jump (the code
+//     was rewritten): the entry is invalidated
+//
+// The history is updated in EX, not speculatively at fetch, so the index
+// used for the update is carried down the pipeline (o_idx → i_upd_idx)
+// rather than recomputed.  The prediction is only a hint: EX checks every
+// instruction fetched with o_taken and redirects on a mispredict.
+// ============================================================================
+
+module k10_bpred
+  import komandara_k10_pkg::*;
+(
+    input  logic        i_clk,
+    input  logic        i_rst_n,
+
+    // ---- Lookup (IF) ----
+    input  logic [31:0]             i_pc,
+    output logic                    o_taken,
+    output logic [31:0]             o_target,
+    output logic [BP_BHT_IDX_W-1:0] o_idx,
+
+    // ---- Update (EX) ----
+    input  logic                    i_upd_valid,    // resolved branch / jump / stale hit
+    input  logic [31:0]             i_upd_pc,
+    input  logic                    i_upd_cti,      // is a branch or jump
+    input  logic                    i_upd_cond,     // is a conditional branch
+    input  logic                    i_upd_taken,
+    input  logic [31:0]             i_upd_target,
+    input  logic [BP_BHT_IDX_W-1:0] i_upd_idx
+);
+
+    localparam int unsigned BTB_IDX_W = $clog2(BP_BTB_ENTRIES);
+    localparam int unsigned BTB_TAG_W = 31 - BTB_IDX_W;
+
+    // Valid bits are reset; the payload arrays are not, so they can map
+    // onto distributed RAM.
+    logic                 r_btb_valid  [BP_BTB_ENTRIES];
+    logic                 r_btb_cond   [BP_BTB_ENTRIES];
+    logic [BTB_TAG_W-1:0] r_btb_tag    [BP_BTB_ENTRIES];
+    logic [30:0]          r_btb_target [BP_BTB_ENTRIES];   // target[31:1]
+    logic [1:0]           r_bht        [BP_BHT_ENTRIES];
+
+    // -----------------------------------------------------------------------
+    // Global history
+    // -----------------------------------------------------------------------
+    logic [BP_BHT_IDX_W-1:0] w_hist;
+
+    if (BP_GHR_BITS > 0) begin : g_gshare
+        logic [BP_GHR_BITS-1:0] r_ghr;
+
+        always_ff @(posedge i_clk or negedge i_rst_n) begin
+            if (!i_rst_n) begin
+                r_ghr <= '0;
+            end else if (i_upd_valid && i_upd_cond) begin
+                r_ghr <= BP_GHR_BITS'({r_ghr, i_upd_taken});
+            end
+        end
+
+        assign w_hist = BP_BHT_IDX_W'(r_ghr);
+    end else begin : g_bimodal
+        assign w_hist = '0;
+    end
+
+    // -----------------------------------------------------------------------
+    // Lookup
+    // -----------------------------------------------------------------------
+    logic [BTB_IDX_W-1:0] w_btb_idx;
+    logic                 w_btb_hit;
+
+    assign w_btb_idx = i_pc[BTB_IDX_W:1];
+    assign w_btb_hit = r_btb_valid[w_btb_idx] &&
+                       (r_btb_tag[w_btb_idx] == i_pc[31:BTB_IDX_W+1]);
+
+    assign o_idx    = i_pc[BP_BHT_IDX_W:1] ^ w_hist;
+    assign o_taken  = w_btb_hit && (!r_btb_cond[w_btb_idx] || r_bht[o_idx][1]);
+    assign o_target = {r_btb_target[w_btb_idx], 1'b0};
+
+    // -----------------------------------------------------------------------
+    // Update
+    // -----------------------------------------------------------------------
+    logic [BTB_IDX_W-1:0] w_upd_btb_idx;
+    assign w_upd_btb_idx = i_upd_pc[BTB_IDX_W:1];
+
+    logic w_btb_write;
+    assign w_btb_write = i_upd_valid && i_upd_cti && i_upd_taken;
+
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            for (int i = 0; i < BP_BTB_ENTRIES; i++) begin
+                r_btb_valid[i] <= 1'b0;
+            end
+        end else if (w_btb_write) begin
+            r_btb_valid[w_upd_btb_idx] <= 1'b1;
+        end else if (i_upd_valid && !i_upd_cti) begin
+            r_btb_valid[w_upd_btb_idx] <= 1'b0;
+        end
+    end
+
+    always_ff @(posedge i_clk) begin
+        if (w_btb_write) begin
+            r_btb_cond[w_upd_btb_idx]   <= i_upd_cond;
+            r_btb_tag[w_upd_btb_idx]    <= i_upd_pc[31:BTB_IDX_W+1];
+            r_btb_target[w_upd_btb_idx] <= i_upd_target[31:1];
+        end
+    end
+
+    // Counters start weakly taken: a branch is only looked up once it is in
+    // the BTB, i.e. after it was taken, and with gshare each new history
+    // value selects a fresh counter.
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            for (int i = 0; i < BP_BHT_ENTRIES; i++) begin
+                r_bht[i] <= 2'b10;
+            end
+        end else if (i_upd_valid && i_upd_cond) begin
+            if (i_upd_taken && r_bht[i_upd_idx] != 2'b11) begin
+                r_bht[i_upd_idx] <= r_bht[i_upd_idx] + 2'd1;
+            end else if (!i_upd_taken && r_bht[i_upd_idx] != 2'b00) begin
+                r_bht[i_upd_idx] <= r_bht[i_upd_idx] - 2'd1;
+            end
+        end
+    end
+
+endmodule : k10_bpred
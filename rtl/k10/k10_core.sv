@@ -34,9 +34,17 @@ module k10_core
 #(
     parameter logic [31:0] BOOT_ADDR   = 32'h0000_0000,
     parameter int unsigned PMP_REGIONS = 16,
+    parameter int unsigned MHPM_COUNTERS = 8,     // mhpmcounter3.. (see k10_csr)
     parameter logic [31:0] MHARTID     = 32'd0,
     parameter logic [31:0] DEBUG_HALT_ADDR      = 32'h4000_3800,
-    parameter logic [31:0] DEBUG_EXCEPTION_ADDR = 32'h4000_3810
+    parameter logic [31:0] DEBUG_EXCEPTION_ADDR = 32'h4000_3810,
+    parameter bit          FAST_DIV    = 1'b1,    // see k10_mul_div
+    parameter int unsigned MUL_STAGES  = 1,       // see k10_mul_div
+    parameter bit          BRANCH_PRED = 1'b1,    // see k10_fetch / k10_bpred
+    parameter int unsigned PREFETCH_DEPTH = 4,    // see k10_fetch
+    parameter int unsigned STORE_BUFFER = 4,      // see k10_lsu
+    parameter logic [31:0] SB_BASE     = 32'h8000_0000,
+    parameter logic [31:0] SB_MASK     = 32'hFFFF_0000
 )(
     input  logic        i_clk,
     input  logic        i_rst_n,
@@ -48,6 +56,7 @@ module k10_core
     input  logic        i_ibus_rvalid,
     input  logic [31:0] i_ibus_rdata,
     input  logic        i_ibus_err,
+    output logic        o_fence_i,          // FENCE.I executed: invalidate I-side caches
 
     // ==== Data bus ====
     output logic        o_dbus_req,
@@ -59,6 +68,9 @@ module k10_core
     input  logic        i_dbus_rvalid,
     input  logic [31:0] i_dbus_rdata,
     input  logic        i_dbus_err,
+    output logic        o_dbus_lock,        // Atomic in progress (see k10_lsu)
+    input  logic        i_snoop_we,         // Other master's write: clears LR reservation
+    input  logic [31:0] i_snoop_addr,
 
     // ==== Interrupts ====
     input  logic        i_ext_irq,
@@ -71,7 +83,10 @@ module k10_core
     output logic        o_debug_mode,
 
     // ==== Timer ====
-    input  logic [63:0] i_mtime
+    input  logic [63:0] i_mtime,
+
+    // ==== Commit trace (k10_trace_buf) ====
+    output commit_trace_t o_commit_trace
 );
 
     // =======================================================================
@@ -86,6 +101,9 @@ module k10_core
     // Fetch outputs
     logic [31:0] w_if_pc, w_if_instr;
     logic        w_if_is_compressed, w_if_valid, w_if_ibus_err, w_if_busy;
+    logic        w_if_bp_taken;
+    logic [31:0] w_if_bp_target;
+    logic [BP_BHT_IDX_W-1:0] w_if_bp_idx;
 
     // Decode outputs
     logic [31:0] w_id_instr_expanded, w_id_imm;
@@ -99,12 +117,18 @@ module k10_core
     // Execute outputs
     logic [31:0] w_ex_alu_result, w_ex_rs1_fwd, w_ex_rs2_fwd, w_ex_branch_target, w_ex_pc_plus;
     logic        w_ex_branch_taken_eval;
-    logic        w_ex_branch_taken;
+    logic        w_ex_resolve;          // EX instruction leaves EX this cycle
+    logic        w_ex_cti;              // ... and is a branch or jump
+    logic        w_ex_bp_ok;            // fetch-stage prediction was right
+    logic        w_ex_redirect;         // mispredict / FENCE.I: refetch from w_ex_redirect_target
+    logic [31:0] w_ex_redirect_target;
 
     // Memory outputs
     logic [31:0] w_mem_rdata;
     logic        w_mem_busy, w_mem_err;
+    logic        w_sb_empty;
     logic        w_mem_misalign_load, w_mem_misalign_store;
+    logic        w_mem_perf_split;
 
     // Writeback outputs
     logic        w_wb_rf_wr_en;
@@ -117,6 +141,7 @@ module k10_core
     priv_lvl_e   w_csr_priv;
     logic        w_trap_taken;
     logic [31:0] w_trap_target;
+    logic [31:0] w_trap_cause;
     logic        w_mret_taken;
     logic [31:0] w_mret_target;
     logic        w_dret_taken;
@@ -135,12 +160,17 @@ module k10_core
     logic        w_md_busy, w_md_done;
     logic [31:0] w_md_result;
 
+    // Performance monitor events (k10_csr mhpmevent selectors)
+    logic [HPM_NUM_EVENTS-1:0] w_hpm_event;
+    logic        w_perf_load_use;
+
     // PC redirect
     logic        w_pc_set;
     logic [31:0] w_pc_target;
 
     logic [31:0] w_async_epc;
     logic        w_step_stall;
+    logic        w_wfi_stall;
 
     // =======================================================================
     //  Pipeline Registers
@@ -153,17 +183,19 @@ module k10_core
     // =======================================================================
     //  1. FETCH STAGE
     // =======================================================================
-    assign w_pc_set    = w_ex_branch_taken || w_trap_taken || w_mret_taken || w_dret_taken ||
+    assign w_pc_set    = w_ex_redirect || w_trap_taken || w_mret_taken || w_dret_taken ||
                          w_debug_taken || w_debug_exc_taken;
     assign w_pc_target = w_debug_taken ? w_debug_target :
                          w_debug_exc_taken ? w_debug_exc_target :
                          w_trap_taken ? w_trap_target :
                          w_dret_taken ? w_dret_target :
                          w_mret_taken ? w_mret_target :
-                         w_ex_branch_target;
+                         w_ex_redirect_target;
 
     k10_fetch #(
-        .BOOT_ADDR (BOOT_ADDR)
+        .BOOT_ADDR      (BOOT_ADDR),
+        .BRANCH_PRED    (BRANCH_PRED),
+        .PREFETCH_DEPTH (PREFETCH_DEPTH)
     ) u_fetch (
         .i_clk           (i_clk),
         .i_rst_n         (i_rst_n),
@@ -171,6 +203,13 @@ module k10_core
         .i_flush         (w_flush_if),
         .i_pc_set        (w_pc_set),
         .i_pc_target     (w_pc_target),
+        .i_bp_upd_valid  (w_ex_resolve && (w_ex_cti || r_id_ex.bp_taken)),
+        .i_bp_upd_pc     (r_id_ex.pc),
+        .i_bp_upd_cti    (w_ex_cti),
+        .i_bp_upd_cond   (r_id_ex.ctrl.is_branch),
+        .i_bp_upd_taken  (w_ex_branch_taken_eval),
+        .i_bp_upd_target (w_ex_branch_target),
+        .i_bp_upd_idx    (r_id_ex.bp_idx),
         .o_ibus_req      (o_ibus_req),
         .o_ibus_addr     (o_ibus_addr),
         .i_ibus_gnt      (i_ibus_gnt),
@@ -182,6 +221,9 @@ module k10_core
         .o_is_compressed (w_if_is_compressed),
         .o_valid         (w_if_valid),
         .o_ibus_err      (w_if_ibus_err),
+        .o_bp_taken      (w_if_bp_taken),
+        .o_bp_target     (w_if_bp_target),
+        .o_bp_idx        (w_if_bp_idx),
         .o_busy          (w_if_busy)
     );
 
@@ -199,6 +241,9 @@ module k10_core
                 r_if_id.pc            <= w_if_pc;
                 r_if_id.instr         <= w_if_instr;
                 r_if_id.is_compressed <= w_if_is_compressed;
+                r_if_id.bp_taken      <= w_if_bp_taken;
+                r_if_id.bp_target     <= w_if_bp_target;
+                r_if_id.bp_idx        <= w_if_bp_idx;
                 r_if_id.valid         <= w_if_valid;
             end
         end
@@ -253,6 +298,9 @@ module k10_core
                 r_id_ex.rd_addr  <= w_id_rd_addr;
                 r_id_ex.csr_addr <= w_id_csr_addr;
                 r_id_ex.ctrl     <= r_if_id.valid ? w_id_ctrl : CTRL_NOP;
+                r_id_ex.bp_taken  <= r_if_id.bp_taken;
+                r_id_ex.bp_target <= r_if_id.bp_target;
+                r_id_ex.bp_idx    <= r_if_id.bp_idx;
                 // Once flush works correctly, valid should not be masked by w_flush_id here since the outer if handles it.
                 r_id_ex.valid    <= r_if_id.valid;
             end
@@ -287,8 +335,35 @@ module k10_core
         .o_pc_plus       (w_ex_pc_plus)
     );
 
-    // Branch condition strictly masked by stall phase
-    assign w_ex_branch_taken = r_id_ex.valid && !w_stall_ex && w_ex_branch_taken_eval;
+    // Branch resolution, strictly masked by stall phase.  Fetch has already
+    // followed its prediction (bp_taken / bp_target), so EX only redirects
+    // when the prediction was wrong: to the target if the branch/jump is
+    // taken, else back to the fall-through PC (predicted taken, not taken).
+    // FENCE.I always redirects to the next instruction, which drops
+    // everything fetched behind it and discards the prefetch queue.
+    assign w_ex_resolve = r_id_ex.valid && !w_stall_ex;
+    assign w_ex_cti     = r_id_ex.ctrl.is_branch || r_id_ex.ctrl.is_jal || r_id_ex.ctrl.is_jalr;
+    assign w_ex_bp_ok   = r_id_ex.ctrl.is_fence_i ? 1'b0 :
+                          r_id_ex.bp_taken
+                          ? (w_ex_branch_taken_eval && (w_ex_branch_target == r_id_ex.bp_target))
+                          : !w_ex_branch_taken_eval;
+
+    assign w_ex_redirect        = w_ex_resolve && !w_ex_bp_ok;
+    assign w_ex_redirect_target = w_ex_branch_taken_eval ? w_ex_branch_target : w_ex_pc_plus;
+
+    assign o_fence_i = w_ex_resolve && r_id_ex.ctrl.is_fence_i;
+
+    // FENCE.I waits in EX until every older store has reached memory: the
+    // store buffer is empty and no store is in MEM.
+    logic w_ex_fence_i_wait;
+    assign w_ex_fence_i_wait = r_id_ex.valid && r_id_ex.ctrl.is_fence_i &&
+                               (!w_sb_empty ||
+                                (r_ex_mem.valid && (r_ex_mem.ctrl.mem_write || r_ex_mem.ctrl.is_atomic)));
+
+    // WFI in EX takes no interrupt itself: it completes once woken, and the
+    // interrupt is taken on the next instruction (mepc = WFI + 4).
+    logic w_ex_wfi;
+    assign w_ex_wfi = r_id_ex.valid && r_id_ex.ctrl.is_wfi;
 
     // CSR unit  (read happens in EX, write committed if no trap)
     logic [31:0] w_csr_wdata;
@@ -414,6 +489,7 @@ module k10_core
     k10_csr #(
         .MHARTID     (MHARTID),
         .PMP_REGIONS (PMP_REGIONS),
+        .MHPM_COUNTERS (MHPM_COUNTERS),
         .DEBUG_HALT_ADDR (DEBUG_HALT_ADDR),
         .DEBUG_EXCEPTION_ADDR (DEBUG_EXCEPTION_ADDR)
     ) u_csr (
@@ -431,12 +507,15 @@ module k10_core
         .i_exc_pc        (w_exc_pc),
         .i_exc_tval      (w_exc_tval),
         .i_is_mret       (r_id_ex.valid && r_id_ex.ctrl.is_mret),
-        .i_is_wfi        (r_id_ex.valid && r_id_ex.ctrl.is_wfi),
+        .i_is_wfi        (w_ex_wfi),
+        .o_wfi_stall     (w_wfi_stall),
         .i_is_dret       (r_id_ex.valid && r_id_ex.ctrl.is_dret),
-        .i_ext_irq       (i_ext_irq && r_id_ex.valid),
-        .i_timer_irq     (i_timer_irq && r_id_ex.valid && !w_stall_ex),
-        .i_sw_irq        (i_sw_irq && r_id_ex.valid && !w_stall_ex),
-        .i_irq_fast      (i_irq_fast & {15{r_id_ex.valid && !w_stall_ex}}),
+        .i_ext_irq       (i_ext_irq && r_id_ex.valid && !w_ex_wfi),
+        .i_timer_irq     (i_timer_irq && r_id_ex.valid && !w_stall_ex && !w_ex_wfi),
+        .i_sw_irq        (i_sw_irq && r_id_ex.valid && !w_stall_ex && !w_ex_wfi),
+        .i_irq_fast      (i_irq_fast & {15{r_id_ex.valid && !w_stall_ex && !w_ex_wfi}}),
+        .i_wake_mip      ({1'b0, i_irq_fast, 4'd0, i_ext_irq, 3'd0, i_timer_irq, 3'd0,
+                           i_sw_irq, 3'd0}),
         .i_id_ex_valid   (r_id_ex.valid && !w_stall_ex),
         .i_debug_req     (i_debug_req),
         .i_trigger_match (w_trigger_match),
@@ -454,12 +533,14 @@ module k10_core
         // ---- Trap output (redirect PC) ----
         .o_trap_taken    (w_trap_taken),
         .o_trap_target   (w_trap_target),
+        .o_trap_cause    (w_trap_cause),
         .o_mret_taken    (w_mret_taken),
         .o_mret_target   (w_mret_target),
         .o_dret_taken    (w_dret_taken),
         .o_dret_target   (w_dret_target),
         .i_async_epc     (w_async_epc),
         .i_instr_retired (r_mem_wb.valid),
+        .i_hpm_event     (w_hpm_event),
         .o_pmp_cfg       (w_pmp_cfg),
         .o_pmp_addr      (w_pmp_addr),
         .i_mtime         (i_mtime)
@@ -468,13 +549,17 @@ module k10_core
 
 
     // Multiply / Divide — uses forwarded operands (critical for data hazards)
-    k10_mul_div u_md (
+    k10_mul_div #(
+        .FAST_DIV   (FAST_DIV),
+        .MUL_STAGES (MUL_STAGES)
+    ) u_md (
         .i_clk    (i_clk),
         .i_rst_n  (i_rst_n),
         .i_start  (r_id_ex.valid && r_id_ex.ctrl.md_en),
         .i_op     (r_id_ex.ctrl.md_op),
         .i_a      (w_ex_rs1_fwd),
         .i_b      (w_ex_rs2_fwd),
+        .i_advance(w_ex_resolve),
         .o_busy   (w_md_busy),
         .o_done   (w_md_done),
         .o_result (w_md_result)
@@ -528,13 +613,18 @@ module k10_core
     // =======================================================================
     //  4. MEMORY STAGE
     // =======================================================================
-    k10_memory u_memory (
+    k10_memory #(
+        .STORE_BUFFER (STORE_BUFFER),
+        .SB_BASE      (SB_BASE),
+        .SB_MASK      (SB_MASK)
+    ) u_memory (
         .i_clk            (i_clk),
         .i_rst_n          (i_rst_n),
         .i_alu_result     (r_ex_mem.alu_result),
         .i_rs2_data       (r_ex_mem.rs2_data),
         .i_ctrl           (r_ex_mem.ctrl),
         .i_valid          (r_ex_mem.valid && w_dbus_pmp_ok),
+        .i_fence          (r_ex_mem.valid && r_ex_mem.ctrl.is_fence),
         .o_dbus_req       (o_dbus_req),
         .o_dbus_we        (o_dbus_we),
         .o_dbus_addr      (o_dbus_addr),
@@ -544,11 +634,16 @@ module k10_core
         .i_dbus_rvalid    (i_dbus_rvalid),
         .i_dbus_rdata     (i_dbus_rdata),
         .i_dbus_err       (i_dbus_err),
+        .o_dbus_lock      (o_dbus_lock),
+        .i_snoop_we       (i_snoop_we),
+        .i_snoop_addr     (i_snoop_addr),
         .o_mem_rdata      (w_mem_rdata),
         .o_busy           (w_mem_busy),
         .o_mem_err        (w_mem_err),
+        .o_sb_empty       (w_sb_empty),
         .o_misalign_load  (w_mem_misalign_load),
-        .o_misalign_store (w_mem_misalign_store)
+        .o_misalign_store (w_mem_misalign_store),
+        .o_perf_split     (w_mem_perf_split)
     );
 
     // ---- MEM/WB Pipeline Register ----
@@ -612,17 +707,18 @@ module k10_core
         .i_wb_valid      (r_mem_wb.valid),
 
         // Control events
-        .i_branch_taken  (w_ex_branch_taken && r_id_ex.valid),
+        .i_branch_taken  (w_ex_redirect),
         .i_debug_taken   (w_debug_taken || w_debug_exc_taken),
         .i_trap_taken    (w_trap_taken),
         .i_mret_taken    (w_mret_taken),
         .i_dret_taken    (w_dret_taken),
-        .i_fence_i       (r_if_id.valid && w_id_ctrl.is_fence_i),
 
         // Busy signals
         .i_fetch_busy    (w_if_busy),
         .i_mem_busy      (w_mem_busy),
         .i_md_busy       (w_md_busy),
+        .i_fence_i_wait  (w_ex_fence_i_wait),
+        .i_wfi_stall     (w_wfi_stall),
 
         // Step stall
         .i_step_stall    (w_step_stall),
@@ -645,9 +741,42 @@ module k10_core
         .o_flush_ex      (w_flush_ex),
         .o_flush_mem     (w_flush_mem),
         .o_fwd_a         (w_fwd_a),
-        .o_fwd_b         (w_fwd_b)
+        .o_fwd_b         (w_fwd_b),
+        .o_perf_load_use (w_perf_load_use)
     );
 
+    // =======================================================================
+    //  PERFORMANCE MONITOR EVENTS  (counted by mhpmcounterN in k10_csr)
+    // =======================================================================
+    always_comb begin
+        w_hpm_event                      = '0;
+        w_hpm_event[HPM_EV_LOAD_USE]     = w_perf_load_use;
+        w_hpm_event[HPM_EV_BRANCH_FLUSH] = w_ex_redirect;
+        w_hpm_event[HPM_EV_MD_BUSY]      = w_md_busy;
+        w_hpm_event[HPM_EV_IF_WAIT]      = w_if_busy && !w_stall_id;
+        w_hpm_event[HPM_EV_LSU_WAIT]     = w_mem_busy;
+        w_hpm_event[HPM_EV_LSU_SPLIT]    = w_mem_perf_split;
+        w_hpm_event[HPM_EV_TRAP_FLUSH]   = w_trap_taken || w_mret_taken || w_dret_taken ||
+                                           w_debug_taken || w_debug_exc_taken;
+        w_hpm_event[HPM_EV_BRANCH]       = w_ex_resolve && w_ex_cti;
+        w_hpm_event[HPM_EV_BP_HIT]       = w_ex_resolve && w_ex_cti && w_ex_bp_ok;
+        w_hpm_event[HPM_EV_BP_MISPREDICT] = w_ex_resolve && w_ex_cti && !w_ex_bp_ok;
+    end
+
+    // =======================================================================
+    //  COMMIT TRACE  (same WB signals as the tracer; synthesizable)
+    // =======================================================================
+    assign o_commit_trace = '{
+        valid:       r_mem_wb.valid,
+        pc:          r_mem_wb.pc,
+        compressed:  r_mem_wb.ctrl.is_compressed,
+        trap:        w_trap_taken,
+        trap_cause:  w_trap_cause,
+        trap_target: w_trap_target,
+        priv:        w_csr_priv,
+        debug_mode:  w_debug_mode
+    };
+
     // =======================================================================
     //  INSTRUCTION TRACER  (simulation only)
     // =======================================================================
@@ -22,14 +22,30 @@
 //   Machine Information : mvendorid, marchid, mimpid, mhartid  (read-only)
 //   Machine Trap Setup  : mstatus, misa, mie, mtvec, mcounteren
 //   Machine Trap Handling: mscratch, mepc, mcause, mtval, mip
-//   Machine Counters    : mcycle/h, minstret/h
+//   Machine Counters    : mcycle/h, minstret/h, mcountinhibit,
+//                         mhpmcounter3–31/h, mhpmevent3–31
 //   PMP                 : pmpcfg0–3, pmpaddr0–15  (delegated to k10_pmp)
-//   User Counters       : cycle/h, time/h, instret/h  (read-only shadows)
+//   User Counters       : cycle/h, time/h, instret/h, hpmcounter3–31/h
+//                         (read-only shadows)
+//
+// Hardware performance monitor:
+//   MHPM_COUNTERS counters (mhpmcounter3 .. 3+MHPM_COUNTERS-1) are
+//   implemented; the rest of 3..31 read as zero and ignore writes.
+//   mhpmeventN holds an hpm_event_e selector (WARL: unknown values read
+//   back as HPM_EV_NONE) and the counter adds one in every cycle its event
+//   input is high.  mcountinhibit gates CY, IR and each implemented HPMn.
 //
 // Trap handling:
 //   Exceptions and interrupts are resolved at the EX/MEM boundary.
 //   On trap, mepc/mcause/mtval are set and a redirect to mtvec is issued.
 //   MRET restores privilege and PC from mstatus.MPP and mepc.
+//
+// WFI:
+//   o_wfi_stall holds WFI in EX until an interrupt is pending and enabled
+//   in mie (mstatus.MIE is ignored, as the spec requires) or a debug
+//   request arrives.  WFI then completes like a NOP and the interrupt, if
+//   enabled, is taken on the next instruction (mepc = WFI + 4).  WFI is a
+//   NOP in Debug Mode and while single-stepping.
 // ============================================================================
 
 module k10_csr
@@ -40,6 +56,7 @@ module k10_csr
     parameter logic [31:0] MIMPID    = 32'd0,
     parameter logic [31:0] MHARTID   = 32'd0,
     parameter int unsigned PMP_REGIONS = 16,
+    parameter int unsigned MHPM_COUNTERS = 8,   // 0..29
     parameter logic [31:0] DEBUG_HALT_ADDR      = 32'h4000_3800,
     parameter logic [31:0] DEBUG_EXCEPTION_ADDR = 32'h4000_3810
 )(
@@ -67,6 +84,7 @@ module k10_csr
     // ---- System instructions ----
     input  logic        i_is_mret,
     input  logic        i_is_wfi,
+    output logic        o_wfi_stall,         // WFI waiting for a wake-up event
     input  logic        i_is_dret,           // DRET instruction
 
     // ---- External interrupts ----
@@ -74,6 +92,7 @@ module k10_csr
     input  logic        i_timer_irq,         // Machine timer interrupt
     input  logic        i_sw_irq,            // Machine software interrupt
     input  logic [14:0] i_irq_fast,          // Fast interrupts (Ibex-style)
+    input  logic [31:0] i_wake_mip,          // Ungated mip bits (WFI wake-up)
     input  logic        i_id_ex_valid,       // Valid instruction in EX stage
 
     // ---- Debug ----
@@ -93,6 +112,7 @@ module k10_csr
     // ---- Trap output (redirect PC) ----
     output logic        o_trap_taken,
     output logic [31:0] o_trap_target,
+    output logic [31:0] o_trap_cause,        // mcause of the trap being taken
     output logic        o_mret_taken,
     output logic [31:0] o_mret_target,
     output logic        o_dret_taken,
@@ -100,6 +120,7 @@ module k10_csr
 
     // ---- Performance counters ----
     input  logic        i_instr_retired,     // WB stage committed
+    input  logic [HPM_NUM_EVENTS-1:0] i_hpm_event,  // indexed by hpm_event_e
 
     // ---- PMP interface (directly exposed for k10_pmp) ----
     output logic [PMP_REGIONS-1:0][7:0]  o_pmp_cfg,
@@ -207,6 +228,7 @@ module k10_csr
     logic r_mcounteren_cy;
     logic r_mcounteren_tm;
     logic r_mcounteren_ir;
+    logic [31:0] r_mcounteren_hpm;   // HPM3..31 bits (implemented ones only)
 
     // --- Machine Trap Handling ---
     logic [31:0] r_mscratch;
@@ -215,9 +237,26 @@ module k10_csr
     logic [31:0] r_mtval;
 
     // --- Counters ---
-    logic [63:0] r_mcycle;
+    logic [63:0] r_mcycle /* verilator public_flat_rw */;   // k10_tb.cpp --fast-forward
     logic [63:0] r_minstret;
 
+    // Implemented HPM counters as a bit mask over counter numbers 0..31
+    localparam logic [31:0] HPM_MASK = 32'(((64'd1 << MHPM_COUNTERS) - 64'd1) << 3);
+
+    logic [31:0]                 r_mcountinhibit;   // CY[0], IR[2], HPMn[n]
+    logic [31:0][63:0]           r_mhpmcounter;     // indexed by counter number
+    logic [31:0][4:0]            r_mhpmevent;
+    logic [4:0]                  w_hpm_idx;         // counter number of i_csr_addr
+    logic [11:0]                 w_hpm_block;       // i_csr_addr with the number cleared
+    logic                        w_hpm_impl;
+
+    assign w_hpm_idx   = i_csr_addr[4:0];
+    assign w_hpm_block = {i_csr_addr[11:5], 5'd0};
+    assign w_hpm_impl  = HPM_MASK[w_hpm_idx];
+
+    logic [31:0] w_hpm_event;                       // i_hpm_event, selector-indexable
+    assign w_hpm_event = 32'(i_hpm_event);
+
     // --- PMP ---
     logic [PMP_REGIONS-1:0][7:0]  r_pmpcfg;
     logic [PMP_REGIONS-1:0][31:0] r_pmpaddr;
@@ -260,6 +299,12 @@ module k10_csr
         end
     end
 
+    // -----------------------------------------------------------------------
+    // WFI sleep
+    // -----------------------------------------------------------------------
+    assign o_wfi_stall = i_is_wfi && !r_debug_mode && !r_dcsr[2] && !i_debug_req &&
+                         ((i_wake_mip & w_mie) == 32'd0);
+
     // -----------------------------------------------------------------------
     // Debug mode entry detection
     // -----------------------------------------------------------------------
@@ -326,6 +371,7 @@ module k10_csr
     assign o_trap_target = w_trap_vectored && w_irq_pending && !i_exc_valid
                            ? w_trap_vec_addr
                            : w_trap_base;
+    assign o_trap_cause  = i_exc_valid ? i_exc_cause : w_irq_cause;
     assign o_mret_taken  = i_is_mret && !r_debug_mode;
     assign o_mret_target = r_mepc;
     assign o_dret_taken  = i_is_dret && r_debug_mode;
@@ -353,8 +399,10 @@ module k10_csr
             CSR_MISA:       w_csr_rdata = MISA_VALUE;
             CSR_MIE:        w_csr_rdata = w_mie;
             CSR_MTVEC:      w_csr_rdata = r_mtvec;
-            CSR_MCOUNTEREN: w_csr_rdata = {29'd0, r_mcounteren_ir,
+            CSR_MCOUNTEREN: w_csr_rdata = r_mcounteren_hpm |
+                                          {29'd0, r_mcounteren_ir,
                                            r_mcounteren_tm, r_mcounteren_cy};
+            CSR_MCOUNTINHIBIT: w_csr_rdata = r_mcountinhibit;
 
             // Machine Trap Handling
             CSR_MSCRATCH:   w_csr_rdata = r_mscratch;
@@ -420,6 +468,26 @@ module k10_csr
             default: begin
                 w_csr_exists = 1'b0;
                 w_csr_rdata  = 32'd0;
+
+                // HPM blocks: every number 3..31 exists, unimplemented
+                // ones read as zero
+                if (w_hpm_idx >= 5'd3) begin
+                    unique case (w_hpm_block)
+                        CSR_MHPMEVENT_BASE: begin
+                            w_csr_exists = 1'b1;
+                            w_csr_rdata  = w_hpm_impl ? 32'(r_mhpmevent[w_hpm_idx]) : 32'd0;
+                        end
+                        CSR_MHPMCOUNTER_BASE, CSR_HPMCOUNTER_BASE: begin
+                            w_csr_exists = 1'b1;
+                            w_csr_rdata  = w_hpm_impl ? r_mhpmcounter[w_hpm_idx][31:0] : 32'd0;
+                        end
+                        CSR_MHPMCOUNTERH_BASE, CSR_HPMCOUNTERH_BASE: begin
+                            w_csr_exists = 1'b1;
+                            w_csr_rdata  = w_hpm_impl ? r_mhpmcounter[w_hpm_idx][63:32] : 32'd0;
+                        end
+                        default: ;
+                    endcase
+                end
             end
         endcase
     end
@@ -444,7 +512,12 @@ module k10_csr
                 CSR_CYCLE, CSR_CYCLEH:     w_counter_ok = r_mcounteren_cy;
                 CSR_TIME, CSR_TIMEH:       w_counter_ok = r_mcounteren_tm;
                 CSR_INSTRET, CSR_INSTRETH: w_counter_ok = r_mcounteren_ir;
-                default: w_counter_ok = 1'b1;
+                default: begin
+                    if (w_hpm_block == CSR_HPMCOUNTER_BASE ||
+                        w_hpm_block == CSR_HPMCOUNTERH_BASE) begin
+                        w_counter_ok = r_mcounteren_hpm[w_hpm_idx];
+                    end
+                end
             endcase
         end
     end
@@ -498,6 +571,10 @@ module k10_csr
             r_mcounteren_cy  <= 1'b0;
             r_mcounteren_tm  <= 1'b0;
             r_mcounteren_ir  <= 1'b0;
+            r_mcounteren_hpm <= 32'd0;
+            r_mcountinhibit  <= 32'd0;
+            r_mhpmcounter    <= '0;
+            r_mhpmevent      <= '0;
             r_mscratch       <= 32'd0;
             r_mepc           <= 32'd0;
             r_mcause         <= 32'd0;
@@ -523,11 +600,18 @@ module k10_csr
             end
         end else begin
 
-            // ---- Counters (always tick) ----
-            r_mcycle <= r_mcycle + 64'd1;
-            if (i_instr_retired) begin
+            // ---- Counters (tick unless inhibited) ----
+            if (!r_mcountinhibit[0]) begin
+                r_mcycle <= r_mcycle + 64'd1;
+            end
+            if (i_instr_retired && !r_mcountinhibit[2]) begin
                 r_minstret <= r_minstret + 64'd1;
             end
+            for (int i = 3; i < 32; i++) begin
+                if (HPM_MASK[i] && !r_mcountinhibit[i] && w_hpm_event[r_mhpmevent[i]]) begin
+                    r_mhpmcounter[i] <= r_mhpmcounter[i] + 64'd1;
+                end
+            end
 
             // ---- Single-Step State Tracker ----
             r_trap_just_taken <= o_trap_taken;
@@ -556,7 +640,7 @@ module k10_csr
             end else if (o_trap_taken) begin
                 // Save state
                 r_mepc         <= i_exc_valid ? i_exc_pc : i_async_epc;
-                r_mcause       <= i_exc_valid ? i_exc_cause : w_irq_cause;
+                r_mcause       <= o_trap_cause;
                 r_mtval        <= i_exc_valid ? i_exc_tval : 32'd0;
 
                 // Update mstatus
@@ -606,8 +690,11 @@ module k10_csr
                         r_mcounteren_cy <= w_csr_wval[0];
                         r_mcounteren_tm <= w_csr_wval[1];
                         r_mcounteren_ir <= w_csr_wval[2];
+                        r_mcounteren_hpm <= w_csr_wval & HPM_MASK;
                     end
 
+                    CSR_MCOUNTINHIBIT: r_mcountinhibit <= w_csr_wval & (HPM_MASK | 32'h5);
+
                     CSR_MSCRATCH: r_mscratch <= w_csr_wval;
                     CSR_MEPC:     r_mepc     <= {w_csr_wval[31:1], 1'b0}; // bit 0 always 0
                     CSR_MCAUSE:   r_mcause   <= w_csr_wval;
@@ -702,7 +789,22 @@ module k10_csr
                     end
                     CSR_TINFO: ; // Read-only
 
-                    default: ; // Unknown — silently ignore (illegal already flagged)
+                    default: begin
+                        // HPM blocks (user shadows are read-only and never
+                        // reach here)
+                        if (w_hpm_impl) begin
+                            unique case (w_hpm_block)
+                                CSR_MHPMEVENT_BASE:
+                                    r_mhpmevent[w_hpm_idx] <= (w_csr_wval < HPM_NUM_EVENTS)
+                                                              ? w_csr_wval[4:0] : HPM_EV_NONE;
+                                CSR_MHPMCOUNTER_BASE:
+                                    r_mhpmcounter[w_hpm_idx][31:0]  <= w_csr_wval;
+                                CSR_MHPMCOUNTERH_BASE:
+                                    r_mhpmcounter[w_hpm_idx][63:32] <= w_csr_wval;
+                                default: ;
+                            endcase
+                        end
+                    end
                 endcase
             end
         end
@@ -16,23 +16,45 @@
 // K10 — Instruction Fetch Stage  (IF)
 // ============================================================================
 // Manages the program counter and fetches instructions over a simple bus.
-// Includes an instruction realignment buffer for the C (compressed) extension
-// so that 16-bit and 32-bit instructions are correctly extracted regardless
-// of half-word alignment.
+// Instructions are extracted from a prefetch queue of 32-bit words, so that
+// 16-bit and 32-bit instructions are correctly extracted regardless of
+// half-word alignment (C extension).
 //
 // Bus interface:  simple valid/ready request–response.
 //   Request:  o_ibus_req / i_ibus_gnt
 //   Response: i_ibus_rvalid / i_ibus_rdata
 //
-// The fetch stage always requests 32-bit aligned reads.  A small buffer
-// (one halfword) holds any residual data from the previous fetch so that
-// instructions that span two aligned words can be reconstructed.
+// Prefetch queue:
+//   The fetch stage always requests 32-bit aligned reads, sequentially from
+//   the current PC, into a PREFETCH_DEPTH-word queue (power of two, >= 2).
+//   The head of the queue is always the word holding the PC.  The aligner
+//   looks at the first two words (queue entries, or the word arriving on
+//   i_ibus_rdata this cycle), so a 32-bit instruction straddling two words
+//   is assembled without an extra fetch, and a word is delivered in the
+//   cycle it arrives.  One request is outstanding at a time, but the next
+//   one is issued in the cycle the previous response arrives: from the
+//   1-cycle BRAM port this gives one word — at least one instruction — per
+//   cycle.  Keeping a single request in flight means responses can never be
+//   reordered by the slaves behind komandara_obi_xbar.
+//
+//   A redirect (i_pc_set, i_flush or a predicted-taken branch) empties the
+//   queue and fetches from the new PC; a request still in flight is
+//   suppressed (its response is dropped).
+//
+// Branch prediction (BRANCH_PRED = 1, see k10_bpred):
+//   When an instruction is handed to ID and the predictor says taken, the
+//   PC moves to the predicted target instead of PC+2/4, exactly as for an
+//   i_pc_set redirect.  The prediction travels with the instruction
+//   (o_bp_*) and EX redirects through i_pc_set if it was wrong.  With
+//   BRANCH_PRED = 0 every instruction is predicted not taken.
 // ============================================================================
 
 module k10_fetch
   import komandara_k10_pkg::*;
 #(
-    parameter logic [31:0] BOOT_ADDR = 32'h0000_0000
+    parameter logic [31:0] BOOT_ADDR      = 32'h0000_0000,
+    parameter bit          BRANCH_PRED    = 1'b1,
+    parameter int unsigned PREFETCH_DEPTH = 4
 )(
     input  logic        i_clk,
     input  logic        i_rst_n,
@@ -45,6 +67,15 @@ module k10_fetch
     input  logic        i_pc_set,
     input  logic [31:0] i_pc_target,
 
+    // Predictor update  (from EX)
+    input  logic        i_bp_upd_valid,
+    input  logic [31:0] i_bp_upd_pc,
+    input  logic        i_bp_upd_cti,
+    input  logic        i_bp_upd_cond,
+    input  logic        i_bp_upd_taken,
+    input  logic [31:0] i_bp_upd_target,
+    input  logic [BP_BHT_IDX_W-1:0] i_bp_upd_idx,
+
     // ---- Instruction bus (to AXI adapter) ----
     output logic        o_ibus_req,
     output logic [31:0] o_ibus_addr,
@@ -59,9 +90,14 @@ module k10_fetch
     output logic        o_is_compressed,
     output logic        o_valid,
     output logic        o_ibus_err,
+    output logic        o_bp_taken,         // o_instr was predicted taken ...
+    output logic [31:0] o_bp_target,        // ... to this target
+    output logic [BP_BHT_IDX_W-1:0] o_bp_idx,
     output logic        o_busy              // fetch is still waiting for data
 );
 
+    localparam int unsigned Q_PTR_W = $clog2(PREFETCH_DEPTH);
+
     // -----------------------------------------------------------------------
     // PC register
     // -----------------------------------------------------------------------
@@ -69,12 +105,15 @@ module k10_fetch
     logic [31:0] w_pc_next;
 
     // -----------------------------------------------------------------------
-    // Instruction alignment buffer
+    // Prefetch queue
     // -----------------------------------------------------------------------
-    // After a 32-bit aligned fetch, the upper halfword may hold the start
-    // of the next instruction.  We keep it here.
-    logic [15:0] r_buf_data;
-    logic        r_buf_valid;
+    // Entry r_q_rd holds the word at {r_pc[31:2], 2'b00}; the following
+    // entries hold the following words.  r_req_addr is the next word to
+    // request (the word after the last queued / in-flight one).
+    logic [31:0]        r_q_data [PREFETCH_DEPTH];
+    logic [Q_PTR_W-1:0] r_q_rd;
+    logic [Q_PTR_W:0]   r_q_count;
+    logic [31:0]        r_req_addr;
 
     // Fetch request tracking
     logic        r_fetch_pending;   // request issued, waiting for response
@@ -83,110 +122,141 @@ module k10_fetch
     // -----------------------------------------------------------------------
     // Derived signals
     // -----------------------------------------------------------------------
-    logic [31:0] w_fetch_addr;       // word-aligned fetch address
     logic        w_have_data;        // we have enough data to output an instr
-
-    // Current instruction data (from buffer + fetched word)
     logic [31:0] w_raw_data;         // 32 bits at current PC
     logic        w_is_compressed;    // instruction is 16-bit?
-    logic        w_need_second_half; // 32-bit instr spans two words
-
-    // Word-aligned fetch address
-    assign w_fetch_addr = {r_pc[31:2], 2'b00};
+    logic        w_redirect;         // queue is emptied, PC moves elsewhere
+    logic [31:0] w_redirect_pc;
+    logic        w_consume;          // instruction handed to ID
+    logic        w_pop;              // ... and it ends the head word
+    logic        w_push;             // response word enters the queue
+    logic        w_issue_ok;         // a new request may be issued
 
     // Suppress stale rvalid: treat suppressed rvalid as if it didn't happen.
     logic w_rvalid_eff;
     assign w_rvalid_eff = i_ibus_rvalid && !r_suppress_rsp;
 
+    // -----------------------------------------------------------------------
+    // Branch prediction
+    // -----------------------------------------------------------------------
+    logic        w_bp_taken;        // predictor lookup on r_pc
+    logic [31:0] w_bp_target;
+    logic        w_bp_redirect;     // instruction handed to ID, PC follows prediction
+
+    if (BRANCH_PRED) begin : g_bpred
+        k10_bpred u_bpred (
+            .i_clk        (i_clk),
+            .i_rst_n      (i_rst_n),
+            .i_pc         (r_pc),
+            .o_taken      (w_bp_taken),
+            .o_target     (w_bp_target),
+            .o_idx        (o_bp_idx),
+            .i_upd_valid  (i_bp_upd_valid),
+            .i_upd_pc     (i_bp_upd_pc),
+            .i_upd_cti    (i_bp_upd_cti),
+            .i_upd_cond   (i_bp_upd_cond),
+            .i_upd_taken  (i_bp_upd_taken),
+            .i_upd_target (i_bp_upd_target),
+            .i_upd_idx    (i_bp_upd_idx)
+        );
+    end else begin : g_no_bpred
+        assign w_bp_taken  = 1'b0;
+        assign w_bp_target = 32'd0;
+        assign o_bp_idx    = '0;
+    end
+
+    // -----------------------------------------------------------------------
+    // First two words of the stream at the PC
+    // -----------------------------------------------------------------------
+    // Word k comes from the queue when it holds more than k entries, or is
+    // the word arriving this cycle when the queue holds exactly k.
+    logic [31:0] w_word0, w_word1;
+    logic        w_word0_valid, w_word1_valid;
+
+    always_comb begin
+        w_word0       = i_ibus_rdata;
+        w_word0_valid = w_rvalid_eff;
+        w_word1       = i_ibus_rdata;
+        w_word1_valid = 1'b0;
+
+        if (r_q_count != '0) begin
+            w_word0       = r_q_data[r_q_rd];
+            w_word0_valid = 1'b1;
+            if (r_q_count > 1) begin
+                w_word1       = r_q_data[Q_PTR_W'(r_q_rd + 1'b1)];
+                w_word1_valid = 1'b1;
+            end else begin
+                w_word1_valid = w_rvalid_eff;
+            end
+        end
+    end
+
     // -----------------------------------------------------------------------
     // Determine what data we have available
     // -----------------------------------------------------------------------
     always_comb begin
-        w_raw_data         = 32'd0;
-        w_is_compressed    = 1'b0;
-        w_have_data        = 1'b0;
-        w_need_second_half = 1'b0;
+        w_raw_data      = 32'd0;
+        w_is_compressed = 1'b0;
+        w_have_data     = 1'b0;
 
         if (r_pc[1] == 1'b0) begin
-            // PC is word-aligned
-            if (r_buf_valid && !r_fetch_pending) begin
-                // We just got redirected, buf_valid is stale from old stream
-                // Wait for fresh fetch
-                w_have_data = 1'b0;
-            end else if (w_rvalid_eff) begin
-                // Fresh data just arrived
-                w_raw_data      = i_ibus_rdata;
-                w_is_compressed = (i_ibus_rdata[1:0] != 2'b11);
-                w_have_data     = 1'b1;
-            end else if (r_buf_valid) begin
-                // Buffered upper half from previous fetch could be
-                // a compressed instruction or the lower half of a 32-bit
-                // We need another fetch for a 32-bit instruction at
-                // word-aligned PC, so this shouldn't happen with proper
-                // buffer management.
-                w_have_data = 1'b0;
-            end
+            // PC is word-aligned: the whole instruction is in word 0
+            w_is_compressed = (w_word0[1:0] != 2'b11);
+            w_raw_data      = w_is_compressed ? {16'd0, w_word0[15:0]} : w_word0;
+            w_have_data     = w_word0_valid;
         end else begin
-            // PC is halfword-aligned (PC[1]=1)
-            if (r_buf_valid) begin
-                // Upper halfword from previous fetch
-                w_is_compressed = (r_buf_data[1:0] != 2'b11);
-                if (w_is_compressed) begin
-                    // 16-bit instruction — we have it in the buffer
-                    w_raw_data  = {16'd0, r_buf_data};
-                    w_have_data = 1'b1;
-                end else begin
-                    // 32-bit instruction spanning two words
-                    if (w_rvalid_eff) begin
-                        w_raw_data  = {i_ibus_rdata[15:0], r_buf_data};
-                        w_have_data = 1'b1;
-                    end else begin
-                        w_need_second_half = 1'b1;
-                        w_have_data        = 1'b0;
-                    end
-                end
-            end else if (w_rvalid_eff) begin
-                // No buffer — use upper half of fetched word
-                w_is_compressed = (i_ibus_rdata[17:16] != 2'b11);
-                if (w_is_compressed) begin
-                    w_raw_data  = {16'd0, i_ibus_rdata[31:16]};
-                    w_have_data = 1'b1;
-                end else begin
-                    // Need another word for the lower half
-                    w_need_second_half = 1'b1;
-                    w_have_data        = 1'b0;
-                end
+            // PC is halfword-aligned: upper half of word 0, and for a
+            // 32-bit instruction the lower half of word 1
+            w_is_compressed = (w_word0[17:16] != 2'b11);
+            if (w_is_compressed) begin
+                w_raw_data  = {16'd0, w_word0[31:16]};
+                w_have_data = w_word0_valid;
+            end else begin
+                w_raw_data  = {w_word1[15:0], w_word0[31:16]};
+                w_have_data = w_word0_valid && w_word1_valid;
             end
         end
     end
 
+    // -----------------------------------------------------------------------
+    // Queue control
+    // -----------------------------------------------------------------------
+    assign w_bp_redirect = w_bp_taken && w_have_data && !i_stall && !i_flush && !i_pc_set;
+
+    assign w_redirect    = i_pc_set || i_flush || w_bp_redirect;
+    assign w_redirect_pc = i_pc_set ? i_pc_target :
+                           w_bp_redirect ? w_bp_target : r_pc;
+
+    assign w_consume = w_have_data && !i_stall && !i_flush && !i_pc_set;
+    assign w_pop     = w_consume && !w_bp_redirect && (r_pc[1] || !w_is_compressed);
+    assign w_push    = w_rvalid_eff && !w_redirect;
+
     // -----------------------------------------------------------------------
     // Instruction bus request
     // -----------------------------------------------------------------------
-    // Issue a fetch when we don't have valid data and aren't already waiting.
+    // A request may go out when nothing is in flight, or the in-flight one
+    // completes this cycle.  Sequential prefetch also needs a free queue
+    // slot for it (counted without this cycle's pop, to keep the hazard
+    // unit's stall off the request path).  After a redirect the queue is
+    // empty, so the new PC is always requested as soon as the bus allows.
     // NOTE: i_stall is intentionally NOT checked here.  The stall prevents PC
-    // and buffer from advancing (see the sequential block) but the bus must be
+    // and queue from advancing (see the sequential block) but the bus must be
     // free to issue requests — otherwise a deadlock occurs because the hazard
     // unit stalls IF when fetch_busy is high, and fetch_busy stays high until
     // data arrives.
+    assign w_issue_ok = !r_fetch_pending || i_ibus_rvalid;
+
     always_comb begin
         o_ibus_req  = 1'b0;
-        o_ibus_addr = w_fetch_addr;
-
-        if (i_flush || i_pc_set) begin
-            // After redirect, need to fetch from new PC
-            o_ibus_req  = !r_fetch_pending;
-            o_ibus_addr = {(i_pc_set ? i_pc_target[31:2] : r_pc[31:2]), 2'b00};
-        end else if (w_need_second_half && !r_fetch_pending) begin
-            // 32-bit instruction spans two words — fetch the next word
-            // NOTE: This must come BEFORE the general !w_have_data check
-            // because w_need_second_half implies !w_have_data, and we need
-            // w_fetch_addr + 4 (the next word) rather than w_fetch_addr.
-            o_ibus_req  = 1'b1;
-            o_ibus_addr = w_fetch_addr + 32'd4;
-        end else if (!w_have_data && !r_fetch_pending) begin
+        o_ibus_addr = r_req_addr;
+
+        if (w_redirect) begin
+            o_ibus_req  = w_issue_ok;
+            o_ibus_addr = {w_redirect_pc[31:2], 2'b00};
+        end else if (w_issue_ok &&
+                     ((r_q_count + (w_rvalid_eff ? 1'b1 : 1'b0)) < (Q_PTR_W+1)'(PREFETCH_DEPTH))) begin
             o_ibus_req  = 1'b1;
-            o_ibus_addr = w_fetch_addr;
+            o_ibus_addr = r_req_addr;
         end
     end
 
@@ -196,9 +266,9 @@ module k10_fetch
     always_comb begin
         w_pc_next = r_pc;
 
-        if (i_pc_set) begin
-            w_pc_next = i_pc_target;
-        end else if (w_have_data && !i_stall) begin
+        if (w_redirect) begin
+            w_pc_next = w_redirect_pc;
+        end else if (w_consume) begin
             w_pc_next = r_pc + (w_is_compressed ? 32'd2 : 32'd4);
         end
     end
@@ -211,87 +281,64 @@ module k10_fetch
     assign o_is_compressed = w_is_compressed;
     assign o_valid         = w_have_data && !i_flush && !i_pc_set;
     assign o_ibus_err      = i_ibus_rvalid && i_ibus_err;
+    assign o_bp_taken      = w_bp_redirect;
+    assign o_bp_target     = w_bp_target;
     assign o_busy          = !w_have_data && !i_flush;
 
     // -----------------------------------------------------------------------
-    // Sequential: PC, buffer, fetch-pending
+    // Sequential: PC, queue, fetch-pending
     // -----------------------------------------------------------------------
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n) begin
             r_pc            <= BOOT_ADDR;
-            r_buf_data      <= 16'd0;
-            r_buf_valid     <= 1'b0;
+            r_req_addr      <= {BOOT_ADDR[31:2], 2'b00};
+            r_q_rd          <= '0;
+            r_q_count       <= '0;
             r_fetch_pending <= 1'b0;
             r_suppress_rsp  <= 1'b0;
         end else begin
             // ---- PC ----
-            if (i_pc_set) begin
-                r_pc <= i_pc_target;
-            end else if (w_have_data && !i_stall) begin
-                r_pc <= w_pc_next;
-            end
+            r_pc <= w_pc_next;
 
             // ---- Stale response suppression ----
-            // When a redirect occurs while a fetch is pending, the
-            // in-flight response is stale.  Set r_suppress_rsp so
-            // the next rvalid is ignored.
-            if ((i_pc_set || i_flush) && r_fetch_pending) begin
+            // When a redirect occurs while a fetch is still in flight after
+            // this cycle, its response is stale.  Set r_suppress_rsp so the
+            // next rvalid is ignored.
+            if (w_redirect && r_fetch_pending && !i_ibus_rvalid) begin
                 r_suppress_rsp <= 1'b1;
-            end else if (i_ibus_rvalid && r_suppress_rsp) begin
+            end else if (i_ibus_rvalid) begin
                 r_suppress_rsp <= 1'b0;
             end
 
             // ---- Fetch pending tracking ----
             if (o_ibus_req && i_ibus_gnt) begin
                 r_fetch_pending <= 1'b1;
-            end
-            if (i_ibus_rvalid) begin
+            end else if (i_ibus_rvalid) begin
                 r_fetch_pending <= 1'b0;
             end
 
-            // ---- Buffer management ----
-            if (i_pc_set || i_flush) begin
-                // Invalidate buffer on redirect
-                r_buf_valid <= 1'b0;
-                r_buf_data  <= 16'd0;
-            end else if (w_have_data && !i_stall) begin
-                if (r_pc[1] == 1'b0) begin
-                    // Word-aligned PC
-                    if (w_is_compressed) begin
-                        // Used lower 16 bits; buffer upper 16 bits
-                        r_buf_valid <= w_rvalid_eff;
-                        r_buf_data  <= w_rvalid_eff ? i_ibus_rdata[31:16] : 16'd0;
-                    end else begin
-                        // Used full 32 bits; no leftover
-                        r_buf_valid <= 1'b0;
-                    end
-                end else begin
-                    // Halfword-aligned PC
-                    if (w_is_compressed) begin
-                        // Used buffered 16 bits; nothing to save (fetch not consumed)
-                        r_buf_valid <= 1'b0;
-                    end else begin
-                        // Used buffer + lower 16 of new fetch; save upper 16
-                        r_buf_valid <= w_rvalid_eff;
-                        r_buf_data  <= w_rvalid_eff ? i_ibus_rdata[31:16] : 16'd0;
-                    end
-                end
-            end else if (w_rvalid_eff && !w_have_data) begin
-                // Data arrived but we can't output yet (e.g. need second word)
-                // Buffer the relevant halfword for the next fetch.
-                if (r_pc[1] == 1'b0) begin
-                    // Word-aligned: buffer upper half for next instruction
-                    r_buf_valid <= 1'b1;
-                    r_buf_data  <= i_ibus_rdata[31:16];
-                end else begin
-                    // Halfword-aligned: the upper half of the fetched word is
-                    // the start of a 32-bit instruction at PC.  Save it so
-                    // that the next fetch (of the following word) can combine
-                    // it to form the full 32-bit instruction.
-                    r_buf_valid <= 1'b1;
-                    r_buf_data  <= i_ibus_rdata[31:16];
-                end
+            // ---- Next request address ----
+            if (w_redirect) begin
+                r_req_addr <= {w_redirect_pc[31:2], 2'b00} + ((o_ibus_req && i_ibus_gnt) ? 32'd4 : 32'd0);
+            end else if (o_ibus_req && i_ibus_gnt) begin
+                r_req_addr <= r_req_addr + 32'd4;
             end
+
+            // ---- Queue ----
+            if (w_redirect) begin
+                r_q_rd    <= '0;
+                r_q_count <= '0;
+            end else begin
+                r_q_rd    <= r_q_rd + (w_pop ? 1'b1 : 1'b0);
+                r_q_count <= r_q_count + (w_push ? 1'b1 : 1'b0) - (w_pop ? 1'b1 : 1'b0);
+            end
+        end
+    end
+
+    // Queue storage (no reset; r_q_count says which entries are live)
+    always_ff @(posedge i_clk) begin
+        if (w_push) begin
+            r_q_data[Q_PTR_W'(r_q_rd + r_q_count)] <= i_ibus_rdata;
         end
     end
 
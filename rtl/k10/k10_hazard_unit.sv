@@ -20,11 +20,10 @@
 // Responsibilities:
 //   1. Data-hazard forwarding  (MEM→EX, WB→EX)
 //   2. Load-use stall          (insert bubble when load result needed next cycle)
-//   3. Control-hazard flush    (branch/jump taken  →  flush IF, ID)
+//   3. Control-hazard flush    (EX redirect: mispredict / FENCE.I  →  flush IF, ID)
 //   4. Trap/MRET flush         (full pipeline flush)
 //   5. Memory-busy stall       (ibus / dbus not responding)
-//   6. MUL/DIV busy stall
-//   7. FENCE.I flush           (flush pipeline + refetch)
+//   6. MUL/DIV busy stall, FENCE.I waiting for the store buffer, WFI sleep
 // ============================================================================
 
 module k10_hazard_unit
@@ -53,13 +52,14 @@ module k10_hazard_unit
     input  logic        i_trap_taken,       // from CSR
     input  logic        i_mret_taken,       // from CSR
     input  logic        i_dret_taken,       // from CSR (debug return)
-    input  logic        i_fence_i,          // FENCE.I in ID stage
     input  logic        i_trap_is_mem,      // Trap originated from MEM stage
 
     // ---- Busy signals ----
     input  logic        i_fetch_busy,       // IF stage waiting for ibus
     input  logic        i_mem_busy,         // MEM stage waiting for dbus
     input  logic        i_md_busy,          // MUL/DIV in progress
+    input  logic        i_fence_i_wait,     // FENCE.I in EX, stores not drained
+    input  logic        i_wfi_stall,        // WFI in EX, no wake-up event yet
     input  logic        i_step_stall,       // Single-step stall
 
     // ---- ID/EX stage load detection (for load-use) ----
@@ -83,7 +83,10 @@ module k10_hazard_unit
 
     // Forwarding control for EX stage
     output fwd_sel_e    o_fwd_a,
-    output fwd_sel_e    o_fwd_b
+    output fwd_sel_e    o_fwd_b,
+
+    // Performance monitor: a load-use bubble is inserted this cycle
+    output logic        o_perf_load_use
 );
 
     // -----------------------------------------------------------------------
@@ -133,9 +136,9 @@ module k10_hazard_unit
     logic w_mem_stall;
     assign w_mem_stall = i_mem_busy;
 
-    // EX-stage stall (MUL/DIV busy)
+    // EX-stage stall (MUL/DIV busy, FENCE.I drain, WFI sleep)
     logic w_ex_stall;
-    assign w_ex_stall = i_md_busy;
+    assign w_ex_stall = i_md_busy || i_fence_i_wait || i_wfi_stall;
 
     // ID-stage stall (load-use)
     // ID-stage stall (load-use or step stall serialization)
@@ -146,6 +149,10 @@ module k10_hazard_unit
     logic w_if_stall;
     assign w_if_stall = i_fetch_busy;
 
+    // Only counted when load-use is the reason ID holds (a MEM / EX stall
+    // would hold it anyway)
+    assign o_perf_load_use = w_load_use && !w_mem_stall && !w_ex_stall;
+
     // ---- Stall outputs (propagate: if lower stage stalls, upper ones do too) ----
     assign o_stall_mem = w_mem_stall;
     assign o_stall_ex  = w_mem_stall || w_ex_stall;
@@ -154,8 +161,7 @@ module k10_hazard_unit
 
     // ---- Flush outputs ----
     // Trap / MRET: flush everything
-    // Branch taken: flush IF/ID and ID/EX
-    // FENCE.I: flush like branch + refetch
+    // EX redirect (mispredict, FENCE.I refetch): flush IF/ID and ID/EX
     // Load-use: insert bubble into EX (flush ID/EX)
     always_comb begin
         o_flush_if  = 1'b0;
@@ -169,7 +175,7 @@ module k10_hazard_unit
             o_flush_id  = 1'b1;
             o_flush_ex  = 1'b1;
             o_flush_mem = i_trap_taken ? i_trap_is_mem : 1'b0;
-        end else if (i_branch_taken || i_fence_i) begin
+        end else if (i_branch_taken) begin
             // Flush IF and ID stages (wrong-path instructions)
             o_flush_if = 1'b1;
             o_flush_id = 1'b1;
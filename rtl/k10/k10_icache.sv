@@ -0,0 +1,269 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Instruction Cache  (direct-mapped, read-only)
+// ============================================================================
+// Sits on the instruction bus between k10_top and the SoC interconnect,
+// with the same request–response protocol on both sides (req/gnt,
+// rvalid/rdata/err; word reads only).
+//
+//   - LINES lines of LINE_WORDS 32-bit words, direct-mapped (both powers
+//     of two, >= 2).
+//   - Only requests inside CACHE_BASE / CACHE_MASK are cached; everything
+//     else (peripherals, the debug module ROM) is passed through uncached.
+//   - Hit:  granted at once, data one cycle later.  A new request is
+//     accepted in the same cycle a response is returned, so a streaming
+//     fetcher gets one word per cycle.
+//   - Miss: the whole line is read downstream, one word after another
+//     starting at word 0, then the requested word is returned.  A line
+//     with an error response in it is not validated.
+//   - i_invalidate (FENCE.I) clears every valid bit.  A lookup in the same
+//     cycle misses, and a fill in progress is not validated.
+//
+// Only one downstream request is outstanding at a time, so responses from
+// different slaves behind komandara_obi_xbar can never be reordered.
+// ============================================================================
+
+module k10_icache #(
+    parameter int unsigned LINES      = 64,
+    parameter int unsigned LINE_WORDS = 4,
+    parameter logic [31:0] CACHE_BASE = 32'h8000_0000,
+    parameter logic [31:0] CACHE_MASK = 32'hFFFF_0000
+)(
+    input  logic        i_clk,
+    input  logic        i_rst_n,
+
+    input  logic        i_invalidate,
+
+    // ---- Upstream (from k10_fetch) ----
+    input  logic        i_req,
+    input  logic [31:0] i_addr,
+    output logic        o_gnt,
+    output logic        o_rvalid,
+    output logic [31:0] o_rdata,
+    output logic        o_err,
+
+    // ---- Downstream (to the instruction interconnect) ----
+    output logic        o_mem_req,
+    output logic [31:0] o_mem_addr,
+    input  logic        i_mem_gnt,
+    input  logic        i_mem_rvalid,
+    input  logic [31:0] i_mem_rdata,
+    input  logic        i_mem_err
+);
+
+    localparam int unsigned OFF_W = $clog2(LINE_WORDS);
+    localparam int unsigned IDX_W = $clog2(LINES);
+    localparam int unsigned TAG_W = 30 - OFF_W - IDX_W;
+
+    // Valid bits are reset; tags and data are not, so they can map onto
+    // distributed RAM.
+    logic             r_valid [LINES];
+    logic [TAG_W-1:0] r_tag   [LINES];
+    logic [31:0]      r_data  [LINES * LINE_WORDS];
+
+    // -----------------------------------------------------------------------
+    // Request decode
+    // -----------------------------------------------------------------------
+    logic [OFF_W-1:0] w_off;
+    logic [IDX_W-1:0] w_idx;
+    logic [TAG_W-1:0] w_tag;
+    logic             w_cacheable;
+    logic             w_hit;
+
+    assign w_off       = i_addr[OFF_W+1:2];
+    assign w_idx       = i_addr[IDX_W+OFF_W+1:OFF_W+2];
+    assign w_tag       = i_addr[31:IDX_W+OFF_W+2];
+    assign w_cacheable = (i_addr & CACHE_MASK) == CACHE_BASE;
+    assign w_hit       = r_valid[w_idx] && (r_tag[w_idx] == w_tag) && !i_invalidate;
+
+    // -----------------------------------------------------------------------
+    // State machine
+    // -----------------------------------------------------------------------
+    typedef enum logic [1:0] {
+        ST_IDLE,        // accept requests, answer hits
+        ST_FILL,        // line fill in progress
+        ST_PASS         // uncached request outstanding downstream
+    } state_e;
+
+    state_e r_state, w_state_next;
+
+    logic [31:0]      r_fill_base;      // line address of the fill
+    logic [OFF_W-1:0] r_fill_off;       // requested word within the line
+    logic [OFF_W:0]   r_fill_req_cnt;   // words requested so far
+    logic [OFF_W:0]   r_fill_rsp_cnt;   // words received so far
+    logic             r_fill_pending;
+    logic             r_fill_err;       // error somewhere in the line
+    logic             r_fill_kill;      // invalidated while filling
+
+    logic             r_rsp_valid;      // response to upstream next cycle
+    logic [31:0]      r_rsp_data;
+    logic             r_rsp_err;
+
+    logic             w_accept;         // upstream request granted (IDLE)
+    logic             w_fill_issue;
+    logic             w_fill_last;      // last word of the line arrives
+
+    always_comb begin
+        w_state_next = r_state;
+
+        case (r_state)
+            ST_IDLE: begin
+                if (i_req && w_cacheable && !w_hit) begin
+                    w_state_next = ST_FILL;
+                end else if (i_req && !w_cacheable && i_mem_gnt) begin
+                    w_state_next = ST_PASS;
+                end
+            end
+            ST_FILL: begin
+                if (w_fill_last) w_state_next = ST_IDLE;
+            end
+            ST_PASS: begin
+                if (i_mem_rvalid) w_state_next = ST_IDLE;
+            end
+            default: w_state_next = ST_IDLE;
+        endcase
+    end
+
+    assign w_fill_issue = (r_state == ST_FILL) &&
+                          (r_fill_req_cnt != (OFF_W+1)'(LINE_WORDS)) &&
+                          (!r_fill_pending || i_mem_rvalid);
+    assign w_fill_last  = (r_state == ST_FILL) && i_mem_rvalid &&
+                          (r_fill_rsp_cnt == (OFF_W+1)'(LINE_WORDS - 1));
+
+    // -----------------------------------------------------------------------
+    // Upstream / downstream ports
+    // -----------------------------------------------------------------------
+    always_comb begin
+        w_accept   = 1'b0;
+        o_gnt      = 1'b0;
+        o_rvalid   = r_rsp_valid;
+        o_rdata    = r_rsp_data;
+        o_err      = r_rsp_err;
+        o_mem_req  = 1'b0;
+        o_mem_addr = i_addr;
+
+        case (r_state)
+            ST_IDLE: begin
+                if (w_cacheable) begin
+                    o_gnt    = i_req;
+                    w_accept = i_req;
+                end else begin
+                    o_mem_req = i_req;
+                    o_gnt     = i_req && i_mem_gnt;
+                end
+            end
+            ST_FILL: begin
+                o_mem_req  = w_fill_issue;
+                o_mem_addr = r_fill_base | {{(30-OFF_W){1'b0}}, r_fill_req_cnt[OFF_W-1:0], 2'b00};
+            end
+            ST_PASS: begin
+                o_rvalid = i_mem_rvalid;
+                o_rdata  = i_mem_rdata;
+                o_err    = i_mem_err;
+            end
+            default: ;
+        endcase
+    end
+
+    // -----------------------------------------------------------------------
+    // Sequential
+    // -----------------------------------------------------------------------
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            r_state        <= ST_IDLE;
+            r_fill_base    <= 32'd0;
+            r_fill_off     <= '0;
+            r_fill_req_cnt <= '0;
+            r_fill_rsp_cnt <= '0;
+            r_fill_pending <= 1'b0;
+            r_fill_err     <= 1'b0;
+            r_fill_kill    <= 1'b0;
+            r_rsp_valid    <= 1'b0;
+            r_rsp_data     <= 32'd0;
+            r_rsp_err      <= 1'b0;
+            for (int i = 0; i < LINES; i++) begin
+                r_valid[i] <= 1'b0;
+            end
+        end else begin
+            r_state     <= w_state_next;
+            r_rsp_valid <= 1'b0;
+
+            // ---- Hit / miss on an accepted request ----
+            if (w_accept && w_hit) begin
+                r_rsp_valid <= 1'b1;
+                r_rsp_data  <= r_data[{w_idx, w_off}];
+                r_rsp_err   <= 1'b0;
+            end else if (w_accept) begin
+                // The tag is overwritten now, the data only during the fill
+                r_valid[w_idx] <= 1'b0;
+                r_fill_base    <= {i_addr[31:OFF_W+2], {(OFF_W+2){1'b0}}};
+                r_fill_off     <= w_off;
+                r_fill_req_cnt <= '0;
+                r_fill_rsp_cnt <= '0;
+                r_fill_err     <= 1'b0;
+                r_fill_kill    <= 1'b0;
+                r_rsp_err      <= 1'b0;
+            end
+
+            // ---- Line fill ----
+            if (w_fill_issue && i_mem_gnt) begin
+                r_fill_req_cnt <= r_fill_req_cnt + 1'b1;
+            end
+            if (w_fill_issue && i_mem_gnt) begin
+                r_fill_pending <= 1'b1;
+            end else if (i_mem_rvalid) begin
+                r_fill_pending <= 1'b0;
+            end
+
+            if (r_state == ST_FILL && i_mem_rvalid) begin
+                r_fill_rsp_cnt <= r_fill_rsp_cnt + 1'b1;
+                if (i_mem_err) r_fill_err <= 1'b1;
+                if (r_fill_rsp_cnt[OFF_W-1:0] == r_fill_off) begin
+                    r_rsp_data <= i_mem_rdata;
+                    r_rsp_err  <= i_mem_err;
+                end
+            end
+
+            if (w_fill_last) begin
+                // The requested word has been captured above (it may be
+                // this last one); answer upstream next cycle.
+                r_rsp_valid <= 1'b1;
+                if (!r_fill_err && !i_mem_err && !r_fill_kill && !i_invalidate) begin
+                    r_valid[r_fill_base[IDX_W+OFF_W+1:OFF_W+2]] <= 1'b1;
+                end
+            end
+
+            // ---- Invalidate ----
+            if (i_invalidate) begin
+                r_fill_kill <= 1'b1;
+                for (int i = 0; i < LINES; i++) begin
+                    r_valid[i] <= 1'b0;
+                end
+            end
+        end
+    end
+
+    // Tag / data arrays (no reset)
+    always_ff @(posedge i_clk) begin
+        if (w_accept && !w_hit) begin
+            r_tag[w_idx] <= w_tag;
+        end
+        if (r_state == ST_FILL && i_mem_rvalid) begin
+            r_data[{r_fill_base[IDX_W+OFF_W+1:OFF_W+2], r_fill_rsp_cnt[OFF_W-1:0]}] <= i_mem_rdata;
+        end
+    end
+
+endmodule : k10_icache
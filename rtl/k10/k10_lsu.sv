@@ -24,6 +24,35 @@
 //   • Atomic (AMO / LR / SC)        — multi-cycle read-modify-write
 //     sequences.  Atomics must be naturally aligned (word-aligned);
 //     misalignment is detected by the wrapper (k10_memory).
+//   • Store buffer (SB_DEPTH > 0)   — see below.
+//
+// Atomics with other bus masters (k10_soc N_HARTS > 1):
+//   o_dbus_lock is held from the first request of an LR, SC or AMO until
+//   its last response; komandara_obi_mux then grants no other master in
+//   between, so the read and write of an AMO are one indivisible access.
+//   The reservation is also cleared by a write of any other master to the
+//   reserved word (i_snoop_we / i_snoop_addr: granted writes on the shared
+//   data bus).  An SC whose reservation is lost while it waits for the
+//   grant fails without a bus access.
+//
+// Store buffer:
+//   Stores that do not cross a word boundary and fall inside the
+//   bufferable window (SB_BASE / SB_MASK, the BRAM in the SoC) retire
+//   without waiting for the bus.  Each entry holds one word with byte
+//   strobes; a store to a word already in the buffer is merged into that
+//   entry, so byte / halfword fills combine into full-word writes.  The
+//   buffer drains in order, one write at a time, whenever the LSU does
+//   not need the bus itself.
+//
+//   Loads inside the window are answered from the buffer when one entry
+//   holds all their bytes; a load that hits no entry goes to the bus
+//   ahead of the buffered stores; a partial hit waits for the drain.
+//   Everything else — accesses outside the window (MMIO at 0x4000_0000,
+//   the debug module, unmapped space), crossing accesses, atomics and
+//   FENCE — waits until the buffer is empty, so it stays ordered after
+//   every older store.  The PMP check is done before a store is accepted
+//   (k10_core gates i_valid).  Write responses of drained stores are not
+//   checked: the bufferable window must not return bus errors.
 //
 // Bus protocol (simple valid/ready):
 //   req + addr + we + wdata + wstrb  →  gnt  →  rvalid + rdata / err
@@ -35,7 +64,11 @@
 
 module k10_lsu
   import komandara_k10_pkg::*;
-(
+#(
+    parameter int unsigned SB_DEPTH = 4,                 // 0 = no store buffer
+    parameter logic [31:0] SB_BASE  = 32'h8000_0000,     // bufferable window
+    parameter logic [31:0] SB_MASK  = 32'hFFFF_0000
+)(
     input  logic        i_clk,
     input  logic        i_rst_n,
 
@@ -48,6 +81,7 @@ module k10_lsu
     input  amo_op_e     i_amo_op,      // AMO operation type
     input  logic [31:0] i_addr,        // Effective address
     input  logic [31:0] i_wdata,       // Store data (rs2, forwarded)
+    input  logic        i_fence,       // FENCE in MEM: wait for the store buffer
 
     // ---- Data bus ----
     output logic        o_dbus_req,
@@ -59,11 +93,18 @@ module k10_lsu
     input  logic        i_dbus_rvalid,
     input  logic [31:0] i_dbus_rdata,
     input  logic        i_dbus_err,
+    output logic        o_dbus_lock,   // Atomic in progress: keep the bus
+    input  logic        i_snoop_we,    // Another master's write was granted
+    input  logic [31:0] i_snoop_addr,  //   ... to this address
 
     // ---- Result ----
     output logic [31:0] o_rdata,       // Sign-extended load result
     output logic        o_busy,        // Stall upstream
-    output logic        o_err          // Bus error (valid when done)
+    output logic        o_err,         // Bus error (valid when done)
+    output logic        o_sb_empty,    // No store buffered or in flight
+
+    // ---- Performance monitor ----
+    output logic        o_perf_split   // Crossing access started (one pulse per split)
 );
 
     // =====================================================================
@@ -139,7 +180,7 @@ module k10_lsu
     assign w_hi_wstrb = w_strb_shifted[7:4];
 
     // =====================================================================
-    // FSM
+    // FSM state
     // =====================================================================
     typedef enum logic [2:0] {
         LSU_IDLE,
@@ -151,6 +192,69 @@ module k10_lsu
     } lsu_state_e;
 
     lsu_state_e  r_state, w_state_next;
+
+    // =====================================================================
+    // Store buffer
+    // =====================================================================
+    // Entries 0 .. r_sb_count-1, oldest first; entry 0 drains next.  A word
+    // is in at most one entry, so a lookup hits at most one entry.
+    localparam int unsigned SB_N     = (SB_DEPTH > 0) ? SB_DEPTH : 1;
+    localparam int unsigned SB_CNT_W = $clog2(SB_N + 1);
+
+    logic [29:0]         r_sb_addr [SB_N];   // word address
+    logic [31:0]         r_sb_data [SB_N];
+    logic [3:0]          r_sb_strb [SB_N];
+    logic [SB_CNT_W-1:0] r_sb_count;
+    logic                r_sb_pending;       // drained write awaiting rvalid
+
+    logic                w_sb_match;         // i_addr word is buffered ...
+    logic [SB_CNT_W-1:0] w_sb_match_idx;     // ... in this entry
+    logic                w_sb_cover;         // ... with all bytes of the access
+
+    always_comb begin
+        w_sb_match     = 1'b0;
+        w_sb_match_idx = '0;
+        for (int i = 0; i < SB_N; i++) begin
+            if ((SB_CNT_W'(i) < r_sb_count) && (r_sb_addr[i] == i_addr[31:2])) begin
+                w_sb_match     = 1'b1;
+                w_sb_match_idx = SB_CNT_W'(i);
+            end
+        end
+    end
+
+    assign w_sb_cover = w_sb_match &&
+                        ((r_sb_strb[w_sb_match_idx] & w_lo_wstrb) == w_lo_wstrb);
+
+    logic w_sb_simple;      // non-atomic, non-crossing, in the window
+    logic w_sb_store;       // store that goes into the buffer
+    logic w_sb_fwd;         // load answered from the buffer
+    logic w_sb_push;        // store accepted this cycle
+    logic w_sb_pop;         // entry 0 granted on the bus this cycle
+    logic w_drain_idle;     // no drained write outstanding after this cycle
+    logic w_sb_drained;     // buffer empty, nothing in flight
+    logic w_sb_ready;       // the access may use the bus now
+    logic w_drain_req;
+
+    assign w_sb_simple  = (SB_DEPTH > 0) && !i_is_atomic && !w_crosses &&
+                          ((i_addr & SB_MASK) == SB_BASE);
+    assign w_sb_store   = i_write && w_sb_simple;
+    assign w_sb_fwd     = i_read && w_sb_simple && w_sb_cover;
+    assign w_drain_idle = !r_sb_pending || i_dbus_rvalid;
+    assign w_sb_drained = (r_sb_count == '0) && w_drain_idle;
+    assign w_sb_ready   = (i_read && w_sb_simple && !w_sb_match) ? w_drain_idle : w_sb_drained;
+    assign w_sb_push    = (r_state == LSU_IDLE) && w_is_mem_op && w_sb_store &&
+                          (w_sb_match || (r_sb_count != SB_CNT_W'(SB_DEPTH)));
+    assign w_sb_pop     = w_drain_req && i_dbus_gnt;
+
+    assign o_sb_empty = (r_sb_count == '0) && !r_sb_pending;
+
+    // While a drained write is outstanding, rvalid belongs to the buffer
+    logic w_lsu_rvalid;
+    assign w_lsu_rvalid = i_dbus_rvalid && !r_sb_pending;
+
+    // =====================================================================
+    // FSM
+    // =====================================================================
     logic        r_granted;         // Current bus request has been granted
     logic [31:0] r_lo_rdata;        // Captured lower-word (split) / AMO read data
     logic        r_err_acc;         // Accumulated error for split accesses
@@ -210,7 +314,15 @@ module k10_lsu
             // =============================================================
             LSU_IDLE: begin
                 if (w_is_mem_op) begin
-                    if (i_is_atomic) begin
+                    if (w_sb_store) begin
+                        // Buffered: retires as soon as there is room
+                        w_done = w_sb_push;
+                    end else if (w_sb_fwd) begin
+                        // Load answered from the store buffer
+                        w_done = 1'b1;
+                    end else if (!w_sb_ready) begin
+                        // Wait for (part of) the store buffer to drain
+                    end else if (i_is_atomic) begin
                         if (i_amo_op == AMO_SC) begin
                             if (w_sc_fail) begin
                                 // SC fails immediately — no bus access
@@ -260,7 +372,7 @@ module k10_lsu
                     o_dbus_wdata = w_lo_wdata;
                     o_dbus_wstrb = w_lo_wstrb;
                 end
-                if (i_dbus_rvalid) begin
+                if (w_lsu_rvalid) begin
                     w_state_next = LSU_IDLE;
                     w_done       = 1'b1;
                 end
@@ -275,7 +387,7 @@ module k10_lsu
                     o_dbus_wdata = w_lo_wdata;
                     o_dbus_wstrb = w_lo_wstrb;
                 end
-                if (i_dbus_rvalid) begin
+                if (w_lsu_rvalid) begin
                     // First half done → advance to upper word
                     w_state_next = LSU_SPLIT_HI;
                 end
@@ -290,7 +402,7 @@ module k10_lsu
                     o_dbus_wdata = w_hi_wdata;
                     o_dbus_wstrb = w_hi_wstrb;
                 end
-                if (i_dbus_rvalid) begin
+                if (w_lsu_rvalid) begin
                     w_state_next = LSU_IDLE;
                     w_done       = 1'b1;
                 end
@@ -303,7 +415,7 @@ module k10_lsu
                     o_dbus_we   = 1'b0;
                     o_dbus_addr = w_addr_lo;
                 end
-                if (i_dbus_rvalid) begin
+                if (w_lsu_rvalid) begin
                     if (i_amo_op == AMO_LR) begin
                         // LR completes after the read
                         w_state_next = LSU_IDLE;
@@ -317,14 +429,18 @@ module k10_lsu
 
             // =============================================================
             LSU_AMO_WRITE: begin
-                if (!r_granted) begin
+                if (!r_granted && w_sc_fail) begin
+                    // Reservation lost to another master before the grant
+                    w_state_next = LSU_IDLE;
+                    w_done       = 1'b1;
+                end else if (!r_granted) begin
                     o_dbus_req   = 1'b1;
                     o_dbus_we    = 1'b1;
                     o_dbus_addr  = w_addr_lo;
                     o_dbus_wdata = (i_amo_op == AMO_SC) ? i_wdata : w_amo_result;
                     o_dbus_wstrb = 4'b1111;
                 end
-                if (i_dbus_rvalid) begin
+                if (w_lsu_rvalid) begin
                     w_state_next = LSU_IDLE;
                     w_done       = 1'b1;
                 end
@@ -333,11 +449,73 @@ module k10_lsu
             // =============================================================
             default: w_state_next = LSU_IDLE;
         endcase
+
+        o_dbus_lock = (r_state == LSU_AMO_READ) || (r_state == LSU_AMO_WRITE) ||
+                      (w_state_next == LSU_AMO_READ) || (w_state_next == LSU_AMO_WRITE);
+
+        // Drain: entry 0 goes out whenever the FSM leaves the bus free.
+        // Not while a store merges into entry 0 (it would be lost).
+        w_drain_req = (r_state == LSU_IDLE) && !o_dbus_req &&
+                      (r_sb_count != '0) && w_drain_idle &&
+                      !(w_sb_push && w_sb_match && (w_sb_match_idx == '0));
+        if (w_drain_req) begin
+            o_dbus_req   = 1'b1;
+            o_dbus_we    = 1'b1;
+            o_dbus_addr  = {r_sb_addr[0], 2'b00};
+            o_dbus_wdata = r_sb_data[0];
+            o_dbus_wstrb = r_sb_strb[0];
+        end
+    end
+
+    // =====================================================================
+    // Store buffer — sequential
+    // =====================================================================
+    // Pop shifts every entry down by one.  A merge or allocation in the
+    // same cycle targets the shifted position (assigned after the shift,
+    // so it takes precedence).
+    logic [SB_CNT_W-1:0] w_sb_slot;
+    assign w_sb_slot = (w_sb_match ? w_sb_match_idx : r_sb_count) - (w_sb_pop ? 1'b1 : 1'b0);
+
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            r_sb_count   <= '0;
+            r_sb_pending <= 1'b0;
+        end else begin
+            r_sb_count <= r_sb_count + ((w_sb_push && !w_sb_match) ? 1'b1 : 1'b0)
+                                     - (w_sb_pop ? 1'b1 : 1'b0);
+
+            if (w_sb_pop) begin
+                r_sb_pending <= 1'b1;
+            end else if (i_dbus_rvalid) begin
+                r_sb_pending <= 1'b0;
+            end
+        end
+    end
+
+    always_ff @(posedge i_clk) begin
+        if (w_sb_pop) begin
+            for (int i = 0; i < SB_N - 1; i++) begin
+                r_sb_addr[i] <= r_sb_addr[i+1];
+                r_sb_data[i] <= r_sb_data[i+1];
+                r_sb_strb[i] <= r_sb_strb[i+1];
+            end
+        end
+        if (w_sb_push) begin
+            r_sb_addr[w_sb_slot] <= i_addr[31:2];
+            r_sb_strb[w_sb_slot] <= (w_sb_match ? r_sb_strb[w_sb_match_idx] : 4'b0000) | w_lo_wstrb;
+            for (int b = 0; b < 4; b++) begin
+                r_sb_data[w_sb_slot][8*b +: 8] <= w_lo_wstrb[b] ? w_lo_wdata[8*b +: 8]
+                                                                : r_sb_data[w_sb_match_idx][8*b +: 8];
+            end
+        end
     end
 
     // =====================================================================
     // FSM — sequential
     // =====================================================================
+    logic w_lr_done;       // LR read data returns: the reservation is set
+    assign w_lr_done = (r_state == LSU_AMO_READ) && w_lsu_rvalid && (i_amo_op == AMO_LR);
+
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n) begin
             r_state             <= LSU_IDLE;
@@ -351,7 +529,7 @@ module k10_lsu
 
             // ----- Grant tracking -----
             // Priority: rvalid > gnt > state-change (clear)
-            if (i_dbus_rvalid) begin
+            if (w_lsu_rvalid) begin
                 r_granted <= 1'b0;
             end else if (i_dbus_gnt && o_dbus_req) begin
                 r_granted <= 1'b1;
@@ -362,26 +540,25 @@ module k10_lsu
 
             // ----- Capture lower-word / AMO read data -----
             if ((r_state == LSU_SPLIT_LO || r_state == LSU_AMO_READ) &&
-                 i_dbus_rvalid) begin
+                 w_lsu_rvalid) begin
                 r_lo_rdata <= i_dbus_rdata;
             end
 
             // ----- Error accumulation for split accesses -----
             if (w_state_next == LSU_IDLE) begin
                 r_err_acc <= 1'b0;
-            end else if (r_state == LSU_SPLIT_LO && i_dbus_rvalid && i_dbus_err) begin
+            end else if (r_state == LSU_SPLIT_LO && w_lsu_rvalid && i_dbus_err) begin
                 r_err_acc <= 1'b1;
             end
 
             // ----- LR sets reservation -----
-            if (r_state == LSU_AMO_READ && i_dbus_rvalid &&
-                i_amo_op == AMO_LR) begin
+            if (w_lr_done) begin
                 r_reservation_valid <= 1'b1;
                 r_reservation_addr  <= w_addr_lo;
             end
 
             // ----- SC clears reservation (regardless of success) -----
-            if (r_state == LSU_AMO_WRITE && i_dbus_rvalid &&
+            if (r_state == LSU_AMO_WRITE && w_lsu_rvalid &&
                 i_amo_op == AMO_SC) begin
                 r_reservation_valid <= 1'b0;
             end
@@ -397,6 +574,14 @@ module k10_lsu
                 w_addr_lo == r_reservation_addr) begin
                 r_reservation_valid <= 1'b0;
             end
+
+            // ----- Another master's write to the reserved word clears it -----
+            // (also the one an LR sets in this cycle)
+            if (i_snoop_we &&
+                (i_snoop_addr[31:2] == (w_lr_done ? w_addr_lo[31:2]
+                                                  : r_reservation_addr[31:2]))) begin
+                r_reservation_valid <= 1'b0;
+            end
         end
     end
 
@@ -421,6 +606,8 @@ module k10_lsu
     always_comb begin
         if (r_state == LSU_SPLIT_HI) begin
             w_combined = {i_dbus_rdata, r_lo_rdata};
+        end else if (w_sb_fwd) begin
+            w_combined = {32'd0, r_sb_data[w_sb_match_idx]};
         end else begin
             w_combined = {32'd0, i_dbus_rdata};
         end
@@ -437,7 +624,7 @@ module k10_lsu
             if (i_amo_op == AMO_SC) begin
                 o_rdata = w_sc_fail ? 32'd1 : 32'd0;
             end else begin
-                if ((r_state == LSU_AMO_READ) && i_dbus_rvalid) begin
+                if ((r_state == LSU_AMO_READ) && w_lsu_rvalid) begin
                     o_rdata = i_dbus_rdata;        // AMO/LR read completion cycle
                 end else begin
                     o_rdata = r_lo_rdata;          // Captured AMO_READ value
@@ -463,9 +650,12 @@ module k10_lsu
     //       drops to 0 in the same cycle w_done asserts so the pipeline
     //       can capture the result and advance without re-starting the
     //       same access.
+    //       A FENCE is held until the store buffer has drained.
     // err : pulsed when the operation completes with an error.
-    assign o_busy = w_is_mem_op && !w_done;
-    assign o_err  = w_done && ((i_dbus_rvalid && i_dbus_err) || r_err_acc);
+    assign o_busy = (w_is_mem_op && !w_done) || (i_fence && !o_sb_empty);
+    assign o_err  = w_done && ((w_lsu_rvalid && i_dbus_err) || r_err_acc);
+
+    assign o_perf_split = (r_state == LSU_IDLE) && (w_state_next == LSU_SPLIT_LO);
 
     // =====================================================================
     // Assertions (simulation only)
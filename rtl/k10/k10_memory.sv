@@ -25,12 +25,16 @@
 //     the results.
 //
 // All bus logic (aligned, unaligned split, AMO read-modify-write,
-// sign extension) is handled inside the LSU.
+// sign extension, store buffer) is handled inside the LSU.
 // ============================================================================
 
 module k10_memory
   import komandara_k10_pkg::*;
-(
+#(
+    parameter int unsigned STORE_BUFFER = 4,             // see k10_lsu
+    parameter logic [31:0] SB_BASE      = 32'h8000_0000,
+    parameter logic [31:0] SB_MASK      = 32'hFFFF_0000
+)(
     input  logic        i_clk,
     input  logic        i_rst_n,
 
@@ -39,6 +43,7 @@ module k10_memory
     input  logic [31:0] i_rs2_data,     // Store data (forwarded)
     input  ctrl_t       i_ctrl,
     input  logic        i_valid,        // Stage active
+    input  logic        i_fence,        // FENCE in MEM (not gated by PMP)
 
     // ---- Data bus ----
     output logic        o_dbus_req,
@@ -50,16 +55,23 @@ module k10_memory
     input  logic        i_dbus_rvalid,
     input  logic [31:0] i_dbus_rdata,
     input  logic        i_dbus_err,
+    output logic        o_dbus_lock,    // see k10_lsu
+    input  logic        i_snoop_we,
+    input  logic [31:0] i_snoop_addr,
 
     // Outputs
     output logic [31:0] o_mem_rdata,    // Sign-extended load data
     output logic        o_busy,         // Stage still processing (stall upstream)
     output logic        o_mem_err,
+    output logic        o_sb_empty,     // Store buffer drained
 
     // Misalignment exception outputs  (AMO only — normal misaligned
     // loads/stores are handled transparently by the LSU)
     output logic        o_misalign_load,
-    output logic        o_misalign_store
+    output logic        o_misalign_store,
+
+    // Performance monitor: misaligned access split into two bus accesses
+    output logic        o_perf_split
 );
 
     // -----------------------------------------------------------------------
@@ -80,7 +92,11 @@ module k10_memory
     // -----------------------------------------------------------------------
     // LSU instance
     // -----------------------------------------------------------------------
-    k10_lsu u_lsu (
+    k10_lsu #(
+        .SB_DEPTH (STORE_BUFFER),
+        .SB_BASE  (SB_BASE),
+        .SB_MASK  (SB_MASK)
+    ) u_lsu (
         .i_clk         (i_clk),
         .i_rst_n       (i_rst_n),
 
@@ -92,6 +108,7 @@ module k10_memory
         .i_amo_op      (i_ctrl.amo_op),
         .i_addr        (i_alu_result),
         .i_wdata       (i_rs2_data),
+        .i_fence       (i_fence),
 
         .o_dbus_req    (o_dbus_req),
         .o_dbus_we     (o_dbus_we),
@@ -102,10 +119,15 @@ module k10_memory
         .i_dbus_rvalid (i_dbus_rvalid),
         .i_dbus_rdata  (i_dbus_rdata),
         .i_dbus_err    (i_dbus_err),
+        .o_dbus_lock   (o_dbus_lock),
+        .i_snoop_we    (i_snoop_we),
+        .i_snoop_addr  (i_snoop_addr),
 
         .o_rdata       (o_mem_rdata),
         .o_busy        (o_busy),
-        .o_err         (o_mem_err)
+        .o_err         (o_mem_err),
+        .o_sb_empty    (o_sb_empty),
+        .o_perf_split  (o_perf_split)
     );
 
 endmodule : k10_memory
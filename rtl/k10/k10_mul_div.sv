@@ -15,8 +15,34 @@
 // ============================================================================
 // K10 — Multiply / Divide Unit  (M extension)
 // ============================================================================
-// Multiplies are single-cycle (combinational `*`; synthesis handles it).
-// Divides / remainders are iterative restoring division (32 cycles).
+// Multiplies take MUL_STAGES cycles in EX; divides / remainders are
+// iterative restoring division.
+//
+// Multiply latency (cycles in EX):
+//   MUL_STAGES = 1 : combinational `*` from the forwarded operands.
+//   MUL_STAGES = 2 : the sign-extended 33-bit operands are registered in
+//                    the start cycle (DSP48E1 A/B registers); the product
+//                    feeds the EX result mux in the next cycle.
+//   MUL_STAGES = 3 : the product is registered as well (M/P registers) and
+//                    the result comes straight from that register.
+//   The pipeline registers have no reset and no other load condition than
+//   the start cycle, so Vivado can pull them into the DSP48E1 cascade that
+//   a 33x33 multiply maps to.  All four MUL* ops share one signed 33x33
+//   multiplier.  o_busy stalls EX for the MUL_STAGES - 1 extra cycles, the
+//   way the divider does; i_advance restarts the count when a multiply
+//   leaves EX, so back-to-back multiplies each get their own pass.
+//
+// Divide latency (cycles from i_start to o_done):
+//   FAST_DIV = 0 : always 33 (start cycle + 32 iterations)
+//   FAST_DIV = 1 : 1 when the divisor is 0 or ±1, or |a| < |b|
+//                  (quotient is a constant / the dividend / zero);
+//                  otherwise 1 + (clz|b| - clz|a| + 1), i.e. one iteration
+//                  per quotient bit that can be non-zero.  The leading
+//                  dividend bits that cannot produce a quotient bit are
+//                  preloaded into the partial remainder in the start cycle.
+//   FAST_DIV puts two leading-zero counts and two barrel shifters on the
+//   forwarded-operand path into the start cycle; set it to 0 if that path
+//   limits Fmax.
 //
 // Interface protocol:
 //   i_start  — held high while an MD instruction occupies the EX stage.
@@ -24,8 +50,11 @@
 //              captures result and advances).
 //   o_done   — high when the result is valid.
 //   o_result — the 32-bit result.
+//   i_advance — the instruction in EX moves on this cycle (only the
+//              pipelined multiplier uses it).
 //
-// FSM: IDLE → CALC (32 iterations) → DONE → IDLE
+// FSM: IDLE → CALC (1..32 iterations) → DONE → IDLE
+//      IDLE → DONE                     (FAST_DIV fast paths)
 //
 // In DONE state: o_busy=0, o_done=1.  The pipeline samples w_ex_result and
 // advances the instruction from EX → MEM.  We remain in DONE until
@@ -35,7 +64,10 @@
 
 module k10_mul_div
   import komandara_k10_pkg::*;
-(
+#(
+    parameter bit          FAST_DIV   = 1'b1,  // early termination + trivial-divisor fast paths
+    parameter int unsigned MUL_STAGES = 1      // multiply cycles in EX (1, 2 or 3)
+)(
     input  logic        i_clk,
     input  logic        i_rst_n,
 
@@ -43,23 +75,13 @@ module k10_mul_div
     input  md_op_e      i_op,
     input  logic [31:0] i_a,        // rs1
     input  logic [31:0] i_b,        // rs2
+    input  logic        i_advance,  // EX → MEM this cycle (instruction leaves EX)
 
     output logic        o_busy,
     output logic        o_done,
     output logic [31:0] o_result
 );
 
-    // -----------------------------------------------------------------------
-    // Multiply (single cycle — combinational)
-    // -----------------------------------------------------------------------
-    logic [63:0] w_mul_ss;   // signed   × signed
-    logic [63:0] w_mul_su;   // signed   × unsigned
-    logic [63:0] w_mul_uu;   // unsigned × unsigned
-
-    assign w_mul_ss = $signed(i_a) * $signed(i_b);
-    assign w_mul_su = $signed({{32{i_a[31]}}, i_a}) * $signed({1'b0, i_b});
-    assign w_mul_uu = {32'd0, i_a} * {32'd0, i_b};
-
     // -----------------------------------------------------------------------
     // Classification helpers
     // -----------------------------------------------------------------------
@@ -76,6 +98,80 @@ module k10_mul_div
     logic w_is_div_request;
     assign w_is_div_request = i_start && !w_is_mul;
 
+    // -----------------------------------------------------------------------
+    // Multiply
+    // -----------------------------------------------------------------------
+    logic [31:0] w_mul_result;
+    logic        w_mul_busy;
+    logic        w_mul_done;
+
+    if (MUL_STAGES <= 1) begin : g_mul_comb
+        logic [63:0] w_mul_ss;   // signed   × signed
+        logic [63:0] w_mul_su;   // signed   × unsigned
+        logic [63:0] w_mul_uu;   // unsigned × unsigned
+
+        assign w_mul_ss = $signed(i_a) * $signed(i_b);
+        assign w_mul_su = $signed({{32{i_a[31]}}, i_a}) * $signed({1'b0, i_b});
+        assign w_mul_uu = {32'd0, i_a} * {32'd0, i_b};
+
+        always_comb begin
+            unique case (i_op)
+                MD_MUL:    w_mul_result = w_mul_ss[31:0];
+                MD_MULH:   w_mul_result = w_mul_ss[63:32];
+                MD_MULHSU: w_mul_result = w_mul_su[63:32];
+                MD_MULHU:  w_mul_result = w_mul_uu[63:32];
+                default:   w_mul_result = 32'd0;
+            endcase
+        end
+
+        assign w_mul_busy = 1'b0;
+        assign w_mul_done = w_is_mul && i_start;
+
+    end else begin : g_mul_pipe
+        localparam int unsigned LAST = (MUL_STAGES > 3) ? 2 : MUL_STAGES - 1;
+
+        logic              w_mul_req;
+        logic [1:0]        r_mul_cnt;    // cycles this multiply has been in EX
+        logic              r_mul_hi;     // MULH* : upper half
+        (* use_dsp = "yes" *) logic signed [32:0] r_mul_a, r_mul_b;
+        (* use_dsp = "yes" *) logic signed [65:0] w_mul_prod;
+
+        assign w_mul_req = i_start && w_is_mul;
+
+        always_ff @(posedge i_clk or negedge i_rst_n) begin
+            if (!i_rst_n) begin
+                r_mul_cnt <= 2'd0;
+            end else if (!w_mul_req || i_advance) begin
+                r_mul_cnt <= 2'd0;
+            end else if (r_mul_cnt != 2'(LAST)) begin
+                r_mul_cnt <= r_mul_cnt + 2'd1;
+            end
+        end
+
+        // Operand registers: loaded only in the start cycle, no reset
+        always_ff @(posedge i_clk) begin
+            if (w_mul_req && r_mul_cnt == 2'd0) begin
+                r_mul_a  <= $signed({(i_op == MD_MULH || i_op == MD_MULHSU) && i_a[31], i_a});
+                r_mul_b  <= $signed({(i_op == MD_MULH) && i_b[31], i_b});
+                r_mul_hi <= (i_op != MD_MUL);
+            end
+        end
+
+        if (LAST == 1) begin : g_two
+            assign w_mul_prod = r_mul_a * r_mul_b;
+        end else begin : g_three
+            (* use_dsp = "yes" *) logic signed [65:0] r_mul_prod;
+            always_ff @(posedge i_clk) begin
+                r_mul_prod <= r_mul_a * r_mul_b;
+            end
+            assign w_mul_prod = r_mul_prod;
+        end
+
+        assign w_mul_result = r_mul_hi ? w_mul_prod[63:32] : w_mul_prod[31:0];
+        assign w_mul_busy   = w_mul_req && (r_mul_cnt != 2'(LAST));
+        assign w_mul_done   = w_mul_req && (r_mul_cnt == 2'(LAST));
+    end
+
     // -----------------------------------------------------------------------
     // Divide / Remainder — iterative restoring division
     // -----------------------------------------------------------------------
@@ -100,6 +196,28 @@ module k10_mul_div
 
     logic [32:0] w_sub;          // trial subtraction
 
+    // -----------------------------------------------------------------------
+    // Operand preparation (start cycle)
+    // -----------------------------------------------------------------------
+    function automatic logic [5:0] clz32(input logic [31:0] v);
+        clz32 = 6'd32;
+        for (int i = 0; i < 32; i++) begin
+            if (v[i]) clz32 = 6'(31 - i);
+        end
+    endfunction
+
+    logic [31:0] w_abs_a, w_abs_b;
+    logic [5:0]  w_iters;        // quotient bits to compute (FAST_DIV)
+    logic        w_div_trivial;  // result known without iterating (FAST_DIV)
+
+    assign w_abs_a = (w_is_signed && i_a[31]) ? (~i_a + 32'd1) : i_a;
+    assign w_abs_b = (w_is_signed && i_b[31]) ? (~i_b + 32'd1) : i_b;
+
+    // Only meaningful when |a| >= |b| >= 2: then clz|b| >= clz|a| and
+    // 1 <= w_iters <= 31.
+    assign w_iters       = clz32(w_abs_b) - clz32(w_abs_a) + 6'd1;
+    assign w_div_trivial = FAST_DIV && ((w_abs_b <= 32'd1) || (w_abs_a < w_abs_b));
+
     // -----------------------------------------------------------------------
     // Division datapath
     // -----------------------------------------------------------------------
@@ -114,7 +232,7 @@ module k10_mul_div
         unique case (r_state)
             DIV_IDLE: begin
                 if (w_is_div_request) begin
-                    w_state_next = DIV_CALC;
+                    w_state_next = w_div_trivial ? DIV_DONE : DIV_CALC;
                 end
             end
             DIV_CALC: begin
@@ -154,24 +272,31 @@ module k10_mul_div
             unique case (r_state)
                 DIV_IDLE: begin
                     if (w_is_div_request) begin
-                        r_count       <= 6'd0;
-                        r_quotient    <= 32'd0;
-                        r_remainder   <= 32'd0;
-                        r_is_rem      <= w_is_rem;
-                        r_div_by_zero <= (i_b == 32'd0);
-
-                        if (w_is_signed) begin
-                            r_dividend      <= i_a[31] ? (~i_a + 32'd1) : i_a;
-                            r_divisor       <= i_b[31] ? (~i_b + 32'd1) : i_b;
-                            r_sign_q        <= i_a[31] ^ i_b[31];
-                            r_sign_r        <= i_a[31];
-                            r_orig_dividend <= i_a;  // Save original (signed) dividend
-                        end else begin
-                            r_dividend      <= i_a;
-                            r_divisor       <= i_b;
-                            r_sign_q        <= 1'b0;
-                            r_sign_r        <= 1'b0;
-                            r_orig_dividend <= i_a;  // Save original dividend
+                        r_count         <= 6'd0;
+                        r_quotient      <= 32'd0;
+                        r_remainder     <= 32'd0;
+                        r_is_rem        <= w_is_rem;
+                        r_div_by_zero   <= (i_b == 32'd0);
+                        r_dividend      <= w_abs_a;
+                        r_divisor       <= w_abs_b;
+                        r_sign_q        <= w_is_signed && (i_a[31] ^ i_b[31]);
+                        r_sign_r        <= w_is_signed && i_a[31];
+                        r_orig_dividend <= i_a;  // Save original dividend
+
+                        if (FAST_DIV) begin
+                            if (w_abs_b == 32'd1) begin
+                                r_quotient  <= w_abs_a;
+                            end else if (w_abs_a < w_abs_b) begin
+                                r_remainder <= w_abs_a;
+                            end else begin
+                                // Skip the iterations whose quotient bit is
+                                // necessarily 0: the top (32 - w_iters) bits
+                                // of |a| are < |b| and become the initial
+                                // partial remainder.
+                                r_count     <= 6'd32 - w_iters;
+                                r_remainder <= w_abs_a >> w_iters;
+                                r_dividend  <= w_abs_a << (6'd32 - w_iters);
+                            end
                         end
                     end
                 end
@@ -218,34 +343,23 @@ module k10_mul_div
         end
     end
 
-    always_comb begin
-        o_result = 32'd0;
-
-        if (w_is_mul && i_start) begin
-            unique case (i_op)
-                MD_MUL:    o_result = w_mul_ss[31:0];
-                MD_MULH:   o_result = w_mul_ss[63:32];
-                MD_MULHSU: o_result = w_mul_su[63:32];
-                MD_MULHU:  o_result = w_mul_uu[63:32];
-                default:   o_result = 32'd0;
-            endcase
-        end else begin
-            o_result = w_div_result;
-        end
-    end
+    assign o_result = (w_is_mul && i_start) ? w_mul_result : w_div_result;
 
     // -----------------------------------------------------------------------
     // Status
     // -----------------------------------------------------------------------
-    // o_busy: stalls the pipeline during CALC (and the start cycle IDLE→CALC).
+    // o_busy: stalls the pipeline during CALC (and the start cycle IDLE→CALC),
+    //         and for the first MUL_STAGES - 1 cycles of a multiply.
     //         NOT asserted during DONE — the pipeline must capture the result.
     assign o_busy = (r_state == DIV_CALC) ||
-                    (r_state == DIV_IDLE && w_is_div_request);
+                    (r_state == DIV_IDLE && w_is_div_request) ||
+                    w_mul_busy;
 
     // o_done: result is valid.
-    //   - Multiplies: every cycle the instruction is in EX.
+    //   - Multiplies: in the instruction's last EX cycle (every cycle for
+    //     MUL_STAGES = 1).
     //   - Divides: during DIV_DONE.
-    assign o_done = (w_is_mul && i_start) ||
+    assign o_done = w_mul_done ||
                     (r_state == DIV_DONE);
 
 endmodule : k10_mul_div
@@ -11,9 +11,17 @@ module k10_top
 #(
     parameter logic [31:0] BOOT_ADDR   = 32'h8000_0000,
     parameter int unsigned PMP_REGIONS = 16,
+    parameter int unsigned MHPM_COUNTERS = 8,     // mhpmcounter3.. (see k10_csr)
     parameter logic [31:0] MHARTID     = 32'd0,
     parameter logic [31:0] DEBUG_HALT_ADDR      = 32'h4000_3800,
-    parameter logic [31:0] DEBUG_EXCEPTION_ADDR = 32'h4000_3810
+    parameter logic [31:0] DEBUG_EXCEPTION_ADDR = 32'h4000_3810,
+    parameter bit          FAST_DIV    = 1'b1,    // see k10_mul_div
+    parameter int unsigned MUL_STAGES  = 1,       // see k10_mul_div
+    parameter bit          BRANCH_PRED = 1'b1,    // see k10_fetch / k10_bpred
+    parameter int unsigned PREFETCH_DEPTH = 4,    // see k10_fetch
+    parameter int unsigned STORE_BUFFER = 4,      // see k10_lsu
+    parameter logic [31:0] SB_BASE     = 32'h8000_0000,
+    parameter logic [31:0] SB_MASK     = 32'hFFFF_0000
 )(
     input  logic        i_clk,
     input  logic        i_rst_n,
@@ -33,6 +41,7 @@ module k10_top
     input  logic        i_ibus_rvalid,
     input  logic [31:0] i_ibus_rdata,
     input  logic        i_ibus_err,
+    output logic        o_fence_i,
 
     output logic        o_dbus_req,
     output logic        o_dbus_we,
@@ -42,15 +51,28 @@ module k10_top
     input  logic        i_dbus_gnt,
     input  logic        i_dbus_rvalid,
     input  logic [31:0] i_dbus_rdata,
-    input  logic        i_dbus_err
+    input  logic        i_dbus_err,
+    output logic        o_dbus_lock,
+    input  logic        i_snoop_we,
+    input  logic [31:0] i_snoop_addr,
+
+    output commit_trace_t o_commit_trace
 );
 
     k10_core #(
         .BOOT_ADDR   (BOOT_ADDR),
         .PMP_REGIONS (PMP_REGIONS),
+        .MHPM_COUNTERS (MHPM_COUNTERS),
         .MHARTID     (MHARTID),
         .DEBUG_HALT_ADDR (DEBUG_HALT_ADDR),
-        .DEBUG_EXCEPTION_ADDR (DEBUG_EXCEPTION_ADDR)
+        .DEBUG_EXCEPTION_ADDR (DEBUG_EXCEPTION_ADDR),
+        .FAST_DIV    (FAST_DIV),
+        .MUL_STAGES  (MUL_STAGES),
+        .BRANCH_PRED (BRANCH_PRED),
+        .PREFETCH_DEPTH (PREFETCH_DEPTH),
+        .STORE_BUFFER (STORE_BUFFER),
+        .SB_BASE     (SB_BASE),
+        .SB_MASK     (SB_MASK)
     ) u_core (
         .i_clk         (i_clk),
         .i_rst_n       (i_rst_n),
@@ -60,6 +82,7 @@ module k10_top
         .i_ibus_rvalid (i_ibus_rvalid),
         .i_ibus_rdata  (i_ibus_rdata),
         .i_ibus_err    (i_ibus_err),
+        .o_fence_i     (o_fence_i),
         .o_dbus_req    (o_dbus_req),
         .o_dbus_we     (o_dbus_we),
         .o_dbus_addr   (o_dbus_addr),
@@ -69,13 +92,17 @@ module k10_top
         .i_dbus_rvalid (i_dbus_rvalid),
         .i_dbus_rdata  (i_dbus_rdata),
         .i_dbus_err    (i_dbus_err),
+        .o_dbus_lock   (o_dbus_lock),
+        .i_snoop_we    (i_snoop_we),
+        .i_snoop_addr  (i_snoop_addr),
         .i_ext_irq     (i_ext_irq),
         .i_timer_irq   (i_timer_irq),
         .i_sw_irq      (i_sw_irq),
         .i_irq_fast    (i_irq_fast),
         .i_debug_req   (i_debug_req),
         .o_debug_mode  (o_debug_mode),
-        .i_mtime       (i_mtime)
+        .i_mtime       (i_mtime),
+        .o_commit_trace (o_commit_trace)
     );
 
 endmodule : k10_top
@@ -29,6 +29,21 @@
 //   gpr    — "abi_name:hex_value" when rd is written, empty otherwise
 //   mode   — "3" for M-mode, "0" for U-mode
 //
+// The trace window, file name and format are set at run time with the
+// +trace_* plusargs listed below (see "Runtime controls").
+//
+// Binary mode (+trace_format=bin, Verilator only):
+//   Each retired instruction is pushed over DPI as a fixed 16-byte record
+//   (pc, instr, rd, rd_data, mode) into the buffered background writer in
+//   rtl/k10/tb/k10_trace_writer.cpp; no per-commit string formatting.  The
+//   file name takes a ".bin" suffix in place of ".csv".  Convert with
+//   scripts/k10_trace_bin2csv.py for instr_trace_compare.py.
+//
+// Co-simulation (+cosim, Verilator only):
+//   Every retirement is also passed to k10_cosim_commit(), which steps the
+//   reference ISS in rtl/k10/tb/k10_cosim.cpp and compares the result.
+//   This is independent of the trace window and of +trace_format=none.
+//
 // This module is intended to be instantiated inside k10_core under:
 //   `ifndef SYNTHESIS  /  `endif
 // ============================================================================
@@ -94,19 +109,116 @@ module k10_tracer
         endcase
     endfunction
 
+`ifdef VERILATOR
+    import "DPI-C" function void k10_trace_bin_open(input string path);
+    import "DPI-C" function void k10_trace_bin_commit(input int pc, input int instr,
+                                                      input byte rd, input int rd_data,
+                                                      input byte flags);
+    import "DPI-C" function void k10_trace_bin_close();
+    import "DPI-C" function void k10_cosim_commit(input int pc, input int instr,
+                                                  input byte rd, input int rd_data,
+                                                  input byte flags);
+`endif
+
+    // -----------------------------------------------------------------------
+    // Runtime controls (plusargs)
+    // -----------------------------------------------------------------------
+    //   +trace_format=csv|bin|none   output format; none opens no file
+    //   +trace_file=<path>           overrides TRACE_FILE
+    //   +trace_start_cycle=<N>       arm once N cycles out of reset
+    //   +trace_start_pc=<hex>        arm on the first commit at this PC
+    //                                (after trace_start_cycle, if given)
+    //   +trace_stop_instret=<N>      stop after N retires since reset
+    //   +trace_full_count=<N>        log every instruction for the first N
+    //                                traced retires, then GPR writers only
+    //                                (default 200)
+    // The window re-arms on every reset, so --batch tests each get one.
+    // -----------------------------------------------------------------------
+    bit              trace_off;
+    bit              trace_bin;
+    bit              cosim;
+    bit              has_start_pc;
+    logic [31:0]     start_pc;
+    longint unsigned start_cycle;
+    longint unsigned stop_instret;     // 0 = never stop
+    integer          full_count;
+
+    bit              trace_armed;
+    bit              trace_stopped;
+    longint unsigned cycle_count;      // cycles since reset
+    longint unsigned retired_total;    // retires since reset
+
+    function automatic void window_reset();
+        cycle_count   = 0;
+        retired_total = 0;
+        trace_armed   = (start_cycle == 0) && !has_start_pc;
+        trace_stopped = 1'b0;
+    endfunction
+
     // -----------------------------------------------------------------------
     // File handle
     // -----------------------------------------------------------------------
+    // trace_open() is also called hierarchically from k10_tb after a
+    // checkpoint restore: the restored fd belongs to the saving process.
+    // -----------------------------------------------------------------------
     integer fd;
+    integer instr_count;   // traced retires; first full_count logged in full
+    string  trace_path;
 
-    initial begin
-        fd = $fopen(TRACE_FILE, "w");
+    function automatic void trace_open(input string path);
+        if (fd != 0) $fclose(fd);
+        fd          = 0;
+        instr_count = 0;
+        trace_path  = path;
+        if (trace_off) return;
+`ifdef VERILATOR
+        if (trace_bin) begin
+            if ((path.len() > 4) && (path.substr(path.len() - 4, path.len() - 1) == ".csv"))
+                trace_path = {path.substr(0, path.len() - 5), ".bin"};
+            k10_trace_bin_open(trace_path);
+            return;
+        end
+`endif
+        fd = $fopen(path, "w");
         if (fd == 0) begin
-            $display("[K10_TRACER] ERROR: Cannot open %s", TRACE_FILE);
+            $display("[K10_TRACER] ERROR: Cannot open %s", path);
             $finish;
         end
         // Write CSV header (matches riscv_trace_csv.py field order)
         $fwrite(fd, "pc,instr,gpr,csr,binary,mode,instr_str,operand,pad\n");
+    endfunction
+
+    initial begin
+        string fmt;
+        string path;
+        fd           = 0;
+        trace_off    = 1'b0;
+        trace_bin    = 1'b0;
+        cosim        = 1'b0;
+        has_start_pc = 1'b0;
+        start_pc     = 32'h0;
+        start_cycle  = 0;
+        stop_instret = 0;
+        full_count   = 200;
+        path         = TRACE_FILE;
+
+        if ($value$plusargs("trace_format=%s", fmt)) begin
+            trace_off = (fmt == "none");
+`ifdef VERILATOR
+            trace_bin = (fmt == "bin");
+`endif
+        end
+`ifdef VERILATOR
+        cosim = $test$plusargs("cosim");
+`endif
+        void'($value$plusargs("trace_file=%s", path));
+        has_start_pc = ($value$plusargs("trace_start_pc=%h", start_pc) != 0);
+        void'($value$plusargs("trace_start_cycle=%d", start_cycle));
+        void'($value$plusargs("trace_stop_instret=%d", stop_instret));
+        void'($value$plusargs("trace_full_count=%d", full_count));
+
+        window_reset();
+        trace_open(path);
     end
 
     // -----------------------------------------------------------------------
@@ -117,29 +229,51 @@ module k10_tracer
     // FENCE, and any other instruction that does not write to a register.
     // -----------------------------------------------------------------------
     /* verilator lint_off BLKSEQ */
-    // Debug: count retired instructions for full tracing
-    integer instr_count;
-    initial instr_count = 0;
-
     always @(posedge i_clk) begin
-        if (i_rst_n && i_valid) begin
-            instr_count = instr_count + 1;
-
-            if (instr_count <= 200) begin
-                // Log ALL retired instructions for first 200
-                if (i_rd_wr_en && i_rd_addr != 5'd0) begin
-                    $fwrite(fd, "%h,,\"%s:%h\",,%h,%0d,,,\n",
-                            i_pc, abi_name(i_rd_addr), i_rd_data,
-                            i_instr, (i_mode == PRIV_M) ? 3 : 0);
-                end else begin
-                    $fwrite(fd, "%h,,,,%h,%0d,,,\n",
-                            i_pc, i_instr, (i_mode == PRIV_M) ? 3 : 0);
+`ifdef VERILATOR
+        if (cosim && i_rst_n && i_valid) begin
+            k10_cosim_commit(i_pc, i_instr, {3'b000, i_rd_addr}, i_rd_data,
+                             {5'b00000, i_mode, i_rd_wr_en});
+        end
+`endif
+        if (!i_rst_n) begin
+            window_reset();
+        end else if (!trace_off) begin
+            cycle_count = cycle_count + 1;
+
+            if (!trace_armed && !trace_stopped && (cycle_count >= start_cycle) &&
+                (!has_start_pc || (i_valid && (i_pc == start_pc)))) begin
+                trace_armed = 1'b1;
+            end
+
+            if (i_valid) begin
+                retired_total = retired_total + 1;
+
+                if (trace_armed && !trace_stopped) begin
+                    instr_count = instr_count + 1;
+
+                    if (trace_bin) begin
+`ifdef VERILATOR
+                        // Every traced commit is recorded; the converter
+                        // applies the full_count / GPR-writer rule below.
+                        k10_trace_bin_commit(i_pc, i_instr, {3'b000, i_rd_addr}, i_rd_data,
+                                             {5'b00000, i_mode,
+                                              (i_rd_wr_en && (i_rd_addr != 5'd0))});
+`endif
+                    end else if (i_rd_wr_en && i_rd_addr != 5'd0) begin
+                        $fwrite(fd, "%h,,\"%s:%h\",,%h,%0d,,,\n",
+                                i_pc, abi_name(i_rd_addr), i_rd_data,
+                                i_instr, (i_mode == PRIV_M) ? 3 : 0);
+                    end else if (instr_count <= full_count) begin
+                        // Non-writers are only logged for the first full_count
+                        $fwrite(fd, "%h,,,,%h,%0d,,,\n",
+                                i_pc, i_instr, (i_mode == PRIV_M) ? 3 : 0);
+                    end
+                end
+
+                if ((stop_instret != 0) && (retired_total >= stop_instret)) begin
+                    trace_stopped = 1'b1;
                 end
-            end else if (i_rd_wr_en && i_rd_addr != 5'd0) begin
-                // After 200, only log GPR-writing instructions
-                $fwrite(fd, "%h,,\"%s:%h\",,%h,%0d,,,\n",
-                        i_pc, abi_name(i_rd_addr), i_rd_data,
-                        i_instr, (i_mode == PRIV_M) ? 3 : 0);
             end
         end
     end
@@ -150,8 +284,14 @@ module k10_tracer
     final begin
         if (fd != 0) begin
             $fclose(fd);
-            $display("[K10_TRACER] Trace written to %s", TRACE_FILE);
+            $display("[K10_TRACER] Trace written to %s", trace_path);
+        end
+`ifdef VERILATOR
+        if (trace_bin) begin
+            k10_trace_bin_close();
+            $display("[K10_TRACER] Binary trace written to %s", trace_path);
         end
+`endif
     end
 
 endmodule : k10_tracer
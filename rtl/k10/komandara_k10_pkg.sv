@@ -224,6 +224,16 @@ package komandara_k10_pkg;
     logic       illegal;
   } ctrl_t;
 
+  // =========================================================================
+  // Branch Prediction  (k10_bpred, enabled by the BRANCH_PRED parameter)
+  // =========================================================================
+  // Both table sizes must be powers of two; BP_GHR_BITS must not exceed
+  // log2(BP_BHT_ENTRIES).
+  parameter int unsigned BP_BTB_ENTRIES = 32;    // direct-mapped, full tag
+  parameter int unsigned BP_BHT_ENTRIES = 256;   // 2-bit counters
+  parameter int unsigned BP_GHR_BITS    = 8;     // gshare history; 0 = bimodal
+  parameter int unsigned BP_BHT_IDX_W   = $clog2(BP_BHT_ENTRIES);
+
   // =========================================================================
   // Pipeline Register Structs
   // =========================================================================
@@ -233,6 +243,9 @@ package komandara_k10_pkg;
     logic [31:0] pc;
     logic [31:0] instr;
     logic        is_compressed;
+    logic        bp_taken;      // fetch followed a predicted-taken target
+    logic [31:0] bp_target;
+    logic [BP_BHT_IDX_W-1:0] bp_idx;  // BHT index used by the lookup
     logic        valid;
   } if_id_t;
 
@@ -248,6 +261,9 @@ package komandara_k10_pkg;
     logic [4:0]  rd_addr;
     logic [11:0] csr_addr;
     ctrl_t       ctrl;
+    logic        bp_taken;
+    logic [31:0] bp_target;
+    logic [BP_BHT_IDX_W-1:0] bp_idx;
     logic        valid;
   } id_ex_t;
 
@@ -276,6 +292,18 @@ package komandara_k10_pkg;
     logic        valid;
   } mem_wb_t;
 
+  // ----- Commit trace  (WB retire stream for k10_trace_buf) -----
+  typedef struct packed {
+    logic        valid;         // instruction retired in WB this cycle
+    logic [31:0] pc;
+    logic        compressed;    // 16-bit encoding (next sequential PC = pc + 2)
+    logic        trap;          // trap taken this cycle (EX stage)
+    logic [31:0] trap_cause;    // mcause written by that trap
+    logic [31:0] trap_target;   // handler address
+    priv_lvl_e   priv;
+    logic        debug_mode;
+  } commit_trace_t;
+
   // =========================================================================
   // Trap Causes  (mcause values — Privileged Spec Table 3.6)
   // =========================================================================
@@ -320,6 +348,7 @@ package komandara_k10_pkg;
   parameter logic [11:0] CSR_MIE        = 12'h304;
   parameter logic [11:0] CSR_MTVEC      = 12'h305;
   parameter logic [11:0] CSR_MCOUNTEREN = 12'h306;
+  parameter logic [11:0] CSR_MCOUNTINHIBIT = 12'h320;
 
   // Machine Trap Handling
   parameter logic [11:0] CSR_MSCRATCH   = 12'h340;
@@ -342,6 +371,32 @@ package komandara_k10_pkg;
   parameter logic [11:0] CSR_TIMEH      = 12'hC81;
   parameter logic [11:0] CSR_INSTRETH   = 12'hC82;
 
+  // Hardware performance monitor (counter N = base + N, N = 3..31).
+  // mhpmevent shares its block with mcountinhibit (0x320).
+  parameter logic [11:0] CSR_MHPMEVENT_BASE     = 12'h320;
+  parameter logic [11:0] CSR_MHPMCOUNTER_BASE   = 12'hB00;
+  parameter logic [11:0] CSR_MHPMCOUNTERH_BASE  = 12'hB80;
+  parameter logic [11:0] CSR_HPMCOUNTER_BASE    = 12'hC00;
+  parameter logic [11:0] CSR_HPMCOUNTERH_BASE   = 12'hC80;
+
+  // mhpmeventN selector values.  Each event is a one-cycle pulse or a
+  // level counted once per cycle; see k10_core for the exact sources.
+  typedef enum logic [4:0] {
+    HPM_EV_NONE         = 5'd0,
+    HPM_EV_LOAD_USE     = 5'd1,   // load-use bubble cycles (only RAW stall; rest is forwarded)
+    HPM_EV_BRANCH_FLUSH = 5'd2,   // EX redirects (IF+ID flush): unpredicted taken / mispredicted
+    HPM_EV_MD_BUSY      = 5'd3,   // EX stalled by k10_mul_div
+    HPM_EV_IF_WAIT      = 5'd4,   // ID starved: fetch waiting on the ibus
+    HPM_EV_LSU_WAIT     = 5'd5,   // MEM stalled by the dbus
+    HPM_EV_LSU_SPLIT    = 5'd6,   // misaligned accesses split in two
+    HPM_EV_TRAP_FLUSH   = 5'd7,   // traps / mret / dret / debug entry
+    HPM_EV_BRANCH       = 5'd8,   // branches / jumps resolved in EX
+    HPM_EV_BP_HIT       = 5'd9,   // ... whose direction and target were predicted
+    HPM_EV_BP_MISPREDICT = 5'd10  // ... redirected from EX (BRANCH = HIT + MISPREDICT)
+  } hpm_event_e;
+
+  parameter int unsigned HPM_NUM_EVENTS = 11;
+
   // Debug Mode CSRs
   parameter logic [11:0] CSR_DCSR       = 12'h7B0;
   parameter logic [11:0] CSR_DPC        = 12'h7B1;
@@ -468,6 +523,9 @@ package komandara_k10_pkg;
       pc:            32'd0,
       instr:         32'd0,
       is_compressed: 1'b0,
+      bp_taken:      1'b0,
+      bp_target:     32'd0,
+      bp_idx:        '0,
       valid:         1'b0
   };
 
@@ -482,6 +540,9 @@ package komandara_k10_pkg;
       rd_addr:  5'd0,
       csr_addr: 12'd0,
       ctrl:     CTRL_NOP,
+      bp_taken: 1'b0,
+      bp_target: 32'd0,
+      bp_idx:   '0,
       valid:    1'b0
   };
 
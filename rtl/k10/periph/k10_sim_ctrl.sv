@@ -21,14 +21,22 @@
 // Register Map (byte offsets from base):
 //   0x00  SIM_CTRL   — Write 0x1 = PASS + $finish, 0x0 = FAIL + $finish  (W)
 //   0x04  CHAR_OUT   — Write byte → $write("%c", data[7:0])              (W)
-//   0x08  SIM_STATUS — Read: cycle count [31:0]                           (R)
-//   0x0C  reserved
+//   0x08  MSIP       — Software interrupt of hart 0, bit 0                (R/W)
+//   0x0C  SIM_STATUS — Read: cycle count [31:0]                           (R)
+//   0x10  NHARTS     — Read: number of harts (N_HARTS)                    (R)
+//   0x40 + 4*h  MSIP of hart h, h < N_HARTS (0x40 aliases 0x08)           (R/W)
+//   anything else reads 0, writes are ignored
 //
 // Use CHAR_OUT for software printf — each write emits one character.
 // Use SIM_CTRL to terminate simulation with pass/fail status.
+//
+// Under Verilator, CHAR_OUT bytes go to k10_console_putc() (k10_console.cpp),
+// which writes whole lines to stdout and the console log.
 // ============================================================================
 
-module k10_sim_ctrl (
+module k10_sim_ctrl #(
+    parameter int unsigned N_HARTS = 1     // 1..16
+)(
     input  logic        i_clk,
     input  logic        i_rst_n,
 
@@ -57,14 +65,21 @@ module k10_sim_ctrl (
     output logic        s_axi_rvalid,
     input  logic        s_axi_rready,
 
-    // ---- Software interrupt output ----
-    output logic        o_sw_irq
+    // ---- Software interrupt outputs (one per hart) ----
+    output logic [N_HARTS-1:0] o_sw_irq
 );
 
+`ifdef VERILATOR
+    import "DPI-C" function void k10_console_putc(input byte c);
+    import "DPI-C" function void k10_console_flush();
+`endif
+
     // -----------------------------------------------------------------------
     // Cycle counter (for SIM_STATUS register)
     // -----------------------------------------------------------------------
-    logic [31:0] r_cycle_count;
+    // public_flat_rw: the Verilator driver advances it together with mtime
+    // while the core sleeps in WFI (k10_tb.cpp --fast-forward).
+    logic [31:0] r_cycle_count /* verilator public_flat_rw */;
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n)
             r_cycle_count <= 32'd0;
@@ -75,16 +90,29 @@ module k10_sim_ctrl (
     // -----------------------------------------------------------------------
     // MSIP register (software interrupt)
     // -----------------------------------------------------------------------
-    logic r_msip;
+    logic [N_HARTS-1:0] r_msip;
     assign o_sw_irq = r_msip;
 
+    if (N_HARTS < 1 || N_HARTS > 16) begin : g_bad_harts
+        $error("k10_sim_ctrl: N_HARTS must be 1..16");
+    end
+
+    // Offset [6:0] -> MSIP of a hart (hart 0 at 0x08 and 0x40)
+    function automatic logic f_is_msip(input logic [6:0] off);
+        return (off[6:2] == 5'd2) || (off[6] && (32'(off[5:2]) < N_HARTS));
+    endfunction
+
+    function automatic logic [3:0] f_msip_hart(input logic [6:0] off);
+        return off[6] ? off[5:2] : 4'd0;
+    endfunction
+
     // -----------------------------------------------------------------------
     // Write channel — simplified AXI4-Lite (accept AW+W together)
     // -----------------------------------------------------------------------
     // We use a simple approach: accept AW and W simultaneously.
     // If only one arrives, latch it and wait for the other.
     logic        r_aw_pending;
-    logic [3:0]  r_aw_addr;
+    logic [6:0]  r_aw_addr;
     logic        r_w_pending;
     logic [31:0] r_w_data;
     logic        r_bvalid;
@@ -111,19 +139,19 @@ module k10_sim_ctrl (
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n) begin
             r_aw_pending <= 1'b0;
-            r_aw_addr    <= 4'd0;
+            r_aw_addr    <= 7'd0;
             r_w_pending  <= 1'b0;
             r_w_data     <= 32'd0;
             r_bvalid     <= 1'b0;
             r_rvalid     <= 1'b0;
             r_rdata      <= 32'd0;
-            r_msip       <= 1'b0;
+            r_msip       <= '0;
         end else begin
 
             // ---- Write address capture ----
             if (s_axi_awvalid && s_axi_awready) begin
                 r_aw_pending <= 1'b1;
-                r_aw_addr    <= s_axi_awaddr[3:0];
+                r_aw_addr    <= s_axi_awaddr[6:0];
             end
 
             // ---- Write data capture ----
@@ -138,9 +166,15 @@ module k10_sim_ctrl (
                 r_w_pending  <= 1'b0;
                 r_bvalid     <= 1'b1;
 
-                unique case (r_aw_addr[3:2])
-                    2'b00: begin  // 0x00: SIM_CTRL
+                if (f_is_msip(r_aw_addr)) begin  // 0x08, 0x40..: MSIP
+                    r_msip[f_msip_hart(r_aw_addr)] <= r_w_data[0];
+                end
+                unique case (r_aw_addr)
+                    7'h00: begin  // 0x00: SIM_CTRL
                         // synthesis translate_off
+`ifdef VERILATOR
+                        k10_console_flush();
+`endif
                         if (r_w_data[0]) begin
                             $display("\n[SIM_CTRL] *** TEST PASSED ***");
                         end else begin
@@ -149,15 +183,16 @@ module k10_sim_ctrl (
                         $finish;
                         // synthesis translate_on
                     end
-                    2'b01: begin  // 0x04: CHAR_OUT
+                    7'h04: begin  // 0x04: CHAR_OUT
                         // synthesis translate_off
+`ifdef VERILATOR
+                        k10_console_putc(r_w_data[7:0]);
+`else
                         $write("%c", r_w_data[7:0]);
+`endif
                         // synthesis translate_on
                     end
-                    2'b10: begin  // 0x08: MSIP (software interrupt)
-                        r_msip <= r_w_data[0];
-                    end
-                    2'b11: ;  // 0x0C: reserved
+                    default: ;
                 endcase
             end
 
@@ -169,12 +204,15 @@ module k10_sim_ctrl (
             // ---- Read ----
             if (s_axi_arvalid && s_axi_arready) begin
                 r_rvalid <= 1'b1;
-                unique case (s_axi_araddr[3:2])
-                    2'b00:   r_rdata <= 32'd0;         // SIM_CTRL: write-only
-                    2'b01:   r_rdata <= 32'd0;         // CHAR_OUT: write-only
-                    2'b10:   r_rdata <= {31'd0, r_msip}; // MSIP
-                    2'b11:   r_rdata <= r_cycle_count;  // SIM_STATUS
-                endcase
+                if (f_is_msip(s_axi_araddr[6:0]))
+                    r_rdata <= {31'd0, r_msip[f_msip_hart(s_axi_araddr[6:0])]};
+                else if (s_axi_araddr[6:0] == 7'h0C)
+                    r_rdata <= r_cycle_count;           // SIM_STATUS
+                else if (s_axi_araddr[6:0] == 7'h10)
+                    r_rdata <= N_HARTS;                 // NHARTS
+                else
+                    r_rdata <= 32'd0;                   // SIM_CTRL, CHAR_OUT: write-only
+
             end
 
             if (r_rvalid && s_axi_rready) begin
@@ -15,19 +15,25 @@
 // ============================================================================
 // K10 — Timer Peripheral (AXI4-Lite Slave)
 // ============================================================================
-// RISC-V compatible timer with mtime and mtimecmp registers.
+// RISC-V compatible timer with mtime and one mtimecmp register per hart.
 //
 // Register Map (byte offsets from base):
 //   0x00  mtime_lo    — Timer counter [31:0]   (R/W)
 //   0x04  mtime_hi    — Timer counter [63:32]  (R/W)
-//   0x08  mtimecmp_lo — Timer compare [31:0]   (R/W)
-//   0x0C  mtimecmp_hi — Timer compare [63:32]  (R/W)
+//   0x08  mtimecmp_lo — Timer compare [31:0]   (R/W)   hart 0
+//   0x0C  mtimecmp_hi — Timer compare [63:32]  (R/W)   hart 0
+//   0x40 + 8*h        — mtimecmp_lo of hart h  (R/W)   h < N_HARTS
+//   0x44 + 8*h        — mtimecmp_hi of hart h  (R/W)   (0x40 aliases 0x08)
+//   anything else reads 0, writes are ignored
 //
-// Timer interrupt: asserted when mtime >= mtimecmp.
-// mtime auto-increments every clock cycle; writable for testing.
+// Timer interrupt of hart h: asserted when mtime >= mtimecmp[h].
+// mtime auto-increments every clock cycle (not while i_debug_mode);
+// writable for testing.
 // ============================================================================
 
-module k10_timer (
+module k10_timer #(
+    parameter int unsigned N_HARTS = 1     // 1..8
+)(
     input  logic        i_clk,
     input  logic        i_rst_n,
     input  logic        i_debug_mode,
@@ -58,24 +64,42 @@ module k10_timer (
     input  logic        s_axi_rready,
 
     // ---- Timer outputs ----
-    output logic        o_timer_irq,
+    output logic [N_HARTS-1:0] o_timer_irq,
     output logic [63:0] o_mtime
 );
 
     // -----------------------------------------------------------------------
     // Timer registers
     // -----------------------------------------------------------------------
-    logic [63:0] r_mtime;
-    logic [63:0] r_mtimecmp;
+    // public_flat_rw: the Verilator driver advances mtime while the core
+    // sleeps in WFI (k10_tb.cpp --fast-forward).
+    logic [63:0] r_mtime    /* verilator public_flat_rw */;
+    logic [63:0] r_mtimecmp [N_HARTS] /* verilator public_flat_rd */;
+
+    assign o_mtime = r_mtime;
+    for (genvar h = 0; h < int'(N_HARTS); h++) begin : g_irq
+        assign o_timer_irq[h] = (r_mtime >= r_mtimecmp[h]);
+    end
+
+    if (N_HARTS < 1 || N_HARTS > 8) begin : g_bad_harts
+        $error("k10_timer: N_HARTS must be 1..8");
+    end
+
+    // Offset [6:0] -> register: mtime, or the mtimecmp of a hart (hart 0
+    // at 0x08 and 0x40); bit 2 selects the high word.
+    function automatic logic [2:0] f_cmp_hart(input logic [6:0] off);
+        return off[6] ? off[5:3] : 3'd0;
+    endfunction
 
-    assign o_mtime     = r_mtime;
-    assign o_timer_irq = (r_mtime >= r_mtimecmp);
+    function automatic logic f_is_cmp(input logic [6:0] off);
+        return (off[6:3] == 4'b0001) || (off[6] && (32'(off[5:3]) < N_HARTS));
+    endfunction
 
     // -----------------------------------------------------------------------
     // Write channel
     // -----------------------------------------------------------------------
     logic        r_aw_pending;
-    logic [3:0]  r_aw_addr;  // offset bits [3:0]
+    logic [6:0]  r_aw_addr;  // offset bits [6:0]
     logic        r_w_pending;
     logic [31:0] r_w_data;
     logic [3:0]  r_w_strb;
@@ -106,9 +130,11 @@ module k10_timer (
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n) begin
             r_mtime      <= 64'd0;
-            r_mtimecmp   <= 64'hFFFF_FFFF_FFFF_FFFF;  // Max value = no interrupt
+            for (int h = 0; h < int'(N_HARTS); h++) begin
+                r_mtimecmp[h] <= 64'hFFFF_FFFF_FFFF_FFFF;  // Max value = no interrupt
+            end
             r_aw_pending <= 1'b0;
-            r_aw_addr    <= 4'd0;
+            r_aw_addr    <= 7'd0;
             r_w_pending  <= 1'b0;
             r_w_data     <= 32'd0;
             r_w_strb     <= 4'd0;
@@ -125,32 +151,15 @@ module k10_timer (
             // Evaluate before modifying pending flags
             if (r_aw_pending && r_w_pending && !r_bvalid) begin
                 r_bvalid <= 1'b1;
-                unique case (r_aw_addr[3:2])
-                    2'b00: begin
-                        if (r_w_strb[0]) r_mtime[7:0]   <= r_w_data[7:0];
-                        if (r_w_strb[1]) r_mtime[15:8]  <= r_w_data[15:8];
-                        if (r_w_strb[2]) r_mtime[23:16] <= r_w_data[23:16];
-                        if (r_w_strb[3]) r_mtime[31:24] <= r_w_data[31:24];
-                    end
-                    2'b01: begin
-                        if (r_w_strb[0]) r_mtime[39:32] <= r_w_data[7:0];
-                        if (r_w_strb[1]) r_mtime[47:40] <= r_w_data[15:8];
-                        if (r_w_strb[2]) r_mtime[55:48] <= r_w_data[23:16];
-                        if (r_w_strb[3]) r_mtime[63:56] <= r_w_data[31:24];
-                    end
-                    2'b10: begin
-                        if (r_w_strb[0]) r_mtimecmp[7:0]   <= r_w_data[7:0];
-                        if (r_w_strb[1]) r_mtimecmp[15:8]  <= r_w_data[15:8];
-                        if (r_w_strb[2]) r_mtimecmp[23:16] <= r_w_data[23:16];
-                        if (r_w_strb[3]) r_mtimecmp[31:24] <= r_w_data[31:24];
-                    end
-                    2'b11: begin
-                        if (r_w_strb[0]) r_mtimecmp[39:32] <= r_w_data[7:0];
-                        if (r_w_strb[1]) r_mtimecmp[47:40] <= r_w_data[15:8];
-                        if (r_w_strb[2]) r_mtimecmp[55:48] <= r_w_data[23:16];
-                        if (r_w_strb[3]) r_mtimecmp[63:56] <= r_w_data[31:24];
+                for (int b = 0; b < 4; b++) begin
+                    if (r_w_strb[b]) begin
+                        if (r_aw_addr[6:3] == 4'b0000)
+                            r_mtime[32*r_aw_addr[2] + 8*b +: 8] <= r_w_data[8*b +: 8];
+                        else if (f_is_cmp(r_aw_addr))
+                            r_mtimecmp[f_cmp_hart(r_aw_addr)][32*r_aw_addr[2] + 8*b +: 8] <=
+                                r_w_data[8*b +: 8];
                     end
-                endcase
+                end
             end
 
             // ---- Write response handshake ----
@@ -162,7 +171,7 @@ module k10_timer (
             // Must evaluate after execute logic to handle back-to-back writes
             if (s_axi_awvalid && s_axi_awready) begin
                 r_aw_pending <= 1'b1;
-                r_aw_addr    <= s_axi_awaddr[3:0];
+                r_aw_addr    <= s_axi_awaddr[6:0];
             end else if (r_aw_pending && r_w_pending && !r_bvalid) begin
                 r_aw_pending <= 1'b0;
             end
@@ -179,12 +188,13 @@ module k10_timer (
             // ---- Read handshake & capture ----
             if (s_axi_arvalid && s_axi_arready) begin
                 r_rvalid <= 1'b1;
-                unique case (s_axi_araddr[3:2])
-                    2'b00: r_rdata <= r_mtime[31:0];
-                    2'b01: r_rdata <= r_mtime[63:32];
-                    2'b10: r_rdata <= r_mtimecmp[31:0];
-                    2'b11: r_rdata <= r_mtimecmp[63:32];
-                endcase
+                if (s_axi_araddr[6:3] == 4'b0000)
+                    r_rdata <= s_axi_araddr[2] ? r_mtime[63:32] : r_mtime[31:0];
+                else if (f_is_cmp(s_axi_araddr[6:0]))
+                    r_rdata <= s_axi_araddr[2] ? r_mtimecmp[f_cmp_hart(s_axi_araddr[6:0])][63:32]
+                                               : r_mtimecmp[f_cmp_hart(s_axi_araddr[6:0])][31:0];
+                else
+                    r_rdata <= 32'd0;
             end else if (r_rvalid && s_axi_rready) begin
                 r_rvalid <= 1'b0;
             end
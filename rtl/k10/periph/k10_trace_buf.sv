@@ -0,0 +1,573 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Commit Trace Buffer (AXI4-Lite Slave)
+// ============================================================================
+// Records the WB retire stream of k10_core (o_commit_trace, the signals
+// k10_tracer prints) as compressed 32-bit records into an on-chip ring.
+// Meant to stay in the bitstream: it is read back over the debug module's
+// system bus access (scripts/k10_tracebuf_dump.sh), with no ILA and no
+// rebuild, and it keeps its contents across an ndmreset.
+//
+// Register Map (byte offsets from base):
+//   0x00  CTRL     — [0] EN  start recording when written 1; cleared by
+//                         hardware when a stop condition has drained
+//                    [1] WRAP  ring mode (keep the newest records); when 0
+//                         recording stops once DEPTH words are written
+//                    [2] START_PC  wait for a commit at START_PC
+//                    [3] STOP_PC   stop after the commit at STOP_PC
+//                    [4] STOP_TRAP stop on the first exception
+//                    [8] CLEAR (write 1)  reset WPTR / STATUS flags   (R/W)
+//   0x04  STATUS   — [2:0] state (0 idle, 1 armed, 2 recording,
+//                    3/4 stopping), [4] WRAPPED, [5] FULL,
+//                    [6] OVERFLOW (records dropped)                   (R)
+//   0x08  WPTR     — Words written since CLEAR; the oldest word is at
+//                    DATA[WPTR % DEPTH] once WRAPPED                  (R)
+//   0x0C  DEPTH    — Ring size in words (WORDS)                       (R)
+//   0x10  START_PC — Start trigger address                            (R/W)
+//   0x14  STOP_PC  — Stop trigger address                             (R/W)
+//   0x18  CYCLE    — Free-running cycle counter (TIME record base)    (R)
+//   0x8000.. DATA  — Ring memory, word i at 0x8000 + 4*i              (R)
+//
+// Record format (bit 31 first):
+//   1 pc[31:1]                      SYNC    absolute PC of this commit
+//   00 nseq[8:0] delta[20:0]        BRANCH  nseq sequential commits, then a
+//                                           commit at anchor + 2*delta
+//   0100 n[27:0]                    SEQ     n sequential commits
+//   0101 n[27:0]                    REPEAT  previous BRANCH n more times
+//   0110 t i cause[4:0] priv[1:0] d EVENT   t: trap taken (i: interrupt);
+//                                           priv / d: mode of the commits
+//                                           that follow
+//   0111 cycle[31:4]                TIME    cycle counter at this point
+// The anchor is the PC of the last SYNC / BRANCH commit, so branch
+// targets decode without the ELF; the ELF is needed only to expand
+// sequential runs into PCs.  A SYNC + TIME pair is written at start,
+// every SYNC_WORDS words and after an overflow; a TIME alone every 2^24
+// cycles.  Decoding starts at the first SYNC.  A trap EVENT is written
+// when the handler's first instruction commits, so the instructions older
+// than the trap that retire after it are still ordered before it.
+// Commits in debug mode are not recorded.
+//
+// Up to five records are produced in one cycle into a FIFO_DEPTH staging
+// FIFO; the ring takes one word per cycle.  A cycle whose records do not
+// fit is dropped as a whole, OVERFLOW is set and the stream resyncs.
+// ============================================================================
+
+module k10_trace_buf
+  import komandara_k10_pkg::*;
+#(
+    parameter int unsigned WORDS      = 4096,   // power of two, <= 8192
+    parameter int unsigned SYNC_WORDS = 256,
+    parameter bit          AUTO_START = 1'b1    // record (ring mode) from reset
+)(
+    input  logic        i_clk,
+    input  logic        i_rst_n,
+
+    input  commit_trace_t i_trace,
+
+    // ---- AXI4-Lite Slave ----
+    input  logic [31:0] s_axi_awaddr,
+    input  logic [2:0]  s_axi_awprot,
+    input  logic        s_axi_awvalid,
+    output logic        s_axi_awready,
+
+    input  logic [31:0] s_axi_wdata,
+    input  logic [3:0]  s_axi_wstrb,
+    input  logic        s_axi_wvalid,
+    output logic        s_axi_wready,
+
+    output logic [1:0]  s_axi_bresp,
+    output logic        s_axi_bvalid,
+    input  logic        s_axi_bready,
+
+    input  logic [31:0] s_axi_araddr,
+    input  logic [2:0]  s_axi_arprot,
+    input  logic        s_axi_arvalid,
+    output logic        s_axi_arready,
+
+    output logic [31:0] s_axi_rdata,
+    output logic [1:0]  s_axi_rresp,
+    output logic        s_axi_rvalid,
+    input  logic        s_axi_rready
+);
+
+    localparam int unsigned IDX_W      = $clog2(WORDS);
+    localparam int unsigned FIFO_DEPTH = 16;
+    localparam int unsigned FIFO_W     = $clog2(FIFO_DEPTH);
+    localparam int unsigned N_SLOTS    = 5;
+    localparam logic [27:0] CNT_MAX    = '1;
+
+    localparam int SLOT_REPEAT = 0;
+    localparam int SLOT_SEQ    = 1;
+    localparam int SLOT_EVENT  = 2;
+    localparam int SLOT_FLOW   = 3;
+    localparam int SLOT_TIME   = 4;
+
+    typedef enum logic [2:0] {
+        TB_IDLE  = 3'd0,
+        TB_ARMED = 3'd1,
+        TB_RUN   = 3'd2,
+        TB_FLUSH = 3'd3,   // one cycle: write out pending REPEAT / SEQ / trap
+        TB_DRAIN = 3'd4    // wait for the staging FIFO to empty
+    } tb_state_e;
+
+    // -----------------------------------------------------------------------
+    // Control registers (written from the AXI side)
+    // -----------------------------------------------------------------------
+    logic        r_ctrl_en;
+    logic        r_ctrl_wrap;
+    logic        r_ctrl_start_pc;
+    logic        r_ctrl_stop_pc;
+    logic        r_ctrl_stop_trap;
+    logic        r_clear;           // CLEAR pulse
+    logic [31:0] r_start_pc;
+    logic [31:0] r_stop_pc;
+
+    // -----------------------------------------------------------------------
+    // Recorder state
+    // -----------------------------------------------------------------------
+    tb_state_e   r_state, w_state_next;
+    logic [31:0] r_cycle;       // free-running; k10_tb --fast-forward is rejected
+    logic [31:0] r_wptr;
+    logic        r_overflow;
+
+    logic        r_need_sync;
+    logic [$clog2(SYNC_WORDS+N_SLOTS+1)-1:0] r_since_sync;
+    logic [31:0] r_last_pc;          // last recorded commit
+    logic        r_last_c;
+    logic [31:0] r_anchor_pc;        // last SYNC / BRANCH commit
+    logic [27:0] r_nseq;
+    logic [27:0] r_rep;
+    logic [31:0] r_last_br;          // last BRANCH word written
+    logic        r_last_br_vld;
+    logic        r_mode_vld;
+    priv_lvl_e   r_priv;
+    logic        r_dbg;
+    logic        r_trap_pend;
+    logic [5:0]  r_trap_cause;       // {interrupt, cause[4:0]}
+    logic [31:0] r_trap_target;
+
+    logic [31:0] r_fifo [FIFO_DEPTH];
+    logic [FIFO_W-1:0] r_fifo_rd, r_fifo_wr;
+    logic [FIFO_W:0]   r_fifo_cnt;
+
+    logic [31:0] r_mem [WORDS];
+
+    // -----------------------------------------------------------------------
+    // Triggers / state machine
+    // -----------------------------------------------------------------------
+    logic w_commit;
+    logic w_start_hit;
+    logic w_active;
+    logic w_full;
+    logic w_stop;
+    logic w_fifo_empty;
+
+    assign w_commit     = i_trace.valid && !i_trace.debug_mode;
+    assign w_start_hit  = (r_state == TB_ARMED) && w_commit && (i_trace.pc == r_start_pc);
+    assign w_active     = (r_state == TB_RUN) || w_start_hit;
+    assign w_full       = !r_ctrl_wrap && (r_wptr >= 32'(WORDS));
+    assign w_fifo_empty = (r_fifo_cnt == '0);
+    assign w_stop       = !r_ctrl_en || w_full ||
+                          (r_ctrl_stop_pc && w_commit && (i_trace.pc == r_stop_pc)) ||
+                          (r_ctrl_stop_trap && i_trace.trap && !i_trace.trap_cause[31]);
+
+    always_comb begin
+        w_state_next = r_state;
+        unique case (r_state)
+            TB_IDLE: begin
+                if (r_ctrl_en) w_state_next = r_ctrl_start_pc ? TB_ARMED : TB_RUN;
+            end
+            TB_ARMED: begin
+                if (!r_ctrl_en)      w_state_next = TB_IDLE;
+                else if (w_start_hit) w_state_next = w_stop ? TB_FLUSH : TB_RUN;
+            end
+            TB_RUN: begin
+                if (w_stop) w_state_next = TB_FLUSH;
+            end
+            TB_FLUSH: begin
+                w_state_next = TB_DRAIN;
+            end
+            TB_DRAIN: begin
+                if (w_fifo_empty || w_full) w_state_next = TB_IDLE;
+            end
+            default: w_state_next = TB_IDLE;
+        endcase
+    end
+
+    // -----------------------------------------------------------------------
+    // Record encoder
+    // -----------------------------------------------------------------------
+    logic        w_flush;
+    logic [31:0] w_expect_pc;
+    logic [31:0] w_delta;
+    logic        w_fits;
+    logic        w_seq, w_br, w_sync;
+    logic        w_seq_flush;
+    logic [31:0] w_br_word;
+    logic        w_rep_hit;
+    logic        w_evt_trap, w_evt_mode, w_evt;
+    logic        w_time_tick;
+
+    logic [N_SLOTS-1:0]       w_slot_vld;
+    logic [N_SLOTS-1:0][31:0] w_slot;
+
+    assign w_flush     = (r_state == TB_FLUSH);
+    assign w_expect_pc = r_last_pc + (r_last_c ? 32'd2 : 32'd4);
+    assign w_delta     = i_trace.pc - r_anchor_pc;
+    assign w_fits      = (&w_delta[31:21]) || !(|w_delta[31:21]);
+
+    assign w_seq  = w_active && w_commit && !r_need_sync && (i_trace.pc == w_expect_pc);
+    assign w_br   = w_active && w_commit && !r_need_sync && !w_seq && w_fits;
+    assign w_sync = w_active && w_commit && !w_seq && !w_br;
+
+
+    // Pending trap: written at the handler's first commit, or right away
+    // when another trap or a stop comes first.
+    assign w_evt_trap = r_trap_pend &&
+                        (w_flush || (w_active && (i_trace.trap ||
+                                     (w_commit && i_trace.pc == r_trap_target))));
+    assign w_evt_mode = w_active &&
+                        ((w_commit && (!r_mode_vld || i_trace.priv != r_priv)) ||
+                         (r_mode_vld && i_trace.debug_mode != r_dbg));
+    assign w_evt      = w_evt_trap || w_evt_mode;
+
+    // Pending sequential commits go out as a SEQ ahead of any other record
+    // (or when they do not fit the BRANCH count); the BRANCH then counts 0.
+    assign w_seq_flush = (r_nseq != '0) &&
+                         (w_flush || w_evt || w_sync ||
+                          (w_br && r_nseq > 28'd511) ||
+                          (w_seq && r_nseq == CNT_MAX));
+    assign w_br_word   = {2'b00, w_seq_flush ? 9'd0 : r_nseq[8:0], w_delta[21:1]};
+
+    assign w_rep_hit = w_br && r_last_br_vld && (w_br_word == r_last_br) &&
+                       (r_rep != CNT_MAX) && !w_seq_flush && !w_evt;
+
+    assign w_time_tick = w_active && (r_cycle[23:0] == 24'd0);
+
+    always_comb begin
+        w_slot_vld = '0;
+        w_slot     = '0;
+
+        w_slot_vld[SLOT_REPEAT] = (r_rep != '0) &&
+                                  (w_flush || w_evt || w_sync || (w_br && !w_rep_hit));
+        w_slot[SLOT_REPEAT]     = {4'b0101, r_rep};
+
+        w_slot_vld[SLOT_SEQ]    = w_seq_flush;
+        w_slot[SLOT_SEQ]        = {4'b0100, r_nseq};
+
+        w_slot_vld[SLOT_EVENT]  = w_evt;
+        w_slot[SLOT_EVENT]      = {4'b0110, w_evt_trap, w_evt_trap ? r_trap_cause : 6'd0,
+                                   w_commit ? i_trace.priv : r_priv, i_trace.debug_mode,
+                                   18'd0};
+
+        w_slot_vld[SLOT_FLOW]   = w_sync || (w_br && !w_rep_hit);
+        w_slot[SLOT_FLOW]       = w_sync ? {1'b1, i_trace.pc[31:1]} : w_br_word;
+
+        w_slot_vld[SLOT_TIME]   = w_sync || w_time_tick;
+        w_slot[SLOT_TIME]       = {4'b0111, r_cycle[31:4]};
+    end
+
+    // -----------------------------------------------------------------------
+    // Staging FIFO: pack this cycle's records, drain one per cycle
+    // -----------------------------------------------------------------------
+    logic [N_SLOTS-1:0][FIFO_W-1:0] w_slot_pos;
+    logic [$clog2(N_SLOTS+1)-1:0]   w_push_n;
+    logic                           w_push, w_drop, w_pop;
+
+    always_comb begin
+        logic [FIFO_W-1:0] pos;
+        pos      = r_fifo_wr;
+        w_push_n = '0;
+        for (int k = 0; k < N_SLOTS; k++) begin
+            w_slot_pos[k] = pos;
+            if (w_slot_vld[k]) begin
+                pos      = pos + 1'b1;
+                w_push_n = w_push_n + 1'b1;
+            end
+        end
+    end
+
+    assign w_push = (w_push_n != '0) && ((FIFO_W+1)'(w_push_n) <= (FIFO_W+1)'(FIFO_DEPTH) - r_fifo_cnt);
+    assign w_drop = (w_push_n != '0) && !w_push;
+    assign w_pop  = !w_fifo_empty && !w_full &&
+                    (r_state == TB_RUN || r_state == TB_FLUSH || r_state == TB_DRAIN);
+
+    always_ff @(posedge i_clk) begin
+        for (int k = 0; k < N_SLOTS; k++) begin
+            if (w_push && w_slot_vld[k]) r_fifo[w_slot_pos[k]] <= w_slot[k];
+        end
+    end
+
+    always_ff @(posedge i_clk) begin
+        if (w_pop) r_mem[r_wptr[IDX_W-1:0]] <= r_fifo[r_fifo_rd];
+    end
+
+    // -----------------------------------------------------------------------
+    // Recorder sequential logic
+    // -----------------------------------------------------------------------
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            r_state       <= TB_IDLE;
+            r_cycle       <= 32'd0;
+            r_wptr        <= 32'd0;
+            r_overflow    <= 1'b0;
+            r_need_sync   <= 1'b1;
+            r_since_sync  <= '0;
+            r_last_pc     <= 32'd0;
+            r_last_c      <= 1'b0;
+            r_anchor_pc   <= 32'd0;
+            r_nseq        <= '0;
+            r_rep         <= '0;
+            r_last_br     <= 32'd0;
+            r_last_br_vld <= 1'b0;
+            r_mode_vld    <= 1'b0;
+            r_priv        <= PRIV_M;
+            r_dbg         <= 1'b0;
+            r_trap_pend   <= 1'b0;
+            r_trap_cause  <= 6'd0;
+            r_trap_target <= 32'd0;
+            r_fifo_rd     <= '0;
+            r_fifo_wr     <= '0;
+            r_fifo_cnt    <= '0;
+        end else begin
+            r_state <= w_state_next;
+            r_cycle <= r_cycle + 32'd1;
+
+            // ---- Ring write ----
+            if (w_pop) begin
+                r_wptr    <= r_wptr + 32'd1;
+                r_fifo_rd <= r_fifo_rd + 1'b1;
+            end
+
+            // ---- Staging FIFO ----
+            if (w_push) r_fifo_wr <= w_slot_pos[N_SLOTS-1] + FIFO_W'(w_slot_vld[N_SLOTS-1]);
+            r_fifo_cnt <= r_fifo_cnt + (w_push ? (FIFO_W+1)'(w_push_n) : '0) - (FIFO_W+1)'(w_pop);
+
+            // ---- Encoder state ----
+            if (w_active) r_dbg <= i_trace.debug_mode;
+            if (w_active && i_trace.trap) begin
+                r_trap_pend   <= 1'b1;
+                r_trap_cause  <= {i_trace.trap_cause[31], i_trace.trap_cause[4:0]};
+                r_trap_target <= i_trace.trap_target;
+            end else if (w_evt_trap) begin
+                r_trap_pend   <= 1'b0;
+            end
+
+            if (w_drop) begin
+                // Lost records: resync at the next commit
+                r_overflow    <= 1'b1;
+                r_need_sync   <= 1'b1;
+                r_nseq        <= '0;
+                r_rep         <= '0;
+                r_last_br_vld <= 1'b0;
+                r_mode_vld    <= 1'b0;
+            end else begin
+                if (w_push) begin
+                    r_since_sync <= r_since_sync + w_push_n;
+                    if (r_since_sync >= SYNC_WORDS) r_need_sync <= 1'b1;
+                end
+
+                if (w_evt_mode && w_commit) begin
+                    r_mode_vld <= 1'b1;
+                    r_priv     <= i_trace.priv;
+                end
+
+                if (w_slot_vld[SLOT_REPEAT]) r_rep <= '0;
+
+                if (w_seq) begin
+                    r_nseq <= w_seq_flush ? 28'd1 : r_nseq + 28'd1;
+                end else if (w_br || w_sync || w_seq_flush) begin
+                    r_nseq <= '0;
+                end
+
+                if (w_rep_hit) begin
+                    r_rep <= r_rep + 28'd1;
+                end else if (w_br) begin
+                    r_last_br     <= w_br_word;
+                    r_last_br_vld <= 1'b1;
+                end
+
+                if (w_br || w_sync) r_anchor_pc <= i_trace.pc;
+                if (w_sync) begin
+                    r_need_sync   <= 1'b0;
+                    r_since_sync  <= '0;
+                    r_last_br_vld <= 1'b0;
+                end
+
+                if (w_active && w_commit) begin
+                    r_last_pc <= i_trace.pc;
+                    r_last_c  <= i_trace.compressed;
+                end
+            end
+
+            // ---- Start / stop / clear ----
+            if (r_state == TB_IDLE && w_state_next != TB_IDLE) begin
+                r_need_sync   <= 1'b1;
+                r_nseq        <= '0;
+                r_rep         <= '0;
+                r_last_br_vld <= 1'b0;
+                r_mode_vld    <= 1'b0;
+                r_trap_pend   <= 1'b0;
+            end
+            if (r_clear) begin
+                r_wptr        <= 32'd0;
+                r_overflow    <= 1'b0;
+                r_need_sync   <= 1'b1;
+                r_nseq        <= '0;
+                r_rep         <= '0;
+                r_last_br_vld <= 1'b0;
+                r_mode_vld    <= 1'b0;
+                r_fifo_rd     <= '0;
+                r_fifo_wr     <= '0;
+                r_fifo_cnt    <= '0;
+            end
+        end
+    end
+
+    // -----------------------------------------------------------------------
+    // Write channel
+    // -----------------------------------------------------------------------
+    logic        r_aw_pending;
+    logic [15:0] r_aw_addr;  // offset bits [15:0]
+    logic        r_w_pending;
+    logic [31:0] r_w_data;
+    logic [3:0]  r_w_strb;
+
+    assign s_axi_awready = !r_aw_pending || (r_w_pending && !s_axi_bvalid);
+    assign s_axi_wready  = !r_w_pending || (r_aw_pending && !s_axi_bvalid);
+
+    logic r_bvalid;
+    assign s_axi_bvalid = r_bvalid;
+    assign s_axi_bresp  = 2'b00;  // OKAY
+
+    // -----------------------------------------------------------------------
+    // Read channel
+    // -----------------------------------------------------------------------
+    // DATA reads come straight from the ring's read port, registers from
+    // r_rdata; both are valid the cycle after the address handshake.
+    logic        r_rvalid;
+    logic [31:0] r_rdata;
+    logic        r_rd_mem;
+    logic [31:0] r_mem_rdata;
+    logic        w_ar_fire;
+
+    assign w_ar_fire     = s_axi_arvalid && s_axi_arready;
+    assign s_axi_arready = !r_rvalid || s_axi_rready;
+    assign s_axi_rvalid  = r_rvalid;
+    assign s_axi_rdata   = r_rd_mem ? r_mem_rdata : r_rdata;
+    assign s_axi_rresp   = 2'b00;  // OKAY
+
+    always_ff @(posedge i_clk) begin
+        if (w_ar_fire) r_mem_rdata <= r_mem[s_axi_araddr[IDX_W+1:2]];
+    end
+
+    // -----------------------------------------------------------------------
+    // Register sequential logic
+    // -----------------------------------------------------------------------
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            r_ctrl_en        <= AUTO_START;
+            r_ctrl_wrap      <= 1'b1;
+            r_ctrl_start_pc  <= 1'b0;
+            r_ctrl_stop_pc   <= 1'b0;
+            r_ctrl_stop_trap <= 1'b0;
+            r_clear          <= 1'b0;
+            r_start_pc       <= 32'd0;
+            r_stop_pc        <= 32'd0;
+            r_aw_pending     <= 1'b0;
+            r_aw_addr        <= 16'd0;
+            r_w_pending      <= 1'b0;
+            r_w_data         <= 32'd0;
+            r_w_strb         <= 4'd0;
+            r_bvalid         <= 1'b0;
+            r_rvalid         <= 1'b0;
+            r_rdata          <= 32'd0;
+            r_rd_mem         <= 1'b0;
+        end else begin
+            r_clear <= 1'b0;
+
+            // ---- Hardware stop: EN reads back 0 once drained ----
+            if ((r_state == TB_DRAIN || r_state == TB_ARMED) && w_state_next == TB_IDLE) begin
+                r_ctrl_en <= 1'b0;
+            end
+
+            // ---- Write Execution condition ----
+            if (r_aw_pending && r_w_pending && !r_bvalid) begin
+                r_bvalid <= 1'b1;
+                if (!r_aw_addr[15] && r_w_strb[0]) begin
+                    unique case (r_aw_addr[7:2])
+                        6'h00: begin
+                            r_ctrl_en        <= r_w_data[0];
+                            r_ctrl_wrap      <= r_w_data[1];
+                            r_ctrl_start_pc  <= r_w_data[2];
+                            r_ctrl_stop_pc   <= r_w_data[3];
+                            r_ctrl_stop_trap <= r_w_data[4];
+                        end
+                        6'h04: r_start_pc <= r_w_data;
+                        6'h05: r_stop_pc  <= r_w_data;
+                        default: ;
+                    endcase
+                end
+                if (!r_aw_addr[15] && r_aw_addr[7:2] == 6'h00 && r_w_strb[1]) begin
+                    r_clear <= r_w_data[8];
+                end
+            end
+
+            // ---- Write response handshake ----
+            if (r_bvalid && s_axi_bready) begin
+                r_bvalid <= 1'b0;
+            end
+
+            // ---- Write address capture ----
+            if (s_axi_awvalid && s_axi_awready) begin
+                r_aw_pending <= 1'b1;
+                r_aw_addr    <= s_axi_awaddr[15:0];
+            end else if (r_aw_pending && r_w_pending && !r_bvalid) begin
+                r_aw_pending <= 1'b0;
+            end
+
+            // ---- Write data capture ----
+            if (s_axi_wvalid && s_axi_wready) begin
+                r_w_pending <= 1'b1;
+                r_w_data    <= s_axi_wdata;
+                r_w_strb    <= s_axi_wstrb;
+            end else if (r_aw_pending && r_w_pending && !r_bvalid) begin
+                r_w_pending <= 1'b0;
+            end
+
+            // ---- Read handshake & capture ----
+            if (w_ar_fire) begin
+                r_rvalid <= 1'b1;
+                r_rd_mem <= s_axi_araddr[15];
+                unique case (s_axi_araddr[7:2])
+                    6'h00: r_rdata <= {23'd0, 1'b0, 3'd0, r_ctrl_stop_trap, r_ctrl_stop_pc,
+                                       r_ctrl_start_pc, r_ctrl_wrap, r_ctrl_en};
+                    6'h01: r_rdata <= {25'd0, r_overflow, w_full, |r_wptr[31:IDX_W],
+                                       1'b0, r_state};
+                    6'h02: r_rdata <= r_wptr;
+                    6'h03: r_rdata <= 32'(WORDS);
+                    6'h04: r_rdata <= r_start_pc;
+                    6'h05: r_rdata <= r_stop_pc;
+                    6'h06: r_rdata <= r_cycle;
+                    default: r_rdata <= 32'd0;
+                endcase
+            end else if (r_rvalid && s_axi_rready) begin
+                r_rvalid <= 1'b0;
+            end
+        end
+    end
+
+endmodule : k10_trace_buf
@@ -47,6 +47,27 @@ module k10_uart #(
 
     localparam int unsigned BAUD_DIV_DEFAULT = CLK_FREQ_HZ / BAUD_DEFAULT;
 
+    // -----------------------------------------------------------------------
+    // Simulation backdoor (Verilator, +uart_backdoor[=stdin|pty])
+    // -----------------------------------------------------------------------
+    // TXDATA writes are handed to k10_uart_tx() and complete at once; RX
+    // bytes are taken from k10_console.cpp into RXDATA whenever it is empty.
+    // The serial pins stay idle.  Registers and interrupts behave as in
+    // normal operation, minus the bit timing.
+    // -----------------------------------------------------------------------
+    logic w_backdoor;
+`ifdef VERILATOR
+    import "DPI-C" function void k10_uart_tx(input byte c);
+    import "DPI-C" function bit  k10_uart_rx_ready();
+    import "DPI-C" function byte k10_uart_rx_pop();
+
+    bit r_backdoor;
+    initial r_backdoor = $test$plusargs("uart_backdoor");
+    assign w_backdoor = r_backdoor;
+`else
+    assign w_backdoor = 1'b0;
+`endif
+
     logic        r_aw_pending;
     logic [5:0]  r_aw_addr;
     logic        r_w_pending;
@@ -149,7 +170,12 @@ module k10_uart #(
 
                 unique case (r_aw_addr[5:2])
                     4'h0: begin
-                        if (w_tx_ready) begin
+                        if (w_tx_ready && w_backdoor) begin
+`ifdef VERILATOR
+                            k10_uart_tx(r_w_data[7:0]);
+`endif
+                            r_irq_tx_pending <= 1'b1;
+                        end else if (w_tx_ready) begin
                             r_tx_shift   <= {1'b1, r_w_data[7:0], 1'b0};
                             r_tx_busy    <= 1'b1;
                             r_tx_bit_idx <= 4'd0;
@@ -199,6 +225,14 @@ module k10_uart #(
                 r_irq_rx_pending <= 1'b0;
             end
 
+`ifdef VERILATOR
+            if (w_backdoor && !r_rx_valid && k10_uart_rx_ready()) begin
+                r_rx_data        <= k10_uart_rx_pop();
+                r_rx_valid       <= 1'b1;
+                r_irq_rx_pending <= 1'b1;
+            end
+`endif
+
             if (r_tx_busy) begin
                 if (r_tx_cnt == 0) begin
                     r_tx_cnt <= (r_baud_div > 0) ? (r_baud_div - 1) : 32'd0;
@@ -6,6 +6,27 @@
 //
 //     http://www.apache.org/licenses/LICENSE-2.0
 
+// ============================================================================
+// K10 — SoC
+// ============================================================================
+// N_HARTS K10 cores share one BRAM (instruction fetch on port A, data on
+// port B) and the AXI4-Lite peripherals:
+//
+//   hart I-buses ─(I-caches)─ obi_mux ─ obi_xbar ─┬─ BRAM port A
+//                                                 └─ bus2axi4lite ─┐
+//   hart D-buses + DM SBA ──── obi_mux ─ obi_xbar ─┬─ BRAM port B   │
+//                                                 └─ bus2axi4lite ─┴─ axi4lite_xbar
+//
+// The I-side mux is only there with N_HARTS > 1.  Harts are arbitrated
+// round-robin per access.  Each hart has its own mtimecmp (k10_timer) and
+// MSIP (k10_sim_ctrl) and is registered in the debug module; the external
+// and fast interrupts, i_debug_req and the commit trace are hart 0's.
+// Atomics stay atomic across harts: the D-side mux holds a hart's LR / SC /
+// AMO together (o_dbus_lock) and every granted write is snooped by the
+// other harts' LR reservations (see k10_lsu).  Hart 0 is u_top, the rest
+// g_hart[h].u_top.
+// ============================================================================
+
 module k10_soc
   import komandara_k10_pkg::*;
 #(
@@ -15,7 +36,20 @@ module k10_soc
     parameter              MEM_INIT    = "",
     parameter logic [31:0] PERI_BASE   = 32'h4000_0000,
     parameter logic [31:0] PERI_MASK   = 32'hF000_0000,
-    parameter logic [31:0] BOOT_ADDR   = 32'h8000_0000
+    parameter logic [31:0] BOOT_ADDR   = 32'h8000_0000,
+    parameter bit          BRANCH_PRED = 1'b1,
+    parameter bit          FAST_DIV    = 1'b1,    // k10_mul_div early-terminating divide
+    parameter int unsigned MUL_STAGES  = 1,       // k10_mul_div multiply cycles in EX
+    parameter int unsigned CLK_FREQ_HZ = 50_000_000,  // i_clk (UART baud default)
+    parameter int unsigned PREFETCH_DEPTH = 4,
+    parameter int unsigned STORE_BUFFER = 4,       // k10_lsu store buffer (BRAM only)
+    parameter bit          ICACHE      = 1'b0,    // k10_icache on the I-bus
+    parameter int unsigned ICACHE_LINES      = 64,
+    parameter int unsigned ICACHE_LINE_WORDS = 4,
+    parameter int unsigned AXI_OUTSTANDING   = 2,  // per AXI bridge / xbar path
+    parameter bit          TRACE_BUF   = 1'b0,    // k10_trace_buf on the AXI xbar (hart 0)
+    parameter int unsigned TRACE_WORDS = 4096,
+    parameter int unsigned N_HARTS     = 1        // K10 cores, mhartid 0 .. N_HARTS-1 (1..8)
 )(
     input  logic        i_clk,
     input  logic        i_rst_n,
@@ -29,8 +63,8 @@ module k10_soc
     output logic        o_jtag_tdo,
     input  logic        i_uart_rx,
     output logic        o_uart_tx,
-    output logic        o_timer_irq,
-    output logic        o_sw_irq,
+    output logic        o_timer_irq,    // hart 0
+    output logic        o_sw_irq,       // hart 0
     output logic        o_uart_irq,
     output logic [63:0] o_mtime
 );
@@ -38,11 +72,13 @@ module k10_soc
     localparam int MEM_WORDS      = (MEM_SIZE_KB * 1024) / 4;
     localparam int MEM_ADDR_WIDTH = $clog2(MEM_WORDS);
     localparam int N_MASTERS      = 2; // 0: D-Bus AXI bridge, 1: I-Bus AXI bridge
-    localparam int N_SLAVES       = 4; // BRAM removed from AXI
+    localparam int N_DBUS_MASTERS = N_HARTS + 1; // harts, then DM SBA
+    localparam int N_SLAVES       = TRACE_BUF ? 5 : 4; // BRAM removed from AXI
     localparam int SLV_TIMER      = 0;
     localparam int SLV_SIM_CTRL   = 1;
     localparam int SLV_UART       = 2;
     localparam int SLV_DM         = 3;
+    localparam int SLV_TRACE      = 4;
 
     localparam logic [31:0] TIMER_BASE    = PERI_BASE + 32'h0000;
     localparam logic [31:0] TIMER_MASK    = 32'hFFFF_F000;
@@ -52,14 +88,37 @@ module k10_soc
     localparam logic [31:0] UART_MASK     = 32'hFFFF_F000;
     localparam logic [31:0] DM_BASE       = PERI_BASE + 32'h3000;
     localparam logic [31:0] DM_MASK       = 32'hFFFF_F000;
+    localparam logic [31:0] TRACE_BASE    = PERI_BASE + 32'h1_0000;
+    localparam logic [31:0] TRACE_MASK    = 32'hFFFF_0000;
     localparam logic [31:0] DM_HALT_ADDR  = DM_BASE + 32'h0800;
     localparam logic [31:0] DM_EXC_ADDR   = DM_BASE + 32'h0810;
 
-    logic        w_ibus_req, w_ibus_gnt, w_ibus_rvalid, w_ibus_err;
-    logic [31:0] w_ibus_addr, w_ibus_rdata;
-    logic        w_dbus_req, w_dbus_we, w_dbus_gnt, w_dbus_rvalid, w_dbus_err;
-    logic [31:0] w_dbus_addr, w_dbus_wdata, w_dbus_rdata;
-    logic [3:0]  w_dbus_wstrb;
+    // Per hart
+    logic [N_HARTS-1:0]       w_ibus_req, w_ibus_gnt, w_ibus_rvalid, w_ibus_err;
+    logic [N_HARTS-1:0][31:0] w_ibus_addr, w_ibus_rdata;
+    logic [N_HARTS-1:0]       w_fence_i;
+    // I-bus after the (optional) I-caches
+    logic [N_HARTS-1:0]       w_ibus_mem_req, w_ibus_mem_gnt, w_ibus_mem_rvalid, w_ibus_mem_err;
+    logic [N_HARTS-1:0][31:0] w_ibus_mem_addr, w_ibus_mem_rdata;
+    logic [N_HARTS-1:0]       w_dbus_req, w_dbus_we, w_dbus_gnt, w_dbus_rvalid, w_dbus_err;
+    logic [N_HARTS-1:0][31:0] w_dbus_addr, w_dbus_wdata, w_dbus_rdata;
+    logic [N_HARTS-1:0][3:0]  w_dbus_wstrb;
+    logic [N_HARTS-1:0]       w_dbus_lock;
+    logic [N_HARTS-1:0]       w_snoop_we;
+    logic [N_HARTS-1:0]       w_timer_irq, w_sw_irq;
+    // I-bus after the hart arbiter
+    logic        w_ibus_arb_req, w_ibus_arb_gnt, w_ibus_arb_rvalid, w_ibus_arb_err;
+    logic [31:0] w_ibus_arb_addr, w_ibus_arb_rdata;
+    // D-bus after the hart / SBA arbiter
+    logic        w_muxed_dbus_req;
+    logic        w_muxed_dbus_we;
+    logic [31:0] w_muxed_dbus_addr;
+    logic [31:0] w_muxed_dbus_wdata;
+    logic [3:0]  w_muxed_dbus_wstrb;
+    logic        w_muxed_dbus_gnt;
+    logic        w_muxed_dbus_rvalid;
+    logic [31:0] w_muxed_dbus_rdata;
+    logic        w_muxed_dbus_err;
 
     logic [N_MASTERS-1:0][31:0] w_m_awaddr, w_m_wdata, w_m_araddr, w_m_rdata;
     logic [N_MASTERS-1:0][2:0]  w_m_awprot, w_m_arprot;
@@ -153,45 +212,189 @@ module k10_soc
     logic [31:0] w_dm_host_rdata;
     logic        w_dm_host_err;
 
-    (* mark_debug = "true" *) logic        w_dm_debug_req;
+    (* mark_debug = "true" *) logic [N_HARTS-1:0] w_dm_debug_req;
     (* mark_debug = "true" *) logic        w_dm_ndmreset;
     logic        w_dmactive;
     logic        w_core_rst_n;
-    logic        w_debug_mode;
+    logic [N_HARTS-1:0] w_debug_mode;
+    commit_trace_t w_commit_trace;
+
+    if (N_HARTS < 1 || N_HARTS > 8) begin : g_bad_harts
+        $error("k10_soc: N_HARTS must be 1..8");
+    end
 
+    // Hart 0 keeps the u_top path the testbench and tools refer to
     k10_top #(
         .BOOT_ADDR (BOOT_ADDR),
+        .MHARTID     (32'd0),
+        .BRANCH_PRED (BRANCH_PRED),
+        .FAST_DIV    (FAST_DIV),
+        .MUL_STAGES  (MUL_STAGES),
+        .PREFETCH_DEPTH (PREFETCH_DEPTH),
+        .STORE_BUFFER (STORE_BUFFER),
+        .SB_BASE     (MEM_BASE),
+        .SB_MASK     (MEM_MASK),
         .DEBUG_HALT_ADDR (DM_HALT_ADDR),
         .DEBUG_EXCEPTION_ADDR (DM_EXC_ADDR)
     ) u_top (
         .i_clk         (i_clk),
         .i_rst_n       (w_core_rst_n),
         .i_ext_irq     (i_ext_irq || o_uart_irq),
-        .i_timer_irq   (o_timer_irq),
-        .i_sw_irq      (o_sw_irq),
+        .i_timer_irq   (w_timer_irq[0]),
+        .i_sw_irq      (w_sw_irq[0]),
         .i_irq_fast    (i_irq_fast),
-        .i_debug_req   (i_debug_req || w_dm_debug_req),
-        .o_debug_mode  (w_debug_mode),
+        .i_debug_req   (i_debug_req || w_dm_debug_req[0]),
+        .o_debug_mode  (w_debug_mode[0]),
         .i_mtime       (o_mtime),
-        .o_ibus_req    (w_ibus_req),
-        .o_ibus_addr   (w_ibus_addr),
-        .i_ibus_gnt    (w_ibus_gnt),
-        .i_ibus_rvalid (w_ibus_rvalid),
-        .i_ibus_rdata  (w_ibus_rdata),
-        .i_ibus_err    (w_ibus_err),
-        .o_dbus_req    (w_dbus_req),
-        .o_dbus_we     (w_dbus_we),
-        .o_dbus_addr   (w_dbus_addr),
-        .o_dbus_wdata  (w_dbus_wdata),
-        .o_dbus_wstrb  (w_dbus_wstrb),
-        .i_dbus_gnt    (w_dbus_gnt),
-        .i_dbus_rvalid (w_dbus_rvalid),
-        .i_dbus_rdata  (w_dbus_rdata),
-        .i_dbus_err    (w_dbus_err)
+        .o_ibus_req    (w_ibus_req[0]),
+        .o_ibus_addr   (w_ibus_addr[0]),
+        .i_ibus_gnt    (w_ibus_gnt[0]),
+        .i_ibus_rvalid (w_ibus_rvalid[0]),
+        .i_ibus_rdata  (w_ibus_rdata[0]),
+        .i_ibus_err    (w_ibus_err[0]),
+        .o_fence_i     (w_fence_i[0]),
+        .o_dbus_req    (w_dbus_req[0]),
+        .o_dbus_we     (w_dbus_we[0]),
+        .o_dbus_addr   (w_dbus_addr[0]),
+        .o_dbus_wdata  (w_dbus_wdata[0]),
+        .o_dbus_wstrb  (w_dbus_wstrb[0]),
+        .i_dbus_gnt    (w_dbus_gnt[0]),
+        .i_dbus_rvalid (w_dbus_rvalid[0]),
+        .i_dbus_rdata  (w_dbus_rdata[0]),
+        .i_dbus_err    (w_dbus_err[0]),
+        .o_dbus_lock   (w_dbus_lock[0]),
+        .i_snoop_we    (w_snoop_we[0]),
+        .i_snoop_addr  (w_muxed_dbus_addr),
+        .o_commit_trace (w_commit_trace)
     );
 
+    for (genvar h = 1; h < int'(N_HARTS); h++) begin : g_hart
+        k10_top #(
+            .BOOT_ADDR (BOOT_ADDR),
+            .MHARTID     (32'(h)),
+            .BRANCH_PRED (BRANCH_PRED),
+            .FAST_DIV    (FAST_DIV),
+            .MUL_STAGES  (MUL_STAGES),
+            .PREFETCH_DEPTH (PREFETCH_DEPTH),
+            .STORE_BUFFER (STORE_BUFFER),
+            .SB_BASE     (MEM_BASE),
+            .SB_MASK     (MEM_MASK),
+            .DEBUG_HALT_ADDR (DM_HALT_ADDR),
+            .DEBUG_EXCEPTION_ADDR (DM_EXC_ADDR)
+        ) u_top (
+            .i_clk         (i_clk),
+            .i_rst_n       (w_core_rst_n),
+            .i_ext_irq     (1'b0),
+            .i_timer_irq   (w_timer_irq[h]),
+            .i_sw_irq      (w_sw_irq[h]),
+            .i_irq_fast    (15'd0),
+            .i_debug_req   (w_dm_debug_req[h]),
+            .o_debug_mode  (w_debug_mode[h]),
+            .i_mtime       (o_mtime),
+            .o_ibus_req    (w_ibus_req[h]),
+            .o_ibus_addr   (w_ibus_addr[h]),
+            .i_ibus_gnt    (w_ibus_gnt[h]),
+            .i_ibus_rvalid (w_ibus_rvalid[h]),
+            .i_ibus_rdata  (w_ibus_rdata[h]),
+            .i_ibus_err    (w_ibus_err[h]),
+            .o_fence_i     (w_fence_i[h]),
+            .o_dbus_req    (w_dbus_req[h]),
+            .o_dbus_we     (w_dbus_we[h]),
+            .o_dbus_addr   (w_dbus_addr[h]),
+            .o_dbus_wdata  (w_dbus_wdata[h]),
+            .o_dbus_wstrb  (w_dbus_wstrb[h]),
+            .i_dbus_gnt    (w_dbus_gnt[h]),
+            .i_dbus_rvalid (w_dbus_rvalid[h]),
+            .i_dbus_rdata  (w_dbus_rdata[h]),
+            .i_dbus_err    (w_dbus_err[h]),
+            .o_dbus_lock   (w_dbus_lock[h]),
+            .i_snoop_we    (w_snoop_we[h]),
+            .i_snoop_addr  (w_muxed_dbus_addr),
+            .o_commit_trace ()
+        );
+    end
+
     assign w_core_rst_n = i_rst_n && !w_dm_ndmreset;
 
+    // Only the BRAM window is cached; the DM ROM and peripherals on the
+    // AXI side are always fetched uncached.
+    for (genvar h = 0; h < int'(N_HARTS); h++) begin : g_ibus
+        if (ICACHE) begin : g_icache
+            k10_icache #(
+                .LINES      (ICACHE_LINES),
+                .LINE_WORDS (ICACHE_LINE_WORDS),
+                .CACHE_BASE (MEM_BASE),
+                .CACHE_MASK (MEM_MASK)
+            ) u_icache (
+                .i_clk        (i_clk),
+                .i_rst_n      (w_core_rst_n),
+                .i_invalidate (w_fence_i[h]),
+                .i_req        (w_ibus_req[h]),
+                .i_addr       (w_ibus_addr[h]),
+                .o_gnt        (w_ibus_gnt[h]),
+                .o_rvalid     (w_ibus_rvalid[h]),
+                .o_rdata      (w_ibus_rdata[h]),
+                .o_err        (w_ibus_err[h]),
+                .o_mem_req    (w_ibus_mem_req[h]),
+                .o_mem_addr   (w_ibus_mem_addr[h]),
+                .i_mem_gnt    (w_ibus_mem_gnt[h]),
+                .i_mem_rvalid (w_ibus_mem_rvalid[h]),
+                .i_mem_rdata  (w_ibus_mem_rdata[h]),
+                .i_mem_err    (w_ibus_mem_err[h])
+            );
+        end else begin : g_no_icache
+            assign w_ibus_mem_req[h]  = w_ibus_req[h];
+            assign w_ibus_mem_addr[h] = w_ibus_addr[h];
+            assign w_ibus_gnt[h]      = w_ibus_mem_gnt[h];
+            assign w_ibus_rvalid[h]   = w_ibus_mem_rvalid[h];
+            assign w_ibus_rdata[h]    = w_ibus_mem_rdata[h];
+            assign w_ibus_err[h]      = w_ibus_mem_err[h];
+        end
+    end
+
+    if (N_HARTS > 1) begin : g_ibus_mux
+        logic        w_we_unused;
+        logic [31:0] w_wdata_unused;
+        logic [3:0]  w_wstrb_unused;
+
+        komandara_obi_mux #(
+            .N_MASTERS   (N_HARTS),
+            .ADDR_WIDTH  (32),
+            .DATA_WIDTH  (32),
+            .ROUND_ROBIN (1'b1)
+        ) u_obi_ibus_mux (
+            .clk_i      (i_clk),
+            .rst_ni     (i_rst_n),
+            .s_req_i    (w_ibus_mem_req),
+            .s_we_i     ('0),
+            .s_addr_i   (w_ibus_mem_addr),
+            .s_wdata_i  ('0),
+            .s_wstrb_i  ('0),
+            .s_lock_i   ('0),
+            .s_gnt_o    (w_ibus_mem_gnt),
+            .s_rvalid_o (w_ibus_mem_rvalid),
+            .s_rdata_o  (w_ibus_mem_rdata),
+            .s_err_o    (w_ibus_mem_err),
+
+            .m_req_o    (w_ibus_arb_req),
+            .m_we_o     (w_we_unused),
+            .m_addr_o   (w_ibus_arb_addr),
+            .m_wdata_o  (w_wdata_unused),
+            .m_wstrb_o  (w_wstrb_unused),
+            .m_gnt_i    (w_ibus_arb_gnt),
+            .m_rvalid_i (w_ibus_arb_rvalid),
+            .m_rdata_i  (w_ibus_arb_rdata),
+            .m_err_i    (w_ibus_arb_err)
+        );
+    end else begin : g_ibus_direct
+        assign w_ibus_arb_req       = w_ibus_mem_req[0];
+        assign w_ibus_arb_addr      = w_ibus_mem_addr[0];
+        assign w_ibus_mem_gnt[0]    = w_ibus_arb_gnt;
+        assign w_ibus_mem_rvalid[0] = w_ibus_arb_rvalid;
+        assign w_ibus_mem_rdata[0]  = w_ibus_arb_rdata;
+        assign w_ibus_mem_err[0]    = w_ibus_arb_err;
+    end
+
     logic [1:0]        w_obi_m_req;
     logic [1:0]        w_obi_m_we;
     logic [1:0][31:0]  w_obi_m_addr;
@@ -211,15 +414,15 @@ module k10_soc
     ) u_obi_xbar (
         .clk_i      (i_clk),
         .rst_ni     (i_rst_n),
-        .s_req_i    (w_ibus_req),
+        .s_req_i    (w_ibus_arb_req),
         .s_we_i     (1'b0),
-        .s_addr_i   (w_ibus_addr),
+        .s_addr_i   (w_ibus_arb_addr),
         .s_wdata_i  (32'd0),
         .s_wstrb_i  (4'd0),
-        .s_gnt_o    (w_ibus_gnt),
-        .s_rvalid_o (w_ibus_rvalid),
-        .s_rdata_o  (w_ibus_rdata),
-        .s_err_o    (w_ibus_err),
+        .s_gnt_o    (w_ibus_arb_gnt),
+        .s_rvalid_o (w_ibus_arb_rvalid),
+        .s_rdata_o  (w_ibus_arb_rdata),
+        .s_err_o    (w_ibus_arb_err),
         
         .m_req_o    (w_obi_m_req),
         .m_we_o     (w_obi_m_we),
@@ -233,8 +436,9 @@ module k10_soc
     );
 
     komandara_bus2axi4lite #(
-        .ADDR_WIDTH (32),
-        .DATA_WIDTH (32)
+        .ADDR_WIDTH      (32),
+        .DATA_WIDTH      (32),
+        .MAX_OUTSTANDING (AXI_OUTSTANDING)
     ) u_ibus_adapter (
         .i_clk         (i_clk),
         .i_rst_n       (i_rst_n),
@@ -278,18 +482,8 @@ module k10_soc
     logic [1:0][31:0]  w_obi_dbus_m_rdata;
     logic [1:0]        w_obi_dbus_m_err;
 
-    logic        w_muxed_dbus_req;
-    logic        w_muxed_dbus_we;
-    logic [31:0] w_muxed_dbus_addr;
-    logic [31:0] w_muxed_dbus_wdata;
-    logic [3:0]  w_muxed_dbus_wstrb;
-    logic        w_muxed_dbus_gnt;
-    logic        w_muxed_dbus_rvalid;
-    logic [31:0] w_muxed_dbus_rdata;
-    logic        w_muxed_dbus_err;
-
     komandara_obi_mux #(
-        .N_MASTERS   (2),
+        .N_MASTERS   (N_DBUS_MASTERS),
         .ADDR_WIDTH  (32),
         .DATA_WIDTH  (32),
         .ROUND_ROBIN (1'b1)
@@ -301,6 +495,7 @@ module k10_soc
         .s_addr_i   ({w_dm_host_addr,  w_dbus_addr}),
         .s_wdata_i  ({w_dm_host_wdata, w_dbus_wdata}),
         .s_wstrb_i  ({w_dm_host_be,    w_dbus_wstrb}),
+        .s_lock_i   ({1'b0,            w_dbus_lock}),
         .s_gnt_o    ({w_dm_host_gnt,   w_dbus_gnt}),
         .s_rvalid_o ({w_dm_host_rvalid,w_dbus_rvalid}),
         .s_rdata_o  ({w_dm_host_rdata, w_dbus_rdata}),
@@ -317,6 +512,14 @@ module k10_soc
         .m_err_i    (w_muxed_dbus_err)
     );
 
+    // LR reservations: a write granted to one master is seen by the others
+    logic [N_DBUS_MASTERS-1:0] w_dbus_wr_gnt;
+    assign w_dbus_wr_gnt = {w_dm_host_gnt, w_dbus_gnt} & {w_dm_host_we, w_dbus_we};
+
+    for (genvar h = 0; h < int'(N_HARTS); h++) begin : g_snoop
+        assign w_snoop_we[h] = |(w_dbus_wr_gnt & ~(N_DBUS_MASTERS'(1) << h));
+    end
+
     komandara_obi_xbar #(
         .N_SLAVES       (2),
         .ADDR_WIDTH     (32),
@@ -348,8 +551,9 @@ module k10_soc
     );
 
     komandara_bus2axi4lite #(
-        .ADDR_WIDTH (32),
-        .DATA_WIDTH (32)
+        .ADDR_WIDTH      (32),
+        .DATA_WIDTH      (32),
+        .MAX_OUTSTANDING (AXI_OUTSTANDING)
     ) u_dbus_adapter (
         .i_clk         (i_clk),
         .i_rst_n       (i_rst_n),
@@ -416,8 +620,10 @@ module k10_soc
         .ADDR_WIDTH      (32),
         .DATA_WIDTH      (32),
         .ROUND_ROBIN     (1'b0),
-        .SLAVE_ADDR_BASE ({DM_BASE, UART_BASE, SIM_CTRL_BASE, TIMER_BASE}),
-        .SLAVE_ADDR_MASK ({DM_MASK, UART_MASK, SIM_CTRL_MASK, TIMER_MASK})
+        .MAX_OUTSTANDING (AXI_OUTSTANDING),
+        // The trace buffer entry is cut off when TRACE_BUF = 0
+        .SLAVE_ADDR_BASE ((N_SLAVES*32)'({TRACE_BASE, DM_BASE, UART_BASE, SIM_CTRL_BASE, TIMER_BASE})),
+        .SLAVE_ADDR_MASK ((N_SLAVES*32)'({TRACE_MASK, DM_MASK, UART_MASK, SIM_CTRL_MASK, TIMER_MASK}))
     ) u_xbar (
         .clk_i           (i_clk),
         .rst_ni          (i_rst_n),
@@ -607,10 +813,12 @@ module k10_soc
     assign w_xbar_m_rvalid[SLV_DM]  = w_dm_rvalid;
     assign w_dm_rready              = w_xbar_m_rready[SLV_DM];
 
-    k10_timer u_timer (
+    k10_timer #(
+        .N_HARTS       (N_HARTS)
+    ) u_timer (
         .i_clk         (i_clk),
         .i_rst_n       (i_rst_n),
-        .i_debug_mode  (w_debug_mode),
+        .i_debug_mode  (|w_debug_mode),
         .s_axi_awaddr  (w_xbar_m_awaddr[SLV_TIMER]),
         .s_axi_awprot  (w_xbar_m_awprot[SLV_TIMER]),
         .s_axi_awvalid (w_xbar_m_awvalid[SLV_TIMER]),
@@ -630,11 +838,15 @@ module k10_soc
         .s_axi_rresp   (w_xbar_m_rresp[SLV_TIMER]),
         .s_axi_rvalid  (w_xbar_m_rvalid[SLV_TIMER]),
         .s_axi_rready  (w_xbar_m_rready[SLV_TIMER]),
-        .o_timer_irq   (o_timer_irq),
+        .o_timer_irq   (w_timer_irq),
         .o_mtime       (o_mtime)
     );
 
-    k10_sim_ctrl u_sim_ctrl (
+    assign o_timer_irq = w_timer_irq[0];
+
+    k10_sim_ctrl #(
+        .N_HARTS       (N_HARTS)
+    ) u_sim_ctrl (
         .i_clk         (i_clk),
         .i_rst_n       (i_rst_n),
         .s_axi_awaddr  (w_xbar_m_awaddr[SLV_SIM_CTRL]),
@@ -656,11 +868,13 @@ module k10_soc
         .s_axi_rresp   (w_xbar_m_rresp[SLV_SIM_CTRL]),
         .s_axi_rvalid  (w_xbar_m_rvalid[SLV_SIM_CTRL]),
         .s_axi_rready  (w_xbar_m_rready[SLV_SIM_CTRL]),
-        .o_sw_irq      (o_sw_irq)
+        .o_sw_irq      (w_sw_irq)
     );
 
+    assign o_sw_irq = w_sw_irq[0];
+
     k10_uart #(
-        .CLK_FREQ_HZ (50_000_000),
+        .CLK_FREQ_HZ (CLK_FREQ_HZ),
         .BAUD_DEFAULT(115200)
     ) u_uart (
         .i_clk         (i_clk),
@@ -689,8 +903,38 @@ module k10_soc
         .o_irq         (o_uart_irq)
     );
 
+    // Keeps running through ndmreset so a trace survives a debugger reset
+    if (TRACE_BUF) begin : g_trace_buf
+        k10_trace_buf #(
+            .WORDS (TRACE_WORDS)
+        ) u_trace_buf (
+            .i_clk         (i_clk),
+            .i_rst_n       (i_rst_n),
+            .i_trace       (w_commit_trace),
+            .s_axi_awaddr  (w_xbar_m_awaddr[SLV_TRACE]),
+            .s_axi_awprot  (w_xbar_m_awprot[SLV_TRACE]),
+            .s_axi_awvalid (w_xbar_m_awvalid[SLV_TRACE]),
+            .s_axi_awready (w_xbar_m_awready[SLV_TRACE]),
+            .s_axi_wdata   (w_xbar_m_wdata[SLV_TRACE]),
+            .s_axi_wstrb   (w_xbar_m_wstrb[SLV_TRACE]),
+            .s_axi_wvalid  (w_xbar_m_wvalid[SLV_TRACE]),
+            .s_axi_wready  (w_xbar_m_wready[SLV_TRACE]),
+            .s_axi_bresp   (w_xbar_m_bresp[SLV_TRACE]),
+            .s_axi_bvalid  (w_xbar_m_bvalid[SLV_TRACE]),
+            .s_axi_bready  (w_xbar_m_bready[SLV_TRACE]),
+            .s_axi_araddr  (w_xbar_m_araddr[SLV_TRACE]),
+            .s_axi_arprot  (w_xbar_m_arprot[SLV_TRACE]),
+            .s_axi_arvalid (w_xbar_m_arvalid[SLV_TRACE]),
+            .s_axi_arready (w_xbar_m_arready[SLV_TRACE]),
+            .s_axi_rdata   (w_xbar_m_rdata[SLV_TRACE]),
+            .s_axi_rresp   (w_xbar_m_rresp[SLV_TRACE]),
+            .s_axi_rvalid  (w_xbar_m_rvalid[SLV_TRACE]),
+            .s_axi_rready  (w_xbar_m_rready[SLV_TRACE])
+        );
+    end
+
     dm_top #(
-        .NrHarts    (1),
+        .NrHarts    (N_HARTS),
         .IdcodeValue(32'h2495_11C3),
         .BusWidth   (32)
     ) u_dm_top (
@@ -700,7 +944,7 @@ module k10_soc
         .ndmreset_o     (w_dm_ndmreset),
         .dmactive_o     (w_dmactive),
         .debug_req_o    (w_dm_debug_req),
-        .unavailable_i  (1'b0),
+        .unavailable_i  ('0),
         .device_req_i   (w_dm_req),
         .device_we_i    (w_dm_we),
         .device_addr_i  (w_dm_addr),
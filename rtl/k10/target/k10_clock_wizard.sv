@@ -1,4 +1,10 @@
-module k10_clock_wizard (
+// Core clock from the 200 MHz Genesys2 oscillator.  CLK_FREQ_MHZ picks the
+// PLL settings at elaboration: the first VCO frequency (in 100 MHz steps,
+// 1000 MHz first, then up to 1800 MHz, then 900 / 800 MHz) that
+// CLK_FREQ_MHZ divides.  Frequencies with no such VCO stop elaboration.
+module k10_clock_wizard #(
+    parameter int unsigned CLK_FREQ_MHZ = 50
+)(
     input  logic IO_CLK_P,
     input  logic IO_CLK_N,
     input  logic IO_RST_N,
@@ -11,6 +17,27 @@ module k10_clock_wizard (
     logic w_pll_clk0_out;
     logic w_pll_locked;
 
+    localparam int unsigned CLKIN_MHZ = 200;
+
+    function automatic int unsigned pll_vco_mhz(input int unsigned f);
+        int unsigned v;
+        pll_vco_mhz = 0;
+        for (int i = 10; i >= 0; i--) begin
+            v = (i <= 8) ? 1000 + 100 * i : 1000 - 100 * (i - 8);
+            if (f != 0 && v % f == 0 && v / f <= 128) pll_vco_mhz = v;
+        end
+    endfunction
+
+    localparam int unsigned VCO_MHZ    = pll_vco_mhz(CLK_FREQ_MHZ);
+    // 200 MHz PFD when the VCO is a multiple of 200 MHz, else 100 MHz
+    localparam int unsigned DIVCLK     = (VCO_MHZ % CLKIN_MHZ == 0) ? 1 : 2;
+    localparam int unsigned FB_MULT    = (VCO_MHZ != 0) ? VCO_MHZ * DIVCLK / CLKIN_MHZ : 5;
+    localparam int unsigned OUT_DIVIDE = (VCO_MHZ != 0) ? VCO_MHZ / CLK_FREQ_MHZ : 20;
+
+    if (VCO_MHZ == 0) begin : g_bad_freq
+        $error("k10_clock_wizard: no PLLE2 setting for CLK_FREQ_MHZ=%0d", CLK_FREQ_MHZ);
+    end
+
     // LVDS input clock buffer
     IBUFGDS #(
         .DIFF_TERM   ("FALSE"),
@@ -21,13 +48,13 @@ module k10_clock_wizard (
         .O (w_ibufg_out)
     );
 
-    // Advanced PLL instance for 50MHz clock derivation
+    // Advanced PLL instance for CLK_FREQ_MHZ clock derivation
     PLLE2_ADV #(
         .BANDWIDTH          ("OPTIMIZED"),
         .COMPENSATION       ("ZHOLD"),
-        .DIVCLK_DIVIDE      (1),
-        .CLKFBOUT_MULT      (5),
-        .CLKOUT0_DIVIDE     (20),
+        .DIVCLK_DIVIDE      (DIVCLK),
+        .CLKFBOUT_MULT      (FB_MULT),
+        .CLKOUT0_DIVIDE     (OUT_DIVIDE),
         .CLKIN1_PERIOD      (5.0)
     ) u_sys_pll (
         .CLKIN1   (w_ibufg_out),
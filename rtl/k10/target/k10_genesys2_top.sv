@@ -9,7 +9,12 @@
 module k10_genesys2_top #(
     parameter int          MEM_SIZE_KB = 64,
     parameter logic [31:0] BOOT_ADDR   = 32'h8000_0000,
-    parameter              MEM_INIT    = ""
+    parameter              MEM_INIT    = "",
+    parameter bit          TRACE_BUF   = 1'b0,
+    parameter bit          FAST_DIV    = 1'b1,    // k10_mul_div early-terminating divide
+    parameter int unsigned MUL_STAGES  = 1,       // k10_mul_div multiply cycles in EX
+    parameter int unsigned CLK_FREQ_MHZ = 50,     // core clock, see k10_clock_wizard
+    parameter int unsigned N_HARTS     = 1        // K10 cores in k10_soc
 )(
     input  logic IO_CLK_P,
     input  logic IO_CLK_N,
@@ -38,7 +43,9 @@ module k10_genesys2_top #(
     logic w_irq_uart_out;
     logic [63:0] w_mtime_out;
 
-    k10_clock_wizard u_clock_generator (
+    k10_clock_wizard #(
+        .CLK_FREQ_MHZ (CLK_FREQ_MHZ)
+    ) u_clock_generator (
         .IO_CLK_P (IO_CLK_P),
         .IO_CLK_N (IO_CLK_N),
         .IO_RST_N (~IO_RST),
@@ -51,7 +58,12 @@ module k10_genesys2_top #(
         .MEM_BASE    (32'h8000_0000),
         .MEM_MASK    (32'hFFFF_0000),
         .MEM_INIT    (MEM_INIT),
-        .BOOT_ADDR   (BOOT_ADDR)
+        .BOOT_ADDR   (BOOT_ADDR),
+        .TRACE_BUF   (TRACE_BUF),
+        .FAST_DIV    (FAST_DIV),
+        .MUL_STAGES  (MUL_STAGES),
+        .CLK_FREQ_HZ (CLK_FREQ_MHZ * 1_000_000),
+        .N_HARTS     (N_HARTS)
     ) u_k10_system (
         .i_clk      (w_core_clk),
         .i_rst_n    (w_core_rst_n),
@@ -0,0 +1,188 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Simulation Console and UART Backdoor  (Verilator testbench only)
+// ============================================================================
+// See k10_console.h.  The DPI entry points at the bottom are imported by
+// k10_sim_ctrl.sv and k10_uart.sv.
+// ============================================================================
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "k10_console.h"
+#include "verilated.h"
+#include "Vk10_tb__Dpi.h"
+
+K10Console::~K10Console()
+{
+    open_log(nullptr);
+    if (m_uart_pty && m_uart_fd >= 0) close(m_uart_fd);
+}
+
+bool K10Console::open_log(const char* path)
+{
+    flush();
+    if (m_log) {
+        std::fclose(m_log);
+        m_log = nullptr;
+    }
+    if (!path || !path[0]) return true;
+    m_log = std::fopen(path, "w");
+    if (!m_log) {
+        std::printf("[K10_TB] ERROR: Cannot write %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+void K10Console::flush()
+{
+    if (m_line.empty()) return;
+    std::fwrite(m_line.data(), 1, m_line.size(), stdout);
+    std::fflush(stdout);
+    if (m_log) {
+        std::fwrite(m_line.data(), 1, m_line.size(), m_log);
+        std::fflush(m_log);
+    }
+    m_line.clear();
+}
+
+// ----------------------------------------------------------------------------
+// UART backdoor
+// ----------------------------------------------------------------------------
+// Opened on the first backdoor access, i.e. only when k10_uart saw
+// +uart_backdoor.
+void K10Console::uart_open()
+{
+    m_uart_open = true;
+    const std::string arg = Verilated::commandArgsPlusMatch("uart_backdoor=");
+    const std::string mode = arg.empty() ? "stdin" : arg.substr(std::strlen("+uart_backdoor="));
+
+    if (mode == "stdin") {
+        m_uart_fd = STDIN_FILENO;
+        std::printf("[K10_TB] UART backdoor: TX to the console, RX from stdin\n");
+        return;
+    }
+    if (mode != "pty") {
+        std::printf("[K10_TB] ERROR: +uart_backdoor=%s (expected stdin or pty)\n", mode.c_str());
+        return;
+    }
+
+    const int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+        std::printf("[K10_TB] ERROR: Cannot open a PTY: %s\n", std::strerror(errno));
+        if (fd >= 0) close(fd);
+        return;
+    }
+    termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    // Nobody may be attached: drop TX bytes rather than block the model.
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    m_uart_fd  = fd;
+    m_uart_pty = true;
+    std::printf("[K10_TB] UART backdoor on %s\n", ptsname(fd));
+    std::fflush(stdout);
+}
+
+void K10Console::uart_tx(uint8_t c)
+{
+    if (!m_uart_open) uart_open();
+    if (!m_uart_pty) {
+        putc(c);
+        return;
+    }
+    if (write(m_uart_fd, &c, 1) < 0) {
+        // EAGAIN (buffer full) or EIO (no terminal attached): byte is lost
+    }
+}
+
+void K10Console::uart_poll()
+{
+    if (m_uart_fd < 0) return;
+    pollfd p = {m_uart_fd, POLLIN, 0};
+    if (poll(&p, 1, 0) <= 0 || !(p.revents & (POLLIN | POLLHUP))) return;
+
+    uint8_t buf[256];
+    const ssize_t n = read(m_uart_fd, buf, sizeof(buf));
+    if (n > 0) {
+        m_rx.insert(m_rx.end(), buf, buf + n);
+    } else if (n == 0 && !m_uart_pty) {
+        m_uart_fd = -1;                 // stdin EOF: stop polling
+    }
+    // A PTY without a terminal attached reads EIO; keep polling for one.
+}
+
+bool K10Console::uart_rx_ready()
+{
+    if (!m_uart_open) uart_open();
+    if (m_rx.empty() && ++m_poll_cnt >= RX_POLL_INTERVAL) {
+        m_poll_cnt = 0;
+        uart_poll();
+    }
+    return !m_rx.empty();
+}
+
+uint8_t K10Console::uart_rx_pop()
+{
+    if (m_rx.empty()) return 0;
+    const uint8_t c = m_rx.front();
+    m_rx.pop_front();
+    return c;
+}
+
+// ----------------------------------------------------------------------------
+// DPI entry points (imported by k10_sim_ctrl.sv and k10_uart.sv)
+// ----------------------------------------------------------------------------
+K10Console& k10_console()
+{
+    static K10Console console;
+    return console;
+}
+
+// SV "byte" arguments arrive signed; they carry raw bit patterns.
+void k10_console_putc(char c)
+{
+    k10_console().putc(static_cast<uint8_t>(c));
+}
+
+void k10_console_flush()
+{
+    k10_console().flush();
+}
+
+void k10_uart_tx(char c)
+{
+    k10_console().uart_tx(static_cast<uint8_t>(c));
+}
+
+svBit k10_uart_rx_ready()
+{
+    return k10_console().uart_rx_ready();
+}
+
+char k10_uart_rx_pop()
+{
+    return static_cast<char>(k10_console().uart_rx_pop());
+}
@@ -0,0 +1,82 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Simulation Console and UART Backdoor  (Verilator testbench only)
+// ============================================================================
+// Console: k10_sim_ctrl hands every CHAR_OUT byte to k10_console_putc()
+// instead of $write.  Bytes collect in a line buffer that is written to
+// stdout (and to the optional log file) once per line, so a printf-heavy
+// test costs one fwrite per line rather than one formatted $write per
+// character.  k10_sim_ctrl flushes the partial line before it prints the
+// PASS/FAIL banner; k10_tb.cpp flushes it before its own end-of-run lines.
+//
+// UART backdoor (+uart_backdoor[=stdin|pty]): k10_uart moves bytes through
+// k10_uart_tx() / k10_uart_rx_*() instead of shifting them on
+// o_uart_tx / i_uart_rx, so a TX byte completes in one cycle and RX bytes
+// appear in RXDATA as soon as the host has them.
+//   stdin  TX goes to the console (stdout and the log), RX reads stdin
+//   pty    TX and RX go through a new pseudo-terminal whose name is
+//          printed at start-up (connect with e.g. "screen /dev/pts/N")
+// The host side is polled every RX_POLL_INTERVAL cycles, not every cycle.
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+
+class K10Console {
+public:
+    static constexpr size_t   LINE_MAX         = 4096;   // flush a line this long
+    static constexpr uint32_t RX_POLL_INTERVAL = 1024;   // cycles between host polls
+
+    K10Console() = default;
+    K10Console(const K10Console&) = delete;
+    K10Console& operator=(const K10Console&) = delete;
+    ~K10Console();
+
+    // Log file for console output; nullptr or "" closes the current one.
+    bool open_log(const char* path);
+
+    void putc(uint8_t c)
+    {
+        m_line.push_back(static_cast<char>(c));
+        if (c == '\n' || m_line.size() >= LINE_MAX) flush();
+    }
+    void flush();
+
+    // UART backdoor
+    void uart_tx(uint8_t c);
+    bool uart_rx_ready();
+    uint8_t uart_rx_pop();
+
+private:
+    void uart_open();
+    void uart_poll();
+
+    std::string         m_line;
+    FILE*               m_log = nullptr;
+
+    bool                m_uart_open = false;
+    int                 m_uart_fd = -1;     // stdin or the PTY master; -1 = EOF
+    bool                m_uart_pty = false;
+    uint32_t            m_poll_cnt = 0;
+    std::deque<uint8_t> m_rx;
+};
+
+K10Console& k10_console();
@@ -0,0 +1,196 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Lockstep Co-simulation Checker  (Verilator testbench only)
+// ============================================================================
+// See k10_cosim.h.  The DPI entry points at the bottom are imported by
+// k10_tracer.sv and k10_tb.sv.
+// ============================================================================
+
+#include <cstdio>
+
+#include "k10_cosim.h"
+#include "Vk10_tb__Dpi.h"
+
+static const char* mode_name(uint8_t flags)
+{
+    return ((flags >> 1) & 3u) == K10Iss::PRIV_M ? "M" : "U";
+}
+
+void K10Cosim::start(uint32_t ram_base, const uint32_t* ram, size_t words)
+{
+    m_iss.reset(ram_base, ram, words);
+    m_armed   = true;
+    m_started = false;
+    m_failed  = false;
+    m_checked = 0;
+    m_synced  = 0;
+    m_stopped.clear();
+    m_pending.clear();
+}
+
+void K10Cosim::stop(const std::string& why)
+{
+    if (!m_armed) return;
+    m_armed   = false;
+    m_stopped = why;
+    std::printf("[K10_COSIM] Checking stopped after %lu retirements: %s\n",
+                m_checked, why.c_str());
+}
+
+void K10Cosim::interrupt(uint32_t cause, uint32_t epc)
+{
+    if (!m_armed) return;
+    if (m_pending.size() >= MAX_PENDING) m_pending.erase(m_pending.begin());
+    m_pending.push_back(PendingIrq{cause, epc});
+}
+
+void K10Cosim::debug_entry()
+{
+    stop("debug mode entered");
+}
+
+void K10Cosim::commit(const K10CosimCommit& dut)
+{
+    if (!m_armed) return;
+    if (!m_started) {
+        m_iss.set_pc(dut.pc);
+        m_started = true;
+    }
+
+    // The DUT left the ISS's path: the only legitimate reason is an
+    // interrupt taken at the instruction the ISS is about to execute.
+    if (dut.pc != m_iss.pc()) {
+        for (size_t i = 0; i < m_pending.size(); ++i) {
+            if (m_pending[i].epc == m_iss.pc()) {
+                m_iss.interrupt(m_pending[i].cause);
+                m_pending.clear();
+                break;
+            }
+        }
+    }
+
+    K10IssRetire iss;
+    const K10Iss::Status st = m_iss.step(iss);
+    if (st != K10Iss::RETIRED) {
+        char why[96];
+        std::snprintf(why, sizeof(why), st == K10Iss::FETCH_OUTSIDE_RAM
+                          ? "ISS pc 0x%08x is outside RAM"
+                          : "ISS trap loop at pc 0x%08x", m_iss.pc());
+        stop(why);
+        return;
+    }
+
+    const bool dut_wr = (dut.flags & 1u) && dut.rd != 0;
+    if (dut.pc != iss.pc) {
+        mismatch("pc", dut, iss);
+    } else if (dut.instr != iss.instr) {
+        mismatch("instruction", dut, iss);
+    } else if (dut_wr != iss.rd_wr || (dut_wr && dut.rd != iss.rd)) {
+        mismatch("destination register", dut, iss);
+    } else if (dut_wr && dut.rd_data != iss.rd_data) {
+        if (!iss.rd_sync) {
+            mismatch("write-back value", dut, iss);
+        } else {
+            m_iss.set_gpr(iss.rd, dut.rd_data);
+            iss.rd_data = dut.rd_data;
+            m_synced++;
+        }
+    }
+    if (m_failed) return;
+
+    m_history[m_checked % HISTORY] = Entry{dut, iss};
+    m_checked++;
+}
+
+void K10Cosim::mismatch(const char* what, const K10CosimCommit& dut, const K10IssRetire& iss)
+{
+    m_failed = true;
+    m_armed  = false;
+
+    auto rd_str = [](char* buf, size_t n, bool wr, unsigned rd, uint32_t v) {
+        if (wr) std::snprintf(buf, n, "x%-2u=0x%08x", rd, v);
+        else    std::snprintf(buf, n, "-");
+    };
+    char a[32], b[32];
+
+    std::printf("[K10_COSIM] MISMATCH (%s) at retirement %lu\n", what, m_checked);
+    rd_str(a, sizeof(a), (dut.flags & 1u) && dut.rd != 0, dut.rd, dut.rd_data);
+    rd_str(b, sizeof(b), iss.rd_wr, iss.rd, iss.rd_data);
+    std::printf("[K10_COSIM]   DUT pc=0x%08x instr=0x%08x %-16s mode=%s\n",
+                dut.pc, dut.instr, a, mode_name(dut.flags));
+    std::printf("[K10_COSIM]   ISS pc=0x%08x instr=0x%08x %-16s traps=%u\n",
+                iss.pc, iss.instr, b, iss.traps);
+
+    const size_t n = m_checked < HISTORY ? m_checked : HISTORY;
+    std::printf("[K10_COSIM] Last %zu matching retirements (oldest first):\n", n);
+    for (size_t k = 0; k < n; ++k) {
+        const uint64_t idx = m_checked - n + k;
+        const Entry& e = m_history[idx % HISTORY];
+        rd_str(a, sizeof(a), e.iss.rd_wr, e.iss.rd, e.iss.rd_data);
+        std::printf("[K10_COSIM]   #%-8lu pc=0x%08x instr=0x%08x %-16s mode=%s%s\n",
+                    idx, e.dut.pc, e.dut.instr, a, mode_name(e.dut.flags),
+                    e.iss.traps ? "  (after trap)" : "");
+    }
+
+    std::printf("[K10_COSIM] ISS state: priv=%s mstatus=0x%08x mepc=0x%08x "
+                "mcause=0x%08x mtval=0x%08x\n",
+                m_iss.priv() == K10Iss::PRIV_M ? "M" : "U", m_iss.mstatus(),
+                m_iss.mepc(), m_iss.mcause(), m_iss.mtval());
+    for (unsigned r = 0; r < 32; r += 4) {
+        std::printf("[K10_COSIM]   x%-2u=0x%08x x%-2u=0x%08x x%-2u=0x%08x x%-2u=0x%08x\n",
+                    r, m_iss.gpr(r), r + 1, m_iss.gpr(r + 1),
+                    r + 2, m_iss.gpr(r + 2), r + 3, m_iss.gpr(r + 3));
+    }
+}
+
+void K10Cosim::report() const
+{
+    if (!m_started && !m_failed) return;
+    std::printf("[K10_COSIM] %s: %lu retirements checked, %lu values taken from the DUT%s%s\n",
+                m_failed ? "FAIL" : "PASS", m_checked, m_synced,
+                m_stopped.empty() ? "" : ", stopped: ", m_stopped.c_str());
+}
+
+// ----------------------------------------------------------------------------
+// DPI entry points (imported by k10_tracer.sv / k10_tb.sv under +cosim)
+// ----------------------------------------------------------------------------
+K10Cosim& k10_cosim()
+{
+    static K10Cosim cosim;
+    return cosim;
+}
+
+// SV "int"/"byte" arguments arrive signed; they carry raw bit patterns.
+void k10_cosim_commit(int pc, int instr, char rd, int rd_data, char flags)
+{
+    K10CosimCommit c;
+    c.pc      = static_cast<uint32_t>(pc);
+    c.instr   = static_cast<uint32_t>(instr);
+    c.rd_data = static_cast<uint32_t>(rd_data);
+    c.rd      = static_cast<uint8_t>(rd);
+    c.flags   = static_cast<uint8_t>(flags);
+    k10_cosim().commit(c);
+}
+
+void k10_cosim_interrupt(int cause, int epc)
+{
+    k10_cosim().interrupt(static_cast<uint32_t>(cause), static_cast<uint32_t>(epc));
+}
+
+void k10_cosim_debug_entry()
+{
+    k10_cosim().debug_entry();
+}
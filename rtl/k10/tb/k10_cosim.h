@@ -0,0 +1,101 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Lockstep Co-simulation Checker  (Verilator testbench only)
+// ============================================================================
+// Under +cosim, k10_tracer reports every WB-stage retirement over DPI
+// (k10_cosim_commit) and k10_tb.sv reports interrupt and debug-mode entry.
+// Each retirement steps the built-in ISS (k10_iss.h) by one instruction and
+// compares:
+//   - pc
+//   - instruction encoding (the expansion, for compressed instructions)
+//   - GPR write: whether one happens, rd, and the value written
+// The first difference is reported with the last HISTORY retirements and
+// the ISS register state; k10_tb.cpp then ends the run as a failure.
+//
+// Synchronisation with the DUT:
+//   - the ISS takes its pc from the first retirement after start()
+//   - RAM is copied from the BRAM by start(), before reset is released
+//   - values the ISS cannot predict (MMIO loads, counter / mip / debug
+//     CSR reads) are taken from the DUT's write-back
+//   - an interrupt is queued with its EPC and taken once the DUT's pc
+//     leaves the ISS's path with the ISS at that EPC (older instructions
+//     may still retire after the CSR file has taken the trap)
+//   - debug-mode entry, or the ISS leaving RAM, stops checking (not a
+//     failure); the summary line says why
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "k10_iss.h"
+
+// One DUT retirement; flags as in K10TraceRecord: [0] rd written, [2:1] mode
+struct K10CosimCommit {
+    uint32_t pc      = 0;
+    uint32_t instr   = 0;
+    uint32_t rd_data = 0;
+    uint8_t  rd      = 0;
+    uint8_t  flags   = 0;
+};
+
+class K10Cosim {
+public:
+    static constexpr size_t HISTORY     = 16;
+    static constexpr size_t MAX_PENDING = 8;
+
+    // Arm the checker against a fresh copy of the BRAM image.
+    void start(uint32_t ram_base, const uint32_t* ram, size_t words);
+
+    void commit(const K10CosimCommit& dut);
+    void interrupt(uint32_t cause, uint32_t epc);
+    void debug_entry();
+
+    bool     armed() const { return m_armed; }
+    bool     failed() const { return m_failed; }
+    uint64_t checked() const { return m_checked; }
+    void     report() const;
+
+private:
+    struct Entry {
+        K10CosimCommit dut;
+        K10IssRetire   iss;
+    };
+    struct PendingIrq {
+        uint32_t cause;
+        uint32_t epc;
+    };
+
+    void stop(const std::string& why);
+    void mismatch(const char* what, const K10CosimCommit& dut, const K10IssRetire& iss);
+
+    K10Iss     m_iss;
+    bool       m_armed   = false;   // between start() and a stop / mismatch
+    bool       m_started = false;   // first retirement seen
+    bool       m_failed  = false;
+    uint64_t   m_checked = 0;
+    uint64_t   m_synced  = 0;
+    std::string m_stopped;          // why checking ended early, if it did
+
+    std::vector<PendingIrq> m_pending;
+    Entry      m_history[HISTORY];  // ring, indexed by m_checked % HISTORY
+};
+
+// The instance behind the DPI entry points
+K10Cosim& k10_cosim();
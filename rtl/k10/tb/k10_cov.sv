@@ -0,0 +1,454 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Functional Coverage Points (sim_cov target)
+// ============================================================================
+// Instantiated by k10_tb under `K10_COVERAGE on hart 0.  Every bin is one
+// cover property, which Verilator --coverage-user turns into a plain
+// counter in coverage.dat next to the line coverage of the RTL: no
+// covergroup sampling, and per-run files that verilator_coverage merges
+// and scripts/k10_cov_minimize.py ranks seeds by.
+//
+// Groups (the generate block names the bin, its index the value):
+//   gen_instr[c]   retired instructions by class (instr_class_e), RVC
+//                  encodings separately from the 32-bit ones
+//   gen_csr[c]     retired CSR reads / writes by CSR (csr_class_e)
+//   gen_exc[i]     exceptions taken, by cause (EXC_CODES) and mode
+//   gen_irq[i]     interrupts taken: MSI, MTI, MEI, fast 0..14
+//   cov_mret, cov_dret, cov_debug    trap returns and debug entry
+//   gen_pmp[r]     data-bus accesses matching PMP region r, by mode
+//   cov_pmp_deny_* data-bus accesses refused by the PMP
+//   gen_hpm[e]     HPM events (hpm_event_e: load-use, flushes, waits, ...)
+//   cov_fwd_*, cov_stall_*, ...      forwarding paths and pipeline stalls
+//
+// ecall / ebreak / illegal instructions trap in EX and never retire; they
+// are covered through gen_exc instead of gen_instr.
+// ============================================================================
+
+module k10_cov
+  import komandara_k10_pkg::*;
+#(
+    parameter int unsigned PMP_REGIONS = 16
+)(
+    input  logic        i_clk,
+    input  logic        i_rst_n,
+
+    // WB retire (k10_core r_mem_wb)
+    input  logic        i_retire,
+    input  logic [31:0] i_retire_instr,
+    input  ctrl_t       i_retire_ctrl,
+
+    // Traps (EX)
+    input  logic        i_trap_taken,
+    input  logic        i_exc_valid,
+    input  logic [31:0] i_exc_cause,
+    input  logic [31:0] i_irq_cause,
+    input  priv_lvl_e   i_priv,
+    input  logic        i_mret_taken,
+    input  logic        i_dret_taken,
+    input  logic        i_debug_taken,
+
+    // Data-bus PMP check (MEM)
+    input  logic                   i_dbus_access,
+    input  logic                   i_dbus_write,
+    input  logic [PMP_REGIONS-1:0] i_pmp_match,
+    input  logic                   i_pmp_allowed,
+
+    // Hazards
+    input  logic                      i_id_ex_valid,
+    input  fwd_sel_e                  i_fwd_a,
+    input  fwd_sel_e                  i_fwd_b,
+    input  logic [HPM_NUM_EVENTS-1:0] i_hpm_event,
+    input  logic                      i_stall_ex,
+    input  logic                      i_stall_mem,
+    input  logic                      i_wfi_stall,
+    input  logic                      i_fence_i_wait
+);
+
+    // -------------------------------------------------------------------------
+    // Retired instruction classes
+    // -------------------------------------------------------------------------
+    typedef enum int unsigned {
+        IC_OTHER,
+        // RV32I
+        IC_LUI, IC_AUIPC, IC_JAL, IC_JALR,
+        IC_BEQ, IC_BNE, IC_BLT, IC_BGE, IC_BLTU, IC_BGEU,
+        IC_LB, IC_LH, IC_LW, IC_LBU, IC_LHU, IC_SB, IC_SH, IC_SW,
+        IC_ADDI, IC_SLTI, IC_SLTIU, IC_XORI, IC_ORI, IC_ANDI,
+        IC_SLLI, IC_SRLI, IC_SRAI,
+        IC_ADD, IC_SUB, IC_SLL, IC_SLT, IC_SLTU, IC_XOR, IC_SRL, IC_SRA,
+        IC_OR, IC_AND,
+        IC_FENCE, IC_FENCE_I, IC_MRET, IC_DRET, IC_WFI,
+        // Zicsr
+        IC_CSRRW, IC_CSRRS, IC_CSRRC, IC_CSRRWI, IC_CSRRSI, IC_CSRRCI,
+        // M
+        IC_MUL, IC_MULH, IC_MULHSU, IC_MULHU, IC_DIV, IC_DIVU, IC_REM, IC_REMU,
+        // A
+        IC_LR, IC_SC, IC_AMOSWAP, IC_AMOADD, IC_AMOXOR, IC_AMOAND, IC_AMOOR,
+        IC_AMOMIN, IC_AMOMAX, IC_AMOMINU, IC_AMOMAXU,
+        // C
+        IC_C_ADDI4SPN, IC_C_LW, IC_C_SW,
+        IC_C_ADDI, IC_C_JAL, IC_C_LI, IC_C_ADDI16SP, IC_C_LUI,
+        IC_C_SRLI, IC_C_SRAI, IC_C_ANDI, IC_C_SUB, IC_C_XOR, IC_C_OR, IC_C_AND,
+        IC_C_J, IC_C_BEQZ, IC_C_BNEZ,
+        IC_C_SLLI, IC_C_LWSP, IC_C_JR, IC_C_MV, IC_C_JALR, IC_C_ADD, IC_C_SWSP,
+        IC_COUNT
+    } instr_class_e;
+
+    function automatic instr_class_e f_rvc_class(input logic [15:0] c);
+        instr_class_e ic;
+        ic = IC_OTHER;
+        unique case ({c[1:0], c[15:13]})
+            5'b00_000: ic = IC_C_ADDI4SPN;
+            5'b00_010: ic = IC_C_LW;
+            5'b00_110: ic = IC_C_SW;
+            5'b01_000: ic = IC_C_ADDI;
+            5'b01_001: ic = IC_C_JAL;
+            5'b01_010: ic = IC_C_LI;
+            5'b01_011: ic = (c[11:7] == 5'd2) ? IC_C_ADDI16SP : IC_C_LUI;
+            5'b01_100: begin
+                unique case (c[11:10])
+                    2'b00: ic = IC_C_SRLI;
+                    2'b01: ic = IC_C_SRAI;
+                    2'b10: ic = IC_C_ANDI;
+                    default: begin
+                        unique case (c[6:5])
+                            2'b00: ic = IC_C_SUB;
+                            2'b01: ic = IC_C_XOR;
+                            2'b10: ic = IC_C_OR;
+                            default: ic = IC_C_AND;
+                        endcase
+                    end
+                endcase
+            end
+            5'b01_101: ic = IC_C_J;
+            5'b01_110: ic = IC_C_BEQZ;
+            5'b01_111: ic = IC_C_BNEZ;
+            5'b10_000: ic = IC_C_SLLI;
+            5'b10_010: ic = IC_C_LWSP;
+            5'b10_100: begin
+                if (!c[12])                ic = (c[6:2] == 5'd0) ? IC_C_JR : IC_C_MV;
+                else if (c[6:2] != 5'd0)   ic = IC_C_ADD;
+                else if (c[11:7] != 5'd0)  ic = IC_C_JALR;       // else c.ebreak
+            end
+            5'b10_110: ic = IC_C_SWSP;
+            default: ic = IC_OTHER;
+        endcase
+        return ic;
+    endfunction
+
+    function automatic instr_class_e f_instr_class(input logic [31:0] instr);
+        instr_class_e ic;
+        logic [2:0]   f3;
+        f3 = instr[14:12];
+        ic = IC_OTHER;
+        unique case (instr[6:0])
+            7'b0110111: ic = IC_LUI;
+            7'b0010111: ic = IC_AUIPC;
+            7'b1101111: ic = IC_JAL;
+            7'b1100111: ic = IC_JALR;
+            7'b1100011: begin
+                unique case (f3)
+                    3'd0: ic = IC_BEQ;
+                    3'd1: ic = IC_BNE;
+                    3'd4: ic = IC_BLT;
+                    3'd5: ic = IC_BGE;
+                    3'd6: ic = IC_BLTU;
+                    3'd7: ic = IC_BGEU;
+                    default: ic = IC_OTHER;
+                endcase
+            end
+            7'b0000011: begin
+                unique case (f3)
+                    3'd0: ic = IC_LB;
+                    3'd1: ic = IC_LH;
+                    3'd2: ic = IC_LW;
+                    3'd4: ic = IC_LBU;
+                    3'd5: ic = IC_LHU;
+                    default: ic = IC_OTHER;
+                endcase
+            end
+            7'b0100011: begin
+                unique case (f3)
+                    3'd0: ic = IC_SB;
+                    3'd1: ic = IC_SH;
+                    3'd2: ic = IC_SW;
+                    default: ic = IC_OTHER;
+                endcase
+            end
+            7'b0010011: begin
+                unique case (f3)
+                    3'd0: ic = IC_ADDI;
+                    3'd1: ic = IC_SLLI;
+                    3'd2: ic = IC_SLTI;
+                    3'd3: ic = IC_SLTIU;
+                    3'd4: ic = IC_XORI;
+                    3'd5: ic = instr[30] ? IC_SRAI : IC_SRLI;
+                    3'd6: ic = IC_ORI;
+                    default: ic = IC_ANDI;
+                endcase
+            end
+            7'b0110011: begin
+                if (instr[31:25] == 7'b0000001) begin
+                    unique case (f3)
+                        3'd0: ic = IC_MUL;
+                        3'd1: ic = IC_MULH;
+                        3'd2: ic = IC_MULHSU;
+                        3'd3: ic = IC_MULHU;
+                        3'd4: ic = IC_DIV;
+                        3'd5: ic = IC_DIVU;
+                        3'd6: ic = IC_REM;
+                        default: ic = IC_REMU;
+                    endcase
+                end else begin
+                    unique case (f3)
+                        3'd0: ic = instr[30] ? IC_SUB : IC_ADD;
+                        3'd1: ic = IC_SLL;
+                        3'd2: ic = IC_SLT;
+                        3'd3: ic = IC_SLTU;
+                        3'd4: ic = IC_XOR;
+                        3'd5: ic = instr[30] ? IC_SRA : IC_SRL;
+                        3'd6: ic = IC_OR;
+                        default: ic = IC_AND;
+                    endcase
+                end
+            end
+            7'b0001111: ic = (f3 == 3'd1) ? IC_FENCE_I : IC_FENCE;
+            7'b1110011: begin
+                unique case (f3)
+                    3'd0: begin
+                        if (instr == 32'h3020_0073)      ic = IC_MRET;
+                        else if (instr == 32'h7B20_0073) ic = IC_DRET;
+                        else if (instr == 32'h1050_0073) ic = IC_WFI;
+                    end
+                    3'd1: ic = IC_CSRRW;
+                    3'd2: ic = IC_CSRRS;
+                    3'd3: ic = IC_CSRRC;
+                    3'd5: ic = IC_CSRRWI;
+                    3'd6: ic = IC_CSRRSI;
+                    3'd7: ic = IC_CSRRCI;
+                    default: ic = IC_OTHER;
+                endcase
+            end
+            7'b0101111: begin
+                unique case (instr[31:27])
+                    5'b00010: ic = IC_LR;
+                    5'b00011: ic = IC_SC;
+                    5'b00001: ic = IC_AMOSWAP;
+                    5'b00000: ic = IC_AMOADD;
+                    5'b00100: ic = IC_AMOXOR;
+                    5'b01100: ic = IC_AMOAND;
+                    5'b01000: ic = IC_AMOOR;
+                    5'b10000: ic = IC_AMOMIN;
+                    5'b10100: ic = IC_AMOMAX;
+                    5'b11000: ic = IC_AMOMINU;
+                    5'b11100: ic = IC_AMOMAXU;
+                    default:  ic = IC_OTHER;
+                endcase
+            end
+            default: ic = IC_OTHER;
+        endcase
+        return ic;
+    endfunction
+
+    instr_class_e w_instr_class;
+    assign w_instr_class = i_retire_ctrl.is_compressed ? f_rvc_class(i_retire_instr[15:0])
+                                                       : f_instr_class(i_retire_instr);
+
+    for (genvar c = 1; c < IC_COUNT; c++) begin : gen_instr
+        cov_instr : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            i_retire && (w_instr_class == instr_class_e'(c)));
+    end
+
+    // -------------------------------------------------------------------------
+    // CSR accesses (retired; a faulting access traps in EX)
+    // -------------------------------------------------------------------------
+    // The HPM counters and events, pmpcfg and pmpaddr are one bin each.
+    // -------------------------------------------------------------------------
+    typedef enum int unsigned {
+        CC_OTHER,
+        CC_MSTATUS, CC_MISA, CC_MIE, CC_MTVEC, CC_MCOUNTEREN,
+        CC_MCOUNTINHIBIT, CC_MHPMEVENT,
+        CC_MSCRATCH, CC_MEPC, CC_MCAUSE, CC_MTVAL, CC_MIP,
+        CC_PMPCFG, CC_PMPADDR,
+        CC_TSELECT, CC_TDATA1, CC_TDATA2, CC_TINFO,
+        CC_DCSR, CC_DPC, CC_DSCRATCH,
+        CC_MCYCLE, CC_MINSTRET, CC_MHPMCOUNTER,
+        CC_MCYCLEH, CC_MINSTRETH, CC_MHPMCOUNTERH,
+        CC_CYCLE, CC_TIME, CC_INSTRET, CC_HPMCOUNTER,
+        CC_CYCLEH, CC_TIMEH, CC_INSTRETH, CC_HPMCOUNTERH,
+        CC_MVENDORID, CC_MARCHID, CC_MIMPID, CC_MHARTID,
+        CC_COUNT
+    } csr_class_e;
+
+    function automatic csr_class_e f_csr_class(input logic [11:0] a);
+        csr_class_e cc;
+        unique case (a)
+            CSR_MSTATUS:       cc = CC_MSTATUS;
+            CSR_MISA:          cc = CC_MISA;
+            CSR_MIE:           cc = CC_MIE;
+            CSR_MTVEC:         cc = CC_MTVEC;
+            CSR_MCOUNTEREN:    cc = CC_MCOUNTEREN;
+            CSR_MCOUNTINHIBIT: cc = CC_MCOUNTINHIBIT;
+            CSR_MSCRATCH:      cc = CC_MSCRATCH;
+            CSR_MEPC:          cc = CC_MEPC;
+            CSR_MCAUSE:        cc = CC_MCAUSE;
+            CSR_MTVAL:         cc = CC_MTVAL;
+            CSR_MIP:           cc = CC_MIP;
+            CSR_TSELECT:       cc = CC_TSELECT;
+            CSR_TDATA1:        cc = CC_TDATA1;
+            CSR_TDATA2:        cc = CC_TDATA2;
+            CSR_TINFO:         cc = CC_TINFO;
+            CSR_DCSR:          cc = CC_DCSR;
+            CSR_DPC:           cc = CC_DPC;
+            CSR_DSCRATCH0,
+            CSR_DSCRATCH1:     cc = CC_DSCRATCH;
+            CSR_MCYCLE:        cc = CC_MCYCLE;
+            CSR_MINSTRET:      cc = CC_MINSTRET;
+            CSR_MCYCLEH:       cc = CC_MCYCLEH;
+            CSR_MINSTRETH:     cc = CC_MINSTRETH;
+            CSR_CYCLE:         cc = CC_CYCLE;
+            CSR_TIME:          cc = CC_TIME;
+            CSR_INSTRET:       cc = CC_INSTRET;
+            CSR_CYCLEH:        cc = CC_CYCLEH;
+            CSR_TIMEH:         cc = CC_TIMEH;
+            CSR_INSTRETH:      cc = CC_INSTRETH;
+            CSR_MVENDORID:     cc = CC_MVENDORID;
+            CSR_MARCHID:       cc = CC_MARCHID;
+            CSR_MIMPID:        cc = CC_MIMPID;
+            CSR_MHARTID:       cc = CC_MHARTID;
+            default: begin
+                // Counter / event N = base + N, N = 3..31
+                if (a[11:2] == CSR_PMPCFG0[11:2])                    cc = CC_PMPCFG;
+                else if (a[11:4] == CSR_PMPADDR0[11:4])              cc = CC_PMPADDR;
+                else if (a[4:0] < 5'd3)                              cc = CC_OTHER;
+                else if (a[11:5] == CSR_MHPMEVENT_BASE[11:5])        cc = CC_MHPMEVENT;
+                else if (a[11:5] == CSR_MHPMCOUNTER_BASE[11:5])      cc = CC_MHPMCOUNTER;
+                else if (a[11:5] == CSR_MHPMCOUNTERH_BASE[11:5])     cc = CC_MHPMCOUNTERH;
+                else if (a[11:5] == CSR_HPMCOUNTER_BASE[11:5])       cc = CC_HPMCOUNTER;
+                else if (a[11:5] == CSR_HPMCOUNTERH_BASE[11:5])      cc = CC_HPMCOUNTERH;
+                else                                                 cc = CC_OTHER;
+            end
+        endcase
+        return cc;
+    endfunction
+
+    logic       w_csr_retire;
+    logic       w_csr_read;
+    logic       w_csr_write;
+    csr_class_e w_csr_class;
+
+    // csrrw with rd = x0 does not read; csrrs / csrrc with rs1 = x0 (or a
+    // zero zimm) do not write.
+    assign w_csr_retire = i_retire && i_retire_ctrl.csr_en;
+    assign w_csr_read   = (i_retire_ctrl.csr_op != CSR_RW) || (i_retire_instr[11:7] != 5'd0);
+    assign w_csr_write  = (i_retire_ctrl.csr_op == CSR_RW) || (i_retire_instr[19:15] != 5'd0);
+    assign w_csr_class  = f_csr_class(i_retire_instr[31:20]);
+
+    for (genvar c = 1; c < CC_COUNT; c++) begin : gen_csr
+        cov_csr_rd : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            w_csr_retire && w_csr_read && (w_csr_class == csr_class_e'(c)));
+        cov_csr_wr : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            w_csr_retire && w_csr_write && (w_csr_class == csr_class_e'(c)));
+    end
+
+    // -------------------------------------------------------------------------
+    // Traps
+    // -------------------------------------------------------------------------
+    localparam int unsigned NUM_EXC = 10;
+    localparam logic [31:0] EXC_CODES [NUM_EXC] = '{
+        EXC_INSTR_MISALIGN, EXC_INSTR_FAULT, EXC_ILLEGAL_INSTR, EXC_BREAKPOINT,
+        EXC_LOAD_MISALIGN, EXC_LOAD_FAULT, EXC_STORE_MISALIGN, EXC_STORE_FAULT,
+        EXC_ECALL_U, EXC_ECALL_M
+    };
+    localparam int unsigned NUM_IRQ = 3 + NUM_FAST_IRQ;
+
+    function automatic logic [31:0] f_irq_cause(input int unsigned i);
+        unique case (i)
+            0:       return INT_M_SW;
+            1:       return INT_M_TIMER;
+            2:       return INT_M_EXT;
+            default: return INT_FAST_0 + 32'(i - 3);
+        endcase
+    endfunction
+
+    logic w_exc_taken;
+    logic w_irq_taken;
+    assign w_exc_taken = i_trap_taken && i_exc_valid;
+    assign w_irq_taken = i_trap_taken && !i_exc_valid;
+
+    for (genvar i = 0; i < NUM_EXC; i++) begin : gen_exc
+        cov_exc_m : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            w_exc_taken && (i_exc_cause == EXC_CODES[i]) && (i_priv == PRIV_M));
+        cov_exc_u : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            w_exc_taken && (i_exc_cause == EXC_CODES[i]) && (i_priv == PRIV_U));
+    end
+
+    for (genvar i = 0; i < NUM_IRQ; i++) begin : gen_irq
+        cov_irq : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            w_irq_taken && (i_irq_cause == f_irq_cause(i)));
+    end
+
+    cov_mret  : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_mret_taken);
+    cov_dret  : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_dret_taken);
+    cov_debug : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_debug_taken);
+
+    // -------------------------------------------------------------------------
+    // Data-bus PMP (counted per cycle the access waits in MEM)
+    // -------------------------------------------------------------------------
+    for (genvar r = 0; r < PMP_REGIONS; r++) begin : gen_pmp
+        cov_pmp_m : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            i_dbus_access && i_pmp_match[r] && (i_priv == PRIV_M));
+        cov_pmp_u : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+            i_dbus_access && i_pmp_match[r] && (i_priv == PRIV_U));
+    end
+
+    cov_pmp_deny_m_rd : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_dbus_access && !i_pmp_allowed && (i_priv == PRIV_M) && !i_dbus_write);
+    cov_pmp_deny_m_wr : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_dbus_access && !i_pmp_allowed && (i_priv == PRIV_M) && i_dbus_write);
+    cov_pmp_deny_u_rd : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_dbus_access && !i_pmp_allowed && (i_priv == PRIV_U) && !i_dbus_write);
+    cov_pmp_deny_u_wr : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_dbus_access && !i_pmp_allowed && (i_priv == PRIV_U) && i_dbus_write);
+    cov_pmp_nomatch_u : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_dbus_access && (i_pmp_match == '0) && (i_priv == PRIV_U));
+
+    // -------------------------------------------------------------------------
+    // Hazards
+    // -------------------------------------------------------------------------
+    for (genvar e = 1; e < HPM_NUM_EVENTS; e++) begin : gen_hpm
+        cov_hpm : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_hpm_event[e]);
+    end
+
+    cov_fwd_a_mem : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_id_ex_valid && (i_fwd_a == FWD_MEM));
+    cov_fwd_a_wb  : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_id_ex_valid && (i_fwd_a == FWD_WB));
+    cov_fwd_b_mem : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_id_ex_valid && (i_fwd_b == FWD_MEM));
+    cov_fwd_b_wb  : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_id_ex_valid && (i_fwd_b == FWD_WB));
+    cov_fwd_ab    : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_id_ex_valid && (i_fwd_a != FWD_NONE) && (i_fwd_b != FWD_NONE));
+
+    cov_stall_ex   : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_stall_ex);
+    cov_stall_mem  : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_stall_mem);
+    cov_stall_both : cover property (@(posedge i_clk) disable iff (!i_rst_n)
+        i_stall_ex && i_stall_mem);
+    cov_wfi        : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_wfi_stall);
+    cov_fence_i    : cover property (@(posedge i_clk) disable iff (!i_rst_n) i_fence_i_wait);
+
+endmodule : k10_cov
@@ -0,0 +1,180 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — ELF32 Image Reader  (Verilator testbench only)
+// ============================================================================
+// See k10_elf.h.
+// ============================================================================
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <elf.h>
+
+#include "k10_elf.h"
+
+#ifndef EM_RISCV
+#define EM_RISCV 243
+#endif
+
+bool K10Elf::is_elf(const std::string& path)
+{
+    FILE* fp = std::fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    unsigned char magic[SELFMAG];
+    const bool elf = std::fread(magic, 1, SELFMAG, fp) == SELFMAG &&
+                     std::memcmp(magic, ELFMAG, SELFMAG) == 0;
+    std::fclose(fp);
+    return elf;
+}
+
+bool K10Elf::fail(const std::string& msg)
+{
+    m_error = msg;
+    return false;
+}
+
+bool K10Elf::load(const std::string& path)
+{
+    m_entry = 0;
+    m_segments.clear();
+    m_symbols.clear();
+    m_functions.clear();
+    m_error.clear();
+
+    std::vector<uint8_t> file;
+    {
+        FILE* fp = std::fopen(path.c_str(), "rb");
+        if (!fp) return fail("cannot open");
+        std::fseek(fp, 0, SEEK_END);
+        const long size = std::ftell(fp);
+        std::fseek(fp, 0, SEEK_SET);
+        file.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        const size_t got = std::fread(file.data(), 1, file.size(), fp);
+        std::fclose(fp);
+        if (got != file.size()) return fail("short read");
+    }
+
+    // All offsets come from the file: check every table against its size.
+    auto in_file = [&](uint64_t off, uint64_t len) { return off + len <= file.size(); };
+
+    if (!in_file(0, sizeof(Elf32_Ehdr))) return fail("too short for an ELF header");
+    Elf32_Ehdr eh;
+    std::memcpy(&eh, file.data(), sizeof(eh));
+    if (std::memcmp(eh.e_ident, ELFMAG, SELFMAG) != 0) return fail("not an ELF file");
+    if (eh.e_ident[EI_CLASS] != ELFCLASS32)  return fail("not ELF32");
+    if (eh.e_ident[EI_DATA] != ELFDATA2LSB)  return fail("not little-endian");
+    if (eh.e_machine != EM_RISCV)            return fail("not a RISC-V image");
+    if (eh.e_type != ET_EXEC)                return fail("not an executable (ET_EXEC)");
+    m_entry = eh.e_entry;
+
+    // ---- Program headers: loadable segments ----
+    std::vector<std::pair<uint32_t, uint32_t>> text;     // executable [lo, hi)
+    if (eh.e_phentsize != sizeof(Elf32_Phdr) ||
+        !in_file(eh.e_phoff, uint64_t(eh.e_phnum) * sizeof(Elf32_Phdr))) {
+        return fail("bad program header table");
+    }
+    for (unsigned i = 0; i < eh.e_phnum; ++i) {
+        Elf32_Phdr ph;
+        std::memcpy(&ph, file.data() + eh.e_phoff + i * sizeof(ph), sizeof(ph));
+        if (ph.p_type != PT_LOAD || ph.p_memsz == 0) continue;
+        if (ph.p_filesz > ph.p_memsz || !in_file(ph.p_offset, ph.p_filesz)) {
+            return fail("segment " + std::to_string(i) + " outside the file");
+        }
+        K10ElfSegment seg;
+        seg.addr = ph.p_paddr;
+        seg.data.assign(ph.p_memsz, 0);
+        std::memcpy(seg.data.data(), file.data() + ph.p_offset, ph.p_filesz);
+        m_segments.push_back(std::move(seg));
+        if (ph.p_flags & PF_X) text.emplace_back(ph.p_vaddr, ph.p_vaddr + ph.p_memsz);
+    }
+    auto in_text = [&](uint32_t addr) {
+        for (const auto& r : text) {
+            if (addr >= r.first && addr < r.second) return true;
+        }
+        return false;
+    };
+    if (m_segments.empty()) return fail("no loadable segments");
+
+    // ---- Section headers: symbol table (optional) ----
+    if (eh.e_shoff == 0 || eh.e_shnum == 0) return true;
+    if (eh.e_shentsize != sizeof(Elf32_Shdr) ||
+        !in_file(eh.e_shoff, uint64_t(eh.e_shnum) * sizeof(Elf32_Shdr))) {
+        return fail("bad section header table");
+    }
+    auto section = [&](unsigned idx) {
+        Elf32_Shdr sh;
+        std::memcpy(&sh, file.data() + eh.e_shoff + idx * sizeof(sh), sizeof(sh));
+        return sh;
+    };
+    for (unsigned i = 0; i < eh.e_shnum; ++i) {
+        const Elf32_Shdr sh = section(i);
+        if (sh.sh_type != SHT_SYMTAB || sh.sh_link >= eh.e_shnum) continue;
+        const Elf32_Shdr strtab = section(sh.sh_link);
+        if (!in_file(sh.sh_offset, sh.sh_size) || !in_file(strtab.sh_offset, strtab.sh_size)) {
+            return fail("bad symbol table");
+        }
+        const char* names = reinterpret_cast<const char*>(file.data() + strtab.sh_offset);
+        for (uint32_t off = 0; off + sizeof(Elf32_Sym) <= sh.sh_size; off += sizeof(Elf32_Sym)) {
+            Elf32_Sym sym;
+            std::memcpy(&sym, file.data() + sh.sh_offset + off, sizeof(sym));
+            if (sym.st_name == 0 || sym.st_name >= strtab.sh_size) continue;
+            if (sym.st_shndx == SHN_UNDEF) continue;
+            const int type = ELF32_ST_TYPE(sym.st_info);
+            if (type == STT_SECTION || type == STT_FILE) continue;
+            const char* name = names + sym.st_name;
+            if (!std::memchr(name, '\0', strtab.sh_size - sym.st_name)) continue;
+            const bool local = ELF32_ST_BIND(sym.st_info) == STB_LOCAL;
+            // Local loop labels in assembly would split every function.
+            if (type == STT_FUNC || (type == STT_NOTYPE && !local && in_text(sym.st_value))) {
+                m_functions.push_back({name, sym.st_value, sym.st_size});
+            }
+            // A global definition wins over a local of the same name.
+            if (local && m_symbols.count(name)) continue;
+            m_symbols[name] = sym.st_value;
+        }
+    }
+
+    // One entry per address; prefer the symbol that carries a size.
+    std::sort(m_functions.begin(), m_functions.end(),
+              [](const K10ElfFunction& a, const K10ElfFunction& b) {
+                  return a.addr != b.addr ? a.addr < b.addr : a.size > b.size;
+              });
+    m_functions.erase(std::unique(m_functions.begin(), m_functions.end(),
+                                  [](const K10ElfFunction& a, const K10ElfFunction& b) {
+                                      return a.addr == b.addr;
+                                  }),
+                      m_functions.end());
+    return true;
+}
+
+bool K10Elf::symbol(const std::string& name, uint32_t& addr) const
+{
+    const auto it = m_symbols.find(name);
+    if (it == m_symbols.end()) return false;
+    addr = it->second;
+    return true;
+}
+
+const K10ElfFunction* K10Elf::function_at(uint32_t pc) const
+{
+    auto it = std::upper_bound(m_functions.begin(), m_functions.end(), pc,
+                               [](uint32_t a, const K10ElfFunction& f) { return a < f.addr; });
+    if (it == m_functions.begin()) return nullptr;
+    --it;
+    if (it->size != 0 && pc - it->addr >= it->size) return nullptr;
+    return &*it;
+}
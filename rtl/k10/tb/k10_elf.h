@@ -0,0 +1,77 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — ELF32 Image Reader  (Verilator testbench only)
+// ============================================================================
+// Reads a little-endian RV32 executable the way a loader would: the
+// PT_LOAD program headers give the bytes to place at their physical
+// address (p_filesz bytes from the file, zero up to p_memsz), e_entry the
+// first PC, and .symtab the addresses of named symbols (tohost, result
+// buffers, ...).  Function symbols, and global labels in executable
+// segments, also form an address-ordered table for symbolising PCs
+// (k10_profile.cpp).  Section contents other than the symbol table are
+// not looked at, so stripped images load as well; they only lose the
+// symbols.
+//
+// k10_tb.cpp copies the segments straight into the BRAM backdoor, which
+// replaces the objcopy / verilog_byte2word.py / $readmemh chain.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct K10ElfFunction {
+    std::string name;
+    uint32_t    addr;
+    uint32_t    size;       // 0 = unknown: runs up to the next function
+};
+
+struct K10ElfSegment {
+    uint32_t             addr;      // physical (load) address
+    std::vector<uint8_t> data;      // p_memsz bytes, zero-filled past p_filesz
+};
+
+class K10Elf {
+public:
+    // False (with the reason in error()) if the file is not an RV32
+    // little-endian executable or a header points outside the file.
+    bool load(const std::string& path);
+
+    uint32_t entry() const { return m_entry; }
+    const std::vector<K10ElfSegment>& segments() const { return m_segments; }
+    size_t symbol_count() const { return m_symbols.size(); }
+    bool symbol(const std::string& name, uint32_t& addr) const;
+
+    // Function containing pc, or nullptr.
+    const K10ElfFunction* function_at(uint32_t pc) const;
+
+    const std::string& error() const { return m_error; }
+
+    // Cheap check for the ELF magic, so loaders can accept either format.
+    static bool is_elf(const std::string& path);
+
+private:
+    bool fail(const std::string& msg);
+
+    uint32_t                                  m_entry = 0;
+    std::vector<K10ElfSegment>                m_segments;
+    std::unordered_map<std::string, uint32_t> m_symbols;
+    std::vector<K10ElfFunction>               m_functions;   // sorted by addr
+    std::string                               m_error;
+};
@@ -0,0 +1,723 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Reference Instruction-Set Simulator  (Verilator testbench only)
+// ============================================================================
+// See k10_iss.h for the modelled behaviour.  Exception causes and CSR
+// addresses follow komandara_k10_pkg.sv.
+// ============================================================================
+
+#include "k10_iss.h"
+
+namespace {
+
+constexpr uint32_t EXC_ILLEGAL_INSTR  = 2;
+constexpr uint32_t EXC_BREAKPOINT     = 3;
+constexpr uint32_t EXC_LOAD_MISALIGN  = 4;
+constexpr uint32_t EXC_LOAD_FAULT     = 5;
+constexpr uint32_t EXC_STORE_MISALIGN = 6;
+constexpr uint32_t EXC_STORE_FAULT    = 7;
+constexpr uint32_t EXC_ECALL_U        = 8;
+constexpr uint32_t EXC_ECALL_M        = 11;
+
+constexpr uint32_t AMO_LR = 0x02;
+constexpr uint32_t AMO_SC = 0x03;
+
+inline uint32_t bits(uint32_t v, unsigned hi, unsigned lo)
+{
+    return (v >> lo) & ((1u << (hi - lo + 1)) - 1u);
+}
+
+inline uint32_t sext(uint32_t v, unsigned width)
+{
+    const uint32_t m = 1u << (width - 1);
+    return (v ^ m) - m;
+}
+
+// 32-bit encoders used by the compressed expansion
+inline uint32_t enc_i(uint32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op)
+{
+    return ((imm & 0xfffu) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+inline uint32_t enc_r(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd)
+{
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | 0x33u;
+}
+
+inline uint32_t enc_s(uint32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3)
+{
+    return (bits(imm, 11, 5) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) |
+           (bits(imm, 4, 0) << 7) | 0x23u;
+}
+
+inline uint32_t enc_b(uint32_t imm, uint32_t rs1, uint32_t f3)
+{
+    return (bits(imm, 12, 12) << 31) | (bits(imm, 10, 5) << 25) | (rs1 << 15) |
+           (f3 << 12) | (bits(imm, 4, 1) << 8) | (bits(imm, 11, 11) << 7) | 0x63u;
+}
+
+inline uint32_t enc_j(uint32_t imm, uint32_t rd)
+{
+    return (bits(imm, 20, 20) << 31) | (bits(imm, 10, 1) << 21) | (bits(imm, 11, 11) << 20) |
+           (bits(imm, 19, 12) << 12) | (rd << 7) | 0x6fu;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// State
+// ----------------------------------------------------------------------------
+void K10Iss::reset(uint32_t ram_base, const uint32_t* ram, size_t words)
+{
+    *this = K10Iss{};
+    m_ram_base = ram_base;
+    m_ram.resize(words * 4);
+    for (size_t i = 0; i < words; ++i) {
+        for (unsigned b = 0; b < 4; ++b) {
+            m_ram[i * 4 + b] = static_cast<uint8_t>(ram[i] >> (8 * b));
+        }
+    }
+}
+
+uint32_t K10Iss::mstatus() const
+{
+    return (static_cast<uint32_t>(m_mprv) << 17) | (static_cast<uint32_t>(m_mpp) << 11) |
+           (static_cast<uint32_t>(m_mpie) << 7)  | (static_cast<uint32_t>(m_mie) << 3);
+}
+
+bool K10Iss::in_ram(uint32_t addr, unsigned size) const
+{
+    return addr >= m_ram_base &&
+           static_cast<uint64_t>(addr - m_ram_base) + size <= m_ram.size();
+}
+
+uint32_t K10Iss::load(uint32_t addr, unsigned size) const
+{
+    uint32_t v = 0;
+    for (unsigned b = 0; b < size; ++b) {
+        v |= static_cast<uint32_t>(m_ram[addr - m_ram_base + b]) << (8 * b);
+    }
+    return v;
+}
+
+void K10Iss::store(uint32_t addr, unsigned size, uint32_t value)
+{
+    for (unsigned b = 0; b < size; ++b) {
+        m_ram[addr - m_ram_base + b] = static_cast<uint8_t>(value >> (8 * b));
+    }
+}
+
+void K10Iss::write_rd(K10IssRetire& r, uint32_t rd, uint32_t value)
+{
+    if (rd == 0) return;
+    m_x[rd]   = value;
+    r.rd_wr   = true;
+    r.rd      = static_cast<uint8_t>(rd);
+    r.rd_data = value;
+}
+
+// ----------------------------------------------------------------------------
+// Traps — k10_csr trap entry
+// ----------------------------------------------------------------------------
+void K10Iss::trap(uint32_t cause, uint32_t tval)
+{
+    m_mepc   = m_pc;
+    m_mcause = cause;
+    m_mtval  = tval;
+    m_mpie   = m_mie;
+    m_mie    = false;
+    m_mpp    = m_priv;
+    m_priv   = PRIV_M;
+    m_pc     = m_mtvec & ~3u;
+}
+
+void K10Iss::interrupt(uint32_t cause)
+{
+    trap(cause, 0);
+    if ((m_mtvec & 3u) == 1u && (cause >> 31)) m_pc += (cause & 0x3fff'ffffu) << 2;
+}
+
+// ----------------------------------------------------------------------------
+// PMP — first matching region decides (k10_pmp.sv)
+// ----------------------------------------------------------------------------
+bool K10Iss::pmp_ok(uint32_t addr, bool read, bool write) const
+{
+    const uint64_t mask34 = (1ull << 34) - 1;
+    const uint64_t a = addr;
+    for (unsigned i = 0; i < PMP_REGIONS; ++i) {
+        const uint8_t cfg = m_pmpcfg[i];
+        const uint64_t top = static_cast<uint64_t>(m_pmpaddr[i]) << 2;
+        bool match = false;
+        switch ((cfg >> 3) & 3u) {
+            case 1: {   // TOR
+                const uint64_t bottom = i ? static_cast<uint64_t>(m_pmpaddr[i - 1]) << 2 : 0;
+                match = a >= bottom && a < top;
+                break;
+            }
+            case 2:     // NA4
+                match = (a >> 2) == m_pmpaddr[i];
+                break;
+            case 3: {   // NAPOT
+                const uint32_t next = m_pmpaddr[i] + 1u;
+                const uint64_t size = (static_cast<uint64_t>(m_pmpaddr[i] ^ next) << 2) | 3u;
+                const uint64_t mask = ~size & mask34;
+                match = (a & mask) == (top & mask);
+                break;
+            }
+            default:
+                break;
+        }
+        if (!match) continue;
+
+        const bool perm = (!read || (cfg & 0x1u)) && (!write || (cfg & 0x2u));
+        if (m_priv == PRIV_M) return (cfg & 0x80u) ? perm : true;
+        return perm;
+    }
+    return m_priv == PRIV_M;
+}
+
+// ----------------------------------------------------------------------------
+// CSRs — k10_csr read mux and write side effects
+// ----------------------------------------------------------------------------
+bool K10Iss::read_csr(uint32_t addr, uint32_t& value, bool& sync) const
+{
+    value = 0;
+    sync  = false;
+    switch (addr) {
+        case 0x300: value = mstatus();      return true;
+        case 0x301: value = MISA;           return true;
+        case 0x304: value = m_mie_reg;      return true;
+        case 0x305: value = m_mtvec;        return true;
+        case 0x306: value = m_mcounteren;   return true;
+        case 0x340: value = m_mscratch;     return true;
+        case 0x341: value = m_mepc;         return true;
+        case 0x342: value = m_mcause;       return true;
+        case 0x343: value = m_mtval;        return true;
+        // Values the ISS cannot know: IDs are SoC parameters, mip follows
+        // the interrupt lines, counters depend on timing, and the debug /
+        // trigger block belongs to the debug module's view of the hart.
+        case 0xF11: case 0xF12: case 0xF13: case 0xF14:
+        case 0x344:
+        case 0xB00: case 0xB02: case 0xB80: case 0xB82:
+        case 0xC00: case 0xC01: case 0xC02: case 0xC80: case 0xC81: case 0xC82:
+        case 0x7A0: case 0x7A1: case 0x7A2: case 0x7A4:
+        case 0x7B0: case 0x7B1: case 0x7B2: case 0x7B3:
+        case 0x320:
+            sync = true;
+            return true;
+        default:
+            break;
+    }
+    // mhpmevent3..31, mhpmcounter3..31(h), hpmcounter3..31(h)
+    const uint32_t block = addr & ~0x1fu;
+    if ((addr & 0x1fu) >= 3 &&
+        (block == 0x320 || block == 0xB00 || block == 0xB80 || block == 0xC00 || block == 0xC80)) {
+        sync = true;
+        return true;
+    }
+    if (addr >= 0x3A0 && addr <= 0x3A3) {
+        const unsigned base = (addr - 0x3A0u) * 4;
+        for (unsigned i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(m_pmpcfg[base + i]) << (8 * i);
+        }
+        return true;
+    }
+    if (addr >= 0x3B0 && addr <= 0x3BF) {
+        value = m_pmpaddr[addr - 0x3B0u];
+        return true;
+    }
+    return false;
+}
+
+void K10Iss::write_csr(uint32_t addr, uint32_t value)
+{
+    switch (addr) {
+        case 0x300: {
+            m_mie  = (value >> 3) & 1u;
+            m_mpie = (value >> 7) & 1u;
+            const uint8_t mpp = static_cast<uint8_t>((value >> 11) & 3u);
+            if (mpp == PRIV_M || mpp == PRIV_U) m_mpp = mpp;
+            m_mprv = (value >> 17) & 1u;
+            return;
+        }
+        case 0x304: m_mie_reg    = value & 0x7fff'0888u;                     return;
+        case 0x305: m_mtvec      = (value & ~3u) | ((value & 2u) ? 0u : (value & 1u)); return;
+        case 0x306: m_mcounteren = value & MCOUNTEREN_MASK;                  return;
+        case 0x340: m_mscratch   = value;                                    return;
+        case 0x341: m_mepc       = value & ~1u;                              return;
+        case 0x342: m_mcause     = value;                                    return;
+        case 0x343: m_mtval      = value;                                    return;
+        default:
+            break;
+    }
+    if (addr >= 0x3A0 && addr <= 0x3A3) {
+        const unsigned base = (addr - 0x3A0u) * 4;
+        for (unsigned i = 0; i < 4; ++i) {
+            if (!(m_pmpcfg[base + i] & 0x80u)) {
+                m_pmpcfg[base + i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+    } else if (addr >= 0x3B0 && addr <= 0x3BF) {
+        const unsigned i = addr - 0x3B0u;
+        if (!(m_pmpcfg[i] & 0x80u)) m_pmpaddr[i] = value;
+    }
+}
+
+bool K10Iss::exec_csr(uint32_t instr, K10IssRetire& r)
+{
+    const uint32_t f3   = bits(instr, 14, 12);
+    const uint32_t rs1  = bits(instr, 19, 15);
+    const uint32_t rd   = bits(instr, 11, 7);
+    const uint32_t addr = bits(instr, 31, 20);
+    const uint32_t op   = f3 & 3u;
+    const uint32_t wdata = (f3 & 4u) ? rs1 : m_x[rs1];
+
+    uint32_t old = 0;
+    bool sync = false;
+    const bool exists = read_csr(addr, old, sync);
+
+    // k10_csr treats csrrs / csrrc with a zero operand as a pure read
+    const bool is_write  = op == 1 || ((op == 2 || op == 3) && wdata != 0);
+    const bool read_only = bits(addr, 11, 10) == 3u;
+    const bool priv_ok   = m_priv >= bits(addr, 9, 8);
+    bool counter_ok = true;
+    if (m_priv == PRIV_U) {
+        switch (addr) {
+            case 0xC00: case 0xC80: counter_ok = m_mcounteren & 1u; break;
+            case 0xC01: case 0xC81: counter_ok = m_mcounteren & 2u; break;
+            case 0xC02: case 0xC82: counter_ok = m_mcounteren & 4u; break;
+            default:
+                if ((addr & ~0x1fu) == 0xC00 || (addr & ~0x1fu) == 0xC80) {
+                    counter_ok = (m_mcounteren >> (addr & 0x1fu)) & 1u;
+                }
+                break;
+        }
+    }
+    if (!exists || !priv_ok || !counter_ok || (read_only && is_write)) {
+        trap(EXC_ILLEGAL_INSTR, instr);
+        return false;
+    }
+
+    const uint32_t wval = (op == 2) ? (old | wdata) : (op == 3) ? (old & ~wdata) : wdata;
+    if (!read_only) write_csr(addr, wval);
+    write_rd(r, rd, old);
+    r.rd_sync = sync;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// A extension — k10_memory / k10_lsu
+// ----------------------------------------------------------------------------
+bool K10Iss::exec_amo(uint32_t instr, K10IssRetire& r)
+{
+    const uint32_t op   = bits(instr, 31, 27);
+    const uint32_t addr = m_x[bits(instr, 19, 15)];
+    const uint32_t src  = m_x[bits(instr, 24, 20)];
+    const uint32_t rd   = bits(instr, 11, 7);
+
+    switch (op) {
+        case AMO_LR: case AMO_SC:
+        case 0x00: case 0x01: case 0x04: case 0x08: case 0x0C:
+        case 0x10: case 0x14: case 0x18: case 0x1C:
+            break;
+        default:
+            trap(EXC_ILLEGAL_INSTR, instr);
+            return false;
+    }
+    if (bits(instr, 14, 12) != 2u) {
+        trap(EXC_ILLEGAL_INSTR, instr);
+        return false;
+    }
+    if (addr & 3u) {
+        trap(op == AMO_LR ? EXC_LOAD_MISALIGN : EXC_STORE_MISALIGN, addr);
+        return false;
+    }
+    if (!pmp_ok(addr, true, op != AMO_LR)) {
+        trap(op == AMO_LR ? EXC_LOAD_FAULT : EXC_STORE_FAULT, addr);
+        return false;
+    }
+
+    const bool ram = in_ram(addr, 4);
+    if (op == AMO_SC) {
+        const bool fail = !m_resv_valid || m_resv_addr != addr;
+        m_resv_valid = false;
+        if (!fail && ram) store(addr, 4, src);
+        write_rd(r, rd, fail ? 1u : 0u);
+        return true;
+    }
+
+    const uint32_t old = ram ? load(addr, 4) : 0u;
+    r.rd_sync = !ram;
+    if (op == AMO_LR) {
+        m_resv_valid = true;
+        m_resv_addr  = addr;
+        write_rd(r, rd, old);
+        return true;
+    }
+
+    uint32_t v = src;
+    switch (op) {
+        case 0x00: v = old + src; break;
+        case 0x04: v = old ^ src; break;
+        case 0x0C: v = old & src; break;
+        case 0x08: v = old | src; break;
+        case 0x10: v = static_cast<int32_t>(old) < static_cast<int32_t>(src) ? old : src; break;
+        case 0x14: v = static_cast<int32_t>(old) > static_cast<int32_t>(src) ? old : src; break;
+        case 0x18: v = old < src ? old : src; break;
+        case 0x1C: v = old > src ? old : src; break;
+        default:   break;   // AMOSWAP
+    }
+    if (ram) store(addr, 4, v);
+    write_rd(r, rd, old);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Execute one 32-bit (or expanded) instruction at m_pc
+// ----------------------------------------------------------------------------
+bool K10Iss::exec(uint32_t instr, K10IssRetire& r)
+{
+    const uint32_t opcode = bits(instr, 6, 0);
+    const uint32_t rd  = bits(instr, 11, 7);
+    const uint32_t f3  = bits(instr, 14, 12);
+    const uint32_t rs1 = bits(instr, 19, 15);
+    const uint32_t rs2 = bits(instr, 24, 20);
+    const uint32_t f7  = bits(instr, 31, 25);
+    const uint32_t a = m_x[rs1];
+    const uint32_t b = m_x[rs2];
+
+    const uint32_t imm_i = sext(bits(instr, 31, 20), 12);
+    const uint32_t imm_s = sext((f7 << 5) | rd, 12);
+    const uint32_t imm_b = sext((bits(instr, 31, 31) << 12) | (bits(instr, 7, 7) << 11) |
+                                (bits(instr, 30, 25) << 5) | (bits(instr, 11, 8) << 1), 13);
+    const uint32_t imm_j = sext((bits(instr, 31, 31) << 20) | (bits(instr, 19, 12) << 12) |
+                                (bits(instr, 20, 20) << 11) | (bits(instr, 30, 21) << 1), 21);
+
+    uint32_t next_pc = m_pc + (r.compressed ? 2u : 4u);
+
+    switch (opcode) {
+        case 0x37:  // LUI
+            write_rd(r, rd, instr & 0xffff'f000u);
+            break;
+
+        case 0x17:  // AUIPC
+            write_rd(r, rd, m_pc + (instr & 0xffff'f000u));
+            break;
+
+        case 0x6F:  // JAL
+            write_rd(r, rd, next_pc);
+            next_pc = m_pc + imm_j;
+            break;
+
+        case 0x67:  // JALR
+            write_rd(r, rd, next_pc);
+            next_pc = (a + imm_i) & ~1u;
+            break;
+
+        case 0x63: {  // BRANCH
+            bool taken = false;
+            switch (f3) {
+                case 0: taken = a == b; break;
+                case 1: taken = a != b; break;
+                case 4: taken = static_cast<int32_t>(a) <  static_cast<int32_t>(b); break;
+                case 5: taken = static_cast<int32_t>(a) >= static_cast<int32_t>(b); break;
+                case 6: taken = a <  b; break;
+                case 7: taken = a >= b; break;
+                default: break;
+            }
+            if (taken) next_pc = m_pc + imm_b;
+            break;
+        }
+
+        case 0x03: {  // LOAD
+            const uint32_t addr = a + imm_i;
+            const unsigned size = (f3 & 3u) == 0 ? 1 : (f3 & 3u) == 1 ? 2 : 4;
+            if (!pmp_ok(addr, true, false)) {
+                trap(EXC_LOAD_FAULT, addr);
+                return false;
+            }
+            uint32_t v = 0;
+            if (in_ram(addr, size)) v = load(addr, size);
+            else                    r.rd_sync = true;
+            if (f3 == 0) v = sext(v & 0xffu, 8);
+            if (f3 == 1) v = sext(v & 0xffffu, 16);
+            write_rd(r, rd, v);
+            break;
+        }
+
+        case 0x23: {  // STORE
+            const uint32_t addr = a + imm_s;
+            const unsigned size = (f3 & 3u) == 0 ? 1 : (f3 & 3u) == 1 ? 2 : 4;
+            if (!pmp_ok(addr, false, true)) {
+                trap(EXC_STORE_FAULT, addr);
+                return false;
+            }
+            if (m_resv_valid && (addr & ~3u) == m_resv_addr) m_resv_valid = false;
+            if (in_ram(addr, size)) store(addr, size, b);
+            break;
+        }
+
+        case 0x13: {  // OP-IMM
+            const uint32_t sh = rs2;
+            uint32_t v = 0;
+            switch (f3) {
+                case 0: v = a + imm_i; break;
+                case 1: v = a << sh; break;
+                case 2: v = static_cast<int32_t>(a) < static_cast<int32_t>(imm_i); break;
+                case 3: v = a < imm_i; break;
+                case 4: v = a ^ imm_i; break;
+                case 5: v = (f7 & 0x20u) ? static_cast<uint32_t>(static_cast<int32_t>(a) >> sh)
+                                         : a >> sh;
+                        break;
+                case 6: v = a | imm_i; break;
+                default: v = a & imm_i; break;
+            }
+            write_rd(r, rd, v);
+            break;
+        }
+
+        case 0x33: {  // OP / M extension
+            uint32_t v = 0;
+            if (f7 == 0x01) {
+                const int32_t sa = static_cast<int32_t>(a);
+                const int32_t sb = static_cast<int32_t>(b);
+                switch (f3) {
+                    case 0: v = a * b; break;
+                    case 1: v = static_cast<uint32_t>((static_cast<int64_t>(sa) * sb) >> 32); break;
+                    case 2: v = static_cast<uint32_t>((static_cast<int64_t>(sa) *
+                                                       static_cast<int64_t>(b)) >> 32); break;
+                    case 3: v = static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 32); break;
+                    case 4: v = (b == 0) ? ~0u
+                              : (a == 0x8000'0000u && sb == -1) ? a
+                              : static_cast<uint32_t>(sa / sb);
+                            break;
+                    case 5: v = (b == 0) ? ~0u : a / b; break;
+                    case 6: v = (b == 0) ? a
+                              : (a == 0x8000'0000u && sb == -1) ? 0u
+                              : static_cast<uint32_t>(sa % sb);
+                            break;
+                    default: v = (b == 0) ? a : a % b; break;
+                }
+            } else {
+                const uint32_t sh = b & 31u;
+                switch (f3) {
+                    case 0: v = (f7 & 0x20u) ? a - b : a + b; break;
+                    case 1: v = a << sh; break;
+                    case 2: v = static_cast<int32_t>(a) < static_cast<int32_t>(b); break;
+                    case 3: v = a < b; break;
+                    case 4: v = a ^ b; break;
+                    case 5: v = (f7 & 0x20u) ? static_cast<uint32_t>(static_cast<int32_t>(a) >> sh)
+                                             : a >> sh;
+                            break;
+                    case 6: v = a | b; break;
+                    default: v = a & b; break;
+                }
+            }
+            write_rd(r, rd, v);
+            break;
+        }
+
+        case 0x0F:  // MISC-MEM: FENCE / FENCE.I are no-ops here
+            if (f3 > 1) {
+                trap(EXC_ILLEGAL_INSTR, instr);
+                return false;
+            }
+            break;
+
+        case 0x73:  // SYSTEM
+            if (f3 != 0) {
+                if (!exec_csr(instr, r)) return false;
+                break;
+            }
+            switch (bits(instr, 31, 20)) {
+                case 0x000:
+                    trap(m_priv == PRIV_M ? EXC_ECALL_M : EXC_ECALL_U, 0);
+                    return false;
+                case 0x001:
+                    trap(EXC_BREAKPOINT, m_pc);
+                    return false;
+                case 0x302:  // MRET
+                    m_mie   = m_mpie;
+                    m_mpie  = true;
+                    m_priv  = m_mpp;
+                    if (m_mpp != PRIV_M) m_mprv = false;
+                    m_mpp   = PRIV_U;
+                    next_pc = m_mepc;
+                    break;
+                case 0x7B2:  // DRET outside debug mode: no effect
+                case 0x105:  // WFI: the DUT sleeps in EX, then retires it as a NOP
+                    break;
+                default:
+                    trap(EXC_ILLEGAL_INSTR, instr);
+                    return false;
+            }
+            break;
+
+        case 0x2F:  // AMO
+            if (!exec_amo(instr, r)) return false;
+            break;
+
+        default:
+            trap(EXC_ILLEGAL_INSTR, instr);
+            return false;
+    }
+
+    m_pc = next_pc;
+    return true;
+}
+
+K10Iss::Status K10Iss::step(K10IssRetire& r)
+{
+    r = K10IssRetire{};
+    uint32_t traps = 0;
+    for (;;) {
+        if (!in_ram(m_pc, 2)) return FETCH_OUTSIDE_RAM;
+        const uint32_t lo = load(m_pc, 2);
+
+        K10IssRetire cur;
+        cur.pc = m_pc;
+        cur.compressed = (lo & 3u) != 3u;
+        bool illegal = false;
+        if (cur.compressed) {
+            cur.instr = expand(static_cast<uint16_t>(lo), illegal);
+        } else {
+            if (!in_ram(m_pc, 4)) return FETCH_OUTSIDE_RAM;
+            cur.instr = load(m_pc, 4);
+        }
+
+        bool retired = false;
+        if (illegal) trap(EXC_ILLEGAL_INSTR, cur.instr);
+        else         retired = exec(cur.instr, cur);
+
+        if (retired) {
+            r = cur;
+            r.traps = traps;
+            return RETIRED;
+        }
+        if (++traps >= MAX_TRAPS) return TRAP_LOOP;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// RV32C expansion — mirrors k10_compressed_decoder.sv, including which
+// reserved / HINT encodings it rejects.
+// ----------------------------------------------------------------------------
+uint32_t K10Iss::expand(uint16_t c, bool& illegal)
+{
+    const uint32_t f3   = bits(c, 15, 13);
+    const uint32_t rd   = bits(c, 11, 7);
+    const uint32_t rs2  = bits(c, 6, 2);
+    const uint32_t rdp  = 8u + bits(c, 4, 2);
+    const uint32_t rs1p = 8u + bits(c, 9, 7);
+    const uint32_t imm6 = (bits(c, 12, 12) << 5) | bits(c, 6, 2);
+    const uint32_t jimm = sext((bits(c, 12, 12) << 11) | (bits(c, 8, 8) << 10) |
+                               (bits(c, 10, 9) << 8) | (bits(c, 6, 6) << 7) |
+                               (bits(c, 7, 7) << 6) | (bits(c, 2, 2) << 5) |
+                               (bits(c, 11, 11) << 4) | (bits(c, 5, 3) << 1), 12);
+    const uint32_t bimm = sext((bits(c, 12, 12) << 8) | (bits(c, 6, 5) << 6) |
+                               (bits(c, 2, 2) << 5) | (bits(c, 11, 10) << 3) |
+                               (bits(c, 4, 3) << 1), 9);
+
+    // Case labels are octal: <quadrant><funct3>
+    illegal = false;
+    switch ((bits(c, 1, 0) << 3) | f3) {
+        // ---- Quadrant 0 ----
+        case 000: {  // C.ADDI4SPN
+            const uint32_t nzuimm = (bits(c, 10, 7) << 6) | (bits(c, 12, 11) << 4) |
+                                    (bits(c, 5, 5) << 3) | (bits(c, 6, 6) << 2);
+            if (nzuimm == 0) break;
+            return enc_i(nzuimm, 2, 0, rdp, 0x13);
+        }
+        case 002: {  // C.LW
+            const uint32_t off = (bits(c, 5, 5) << 6) | (bits(c, 12, 10) << 3) | (bits(c, 6, 6) << 2);
+            return enc_i(off, rs1p, 2, rdp, 0x03);
+        }
+        case 006: {  // C.SW
+            const uint32_t off = (bits(c, 5, 5) << 6) | (bits(c, 12, 10) << 3) | (bits(c, 6, 6) << 2);
+            return enc_s(off, rdp, rs1p, 2);
+        }
+
+        // ---- Quadrant 1 ----
+        case 010:    // C.NOP / C.ADDI
+            return enc_i(sext(imm6, 6), rd, 0, rd, 0x13);
+        case 011:    // C.JAL
+            return enc_j(jimm, 1);
+        case 012:    // C.LI
+            return enc_i(sext(imm6, 6), 0, 0, rd, 0x13);
+        case 013:
+            if (rd == 2) {  // C.ADDI16SP
+                const uint32_t nz = (bits(c, 12, 12) << 9) | (bits(c, 4, 3) << 7) |
+                                    (bits(c, 5, 5) << 6) | (bits(c, 2, 2) << 5) |
+                                    (bits(c, 6, 6) << 4);
+                if (nz == 0) break;
+                return enc_i(sext(nz, 10), 2, 0, 2, 0x13);
+            }
+            if (imm6 == 0 || rd == 0) break;  // C.LUI
+            return (sext(imm6, 6) << 12) | (rd << 7) | 0x37u;
+        case 014:
+            switch (bits(c, 11, 10)) {
+                case 0:  // C.SRLI
+                    if (imm6 & 0x20u) break;
+                    return enc_i(imm6, rs1p, 5, rs1p, 0x13);
+                case 1:  // C.SRAI
+                    if (imm6 & 0x20u) break;
+                    return enc_i(0x400u | imm6, rs1p, 5, rs1p, 0x13);
+                case 2:  // C.ANDI
+                    return enc_i(sext(imm6, 6), rs1p, 7, rs1p, 0x13);
+                default:
+                    switch (bits(c, 6, 5)) {
+                        case 0:  return enc_r(0x20, rdp, rs1p, 0, rs1p);  // C.SUB
+                        case 1:  return enc_r(0x00, rdp, rs1p, 4, rs1p);  // C.XOR
+                        case 2:  return enc_r(0x00, rdp, rs1p, 6, rs1p);  // C.OR
+                        default: return enc_r(0x00, rdp, rs1p, 7, rs1p);  // C.AND
+                    }
+            }
+            break;
+        case 015:    // C.J
+            return enc_j(jimm, 0);
+        case 016:    // C.BEQZ
+            return enc_b(bimm, rs1p, 0);
+        case 017:    // C.BNEZ
+            return enc_b(bimm, rs1p, 1);
+
+        // ---- Quadrant 2 ----
+        case 020:    // C.SLLI
+            if ((imm6 & 0x20u) || rd == 0) break;
+            return enc_i(imm6, rd, 1, rd, 0x13);
+        case 022: {  // C.LWSP
+            if (rd == 0) break;
+            const uint32_t off = (bits(c, 3, 2) << 6) | (bits(c, 12, 12) << 5) | (bits(c, 6, 4) << 2);
+            return enc_i(off, 2, 2, rd, 0x03);
+        }
+        case 024:
+            if (!bits(c, 12, 12)) {
+                if (rs2 != 0) return enc_r(0, rs2, 0, 0, rd);             // C.MV
+                if (rd == 0) break;
+                return enc_i(0, rd, 0, 0, 0x67);                          // C.JR
+            }
+            if (rs2 != 0) return enc_r(0, rs2, rd, 0, rd);               // C.ADD
+            if (rd == 0)  return 0x0010'0073u;                            // C.EBREAK
+            return enc_i(0, rd, 0, 1, 0x67);                              // C.JALR
+        case 026: {  // C.SWSP
+            const uint32_t off = (bits(c, 8, 7) << 6) | (bits(c, 12, 9) << 2);
+            return enc_s(off, rs2, 2, 2);
+        }
+        default:
+            break;
+    }
+    illegal = true;
+    return 0;
+}
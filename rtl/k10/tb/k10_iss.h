@@ -0,0 +1,135 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Reference Instruction-Set Simulator  (Verilator testbench only)
+// ============================================================================
+// A small RV32IMAC + Zicsr interpreter with M and U modes, used as the
+// golden model for +cosim (see k10_cosim.h).  It models the architectural
+// state the K10 exposes and follows the RTL's implementation choices
+// wherever the ISA leaves room:
+//   - CSR set, WARL masks and access checks of k10_csr.sv (mstatus MPP
+//     holds M or U only, mtvec MODE 0/1, mepc bit 0 cleared, PMP lock bits)
+//   - compressed expansion and reserved encodings of
+//     k10_compressed_decoder.sv; the retire record carries the expansion,
+//     which is what k10_tracer reports
+//   - misaligned loads / stores are performed, only AMOs trap
+//   - PMP (k10_pmp.sv) checks data accesses at the effective privilege
+//     level, ignoring MPRV, against the first byte of the access
+//   - the LR/SC reservation rules of k10_lsu.sv
+//
+// RAM is a private copy of the BRAM image taken at start-up.  Accesses
+// outside it are treated as MMIO: stores are dropped and a load's value
+// is marked rd_sync so the checker adopts the DUT's result.  Counter
+// (including the HPM block), mip, ID and debug / trigger CSR reads are
+// handled the same way.  mcounteren's HPM bits follow MHPM_COUNTERS.
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One retirement as produced by K10Iss::step()
+struct K10IssRetire {
+    uint32_t pc         = 0;
+    uint32_t instr      = 0;      // 32-bit encoding (expanded if compressed)
+    bool     compressed = false;
+    bool     rd_wr      = false;  // a GPR other than x0 was written
+    uint8_t  rd         = 0;
+    uint32_t rd_data    = 0;
+    bool     rd_sync    = false;  // rd_data is not predictable by the ISS
+    uint32_t traps      = 0;      // exceptions taken before this retirement
+};
+
+class K10Iss {
+public:
+    enum Status {
+        RETIRED,                  // r describes one retired instruction
+        FETCH_OUTSIDE_RAM,        // pc left the RAM image
+        TRAP_LOOP                 // MAX_TRAPS exceptions without a retire
+    };
+
+    static constexpr uint32_t MISA        = 0x4010'1105u;   // RV32IMAC, MXL=1, U
+    static constexpr unsigned PMP_REGIONS = 16;
+    static constexpr unsigned MHPM_COUNTERS = 8;                 // k10_csr default
+    static constexpr uint32_t MCOUNTEREN_MASK = 7u | (((1u << MHPM_COUNTERS) - 1u) << 3);
+    static constexpr unsigned MAX_TRAPS   = 32;
+
+    static constexpr uint8_t PRIV_U = 0;
+    static constexpr uint8_t PRIV_M = 3;
+
+    // Architectural reset state; pc is set by the caller.
+    void reset(uint32_t ram_base, const uint32_t* ram, size_t words);
+
+    Status step(K10IssRetire& r);
+
+    // Take an interrupt with the given mcause before the instruction at pc.
+    void interrupt(uint32_t cause);
+
+    uint32_t pc() const { return m_pc; }
+    void     set_pc(uint32_t pc) { m_pc = pc; }
+    uint32_t gpr(unsigned i) const { return m_x[i & 31u]; }
+    void     set_gpr(unsigned i, uint32_t v) { if (i & 31u) m_x[i & 31u] = v; }
+    uint8_t  priv() const { return m_priv; }
+    uint32_t mstatus() const;
+    uint32_t mepc() const { return m_mepc; }
+    uint32_t mcause() const { return m_mcause; }
+    uint32_t mtval() const { return m_mtval; }
+
+    // k10_compressed_decoder: 32-bit expansion, or illegal with o = 0
+    static uint32_t expand(uint16_t c, bool& illegal);
+
+private:
+    bool exec(uint32_t instr, K10IssRetire& r);     // false: trapped
+    bool exec_csr(uint32_t instr, K10IssRetire& r);
+    bool exec_amo(uint32_t instr, K10IssRetire& r);
+    void trap(uint32_t cause, uint32_t tval);
+    void write_rd(K10IssRetire& r, uint32_t rd, uint32_t value);
+
+    bool read_csr(uint32_t addr, uint32_t& value, bool& sync) const;
+    void write_csr(uint32_t addr, uint32_t value);
+    bool pmp_ok(uint32_t addr, bool read, bool write) const;
+
+    bool     in_ram(uint32_t addr, unsigned size) const;
+    uint32_t load(uint32_t addr, unsigned size) const;
+    void     store(uint32_t addr, unsigned size, uint32_t value);
+
+    uint32_t m_pc = 0;
+    uint32_t m_x[32] = {};
+    uint8_t  m_priv = PRIV_M;
+
+    // mstatus fields
+    bool     m_mie  = false;
+    bool     m_mpie = false;
+    uint8_t  m_mpp  = PRIV_M;
+    bool     m_mprv = false;
+
+    uint32_t m_mie_reg     = 0;   // mie (meie / mtie / msie / fast)
+    uint32_t m_mtvec       = 0;
+    uint32_t m_mcounteren  = 0;
+    uint32_t m_mscratch    = 0;
+    uint32_t m_mepc        = 0;
+    uint32_t m_mcause      = 0;
+    uint32_t m_mtval       = 0;
+    uint8_t  m_pmpcfg[PMP_REGIONS]  = {};
+    uint32_t m_pmpaddr[PMP_REGIONS] = {};
+
+    bool     m_resv_valid = false;
+    uint32_t m_resv_addr  = 0;
+
+    uint32_t             m_ram_base = 0;
+    std::vector<uint8_t> m_ram;
+};
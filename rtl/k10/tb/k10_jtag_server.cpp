@@ -0,0 +1,145 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// ============================================================================
+// K10 — OpenOCD remote_bitbang JTAG Server  (Verilator testbench only)
+// ============================================================================
+// See k10_jtag_server.h for the protocol and the batching scheme.
+// ============================================================================
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "k10_jtag_server.h"
+
+static bool set_nonblocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool K10JtagServer::listen(uint16_t port)
+{
+    close();
+
+    m_listen = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listen < 0) {
+        std::printf("[K10_TB:JTAG] ERROR: socket: %s\n", std::strerror(errno));
+        return false;
+    }
+
+    const int one = 1;
+    setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = htons(port);
+    if (bind(m_listen, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(m_listen, 1) != 0 || !set_nonblocking(m_listen)) {
+        std::printf("[K10_TB:JTAG] ERROR: Cannot listen on port %u: %s\n",
+                    port, std::strerror(errno));
+        close();
+        return false;
+    }
+
+    std::printf("[K10_TB:JTAG] remote_bitbang server listening on 127.0.0.1:%u\n", port);
+    return true;
+}
+
+void K10JtagServer::close()
+{
+    drop_client();
+    if (m_listen >= 0) {
+        ::close(m_listen);
+        m_listen = -1;
+    }
+}
+
+void K10JtagServer::drop_client()
+{
+    if (m_client >= 0) {
+        ::close(m_client);
+        m_client = -1;
+    }
+}
+
+size_t K10JtagServer::service(const Pins& pins)
+{
+    if (m_client < 0) {
+        if (m_listen < 0) return 0;
+        const int fd = accept(m_listen, nullptr, nullptr);
+        if (fd < 0) return 0;
+        const int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (!set_nonblocking(fd)) {
+            ::close(fd);
+            return 0;
+        }
+        m_client = fd;
+        std::printf("[K10_TB:JTAG] remote_bitbang client connected\n");
+    }
+
+    const ssize_t n = recv(m_client, m_in.data(), m_in.size(), 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        std::printf("[K10_TB:JTAG] remote_bitbang client disconnected\n");
+        drop_client();
+        return 0;
+    }
+    if (n < 0) return 0;
+
+    m_out.clear();
+    for (ssize_t i = 0; i < n; ++i) {
+        const char c = m_in[static_cast<size_t>(i)];
+        if (c >= '0' && c <= '7') {
+            const int v = c - '0';
+            pins.write((v >> 2) & 1, (v >> 1) & 1, v & 1);
+        } else if (c == 'R') {
+            m_out.push_back(pins.read_tdo() ? '1' : '0');
+        } else if (c >= 'r' && c <= 'u') {
+            const int v = c - 'r';
+            pins.reset((v & 2) != 0, (v & 1) != 0);
+        } else if (c == 'Q') {
+            std::printf("[K10_TB:JTAG] remote_bitbang quit\n");
+            m_quit = true;
+            break;
+        }
+        // 'B'/'b' (blink) and whitespace are ignored
+    }
+
+    // Retry on a full socket buffer: OpenOCD reads the replies before it
+    // sends the next batch, so this drains almost immediately.
+    size_t sent = 0;
+    while (sent < m_out.size()) {
+        const ssize_t w = send(m_client, m_out.data() + sent, m_out.size() - sent, MSG_NOSIGNAL);
+        if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+        if (w <= 0) {
+            drop_client();
+            break;
+        }
+        sent += static_cast<size_t>(w);
+    }
+
+    return static_cast<size_t>(n);
+}
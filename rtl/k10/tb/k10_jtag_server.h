@@ -0,0 +1,79 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// ============================================================================
+// K10 — OpenOCD remote_bitbang JTAG Server  (Verilator testbench only)
+// ============================================================================
+// Lets OpenOCD (and GDB through it) drive the simulated TAP:
+//   ./Vk10_tb +firmware=<hex> --jtag-server 9824
+//   openocd -f scripts/k10-sim-openocd.tcl
+//
+// The listening socket and the client are non-blocking.  service() drains
+// whatever OpenOCD has sent so far in one recv(), applies every command in
+// order (each pin write is one eval of the model, with no system clock
+// edge) and answers all 'R' reads of the batch with a single send().  The
+// driver calls it between system clock cycles; the system clock only
+// advances between batches.
+//
+// Protocol (OpenOCD doc/manual/jtag/drivers/remote_bitbang.txt):
+//   '0'..'7'  write tck/tms/tdi = bits [2]/[1]/[0]
+//   'R'       read tdo, answered with '0' or '1'
+//   'r'..'u'  reset: bit [1] = assert trst, bit [0] = assert srst
+//   'B' 'b'   blink on/off (ignored)
+//   'Q'       quit — the simulation ends
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class K10JtagServer {
+public:
+    struct Pins {
+        std::function<void(int tck, int tms, int tdi)> write;
+        std::function<int()>                          read_tdo;
+        std::function<void(bool trst, bool srst)>     reset;
+    };
+
+    K10JtagServer() = default;
+    K10JtagServer(const K10JtagServer&) = delete;
+    K10JtagServer& operator=(const K10JtagServer&) = delete;
+    ~K10JtagServer() { close(); }
+
+    // Listen on 127.0.0.1:<port>.  Returns false (after printing why) on error.
+    bool listen(uint16_t port);
+    void close();
+
+    // Accept a pending client and process one batch of its commands.
+    // Returns the number of commands handled (0 when idle).
+    size_t service(const Pins& pins);
+
+    bool connected() const { return m_client >= 0; }
+    bool quit() const { return m_quit; }
+
+private:
+    void drop_client();
+
+    static constexpr size_t RECV_BYTES = 64 * 1024;
+
+    int               m_listen = -1;
+    int               m_client = -1;
+    bool              m_quit = false;
+    std::vector<char> m_in = std::vector<char>(RECV_BYTES);
+    std::vector<char> m_out;
+};
@@ -0,0 +1,198 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Cycle Profiler  (Verilator testbench only)
+// ============================================================================
+// See k10_profile.h.
+// ============================================================================
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+#include "k10_elf.h"
+#include "k10_profile.h"
+
+void K10Profile::flush_run()
+{
+    if (m_run_cycles == 0 && m_run_retired == 0) return;
+    Count& c = m_hist[m_key];
+    c.cycles  += m_run_cycles;
+    c.retired += m_run_retired;
+    m_run_cycles  = 0;
+    m_run_retired = 0;
+}
+
+// Call / return hints as in the RISC-V unprivileged spec (RAS table).
+void K10Profile::track(uint32_t pc, uint32_t instr)
+{
+    auto link = [](uint32_t r) { return r == 1 || r == 5; };
+    bool call = false;
+    bool ret  = false;
+    if ((instr & 3u) == 3u) {
+        const uint32_t op  = instr & 0x7Fu;
+        const uint32_t rd  = (instr >> 7) & 31u;
+        const uint32_t rs1 = (instr >> 15) & 31u;
+        if (op == 0x6Fu) {                          // jal
+            call = link(rd);
+        } else if (op == 0x67u) {                   // jalr
+            call = link(rd);
+            ret  = rd == 0 && link(rs1);
+        }
+    } else {
+        const uint32_t op     = instr & 3u;
+        const uint32_t funct3 = (instr >> 13) & 7u;
+        const uint32_t rs1    = (instr >> 7) & 31u;
+        const uint32_t rs2    = (instr >> 2) & 31u;
+        if (op == 1u && funct3 == 1u) {             // c.jal (RV32)
+            call = true;
+        } else if (op == 2u && funct3 == 4u && rs2 == 0 && rs1 != 0) {
+            if ((instr >> 12) & 1u) call = true;    // c.jalr
+            else                    ret  = link(rs1);  // c.jr
+        }
+    }
+
+    if (ret) {
+        if (m_untracked) {
+            m_untracked--;
+        } else if (m_node != 0) {
+            m_node = m_nodes[m_node].parent;
+            m_depth--;
+        }
+    } else if (call) {
+        if (m_depth >= MAX_DEPTH) {
+            m_untracked++;
+            return;
+        }
+        const uint64_t key = (static_cast<uint64_t>(m_node) << 32) | pc;
+        auto it = m_children.find(key);
+        if (it == m_children.end()) {
+            it = m_children.emplace(key, static_cast<uint32_t>(m_nodes.size())).first;
+            m_nodes.push_back({m_node, pc});
+        }
+        m_node = it->second;
+        m_depth++;
+    }
+}
+
+bool K10Profile::write(const std::string& prefix, const K10Elf& elf, unsigned top_n)
+{
+    flush_run();
+
+    auto func_name = [&](uint32_t pc) {
+        const K10ElfFunction* f = elf.function_at(pc);
+        if (f) return f->name;
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "0x%08x", pc);
+        return std::string(buf);
+    };
+    auto location = [&](uint32_t pc) {
+        const K10ElfFunction* f = elf.function_at(pc);
+        if (!f) return std::string("?");
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "+0x%x", pc - f->addr);
+        return f->name + buf;
+    };
+
+    // ---- Flat profile: per PC and per function ----
+    Count total;
+    std::unordered_map<uint32_t, Count>    by_pc;
+    std::unordered_map<std::string, Count> by_func;
+    for (const auto& kv : m_hist) {
+        const uint32_t pc = static_cast<uint32_t>(kv.first);
+        Count& p = by_pc[pc];
+        p.cycles      += kv.second.cycles;
+        p.retired     += kv.second.retired;
+        total.cycles  += kv.second.cycles;
+        total.retired += kv.second.retired;
+    }
+    for (const auto& kv : by_pc) {
+        Count& f = by_func[func_name(kv.first)];
+        f.cycles  += kv.second.cycles;
+        f.retired += kv.second.retired;
+    }
+
+    const std::string txt_path = prefix + ".txt";
+    FILE* txt = std::fopen(txt_path.c_str(), "w");
+    if (!txt) {
+        std::printf("[K10_TB] ERROR: Cannot write %s\n", txt_path.c_str());
+        return false;
+    }
+    auto cpi = [](const Count& c) {
+        return c.retired ? static_cast<double>(c.cycles) / static_cast<double>(c.retired) : 0.0;
+    };
+    auto pct = [&](const Count& c) {
+        return total.cycles ? 100.0 * static_cast<double>(c.cycles) / static_cast<double>(total.cycles)
+                            : 0.0;
+    };
+    auto by_cycles = [](const auto& a, const auto& b) { return a.second.cycles > b.second.cycles; };
+
+    std::fprintf(txt, "# K10 cycle profile: %lu cycles, %lu retired, CPI %.3f\n",
+                 total.cycles, total.retired, cpi(total));
+    std::fprintf(txt, "# A cycle is charged to the retiring instruction, or else to the\n"
+                      "# oldest instruction still in the pipeline.\n\n");
+
+    std::vector<std::pair<std::string, Count>> funcs(by_func.begin(), by_func.end());
+    std::sort(funcs.begin(), funcs.end(), by_cycles);
+    if (funcs.size() > top_n) funcs.resize(top_n);
+    std::fprintf(txt, "Functions (top %u by cycles)\n", top_n);
+    std::fprintf(txt, "%14s %7s %14s %8s  %s\n", "cycles", "%", "retired", "CPI", "function");
+    for (const auto& f : funcs) {
+        std::fprintf(txt, "%14lu %6.2f%% %14lu %8.3f  %s\n", f.second.cycles, pct(f.second),
+                     f.second.retired, cpi(f.second), f.first.c_str());
+    }
+
+    std::vector<std::pair<uint32_t, Count>> pcs(by_pc.begin(), by_pc.end());
+    std::sort(pcs.begin(), pcs.end(), by_cycles);
+    if (pcs.size() > top_n) pcs.resize(top_n);
+    std::fprintf(txt, "\nInstructions (top %u by cycles)\n", top_n);
+    std::fprintf(txt, "%14s %7s %14s %8s  %-10s  %s\n", "cycles", "%", "retired", "CPI", "pc",
+                 "location");
+    for (const auto& p : pcs) {
+        std::fprintf(txt, "%14lu %6.2f%% %14lu %8.3f  0x%08x  %s\n", p.second.cycles,
+                     pct(p.second), p.second.retired, cpi(p.second), p.first,
+                     location(p.first).c_str());
+    }
+    std::fclose(txt);
+
+    // ---- Folded stacks: caller frames from the call-site tree ----
+    std::vector<std::string> frames(m_nodes.size());
+    for (size_t n = 1; n < m_nodes.size(); ++n) {
+        // Parents are always created before their children.
+        const Node& node = m_nodes[n];
+        frames[n] = (node.parent ? frames[node.parent] + ";" : std::string()) +
+                    func_name(node.call_pc);
+    }
+    std::map<std::string, uint64_t> folded;
+    for (const auto& kv : m_hist) {
+        if (kv.second.cycles == 0) continue;
+        const uint32_t node = static_cast<uint32_t>(kv.first >> 32);
+        const uint32_t pc   = static_cast<uint32_t>(kv.first);
+        folded[(node ? frames[node] + ";" : std::string()) + func_name(pc)] += kv.second.cycles;
+    }
+
+    const std::string folded_path = prefix + ".folded";
+    FILE* fp = std::fopen(folded_path.c_str(), "w");
+    if (!fp) {
+        std::printf("[K10_TB] ERROR: Cannot write %s\n", folded_path.c_str());
+        return false;
+    }
+    for (const auto& kv : folded) std::fprintf(fp, "%s %lu\n", kv.first.c_str(), kv.second);
+    std::fclose(fp);
+
+    std::printf("[K10_TB] Profile: %lu cycles over %zu PCs, %zu call stacks -> %s, %s\n",
+                total.cycles, by_pc.size(), folded.size(), txt_path.c_str(), folded_path.c_str());
+    return true;
+}
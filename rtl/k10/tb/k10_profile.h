@@ -0,0 +1,90 @@
+// Copyright 2026 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Cycle Profiler  (Verilator testbench only, k10_tb.cpp --profile)
+// ============================================================================
+// Every cycle is charged to one PC (k10_tb.sv prof_pc): the instruction
+// retiring from MEM/WB, or else the oldest instruction still in the
+// pipeline, which is the one retirement is waiting on.  A load waiting for
+// the bus, a divide, a load-use bubble or a WFI therefore lands on the
+// instruction that caused it, and the cycles after a redirect land on the
+// branch target.  Cycles skipped by --fast-forward go to the WFI.
+//
+// A shadow call stack follows the retirement stream: jal/jalr writing a
+// link register (x1/x5) push the call site, "jalr x0, 0(x1|x5)" pops it.
+// Each stack is a node in a call-site tree, and cycles are counted per
+// (node, pc) in a hash map.  Consecutive cycles on the same key are summed
+// before the map is touched, so a stall costs an add, not a lookup.
+//
+// write() symbolises the histogram against the ELF (if one was loaded):
+//   <prefix>.txt     top-N functions and top-N instructions by cycles,
+//                    with retired instructions and CPI
+//   <prefix>.folded  "caller;callee;leaf <cycles>" lines for flamegraph.pl
+//                    or speedscope
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class K10Elf;
+
+class K10Profile {
+public:
+    static constexpr uint32_t MAX_DEPTH = 256;   // deeper calls are not tracked
+
+    void sample(uint32_t pc, bool retire, uint32_t instr, uint64_t cycles = 1)
+    {
+        const uint64_t key = (static_cast<uint64_t>(m_node) << 32) | pc;
+        if (key != m_key) {
+            flush_run();
+            m_key = key;
+        }
+        m_run_cycles += cycles;
+        if (retire) {
+            m_run_retired++;
+            track(pc, instr);
+        }
+    }
+
+    bool write(const std::string& prefix, const K10Elf& elf, unsigned top_n);
+
+private:
+    struct Count {
+        uint64_t cycles  = 0;
+        uint64_t retired = 0;
+    };
+    struct Node {
+        uint32_t parent;
+        uint32_t call_pc;
+    };
+
+    void flush_run();
+    void track(uint32_t pc, uint32_t instr);
+
+    std::vector<Node>                      m_nodes{{0, 0}};   // [0] = root
+    std::unordered_map<uint64_t, uint32_t> m_children;        // node:call_pc -> node
+    std::unordered_map<uint64_t, Count>    m_hist;            // node:pc
+    uint32_t m_node     = 0;
+    uint32_t m_depth    = 0;
+    uint32_t m_untracked = 0;     // calls below MAX_DEPTH still to return
+
+    uint64_t m_key         = ~0ull;
+    uint64_t m_run_cycles  = 0;
+    uint64_t m_run_retired = 0;
+};
@@ -17,29 +17,191 @@
 // ============================================================================
 // Usage:
 //   ./Vk10_tb [+verilator+seed+<N>] [--trace]
+//             [+max_cycles=<N>] [+max_idle_cycles=<N>]
+//             [--save-checkpoint <file> --at-cycle <N>]
+//             [--restore-checkpoint <file> [+firmware=<hex|elf>]]
+//             [--elf <file>] [--dump-symbol <name>[:<words>]]
+//             [--profile <prefix> [--profile-top <N>]]
 //
 // The simulation terminates when:
 //   1. The SV testbench detects an ECALL/sim_ctrl ($finish), or
-//   2. MAX_CYCLES is reached (timeout / fail)
+//   2. The cycle budget is exhausted (timeout / fail), or
+//   3. The idle watchdog fires (timeout / fail), or
+//   4. A requested checkpoint has been written
 //
 // --trace  enables FST waveform dump to k10_sim.fst
+//   --trace-start <cycle>      first cycle to dump (default 0)
+//   --trace-end <cycle>        stop dumping at this cycle
+//   --trace-cycles <N>         dump N cycles from the start / trigger
+//   --trace-trigger-pc <hex>   start dumping when an instruction at this PC
+//                              retires (at or after --trace-start)
+//   --trace-trigger-exc <c|any> start dumping on an exception (w_exc_valid),
+//                              optionally only for mcause code <c>
+//   --trace-ring <N>           dump continuously into two rotating segment
+//                              files of N cycles; both are kept only when
+//                              the run fails or times out, otherwise deleted
+//   --trace-depth <N>          hierarchy depth passed to trace() (default 99)
+//   --trace-scope <hier>       restrict dumping to one scope, e.g.
+//                              TOP.k10_tb.u_dut.u_top.u_core
+//
+// +max_cycles=<N>       cycle budget per test, 0 = unlimited (default 1,000,000)
+// +max_idle_cycles=<N>  fail once no instruction has retired at a new PC
+//                       for N cycles: catches both a dead pipeline (no
+//                       retire at all) and a "j ." spin.  0 disables it
+//                       (default 100,000).  Cycles asleep in WFI do not
+//                       count; a hart that never wakes runs into +max_cycles.
+//
+// --fast-forward  skip idle time: once the core has slept in WFI for a few
+//                 cycles with the pipeline and every bus quiet, mtime, mcycle,
+//                 SIM_STATUS and the cycle count jump to a few cycles before the next
+//                 wake-up (mtimecmp with MTIE set; otherwise the cycle budget,
+//                 the checkpoint cycle or the DMI start) and stepping resumes
+//                 there, so the interrupt is taken on the same cycle as
+//                 without it.  Not available with --trace, --jtag-server,
+//                 +debug_req_cycle or on a TRACE_BUF build.
+//
+// --elf <file>  load an RV32 ELF executable straight into the BRAM (PT_LOAD
+//               segments at their physical address) instead of a
+//               $readmemh image.  The entry point must equal the model's
+//               BOOT_ADDR.  +firmware=<file> and --batch manifests accept
+//               ELF files as well; they are recognised by their magic.
+// --dump-symbol <name>[:<words>]  at the end of the run (each batch test),
+//               print <words> (default 1) BRAM words at an ELF symbol, e.g.
+//               a benchmark result buffer.  May be repeated.
+//
+// --profile <prefix>  charge every cycle after reset to a PC (the retiring
+//               instruction, else the oldest one in the pipeline) and track
+//               calls and returns; at the end write <prefix>.txt (top
+//               functions and instructions with cycles, retires and CPI,
+//               symbolised against the --elf image) and <prefix>.folded
+//               (folded stacks for flamegraph.pl).  See k10_profile.h.
+//   --profile-top <N>  entries per table in <prefix>.txt (default 20)
+//
+// --coverage <file>  (sim_cov target only — a --coverage model) write the
+//               line and k10_cov.sv coverage counters to <file> at the end
+//               of the run (default coverage.dat in the working directory).
+//               Batch mode writes <name>_coverage.dat per test and zeroes
+//               the counters in between.  Merge with verilator_coverage;
+//               see scripts/run_coverage_regression.sh.
+//
+// Checkpoints (sim target only — needs a --savable model):
+//   --save-checkpoint <file> --at-cycle <N>
+//       Run to cycle N, write the full model state to <file> and exit.
+//   --restore-checkpoint <file>
+//       Resume from <file> instead of running reset.  With +firmware=<hex>
+//       the BRAM is cleared and reloaded from <hex> after the restore, so
+//       one warm checkpoint can be forked into many test payloads.  Every
+//       payload must share the code executed up to cycle N (same
+//       startup.S prefix); otherwise use N <= RESET_CYCLES, which still
+//       skips model construction and the reset sequence.
+//       SV plusargs (+finish_on_ecall, ...) keep their checkpointed values.
+//
+// Batch mode:
+//   --batch <manifest> [--batch-results <file>] [-j <N>]
+//       Run every image listed in <manifest> in one process, resetting the
+//       DUT and backdoor-loading the BRAM between tests.  Manifest lines are
+//       "<hex>" or "<name> <hex>"; '#' starts a comment.  One result line
+//       per test is written to <file> (default batch_results.txt):
+//         PASS|FAIL <name> cycles=<N> instret=<N> reason=<why>
+//       -j N forks N workers, each running every Nth test; results are
+//       merged back in manifest order.  Each test writes <name>_trace.csv
+//       and <name>_console.log (and <name>.fst with --trace,
+//       <name>_coverage.dat from a sim_cov model).  Exit status is 1 if
+//       any test fails.
+//
+// Debug module access (started RESET_CYCLES + 30 cycles into the run):
+//   --run-jtag-dmi       built-in halt / read-misa sequence through the JTAG
+//                        TAP, bit-banging every DMI scan (TAP coverage)
+//   --run-dmi            the same sequence through the DMI transactor, which
+//                        drives dm_top's dmi_req/dmi_rsp directly
+//   --dmi-script <file>  run a DMI script through the transactor (or the
+//                        TAP with --dmi-jtag); one command per line:
+//                          write <addr> <data>
+//                          read  <addr> [<expect> [<mask>]]
+//                          poll  <addr> <mask> <value> [<max_reads>]
+//                          idle  <cycles>
+//                        '#' starts a comment.  A failed check, a poll that
+//                        runs out of reads or a non-zero response ends the
+//                        run with exit status 1.
+//   --jtag-server <port> serve the TAP to OpenOCD's remote_bitbang driver
+//                        on 127.0.0.1:<port> (scripts/k10-sim-openocd.tcl).
+//                        +max_cycles and +max_idle_cycles default to 0
+//                        (unlimited / off) in this mode; the run ends when
+//                        OpenOCD sends 'Q' (shutdown) or the firmware
+//                        finishes.
+//
+// +cosim  lockstep co-simulation: every retirement is stepped and compared
+//         against the built-in RV32IMAC ISS (k10_iss.cpp); the first
+//         mismatch ends the run (batch: the test, reason=cosim) as a
+//         failure and prints the recent retirement history and ISS state.
+//         See k10_cosim.h for what is compared and synchronised.  Not
+//         available with --restore-checkpoint, nor on N_HARTS > 1 builds
+//         (other harts write the memory the ISS models).
+//
+// --console-log <file>  also write the console (sim_ctrl CHAR_OUT, and UART
+//                       TX under +uart_backdoor) to <file>.  Console output
+//                       is line-buffered in k10_console.cpp; batch mode
+//                       writes <name>_console.log per test.
+//
+// +uart_backdoor[=stdin|pty]  k10_uart skips bit-level serialisation: TX
+//                       bytes go to the console (stdin, the default) or to
+//                       a PTY whose name is printed at start-up, and RX
+//                       bytes come from stdin or that PTY.  See
+//                       k10_console.h.
+//
+// --stats-json <file>  write host-side throughput numbers (wall time,
+//                      cycles/s, instret/s, time in eval / FST dump / JTAG
+//                      and DMI work, peak RSS) as JSON.  A one-line summary
+//                      is always printed at the end of the run.
 // ============================================================================
 
+#include <chrono>
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include "k10_console.h"
+#include "k10_cosim.h"
+#include "k10_elf.h"
+#include "k10_profile.h"
+#include "k10_jtag_server.h"
 #include "Vk10_tb.h"
+#include "Vk10_tb___024root.h"
+#include "Vk10_tb__Dpi.h"
+#include "svdpi.h"
 #include "verilated.h"
 
 #ifdef VM_TRACE_FST
 #include "verilated_fst_c.h"
 #endif
 
-static constexpr uint64_t MAX_CYCLES = 1'000'000;
+#ifdef K10_TB_SAVABLE
+#include "verilated_save.h"
+#endif
+
+#if VM_COVERAGE
+#include "verilated_cov.h"
+#endif
+
+static constexpr uint64_t DEFAULT_MAX_CYCLES      = 1'000'000;
+static constexpr uint64_t DEFAULT_MAX_IDLE_CYCLES = 100'000;
 static constexpr int      RESET_CYCLES = 5;
+static constexpr uint32_t BRAM_BASE = 0x8000'0000;   // k10_soc MEM_BASE
+static constexpr const char* TRACE_FILE = "k10_trace.csv";
+static constexpr const char* COVERAGE_FILE = "coverage.dat";
+static constexpr int      DMI_TIMEOUT_CYCLES = 1000;
+static constexpr uint64_t JTAG_IDLE_POLL_CYCLES = 256;  // recv() rate with no traffic
+static constexpr uint64_t FF_SETTLE_CYCLES = 8;   // quiet cycles before a jump
+static constexpr uint64_t FF_WAKE_MARGIN   = 4;   // cycles stepped before mtimecmp
 
 static uint64_t pack_dmi_req(uint32_t data, uint8_t addr, uint8_t op)
 {
@@ -57,53 +219,1025 @@ static void unpack_dmi_resp(uint64_t v, uint32_t& data, uint8_t& addr, uint8_t&
     data = static_cast<uint32_t>((v >> 9) & 0xffff'ffffULL);
 }
 
-int main(int argc, char** argv)
+// ----------------------------------------------------------------------------
+// Plusarg helpers
+// ----------------------------------------------------------------------------
+static uint64_t plusarg_u64(VerilatedContext& ctx, const char* name, uint64_t dflt)
 {
-    // Verilator context
-    const std::unique_ptr<VerilatedContext> ctx{new VerilatedContext};
-    ctx->commandArgs(argc, argv);
+    const std::string prefix = std::string(name) + "=";
+    const char* match = ctx.commandArgsPlusMatch(prefix.c_str());
+    if (!match || !match[0]) return dflt;
+    return std::strtoull(match + 1 + prefix.size(), nullptr, 0);
+}
+
+// ----------------------------------------------------------------------------
+// Idle watchdog — "progress" means an instruction retired at a new PC
+// ----------------------------------------------------------------------------
+struct IdleWatchdog {
+    uint64_t limit         = 0;
+    uint64_t last_progress = 0;
+    uint64_t instret       = 0;
+    uint32_t pc            = 0;
+    bool     retired       = false;  // anything retired since last progress
+
+    void reset(uint64_t cycle)
+    {
+        last_progress = cycle;
+        instret = 0;
+        pc = 0;
+        retired = false;
+    }
+
+    // Returns true when the watchdog fires.  A hart asleep in WFI is
+    // waiting, not stuck.
+    bool check(uint64_t cycle, uint64_t cur_instret, uint32_t cur_pc, bool wfi_sleep)
+    {
+        if (limit == 0) return false;
+        if (wfi_sleep) {
+            last_progress = cycle;
+            return false;
+        }
+        if (cur_instret != instret) {
+            instret = cur_instret;
+            if (cur_pc != pc) {
+                pc = cur_pc;
+                last_progress = cycle;
+                retired = false;
+            } else {
+                retired = true;
+            }
+        }
+        return (cycle - last_progress) >= limit;
+    }
+
+    void report(uint64_t cycle) const
+    {
+        k10_console().flush();
+        if (retired) {
+            std::printf("[K10_TB] ERROR: Timeout (idle watchdog): stuck at PC 0x%08x "
+                        "for %lu cycles (cycle %lu)\n", pc, limit, cycle);
+        } else {
+            std::printf("[K10_TB] ERROR: Timeout (idle watchdog): no instruction "
+                        "retired for %lu cycles (cycle %lu)\n", limit, cycle);
+        }
+    }
+};
+
+// ----------------------------------------------------------------------------
+// WFI fast-forward — see k10_tb.sv ff_quiet
+// ----------------------------------------------------------------------------
+// Called once a cycle.  After FF_SETTLE_CYCLES quiet cycles, advances the
+// free-running counters by the number of cycles left until FF_WAKE_MARGIN
+// cycles before mtimecmp (when MTIE is set) or until limit, whichever is
+// first, and returns that number (0 = no jump).
+// ----------------------------------------------------------------------------
+struct WfiFastForward {
+    bool     enabled = false;
+    uint64_t quiet   = 0;
+    uint64_t skipped = 0;
+    uint64_t jumps   = 0;
+
+    uint64_t step(Vk10_tb___024root& root, uint64_t cycle, uint64_t limit)
+    {
+        if (!enabled) return 0;
+        if (!root.k10_tb__DOT__ff_quiet) {
+            quiet = 0;
+            return 0;
+        }
+        if (++quiet < FF_SETTLE_CYCLES) return 0;
+
+        auto& mtime = root.k10_tb__DOT__u_dut__DOT__u_timer__DOT__r_mtime;
+        uint64_t target = limit;
+        if (root.k10_tb__DOT__ff_timer_wake) {
+            const uint64_t cmp = root.k10_tb__DOT__u_dut__DOT__u_timer__DOT__r_mtimecmp[0];
+            if (cmp <= mtime + FF_WAKE_MARGIN) return 0;
+            if (cmp - mtime - FF_WAKE_MARGIN < target - cycle) {
+                target = cycle + (cmp - mtime - FF_WAKE_MARGIN);
+            }
+        }
+        if (target <= cycle + 1) return 0;
+
+        const uint64_t n = target - cycle;
+        mtime += n;
+        if (root.k10_tb__DOT__ff_mcycle_en) {
+            root.k10_tb__DOT__u_dut__DOT__u_top__DOT__u_core__DOT__u_csr__DOT__r_mcycle += n;
+        }
+        root.k10_tb__DOT__u_dut__DOT__u_sim_ctrl__DOT__r_cycle_count += static_cast<IData>(n);
+        root.k10_tb__DOT__cycle_count += n;
+        skipped += n;
+        jumps++;
+        return n;
+    }
+
+    void report() const
+    {
+        if (enabled) {
+            std::printf("[K10_TB] Fast-forward: %lu cycles skipped in %lu jumps\n",
+                        skipped, jumps);
+        }
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Host-side throughput statistics
+// ----------------------------------------------------------------------------
+// eval_s counts top->eval() outside JTAG/DMI work, dump_s the FST dump
+// calls, jtag_s the wall time of JTAG/DMI work including its own evals.
+// Per-eval timing is only switched on by --stats-json (timed).
+// ----------------------------------------------------------------------------
+struct SimStats {
+    using Clock = std::chrono::steady_clock;
+
+    bool              timed = false;
+    Clock::time_point start = Clock::now();
+    double            eval_s = 0.0;
+    double            dump_s = 0.0;
+    double            jtag_s = 0.0;
+    uint64_t          cycles = 0;
+    uint64_t          instret = 0;
+    uint64_t          tests = 1;
+    unsigned          threads = 0;      // model threads (VerilatedContext)
+
+    static double seconds(Clock::duration d)
+    {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    double wall_s() const { return seconds(Clock::now() - start); }
+
+    // Peak RSS of this process and of any reaped batch workers, in KiB
+    static long peak_rss_kb()
+    {
+        rusage self{}, children{};
+        getrusage(RUSAGE_SELF, &self);
+        getrusage(RUSAGE_CHILDREN, &children);
+        return self.ru_maxrss > children.ru_maxrss ? self.ru_maxrss : children.ru_maxrss;
+    }
+
+    // Batch workers hand their counters to the parent as one text line
+    bool write_part(const std::string& path) const
+    {
+        FILE* fp = std::fopen(path.c_str(), "w");
+        if (!fp) return false;
+        std::fprintf(fp, "%lu %lu %lu %u %.9f %.9f %.9f\n", cycles, instret, tests,
+                     threads, eval_s, dump_s, jtag_s);
+        std::fclose(fp);
+        return true;
+    }
+
+    void add_part(const std::string& path)
+    {
+        FILE* fp = std::fopen(path.c_str(), "r");
+        if (!fp) return;
+        unsigned long c = 0, i = 0, t = 0;
+        unsigned th = 0;
+        double e = 0.0, d = 0.0, j = 0.0;
+        if (std::fscanf(fp, "%lu %lu %lu %u %lf %lf %lf", &c, &i, &t, &th, &e, &d, &j) == 7) {
+            cycles += c;
+            instret += i;
+            tests += t;
+            threads = th;
+            eval_s += e;
+            dump_s += d;
+            jtag_s += j;
+        }
+        std::fclose(fp);
+        std::remove(path.c_str());
+    }
+
+    void print() const
+    {
+        const double wall = wall_s();
+        std::printf("[K10_TB] Host: %.3f s wall, %.0f cycles/s, %.3f MIPS, peak RSS %ld KiB\n",
+                    wall, wall > 0.0 ? cycles / wall : 0.0,
+                    wall > 0.0 ? instret / wall / 1e6 : 0.0, peak_rss_kb());
+    }
+
+    bool write_json(const char* path, bool passed) const
+    {
+        FILE* fp = std::fopen(path, "w");
+        if (!fp) {
+            std::printf("[K10_TB] ERROR: Cannot write %s\n", path);
+            return false;
+        }
+        const double wall = wall_s();
+        const double other = wall - eval_s - dump_s - jtag_s;
+        std::fprintf(fp,
+            "{\n"
+            "  \"status\": \"%s\",\n"
+            "  \"tests\": %lu,\n"
+            "  \"cycles\": %lu,\n"
+            "  \"instret\": %lu,\n"
+            "  \"wall_s\": %.6f,\n"
+            "  \"cycles_per_sec\": %.1f,\n"
+            "  \"instret_per_sec\": %.1f,\n"
+            "  \"mips\": %.6f,\n"
+            "  \"eval_s\": %.6f,\n"
+            "  \"dump_s\": %.6f,\n"
+            "  \"jtag_s\": %.6f,\n"
+            "  \"other_s\": %.6f,\n"
+            "  \"threads\": %u,\n"
+            "  \"peak_rss_kb\": %ld\n"
+            "}\n",
+            passed ? "pass" : "fail", tests, cycles, instret, wall,
+            wall > 0.0 ? cycles / wall : 0.0,
+            wall > 0.0 ? instret / wall : 0.0,
+            wall > 0.0 ? instret / wall / 1e6 : 0.0,
+            eval_s, dump_s, jtag_s, other > 0.0 ? other : 0.0,
+            threads, peak_rss_kb());
+        std::fclose(fp);
+        std::printf("[K10_TB] Stats written to %s\n", path);
+        return true;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// FST dump control — windows, triggers and the failure ring buffer
+// ----------------------------------------------------------------------------
+#ifdef VM_TRACE_FST
+struct FstControl {
+    // Options
+    uint64_t    start = 0;
+    uint64_t    end = UINT64_MAX;
+    uint64_t    length = 0;         // 0 = until end
+    uint64_t    ring = 0;           // 0 = no ring buffer
+    bool        trig_pc = false;
+    uint32_t    pc = 0;
+    bool        trig_exc = false;
+    int64_t     exc_cause = -1;     // -1 = any cause
+
+    // State
+    VerilatedFstC* tfp = nullptr;
+    std::string base;
+    bool        on = false;
+    bool        triggered = false;
+    uint64_t    trig_cycle = 0;
+    uint64_t    seg_start = 0;
+    int         seg = 0;
+
+    bool dumping() const { return tfp && on; }
+
+    std::string seg_path(int n) const
+    {
+        return base + ".ring" + std::to_string(n) + ".fst";
+    }
+
+    void begin(const std::string& path, uint64_t cycle)
+    {
+        if (!tfp) return;
+        if (tfp->isOpen()) tfp->close();
+        base = path;
+        if (base.size() > 4 && base.compare(base.size() - 4, 4, ".fst") == 0) {
+            base.resize(base.size() - 4);
+        }
+        triggered = !trig_pc && !trig_exc;
+        trig_cycle = start;
+        on = false;
+        if (ring) {
+            seg = 0;
+            seg_start = cycle;
+            tfp->open(seg_path(seg).c_str());
+            on = true;
+        } else {
+            tfp->open(path.c_str());
+            on = triggered && cycle >= start && cycle < end;
+        }
+    }
+
+    void step(uint64_t cycle, uint32_t commit_pc, bool exc_valid, uint32_t cause)
+    {
+        if (!tfp) return;
+        if (ring) {
+            if (cycle - seg_start >= ring) {
+                tfp->close();
+                seg ^= 1;
+                tfp->open(seg_path(seg).c_str());
+                seg_start = cycle;
+            }
+            return;
+        }
+        if (!triggered && cycle >= start) {
+            const bool pc_hit  = trig_pc && (commit_pc == pc);
+            const bool exc_hit = trig_exc && exc_valid &&
+                                 (exc_cause < 0 || static_cast<int64_t>(cause) == exc_cause);
+            if (pc_hit || exc_hit) {
+                triggered = true;
+                trig_cycle = cycle;
+                std::printf("[K10_TB] FST trigger (%s) at cycle %lu\n",
+                            pc_hit ? "pc" : "exception", cycle);
+            }
+        }
+        on = triggered && cycle >= start && cycle < end &&
+             (length == 0 || cycle - trig_cycle < length);
+    }
+
+    // Close the current file; ring segments survive only a failing run.
+    void finish(bool failed)
+    {
+        if (!tfp || !tfp->isOpen()) return;
+        tfp->close();
+        on = false;
+        if (!ring) return;
+        if (failed) {
+            std::printf("[K10_TB] FST ring buffer kept: %s (older), %s (newer)\n",
+                        seg_path(seg ^ 1).c_str(), seg_path(seg).c_str());
+        } else {
+            std::remove(seg_path(0).c_str());
+            std::remove(seg_path(1).c_str());
+        }
+    }
+};
+#endif
+
+// ----------------------------------------------------------------------------
+// BRAM backdoor — komandara_bram.r_mem is public_flat_rw
+// ----------------------------------------------------------------------------
+// Accepts the $readmemh word format produced by verilog_byte2word.py /
+// bin2hex.py: "@<word addr>" records followed by 32-bit hex words.
+// The whole memory is cleared first so stale data from a previous image
+// (or from the checkpoint) cannot leak into the new test.
+static bool load_hex_image(Vk10_tb& top, const char* path)
+{
+    auto& mem = top.rootp->k10_tb__DOT__u_dut__DOT__u_bram__DOT__r_mem;
+    const size_t depth = sizeof(mem.m_storage) / sizeof(mem.m_storage[0]);
+
+    FILE* fp = std::fopen(path, "r");
+    if (!fp) {
+        std::printf("[K10_TB] ERROR: Cannot open firmware %s\n", path);
+        return false;
+    }
+
+    for (size_t i = 0; i < depth; ++i) mem[i] = 0;
+
+    char tok[64];
+    size_t addr = 0;
+    size_t nwords = 0;
+    bool ok = true;
+    while (std::fscanf(fp, "%63s", tok) == 1) {
+        if (tok[0] == '/' && tok[1] == '/') {
+            int c;
+            while ((c = std::fgetc(fp)) != EOF && c != '\n') {}
+            continue;
+        }
+        char* end = nullptr;
+        if (tok[0] == '@') {
+            addr = std::strtoul(tok + 1, &end, 16);
+        } else {
+            const uint32_t word = static_cast<uint32_t>(std::strtoul(tok, &end, 16));
+            if (addr >= depth) {
+                std::printf("[K10_TB] ERROR: %s: word address 0x%zx outside BRAM\n",
+                            path, addr);
+                ok = false;
+                break;
+            }
+            mem[addr++] = word;
+            nwords++;
+        }
+        if (*end != '\0') {
+            std::printf("[K10_TB] ERROR: %s: bad hex token '%s'\n", path, tok);
+            ok = false;
+            break;
+        }
+    }
+    std::fclose(fp);
+
+    if (ok) {
+        std::printf("[K10_TB] Loaded %zu words from %s (mem[0]=%08x)\n",
+                    nwords, path, mem[0]);
+    }
+    return ok;
+}
+
+// ELF images: the PT_LOAD segments are copied straight into the BRAM, so
+// no objcopy / verilog_byte2word.py pass is needed.  The entry point must
+// match the BOOT_ADDR the model was built with (the reset PC is a
+// parameter, not something the driver can change).
+static bool load_elf_image(Vk10_tb& top, const char* path, K10Elf& elf)
+{
+    auto& mem = top.rootp->k10_tb__DOT__u_dut__DOT__u_bram__DOT__r_mem;
+    const size_t depth = sizeof(mem.m_storage) / sizeof(mem.m_storage[0]);
+
+    if (!elf.load(path)) {
+        std::printf("[K10_TB] ERROR: %s: %s\n", path, elf.error().c_str());
+        return false;
+    }
+    const uint32_t boot_addr = top.rootp->k10_tb__DOT__boot_addr;
+    if (elf.entry() != boot_addr) {
+        std::printf("[K10_TB] ERROR: %s: entry 0x%08x, but the model was built with "
+                    "BOOT_ADDR=0x%08x\n", path, elf.entry(), boot_addr);
+        return false;
+    }
+
+    for (size_t i = 0; i < depth; ++i) mem[i] = 0;
+
+    size_t nbytes = 0;
+    for (const K10ElfSegment& seg : elf.segments()) {
+        const uint64_t off = uint64_t(seg.addr) - BRAM_BASE;
+        if (seg.addr < BRAM_BASE || off + seg.data.size() > depth * 4) {
+            std::printf("[K10_TB] ERROR: %s: segment 0x%08x+0x%zx outside BRAM\n",
+                        path, seg.addr, seg.data.size());
+            return false;
+        }
+        for (size_t b = 0; b < seg.data.size(); ++b) {
+            const size_t   word  = static_cast<size_t>((off + b) >> 2);
+            const unsigned shift = static_cast<unsigned>(((off + b) & 3) * 8);
+            mem[word] = (mem[word] & ~(0xFFu << shift)) |
+                        (static_cast<uint32_t>(seg.data[b]) << shift);
+        }
+        nbytes += seg.data.size();
+    }
+
+    std::printf("[K10_TB] Loaded %zu bytes in %zu segments from %s (entry 0x%08x, %zu symbols)\n",
+                nbytes, elf.segments().size(), path, elf.entry(), elf.symbol_count());
+    return true;
+}
+
+// Either format, told apart by the ELF magic.
+static bool load_image(Vk10_tb& top, const char* path, K10Elf& elf)
+{
+    if (K10Elf::is_elf(path)) return load_elf_image(top, path, elf);
+    elf = K10Elf();     // no symbols for a hex image
+    return load_hex_image(top, path);
+}
+
+// --dump-symbol <name>[:<words>]: print BRAM words at an ELF symbol, e.g.
+// a benchmark's result buffer, once the run has ended.
+static void dump_symbols(Vk10_tb& top, const K10Elf& elf, const std::vector<std::string>& specs)
+{
+    auto& mem = top.rootp->k10_tb__DOT__u_dut__DOT__u_bram__DOT__r_mem;
+    const size_t depth = sizeof(mem.m_storage) / sizeof(mem.m_storage[0]);
+
+    for (const std::string& spec : specs) {
+        const size_t colon = spec.find(':');
+        const std::string name = spec.substr(0, colon);
+        const unsigned words = (colon == std::string::npos)
+            ? 1u : static_cast<unsigned>(std::strtoul(spec.c_str() + colon + 1, nullptr, 0));
+        uint32_t addr = 0;
+        if (!elf.symbol(name, addr)) {
+            std::printf("[K10_TB] Symbol %s: not found\n", name.c_str());
+            continue;
+        }
+        std::printf("[K10_TB] Symbol %s @ 0x%08x:", name.c_str(), addr);
+        for (unsigned i = 0; i < words; ++i) {
+            const uint64_t word = (uint64_t(addr) - BRAM_BASE) / 4 + i;
+            if (addr < BRAM_BASE || word >= depth) {
+                std::printf(" (outside BRAM)");
+                break;
+            }
+            std::printf(" %08x", mem[static_cast<size_t>(word)]);
+        }
+        std::printf("\n");
+    }
+}
+
+// Arm +cosim against the current BRAM image; called while the core is
+// still held in reset so the copy predates every store.
+static void cosim_start(Vk10_tb& top)
+{
+    auto& mem = top.rootp->k10_tb__DOT__u_dut__DOT__u_bram__DOT__r_mem;
+    const size_t depth = sizeof(mem.m_storage) / sizeof(mem.m_storage[0]);
+    k10_cosim().start(BRAM_BASE, mem.m_storage, depth);
+}
+
+// ----------------------------------------------------------------------------
+// Checkpoints — Verilator save/restore plus the driver's own loop state
+// ----------------------------------------------------------------------------
+#ifdef K10_TB_SAVABLE
+static bool save_checkpoint(const char* path, VerilatedContext& ctx, Vk10_tb& top,
+                            uint64_t cycle, bool jtag_script_done)
+{
+    VerilatedSave os;
+    os.open(path);
+    if (!os.isOpen()) {
+        std::printf("[K10_TB] ERROR: Cannot write checkpoint %s\n", path);
+        return false;
+    }
+    uint64_t time = ctx.time();
+    uint8_t  jtag_done = jtag_script_done ? 1 : 0;
+    os << time << cycle << jtag_done;
+    os << top;
+    os.close();
+    std::printf("[K10_TB] Checkpoint saved: %s (cycle %lu)\n", path, cycle);
+    return true;
+}
+
+static bool restore_checkpoint(const char* path, VerilatedContext& ctx, Vk10_tb& top,
+                               uint64_t& cycle, bool& jtag_script_done)
+{
+    VerilatedRestore os;
+    os.open(path);
+    if (!os.isOpen()) {
+        std::printf("[K10_TB] ERROR: Cannot read checkpoint %s\n", path);
+        return false;
+    }
+    uint64_t time = 0;
+    uint8_t  jtag_done = 0;
+    os >> time >> cycle >> jtag_done;
+    os >> top;
+    os.close();
+    ctx.time(time);
+    jtag_script_done = (jtag_done != 0);
+    std::printf("[K10_TB] Checkpoint restored: %s (cycle %lu)\n", path, cycle);
+    return true;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Batch mode — manifest parsing and result reporting
+// ----------------------------------------------------------------------------
+// k10_tb.sv test_status encoding
+enum : uint8_t {
+    TEST_RUNNING     = 0,
+    TEST_PASS_CTRL   = 1,
+    TEST_FAIL_CTRL   = 2,
+    TEST_PASS_ECALL  = 3,
+    TEST_FAIL_EBREAK = 4
+};
+
+struct BatchTest {
+    std::string name;
+    std::string hex;
+};
+
+static bool read_manifest(const char* path, std::vector<BatchTest>& tests)
+{
+    FILE* fp = std::fopen(path, "r");
+    if (!fp) {
+        std::printf("[K10_TB] ERROR: Cannot open manifest %s\n", path);
+        return false;
+    }
+    char line[4096];
+    while (std::fgets(line, sizeof(line), fp)) {
+        if (char* hash = std::strchr(line, '#')) *hash = '\0';
+        char a[2048] = {0};
+        char b[2048] = {0};
+        const int n = std::sscanf(line, "%2047s %2047s", a, b);
+        if (n <= 0) continue;
+        BatchTest t;
+        if (n == 1) {
+            t.hex = a;
+            const size_t slash = t.hex.find_last_of('/');
+            t.name = t.hex.substr(slash == std::string::npos ? 0 : slash + 1);
+            const size_t dot = t.name.rfind(".hex");
+            if (dot != std::string::npos) t.name.resize(dot);
+        } else {
+            t.name = a;
+            t.hex  = b;
+        }
+        tests.push_back(t);
+    }
+    std::fclose(fp);
+    return true;
+}
+
+static const char* test_reason(uint8_t status)
+{
+    switch (status) {
+        case TEST_PASS_CTRL:   return "sim_ctrl";
+        case TEST_FAIL_CTRL:   return "sim_ctrl";
+        case TEST_PASS_ECALL:  return "ecall";
+        case TEST_FAIL_EBREAK: return "ebreak";
+        default:               return "timeout";
+    }
+}
+
+static bool test_passed(uint8_t status)
+{
+    return status == TEST_PASS_CTRL || status == TEST_PASS_ECALL;
+}
+
+// ----------------------------------------------------------------------------
+// DMI scripts — run through either DMI back end
+// ----------------------------------------------------------------------------
+// (op, addr, wdata, rdata, raddr, resp); op/resp use the dm::dtm_op_e and
+// dm::dtm_op_status_e encodings.
+using DmiExec = std::function<void(uint8_t, uint8_t, uint32_t,
+                                   uint32_t&, uint8_t&, uint8_t&)>;
+
+struct DmiOp {
+    enum Kind { WRITE, READ, POLL, IDLE } kind;
+    uint8_t  addr   = 0;
+    uint32_t data   = 0;        // write data / expected value
+    uint32_t mask   = 0;        // 0: no check (read only)
+    uint64_t count  = 0;        // idle cycles / poll reads
+    int      line   = 0;
+};
+
+static bool read_dmi_script(const char* path, std::vector<DmiOp>& ops)
+{
+    FILE* fp = std::fopen(path, "r");
+    if (!fp) {
+        std::printf("[K10_TB] ERROR: Cannot open DMI script %s\n", path);
+        return false;
+    }
+    char line[1024];
+    int lineno = 0;
+    bool ok = true;
+    while (std::fgets(line, sizeof(line), fp)) {
+        ++lineno;
+        if (char* hash = std::strchr(line, '#')) *hash = '\0';
+        char cmd[16] = {0};
+        long a = 0, b = 0, c = 0, d = 0;
+        const int n = std::sscanf(line, "%15s %li %li %li %li", cmd, &a, &b, &c, &d);
+        if (n <= 0) continue;
+
+        DmiOp op;
+        op.line = lineno;
+        op.addr = static_cast<uint8_t>(a & 0x7fu);
+        if (strcmp(cmd, "write") == 0 && n == 3) {
+            op.kind = DmiOp::WRITE;
+            op.data = static_cast<uint32_t>(b);
+        } else if (strcmp(cmd, "read") == 0 && n >= 2 && n <= 4) {
+            op.kind = DmiOp::READ;
+            op.data = static_cast<uint32_t>(b);
+            op.mask = (n == 2) ? 0u : (n == 3) ? 0xffff'ffffu : static_cast<uint32_t>(c);
+        } else if (strcmp(cmd, "poll") == 0 && n >= 4) {
+            op.kind  = DmiOp::POLL;
+            op.mask  = static_cast<uint32_t>(b);
+            op.data  = static_cast<uint32_t>(c);
+            op.count = (n == 5) ? static_cast<uint64_t>(d) : 1000;
+        } else if (strcmp(cmd, "idle") == 0 && n == 2) {
+            op.kind  = DmiOp::IDLE;
+            op.count = static_cast<uint64_t>(a);
+        } else {
+            std::printf("[K10_TB] ERROR: %s:%d: bad DMI script line\n", path, lineno);
+            ok = false;
+            continue;
+        }
+        ops.push_back(op);
+    }
+    std::fclose(fp);
+    return ok;
+}
+
+static bool run_dmi_script(const std::vector<DmiOp>& ops, const DmiExec& dmi_exec,
+                           const std::function<void(uint64_t)>& idle)
+{
+    for (const DmiOp& op : ops) {
+        uint32_t data = 0;
+        uint8_t addr = 0;
+        uint8_t resp = 0;
+        switch (op.kind) {
+            case DmiOp::IDLE:
+                idle(op.count);
+                continue;
+            case DmiOp::WRITE:
+                dmi_exec(2, op.addr, op.data, data, addr, resp);
+                std::printf("[K10_TB:DMI] wr 0x%02x = 0x%08x resp=%u\n", op.addr, op.data, resp);
+                break;
+            case DmiOp::READ:
+                dmi_exec(1, op.addr, 0, data, addr, resp);
+                std::printf("[K10_TB:DMI] rd 0x%02x = 0x%08x resp=%u\n", op.addr, data, resp);
+                if (resp == 0 && (data & op.mask) != (op.data & op.mask)) {
+                    std::printf("[K10_TB:DMI] ERROR: line %d: expected 0x%08x (mask 0x%08x)\n",
+                                op.line, op.data, op.mask);
+                    return false;
+                }
+                break;
+            case DmiOp::POLL: {
+                uint64_t reads = 0;
+                do {
+                    dmi_exec(1, op.addr, 0, data, addr, resp);
+                    ++reads;
+                } while (resp == 0 && (data & op.mask) != op.data && reads < op.count);
+                std::printf("[K10_TB:DMI] poll 0x%02x = 0x%08x after %lu reads resp=%u\n",
+                            op.addr, data, reads, resp);
+                if (resp == 0 && (data & op.mask) != op.data) {
+                    std::printf("[K10_TB:DMI] ERROR: line %d: poll timed out\n", op.line);
+                    return false;
+                }
+                break;
+            }
+        }
+        if (resp != 0) {
+            std::printf("[K10_TB:DMI] ERROR: line %d: DMI response %u\n", op.line, resp);
+            return false;
+        }
+    }
+    return true;
+}
 
+int main(int argc, char** argv)
+{
     // Parse custom args
     bool do_trace = false;
+    int trace_depth = 99;
+    const char* trace_scope = nullptr;
+#ifdef VM_TRACE_FST
+    FstControl fst;
+#endif
     bool run_jtag_dmi = false;
+    bool run_dmi = false;
+    bool dmi_jtag = false;
+    const char* dmi_script_path = nullptr;
+    int jtag_port = 0;
+    const char* stats_path = nullptr;
+    const char* console_log = nullptr;
+    const char* elf_path = nullptr;
+    std::vector<std::string> dump_syms;
+    const char* profile_path = nullptr;
+    unsigned profile_top = 20;
+    const char* save_path = nullptr;
+    const char* restore_path = nullptr;
+    uint64_t save_at_cycle = 0;
+    const char* batch_path = nullptr;
+    const char* batch_results = "batch_results.txt";
+    int batch_jobs = 1;
+    const char* coverage_path = nullptr;
+    WfiFastForward ff;
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--trace") == 0) do_trace = true;
+        if (strcmp(argv[i], "--trace-depth") == 0 && i + 1 < argc) trace_depth = std::atoi(argv[++i]);
+        if (strcmp(argv[i], "--trace-scope") == 0 && i + 1 < argc) trace_scope = argv[++i];
+#ifdef VM_TRACE_FST
+        if (strcmp(argv[i], "--trace-start") == 0 && i + 1 < argc) {
+            fst.start = std::strtoull(argv[++i], nullptr, 0);
+        }
+        if (strcmp(argv[i], "--trace-end") == 0 && i + 1 < argc) {
+            fst.end = std::strtoull(argv[++i], nullptr, 0);
+        }
+        if (strcmp(argv[i], "--trace-cycles") == 0 && i + 1 < argc) {
+            fst.length = std::strtoull(argv[++i], nullptr, 0);
+        }
+        if (strcmp(argv[i], "--trace-ring") == 0 && i + 1 < argc) {
+            fst.ring = std::strtoull(argv[++i], nullptr, 0);
+        }
+        if (strcmp(argv[i], "--trace-trigger-pc") == 0 && i + 1 < argc) {
+            fst.trig_pc = true;
+            fst.pc = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 16));
+        }
+        if (strcmp(argv[i], "--trace-trigger-exc") == 0 && i + 1 < argc) {
+            fst.trig_exc = true;
+            ++i;
+            fst.exc_cause = (strcmp(argv[i], "any") == 0) ? -1 : std::strtoll(argv[i], nullptr, 0);
+        }
+#endif
         if (strcmp(argv[i], "--run-jtag-dmi") == 0) run_jtag_dmi = true;
+        if (strcmp(argv[i], "--run-dmi") == 0) run_dmi = true;
+        if (strcmp(argv[i], "--dmi-jtag") == 0) dmi_jtag = true;
+        if (strcmp(argv[i], "--dmi-script") == 0 && i + 1 < argc) dmi_script_path = argv[++i];
+        if (strcmp(argv[i], "--jtag-server") == 0 && i + 1 < argc) jtag_port = std::atoi(argv[++i]);
+        if (strcmp(argv[i], "--stats-json") == 0 && i + 1 < argc) stats_path = argv[++i];
+        if (strcmp(argv[i], "--console-log") == 0 && i + 1 < argc) console_log = argv[++i];
+        if (strcmp(argv[i], "--elf") == 0 && i + 1 < argc) elf_path = argv[++i];
+        if (strcmp(argv[i], "--dump-symbol") == 0 && i + 1 < argc) dump_syms.push_back(argv[++i]);
+        if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) profile_path = argv[++i];
+        if (strcmp(argv[i], "--profile-top") == 0 && i + 1 < argc) {
+            profile_top = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        if (strcmp(argv[i], "--save-checkpoint") == 0 && i + 1 < argc) save_path = argv[++i];
+        if (strcmp(argv[i], "--restore-checkpoint") == 0 && i + 1 < argc) restore_path = argv[++i];
+        if (strcmp(argv[i], "--at-cycle") == 0 && i + 1 < argc) {
+            save_at_cycle = std::strtoull(argv[++i], nullptr, 0);
+        }
+        if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) batch_path = argv[++i];
+        if (strcmp(argv[i], "--batch-results") == 0 && i + 1 < argc) batch_results = argv[++i];
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) batch_jobs = std::atoi(argv[++i]);
+        if (strcmp(argv[i], "--fast-forward") == 0) ff.enabled = true;
+        if (strcmp(argv[i], "--coverage") == 0 && i + 1 < argc) coverage_path = argv[++i];
+    }
+
+#ifndef K10_TB_SAVABLE
+    if (save_path || restore_path) {
+        std::printf("[K10_TB] ERROR: checkpoints need a --savable build (sim target)\n");
+        return 1;
+    }
+#endif
+#if !VM_COVERAGE
+    if (coverage_path) {
+        std::printf("[K10_TB] ERROR: --coverage needs a --coverage build (sim_cov target)\n");
+        return 1;
+    }
+#endif
+    if (ff.enabled && (do_trace || jtag_port)) {
+        std::printf("[K10_TB] ERROR: --fast-forward cannot be combined with --trace or --jtag-server\n");
+        return 1;
+    }
+    if (save_path && save_at_cycle == 0) {
+        std::printf("[K10_TB] ERROR: --save-checkpoint requires --at-cycle <N>\n");
+        return 1;
     }
 
+    SimStats stats;
+    stats.timed = (stats_path != nullptr);
+
+    // Batch mode opens <name>_console.log per test instead.
+    if (console_log && !batch_path && !k10_console().open_log(console_log)) return 1;
+
+    std::vector<DmiOp> dmi_script;
+    if (dmi_script_path && !read_dmi_script(dmi_script_path, dmi_script)) return 1;
+    const bool run_debug = run_jtag_dmi || run_dmi || dmi_script_path;
+
+    std::vector<BatchTest> batch;
+    if (batch_path) {
+        if (save_path || restore_path || run_debug || jtag_port) {
+            std::printf("[K10_TB] ERROR: --batch cannot be combined with checkpoints or DMI access\n");
+            return 1;
+        }
+        if (elf_path) {
+            std::printf("[K10_TB] ERROR: --elf cannot be combined with --batch (list the ELF in the manifest)\n");
+            return 1;
+        }
+        if (profile_path) {
+            std::printf("[K10_TB] ERROR: --profile cannot be combined with --batch\n");
+            return 1;
+        }
+        if (!read_manifest(batch_path, batch)) return 1;
+        if (batch_jobs < 1) batch_jobs = 1;
+    }
+
+    // Batch workers: fork before any Verilator state exists; each worker
+    // runs tests worker, worker+N, ... and writes "<index> <line>" records.
+    int batch_worker = 0;
+    if (batch_path && batch_jobs > 1) {
+        std::fflush(stdout);
+        std::vector<pid_t> pids;
+        for (int w = 0; w < batch_jobs; ++w) {
+            const pid_t pid = fork();
+            if (pid < 0) {
+                std::printf("[K10_TB] ERROR: fork failed\n");
+                return 1;
+            }
+            if (pid == 0) {
+                batch_worker = w;
+                pids.clear();
+                break;
+            }
+            pids.push_back(pid);
+        }
+
+        if (!pids.empty()) {
+            int failed = 0;
+            for (pid_t pid : pids) {
+                int wstatus = 0;
+                waitpid(pid, &wstatus, 0);
+                if (!WIFEXITED(wstatus)) failed = 1;
+            }
+
+            std::vector<std::string> lines(batch.size());
+            for (int w = 0; w < batch_jobs; ++w) {
+                const std::string part = std::string(batch_results) + "." + std::to_string(w);
+                FILE* fp = std::fopen(part.c_str(), "r");
+                if (!fp) continue;
+                char buf[4096];
+                while (std::fgets(buf, sizeof(buf), fp)) {
+                    char* rest = nullptr;
+                    const size_t idx = std::strtoul(buf, &rest, 10);
+                    if (idx < lines.size() && *rest == ' ') lines[idx] = rest + 1;
+                }
+                std::fclose(fp);
+                std::remove(part.c_str());
+            }
+
+            FILE* out = std::fopen(batch_results, "w");
+            for (size_t i = 0; i < lines.size(); ++i) {
+                if (lines[i].empty()) {
+                    lines[i] = "FAIL " + batch[i].name + " cycles=0 instret=0 reason=crash\n";
+                }
+                if (lines[i].compare(0, 4, "PASS") != 0) failed = 1;
+                if (out) std::fputs(lines[i].c_str(), out);
+            }
+            if (out) std::fclose(out);
+            std::printf("[K10_TB] Batch results written to %s\n", batch_results);
+
+            stats.tests = 0;
+            for (int w = 0; w < batch_jobs && stats_path; ++w) {
+                stats.add_part(std::string(stats_path) + "." + std::to_string(w));
+            }
+            stats.print();
+            if (stats_path && !stats.write_json(stats_path, failed == 0)) failed = 1;
+            return failed;
+        }
+    }
+
+    // Verilator context
+    const std::unique_ptr<VerilatedContext> ctx{new VerilatedContext};
+    ctx->commandArgs(argc, argv);
+    stats.threads = ctx->threads();
+
+    const bool cosim = ctx->commandArgsPlusMatch("cosim")[0] != '\0';
+    if (ff.enabled && ctx->commandArgsPlusMatch("debug_req_cycle=")[0] != '\0') {
+        std::printf("[K10_TB] ERROR: --fast-forward cannot be combined with +debug_req_cycle\n");
+        return 1;
+    }
+    if (cosim && restore_path) {
+        std::printf("[K10_TB] ERROR: +cosim cannot start from a restored checkpoint\n");
+        return 1;
+    }
+
+    // An interactive debug session has no natural end, and a halted hart
+    // retires nothing: lift the cycle budget and the watchdog by default.
+    uint64_t max_cycles = plusarg_u64(*ctx, "max_cycles", jtag_port ? 0 : DEFAULT_MAX_CYCLES);
+    if (max_cycles == 0) max_cycles = UINT64_MAX;
+    IdleWatchdog watchdog;
+    watchdog.limit = plusarg_u64(*ctx, "max_idle_cycles",
+                                 jtag_port ? 0 : DEFAULT_MAX_IDLE_CYCLES);
+
     // DUT
     const std::unique_ptr<Vk10_tb> top{new Vk10_tb{ctx.get(), "TOP"}};
+    svSetScope(svGetScopeFromName("TOP.k10_tb"));
+    if (cosim && top->rootp->k10_tb__DOT__n_harts != 1) {
+        std::printf("[K10_TB] ERROR: +cosim needs a single-hart build (N_HARTS=%u)\n",
+                    static_cast<unsigned>(top->rootp->k10_tb__DOT__n_harts));
+        return 1;
+    }
+    // k10_trace_buf's CYCLE register and record timestamps count every
+    // cycle and are not advanced by the jump
+    if (ff.enabled && top->rootp->k10_tb__DOT__trace_buf) {
+        std::printf("[K10_TB] ERROR: --fast-forward cannot be used on a TRACE_BUF build\n");
+        return 1;
+    }
+
+    bool jtag_script_done = false;
+    uint64_t cycle = 0;
+    K10Elf elf;     // last ELF image loaded, for --dump-symbol and --profile
+    K10Profile profile;
+
+#ifdef K10_TB_SAVABLE
+    if (restore_path) {
+        if (!restore_checkpoint(restore_path, *ctx, *top, cycle, jtag_script_done)) return 1;
+        const char* trace_arg = ctx->commandArgsPlusMatch("trace_file=");
+        k10_tb_trace_reopen((trace_arg && trace_arg[0])
+                            ? trace_arg + std::strlen("+trace_file=") : TRACE_FILE);
+        const char* fw_arg = ctx->commandArgsPlusMatch("firmware=");
+        if (fw_arg && fw_arg[0]) {
+            if (!load_image(*top, fw_arg + std::strlen("+firmware="), elf)) return 1;
+        }
+    }
+#endif
+
+    auto& root = *top->rootp;
 
     // FST trace
 #ifdef VM_TRACE_FST
-    VerilatedFstC* tfp = nullptr;
     if (do_trace) {
         ctx->traceEverOn(true);
-        tfp = new VerilatedFstC;
-        top->trace(tfp, 99);
-        tfp->open("k10_sim.fst");
+        fst.tfp = new VerilatedFstC;
+        top->trace(fst.tfp, trace_depth);
+        if (trace_scope) fst.tfp->dumpvars(trace_depth, trace_scope);
+        fst.begin("k10_sim.fst", cycle);
         printf("[K10_TB] FST trace enabled: k10_sim.fst\n");
     }
 #else
     (void)do_trace;
+    (void)trace_depth;
+    (void)trace_scope;
 #endif
 
-    // Initialise signals
-    top->i_clk   = 0;
-    top->i_rst_n = 0;
-    top->i_jtag_tck = 0;
-    top->i_jtag_tms = 1;
-    top->i_jtag_trst_n = 1;
-    top->i_jtag_tdi = 0;
+    // Initialise signals (a restored checkpoint already carries them)
+    if (!restore_path) {
+        top->i_clk   = 0;
+        top->i_rst_n = 0;
+        top->i_jtag_tck = 0;
+        top->i_jtag_tms = 1;
+        top->i_jtag_trst_n = 1;
+        top->i_jtag_tdi = 0;
+        top->i_dmi_force = 0;
+        top->i_dmi_req_valid = 0;
+        top->i_dmi_req_op = 0;
+        top->i_dmi_req_addr = 0;
+        top->i_dmi_req_data = 0;
+    }
+
+    // --elf: run the initial blocks (MEM_INIT / +firmware $readmemh) first so
+    // they cannot overwrite the image.  A restored model has run them.
+    if (elf_path) {
+        if (!restore_path) top->eval();
+        if (!load_elf_image(*top, elf_path, elf)) return 1;
+    }
 
+    // in_jtag: the eval belongs to JTAG/DMI work, which is timed as a whole
+    bool in_jtag = false;
     auto eval_and_dump = [&](uint64_t step_ps) {
-        top->eval();
+        if (!stats.timed) {
+            top->eval();
 #ifdef VM_TRACE_FST
-        if (tfp) tfp->dump(ctx->time());
+            if (fst.dumping()) fst.tfp->dump(ctx->time());
 #endif
+        } else {
+            const auto t0 = SimStats::Clock::now();
+            top->eval();
+            const auto t1 = SimStats::Clock::now();
+            if (!in_jtag) stats.eval_s += SimStats::seconds(t1 - t0);
+#ifdef VM_TRACE_FST
+            if (fst.dumping()) {
+                fst.tfp->dump(ctx->time());
+                stats.dump_s += SimStats::seconds(SimStats::Clock::now() - t1);
+            }
+#endif
+        }
         ctx->timeInc(step_ps);
     };
 
+    auto jtag_begin = [&]() -> SimStats::Clock::time_point {
+        in_jtag = true;
+        return SimStats::Clock::now();
+    };
+    auto jtag_end = [&](SimStats::Clock::time_point t0) {
+        in_jtag = false;
+        stats.jtag_s += SimStats::seconds(SimStats::Clock::now() - t0);
+    };
+
     auto jtag_tick = [&](int tms, int tdi) -> int {
         top->i_jtag_tms = tms;
         top->i_jtag_tdi = tdi;
@@ -158,88 +1292,343 @@ int main(int argc, char** argv)
         for (int i = 0; i < ncycles; ++i) (void)jtag_tick(0, 0);
     };
 
-    bool jtag_script_done = false;
+    // One full clock period (2 eval calls per cycle)
+    auto clock_cycle = [&]() {
+        top->i_clk = 0;
+        eval_and_dump(5);
+        top->i_clk = 1;
+        eval_and_dump(5);
+    };
 
-    uint64_t cycle = 0;
-    int finish_status = 0;
+    // DMI access through the TAP: scan the request, then scan NOPs until the
+    // captured response is no longer busy.
+    auto dmi_exec_jtag = [&](uint8_t op, uint8_t a, uint32_t wdata,
+                             uint32_t& rdata, uint8_t& raddr, uint8_t& rresp) {
+        (void)dmi_scan(op, a, wdata);
+        jtag_idle(8);
+        for (int k = 0; k < 128; ++k) {
+            const uint64_t raw = dmi_scan(0, 0x00, 0x00000000);
+            jtag_idle(8);
+            unpack_dmi_resp(raw, rdata, raddr, rresp);
+            if ((rresp != 3) && (raddr == a)) break;
+        }
+    };
 
-    while (!ctx->gotFinish() && cycle < MAX_CYCLES) {
+    auto dmi_jtag_select = [&]() {
+        jtag_reset_to_idle();
+        jtag_shift_ir(0x10, 5); // DTMCS
+        uint32_t dtmcs = static_cast<uint32_t>(jtag_shift_dr(0, 32));
+        std::printf("[K10_TB:JTAG] dtmcs=0x%08x\n", dtmcs);
+        (void)jtag_shift_dr(0x00010000u, 32); // dmireset
+        jtag_idle(8);
+        (void)jtag_shift_dr(0x00000000u, 32);
+        jtag_idle(8);
 
-        // Toggle clock (2 eval calls per cycle)
-        top->i_clk = 0;
+        jtag_shift_ir(0x11, 5); // DMI
+    };
+
+    // DMI transactor: drive dm_top's request channel from the i_dmi_* ports
+    // (k10_tb.sv forces them on the falling edge).  Handshakes are sampled
+    // between the falling and the rising edge; each system clock spent here
+    // counts towards the run's cycle total.  A timeout returns resp=3 (busy).
+    auto dmi_exec_direct = [&](uint8_t op, uint8_t a, uint32_t wdata,
+                               uint32_t& rdata, uint8_t& raddr, uint8_t& rresp) {
+        rdata = 0;
+        raddr = a;
+        rresp = 3;
+        top->i_dmi_force     = 1;
+        top->i_dmi_req_valid = 1;
+        top->i_dmi_req_op    = op;
+        top->i_dmi_req_addr  = a;
+        top->i_dmi_req_data  = wdata;
+
+        bool accepted = false;
+        for (int k = 0; k < DMI_TIMEOUT_CYCLES && !accepted; ++k) {
+            top->i_clk = 0;
+            eval_and_dump(5);
+            accepted = top->o_dmi_req_ready;
+            top->i_clk = 1;
+            eval_and_dump(5);
+            cycle++;
+        }
+        top->i_dmi_req_valid = 0;
+        top->i_dmi_req_op    = 0;
+        if (!accepted) return;
+
+        for (int k = 0; k < DMI_TIMEOUT_CYCLES; ++k) {
+            top->i_clk = 0;
+            eval_and_dump(5);
+            const bool got = top->o_dmi_rsp_valid;
+            if (got) {
+                rdata = top->o_dmi_rsp_data;
+                rresp = top->o_dmi_rsp_resp;
+            }
+            top->i_clk = 1;
+            eval_and_dump(5);
+            cycle++;
+            if (got) return;
+        }
+    };
+
+    auto dmi_idle = [&](uint64_t ncycles) {
+        for (uint64_t i = 0; i < ncycles; ++i) {
+            clock_cycle();
+            cycle++;
+        }
+    };
+
+    // remote_bitbang: pin writes evaluate the TAP only; srst drives the
+    // system reset once the initial reset sequence is over.
+    K10JtagServer jtag_server;
+    if (jtag_port && !jtag_server.listen(static_cast<uint16_t>(jtag_port))) return 1;
+    const K10JtagServer::Pins jtag_pins{
+        [&](int tck, int tms, int tdi) {
+            top->i_jtag_tck = tck;
+            top->i_jtag_tms = tms;
+            top->i_jtag_tdi = tdi;
+            eval_and_dump(1);
+        },
+        [&]() -> int { return top->o_jtag_tdo & 0x1; },
+        [&](bool trst, bool srst) {
+            top->i_jtag_trst_n = trst ? 0 : 1;
+            if (cycle > static_cast<uint64_t>(RESET_CYCLES)) top->i_rst_n = srst ? 0 : 1;
+            eval_and_dump(1);
+        }
+    };
+    uint64_t jtag_next_poll = 0;
+
+    // Built-in sequence: halt hart 0 and read misa with an abstract command.
+    auto dmi_builtin = [&](const DmiExec& dmi_exec, const char* tag) {
+        uint32_t data = 0;
+        uint8_t addr = 0;
+        uint8_t resp = 0;
+
+        dmi_exec(2, 0x10, 0x00000001, data, addr, resp); // dmactive
+        std::printf("[%s] wr dmcontrol dmactive resp=%u\n", tag, resp);
+
+        dmi_exec(2, 0x10, 0x80000001, data, addr, resp); // haltreq + dmactive
+        std::printf("[%s] wr dmcontrol haltreq resp=%u\n", tag, resp);
+
+        dmi_exec(1, 0x11, 0x00000000, data, addr, resp);
+        std::printf("[%s] dmstatus=0x%08x addr=0x%02x resp=%u\n", tag, data, addr, resp);
+
+        dmi_exec(2, 0x17, 0x00321008, data, addr, resp); // command: read misa
+        std::printf("[%s] wr command resp=%u\n", tag, resp);
+
+        for (int i = 0; i < 8; ++i) {
+            dmi_exec(1, 0x16, 0x00000000, data, addr, resp);
+            std::printf("[%s] abstractcs[%d]=0x%08x resp=%u\n", tag, i, data, resp);
+        }
+
+        dmi_exec(1, 0x04, 0x00000000, data, addr, resp);
+        std::printf("[%s] data0=0x%08x addr=0x%02x resp=%u\n", tag, data, addr, resp);
+    };
+
+    if (batch_path) {
+        int failed = 0;
+        stats.tests = 0;
+
+        // Run initial blocks ($readmemh, tracer open) before the first
+        // backdoor load so they cannot overwrite it.
         top->eval();
+
+        const std::string part = (batch_jobs > 1)
+            ? std::string(batch_results) + "." + std::to_string(batch_worker)
+            : std::string(batch_results);
+        FILE* out = std::fopen(part.c_str(), "w");
+        if (!out) {
+            std::printf("[K10_TB] ERROR: Cannot write %s\n", part.c_str());
+            return 1;
+        }
+
+        for (size_t t = static_cast<size_t>(batch_worker); t < batch.size();
+             t += static_cast<size_t>(batch_jobs)) {
+            const BatchTest& test = batch[t];
+            std::printf("[K10_TB] === Batch test %zu/%zu: %s ===\n",
+                        t + 1, batch.size(), test.name.c_str());
+
+            top->i_rst_n = 0;
+            clock_cycle();
+            ctx->gotFinish(false);
+
+            const bool loaded = load_image(*top, test.hex.c_str(), elf);
+            if (cosim && loaded) cosim_start(*top);
+            k10_tb_trace_reopen((test.name + "_trace.csv").c_str());
+            k10_console().open_log((test.name + "_console.log").c_str());
 #ifdef VM_TRACE_FST
-        if (tfp) tfp->dump(ctx->time());
+            fst.begin(test.name + ".fst", 0);
 #endif
-        ctx->timeInc(5);
 
-        top->i_clk = 1;
-        top->eval();
+            uint64_t c = 0;
+            bool idle = false;
+            watchdog.reset(RESET_CYCLES);
+            ff.quiet = 0;
+            while (loaded && !ctx->gotFinish() && c < max_cycles) {
+                clock_cycle();
+                if (c == RESET_CYCLES) top->i_rst_n = 1;
+                c++;
+#ifdef VM_TRACE_FST
+                fst.step(c, root.k10_tb__DOT__commit_pc, root.k10_tb__DOT__exc_valid,
+                         root.k10_tb__DOT__exc_cause);
+#endif
+                if (c > RESET_CYCLES &&
+                    watchdog.check(c, root.k10_tb__DOT__instret_count,
+                                   root.k10_tb__DOT__commit_pc, root.k10_tb__DOT__wfi_sleep)) {
+                    watchdog.report(c);
+                    idle = true;
+                    break;
+                }
+                if (cosim && k10_cosim().failed()) break;
+                if (const uint64_t n = ff.step(root, c, max_cycles)) {
+                    c += n;
+                    ctx->timeInc(n * 10);
+                }
+            }
+            k10_console().flush();
+            if (cosim) k10_cosim().report();
+            if (loaded) dump_symbols(*top, elf, dump_syms);
+#if VM_COVERAGE
+            ctx->coveragep()->write(test.name + "_coverage.dat");
+            ctx->coveragep()->zero();
+#endif
+
+            const uint8_t status = loaded ? root.k10_tb__DOT__test_status
+                                           : static_cast<uint8_t>(TEST_RUNNING);
+            const bool cosim_failed = cosim && k10_cosim().failed();
+            const bool pass = test_passed(status) && !cosim_failed;
+            char line[1024];
+            std::snprintf(line, sizeof(line), "%s %s cycles=%lu instret=%lu reason=%s\n",
+                          pass ? "PASS" : "FAIL", test.name.c_str(), c,
+                          static_cast<uint64_t>(root.k10_tb__DOT__instret_count),
+                          !loaded ? "load" : idle ? "idle" : cosim_failed ? "cosim"
+                                                                    : test_reason(status));
+            std::printf("[K10_TB] %s", line);
+            if (batch_jobs > 1) std::fprintf(out, "%zu %s", t, line);
+            else                std::fputs(line, out);
+            std::fflush(out);
+            if (!pass) failed = 1;
 #ifdef VM_TRACE_FST
-        if (tfp) tfp->dump(ctx->time());
+            fst.finish(!pass);
+#endif
+            stats.cycles  += c;
+            stats.instret += root.k10_tb__DOT__instret_count;
+            stats.tests++;
+        }
+        std::fclose(out);
+        if (batch_jobs == 1) {
+            std::printf("[K10_TB] Batch results written to %s\n", batch_results);
+            stats.print();
+            if (stats_path && !stats.write_json(stats_path, failed == 0)) failed = 1;
+        } else if (stats_path) {
+            stats.write_part(std::string(stats_path) + "." + std::to_string(batch_worker));
+        }
+
+        top->final();
+#ifdef VM_TRACE_FST
+        delete fst.tfp;
+#endif
+        return failed;
+    }
+
+    int finish_status = 0;
+    bool checkpoint_saved = false;
+    bool idle = false;
+    bool dmi_failed = false;
+    bool cosim_failed = false;
+    const uint64_t start_cycle = cycle;
+    const uint64_t start_instret = root.k10_tb__DOT__instret_count;
+    watchdog.reset(cycle > static_cast<uint64_t>(RESET_CYCLES) ? cycle : RESET_CYCLES);
+
+    while (!ctx->gotFinish() && cycle < max_cycles) {
+
+        clock_cycle();
+#ifdef VM_TRACE_FST
+        fst.step(cycle + 1, root.k10_tb__DOT__commit_pc, root.k10_tb__DOT__exc_valid,
+                 root.k10_tb__DOT__exc_cause);
 #endif
-        ctx->timeInc(5);
 
         // Release reset after RESET_CYCLES
         if (cycle == RESET_CYCLES) {
+            if (cosim) cosim_start(*top);
             top->i_rst_n = 1;
         }
 
-        if (run_jtag_dmi && !jtag_script_done && cycle == (RESET_CYCLES + 30)) {
-            jtag_reset_to_idle();
-            jtag_shift_ir(0x10, 5); // DTMCS
-            uint32_t dtmcs = static_cast<uint32_t>(jtag_shift_dr(0, 32));
-            std::printf("[K10_TB:JTAG] dtmcs=0x%08x\n", dtmcs);
-            (void)jtag_shift_dr(0x00010000u, 32); // dmireset
-            jtag_idle(8);
-            (void)jtag_shift_dr(0x00000000u, 32);
-            jtag_idle(8);
+        if (run_debug && !jtag_script_done && cycle == (RESET_CYCLES + 30)) {
+            const auto t_jtag = jtag_begin();
+            if (run_jtag_dmi || (dmi_script_path && dmi_jtag)) dmi_jtag_select();
+            if (run_jtag_dmi) dmi_builtin(dmi_exec_jtag, "K10_TB:JTAG");
+            if (run_dmi)      dmi_builtin(dmi_exec_direct, "K10_TB:DMI");
+            if (dmi_script_path &&
+                !run_dmi_script(dmi_script, dmi_jtag ? DmiExec(dmi_exec_jtag)
+                                                     : DmiExec(dmi_exec_direct), dmi_idle)) {
+                finish_status = 1;
+                dmi_failed = true;
+            }
+            jtag_script_done = true;
+            jtag_end(t_jtag);
+            if (dmi_failed) break;
+        }
 
-            jtag_shift_ir(0x11, 5); // DMI
-
-            uint32_t data = 0;
-            uint8_t addr = 0;
-            uint8_t resp = 0;
-
-            auto dmi_exec = [&](uint8_t op, uint8_t a, uint32_t wdata,
-                                uint32_t& rdata, uint8_t& raddr, uint8_t& rresp) {
-                (void)dmi_scan(op, a, wdata);
-                jtag_idle(8);
-                for (int k = 0; k < 128; ++k) {
-                    const uint64_t raw = dmi_scan(0, 0x00, 0x00000000);
-                    jtag_idle(8);
-                    unpack_dmi_resp(raw, rdata, raddr, rresp);
-                    if ((rresp != 3) && (raddr == a)) break;
-                }
-            };
+        if (jtag_port && cycle >= jtag_next_poll) {
+            const auto t_jtag = jtag_begin();
+            const size_t handled = jtag_server.service(jtag_pins);
+            jtag_end(t_jtag);
+            if (jtag_server.quit()) break;
+            jtag_next_poll = cycle + (handled ? 1 : JTAG_IDLE_POLL_CYCLES);
+        }
 
-            dmi_exec(2, 0x10, 0x00000001, data, addr, resp); // dmactive
-            std::printf("[K10_TB:JTAG] wr dmcontrol dmactive resp=%u\n", resp);
+        cycle++;
 
-            dmi_exec(2, 0x10, 0x80000001, data, addr, resp); // haltreq + dmactive
-            std::printf("[K10_TB:JTAG] wr dmcontrol haltreq resp=%u\n", resp);
+        if (profile_path && cycle > static_cast<uint64_t>(RESET_CYCLES)) {
+            profile.sample(root.k10_tb__DOT__prof_pc, root.k10_tb__DOT__prof_retire,
+                           root.k10_tb__DOT__prof_instr);
+        }
 
-            dmi_exec(1, 0x11, 0x00000000, data, addr, resp);
-            std::printf("[K10_TB:JTAG] dmstatus=0x%08x addr=0x%02x resp=%u\n", data, addr, resp);
+        if (cycle > static_cast<uint64_t>(RESET_CYCLES) &&
+            watchdog.check(cycle, root.k10_tb__DOT__instret_count,
+                           root.k10_tb__DOT__commit_pc, root.k10_tb__DOT__wfi_sleep)) {
+            watchdog.report(cycle);
+            idle = true;
+            break;
+        }
 
-            dmi_exec(2, 0x17, 0x00321008, data, addr, resp); // command: read misa
-            std::printf("[K10_TB:JTAG] wr command resp=%u\n", resp);
+        if (cosim && k10_cosim().failed()) {
+            cosim_failed = true;
+            break;
+        }
 
-            for (int i = 0; i < 8; ++i) {
-                dmi_exec(1, 0x16, 0x00000000, data, addr, resp);
-                std::printf("[K10_TB:JTAG] abstractcs[%d]=0x%08x resp=%u\n", i, data, resp);
+#ifdef K10_TB_SAVABLE
+        if (save_path && cycle == save_at_cycle) {
+            if (!save_checkpoint(save_path, *ctx, *top, cycle, jtag_script_done)) {
+                finish_status = 1;
             }
-
-            dmi_exec(1, 0x04, 0x00000000, data, addr, resp);
-            std::printf("[K10_TB:JTAG] data0=0x%08x addr=0x%02x resp=%u\n", data, addr, resp);
-
-            jtag_script_done = true;
+            checkpoint_saved = true;
+            break;
         }
+#endif
 
-        cycle++;
+        if (ff.enabled) {
+            // Never jump past a cycle the loop acts on
+            uint64_t limit = max_cycles;
+            if (save_path && save_at_cycle > cycle && save_at_cycle <= limit) limit = save_at_cycle - 1;
+            const uint64_t dmi_start = RESET_CYCLES + 30;
+            if (run_debug && !jtag_script_done && dmi_start < limit) limit = dmi_start;
+            if (const uint64_t n = ff.step(root, cycle, limit)) {
+                cycle += n;
+                ctx->timeInc(n * 10);
+                if (profile_path) profile.sample(root.k10_tb__DOT__prof_pc, false, 0, n);
+            }
+        }
     }
 
-    if (cycle >= MAX_CYCLES && !ctx->gotFinish()) {
+    k10_console().flush();
+    if (checkpoint_saved) {
+        // Nothing further to report; the run resumes from the checkpoint.
+    } else if (jtag_server.quit()) {
+        printf("[K10_TB] OpenOCD shutdown after %lu cycles\n", cycle);
+    } else if (idle || dmi_failed || cosim_failed) {
+        finish_status = 1;
+    } else if (cycle >= max_cycles && !ctx->gotFinish()) {
         printf("[K10_TB] ERROR: Timeout after %lu cycles\n", cycle);
         finish_status = 1;
     } else {
@@ -248,13 +1637,36 @@ int main(int argc, char** argv)
 
     // Cleanup
     top->final();
+    if (cosim) k10_cosim().report();
+    dump_symbols(*top, elf, dump_syms);
+    ff.report();
+    if (profile_path && !checkpoint_saved && !profile.write(profile_path, elf, profile_top)) {
+        finish_status = 1;
+    }
+#if VM_COVERAGE
+    if (!checkpoint_saved) {
+        const char* cov = coverage_path ? coverage_path : COVERAGE_FILE;
+        ctx->coveragep()->write(cov);
+        std::printf("[K10_TB] Coverage written to %s\n", cov);
+    }
+#endif
+
+    stats.cycles  = cycle - start_cycle;
+    stats.instret = root.k10_tb__DOT__instret_count - start_instret;
+    stats.print();
 
 #ifdef VM_TRACE_FST
-    if (tfp) {
-        tfp->close();
-        delete tfp;
-    }
+    const uint8_t status = root.k10_tb__DOT__test_status;
+    fst.finish(finish_status != 0 || status == TEST_FAIL_CTRL || status == TEST_FAIL_EBREAK);
+    delete fst.tfp;
 #endif
 
+    if (stats_path) {
+        const uint8_t verdict = root.k10_tb__DOT__test_status;
+        const bool passed = finish_status == 0 &&
+                            verdict != TEST_FAIL_CTRL && verdict != TEST_FAIL_EBREAK;
+        if (!stats.write_json(stats_path, passed)) finish_status = 1;
+    }
+
     return finish_status;
 }
@@ -12,7 +12,15 @@ module k10_tb
 #(
     parameter int          MEM_SIZE_KB = 64,
     parameter              MEM_INIT    = "",
-    parameter logic [31:0] BOOT_ADDR   = 32'h8000_0000
+    parameter logic [31:0] BOOT_ADDR   = 32'h8000_0000,
+    parameter bit          BRANCH_PRED = 1'b1,
+    parameter bit          FAST_DIV    = 1'b1,
+    parameter int unsigned MUL_STAGES  = 1,
+    parameter int unsigned PREFETCH_DEPTH = 4,
+    parameter bit          ICACHE      = 1'b0,
+    parameter int unsigned STORE_BUFFER = 4,
+    parameter bit          TRACE_BUF   = 1'b0,
+    parameter int unsigned N_HARTS     = 1
 )(
     input  logic i_clk,
     input  logic i_rst_n,
@@ -20,7 +28,18 @@ module k10_tb
     input  logic i_jtag_tms,
     input  logic i_jtag_trst_n,
     input  logic i_jtag_tdi,
-    output logic o_jtag_tdo
+    output logic o_jtag_tdo,
+
+    // DMI transactor (driven by k10_tb.cpp --run-dmi / --dmi-script)
+    input  logic        i_dmi_force,
+    input  logic        i_dmi_req_valid,
+    input  logic [1:0]  i_dmi_req_op,
+    input  logic [6:0]  i_dmi_req_addr,
+    input  logic [31:0] i_dmi_req_data,
+    output logic        o_dmi_req_ready,
+    output logic        o_dmi_rsp_valid,
+    output logic [31:0] o_dmi_rsp_data,
+    output logic [1:0]  o_dmi_rsp_resp
 );
 
     /* verilator lint_off SYNCASYNCNET */
@@ -38,7 +57,15 @@ module k10_tb
         .MEM_BASE    (32'h8000_0000),
         .MEM_MASK    (32'hFFFF_0000),
         .MEM_INIT    (MEM_INIT),
-        .BOOT_ADDR   (BOOT_ADDR)
+        .BOOT_ADDR   (BOOT_ADDR),
+        .BRANCH_PRED (BRANCH_PRED),
+        .FAST_DIV    (FAST_DIV),
+        .MUL_STAGES  (MUL_STAGES),
+        .PREFETCH_DEPTH (PREFETCH_DEPTH),
+        .ICACHE      (ICACHE),
+        .STORE_BUFFER (STORE_BUFFER),
+        .TRACE_BUF   (TRACE_BUF),
+        .N_HARTS     (N_HARTS)
     ) u_dut (
         .i_clk       (i_clk),
         .i_rst_n     (i_rst_n),
@@ -298,7 +325,7 @@ module k10_tb
         end
     end
 
-    longint unsigned cycle_count /* verilator public */;
+    longint unsigned cycle_count /* verilator public_flat_rw */;
     always_ff @(posedge i_clk or negedge i_rst_n) begin
         if (!i_rst_n)
             cycle_count <= 0;
@@ -306,6 +333,230 @@ module k10_tb
             cycle_count <= cycle_count + 1;
     end
 
+    // -------------------------------------------------------------------------
+    // Test verdict and retire progress (read by k10_tb.cpp through rootp)
+    // -------------------------------------------------------------------------
+    // Latched on the same edge as the $finish that ends the test, so the
+    // driver can report PASS/FAIL without parsing stdout.
+    // -------------------------------------------------------------------------
+    localparam logic [2:0] TEST_RUNNING     = 3'd0;
+    localparam logic [2:0] TEST_PASS_CTRL   = 3'd1;  // SIM_CTRL write, bit 0 = 1
+    localparam logic [2:0] TEST_FAIL_CTRL   = 3'd2;  // SIM_CTRL write, bit 0 = 0
+    localparam logic [2:0] TEST_PASS_ECALL  = 3'd3;  // +finish_on_ecall
+    localparam logic [2:0] TEST_FAIL_EBREAK = 3'd4;  // +finish_on_ebreak
+
+    logic [2:0]      test_status /* verilator public */;
+    longint unsigned instret_count /* verilator public */;
+    logic [31:0]     commit_pc /* verilator public */;     // idle watchdog
+    logic            wfi_sleep /* verilator public */;     // idle watchdog
+    logic [31:0]     boot_addr /* verilator public */;     // --elf entry check
+    logic [7:0]      n_harts /* verilator public */;       // --cosim: hart 0 only
+    logic            trace_buf /* verilator public */;     // no --fast-forward
+    logic            exc_valid /* verilator public */;     // FST trigger
+    logic [31:0]     exc_cause /* verilator public */;
+    logic            w_sim_ctrl_finish;
+
+    assign exc_valid = u_dut.u_top.u_core.w_exc_valid;
+    assign wfi_sleep = u_dut.u_top.u_core.w_wfi_stall;
+    assign boot_addr = BOOT_ADDR;
+    assign n_harts   = 8'(N_HARTS);
+    assign trace_buf = TRACE_BUF;
+    assign exc_cause = u_dut.u_top.u_core.w_exc_cause;
+
+    assign w_sim_ctrl_finish = u_dut.u_sim_ctrl.r_aw_pending &&
+                               u_dut.u_sim_ctrl.r_w_pending  &&
+                               !u_dut.u_sim_ctrl.r_bvalid    &&
+                               (u_dut.u_sim_ctrl.r_aw_addr == '0);
+
+    always_ff @(posedge i_clk or negedge i_rst_n) begin
+        if (!i_rst_n) begin
+            test_status   <= TEST_RUNNING;
+            instret_count <= 0;
+            commit_pc     <= 32'h0;
+        end else begin
+            if (u_dut.u_top.u_core.r_mem_wb.valid) begin
+                instret_count <= instret_count + 1;
+                commit_pc     <= u_dut.u_top.u_core.r_mem_wb.pc;
+            end
+
+            if (test_status == TEST_RUNNING) begin
+                if (w_sim_ctrl_finish)
+                    test_status <= u_dut.u_sim_ctrl.r_w_data[0] ? TEST_PASS_CTRL
+                                                                : TEST_FAIL_CTRL;
+                else if (r_finish_pending && (r_finish_count == 0))
+                    test_status <= TEST_PASS_ECALL;
+                else if ((r_finish_on_ebreak != 0) &&
+                         u_dut.u_top.u_core.w_exc_valid &&
+                         (u_dut.u_top.u_core.w_exc_cause == 32'd3))
+                    test_status <= TEST_FAIL_EBREAK;
+            end
+        end
+    end
+
+    // -------------------------------------------------------------------------
+    // WFI fast-forward (read by k10_tb.cpp --fast-forward)
+    // -------------------------------------------------------------------------
+    // ff_quiet: the core sleeps in WFI with an empty pipeline behind it, no
+    // bus master is requesting or waiting for a response, the UART is not
+    // shifting (nor polling the host, +uart_backdoor) and no HPM event is
+    // counting.  While it holds, the only state that changes per cycle is
+    // mtime, mcycle (unless inhibited), the sim_ctrl cycle counter read as
+    // SIM_STATUS and cycle_count, which the driver can then advance in one
+    // step.  Only hart 0 is checked, so it never holds with N_HARTS > 1.
+    // k10_trace_buf has its own cycle counter and timestamps records with
+    // it, so k10_tb.cpp rejects --fast-forward on a TRACE_BUF build.
+    // -------------------------------------------------------------------------
+    logic        ff_quiet /* verilator public */;
+    logic        ff_timer_wake /* verilator public */;  // MTIE set: mtimecmp wakes
+    logic        ff_mcycle_en /* verilator public */;
+
+    assign ff_quiet = (N_HARTS == 1)                           &&
+                      u_dut.u_top.u_core.w_wfi_stall           &&
+                      !u_dut.u_top.u_core.r_ex_mem.valid       &&
+                      !u_dut.u_top.u_core.r_mem_wb.valid       &&
+                      u_dut.u_top.u_core.w_sb_empty            &&
+                      (u_dut.u_top.u_core.w_hpm_event == '0)   &&
+                      !u_dut.w_ibus_req && !u_dut.w_ibus_rvalid &&
+                      !u_dut.w_ibus_mem_req && !u_dut.w_ibus_mem_rvalid &&
+                      !u_dut.w_dbus_req && !u_dut.w_dbus_rvalid &&
+                      !u_dut.w_dm_host_req                     &&
+                      (u_dut.r_dm_state == '0)                &&  // DM_IDLE
+                      (u_dut.u_ibus_adapter.r_ord_cnt == '0)   &&
+                      (u_dut.u_dbus_adapter.r_ord_cnt == '0)   &&
+                      !u_dut.u_uart.r_tx_busy && !u_dut.u_uart.w_backdoor;
+    assign ff_timer_wake = u_dut.u_top.u_core.u_csr.r_mie_mtie;
+    assign ff_mcycle_en  = !u_dut.u_top.u_core.u_csr.r_mcountinhibit[0];
+
+    // -------------------------------------------------------------------------
+    // Cycle profiler (read by k10_tb.cpp --profile)
+    // -------------------------------------------------------------------------
+    // prof_pc: the PC this cycle is charged to — the instruction retiring from
+    // MEM/WB, else the oldest one still in flight, else the fetch PC.
+    // -------------------------------------------------------------------------
+    logic [31:0] prof_pc /* verilator public */;
+    logic        prof_retire /* verilator public */;
+    logic [31:0] prof_instr /* verilator public */;
+
+    assign prof_retire = u_dut.u_top.u_core.r_mem_wb.valid;
+    assign prof_instr  = u_dut.u_top.u_core.r_mem_wb.instr;
+
+    always_comb begin
+        if (u_dut.u_top.u_core.r_mem_wb.valid)
+            prof_pc = u_dut.u_top.u_core.r_mem_wb.pc;
+        else if (u_dut.u_top.u_core.r_ex_mem.valid)
+            prof_pc = u_dut.u_top.u_core.r_ex_mem.pc;
+        else if (u_dut.u_top.u_core.r_id_ex.valid)
+            prof_pc = u_dut.u_top.u_core.r_id_ex.pc;
+        else if (u_dut.u_top.u_core.r_if_id.valid)
+            prof_pc = u_dut.u_top.u_core.r_if_id.pc;
+        else
+            prof_pc = u_dut.u_top.u_core.w_if_pc;
+    end
+
+    // -------------------------------------------------------------------------
+    // Functional coverage (sim_cov target, written by k10_tb.cpp --coverage)
+    // -------------------------------------------------------------------------
+    // Hart 0 only; see k10_cov.sv for the bins.  k10_soc keeps the default
+    // 16 PMP regions, which is also k10_cov's.
+    // -------------------------------------------------------------------------
+`ifdef K10_COVERAGE
+    k10_cov u_cov (
+        .i_clk          (i_clk),
+        .i_rst_n        (i_rst_n),
+        .i_retire       (u_dut.u_top.u_core.r_mem_wb.valid),
+        .i_retire_instr (u_dut.u_top.u_core.r_mem_wb.instr),
+        .i_retire_ctrl  (u_dut.u_top.u_core.r_mem_wb.ctrl),
+        .i_trap_taken   (u_dut.u_top.u_core.w_trap_taken),
+        .i_exc_valid    (u_dut.u_top.u_core.w_exc_valid),
+        .i_exc_cause    (u_dut.u_top.u_core.w_exc_cause),
+        .i_irq_cause    (u_dut.u_top.u_core.u_csr.w_irq_cause),
+        .i_priv         (u_dut.u_top.u_core.w_csr_priv),
+        .i_mret_taken   (u_dut.u_top.u_core.w_mret_taken),
+        .i_dret_taken   (u_dut.u_top.u_core.w_dret_taken),
+        .i_debug_taken  (u_dut.u_top.u_core.w_debug_taken),
+        .i_dbus_access  (u_dut.u_top.u_core.r_ex_mem.valid &&
+                         (u_dut.u_top.u_core.r_ex_mem.ctrl.mem_read ||
+                          u_dut.u_top.u_core.r_ex_mem.ctrl.mem_write)),
+        .i_dbus_write   (u_dut.u_top.u_core.r_ex_mem.ctrl.mem_write),
+        .i_pmp_match    (u_dut.u_top.u_core.u_pmp_dbus.w_match),
+        .i_pmp_allowed  (u_dut.u_top.u_core.w_dbus_pmp_ok),
+        .i_id_ex_valid  (u_dut.u_top.u_core.r_id_ex.valid),
+        .i_fwd_a        (u_dut.u_top.u_core.w_fwd_a),
+        .i_fwd_b        (u_dut.u_top.u_core.w_fwd_b),
+        .i_hpm_event    (u_dut.u_top.u_core.w_hpm_event),
+        .i_stall_ex     (u_dut.u_top.u_core.w_stall_ex),
+        .i_stall_mem    (u_dut.u_top.u_core.w_stall_mem),
+        .i_wfi_stall    (u_dut.u_top.u_core.w_wfi_stall),
+        .i_fence_i_wait (u_dut.u_top.u_core.w_ex_fence_i_wait)
+    );
+`endif
+
+    // -------------------------------------------------------------------------
+    // DMI transactor
+    // -------------------------------------------------------------------------
+    // Once i_dmi_force is raised, dm_top's DMI request/response channel is
+    // taken over from dmi_jtag and driven from the i_dmi_* ports, so the C++
+    // driver can issue one DMI access per handful of system clocks instead of
+    // ~100 bit-banged TCK cycles.  The forces are re-applied on the falling
+    // edge, which keeps them stable across the rising edge that dm_top
+    // samples on.  Not meant to be combined with +run_dmi_script.
+    // -------------------------------------------------------------------------
+    assign o_dmi_req_ready = u_dut.u_dm_top.dmi_req_ready;
+    assign o_dmi_rsp_valid = u_dut.u_dm_top.dmi_rsp_valid;
+    assign o_dmi_rsp_data  = u_dut.u_dm_top.dmi_rsp.data;
+    assign o_dmi_rsp_resp  = u_dut.u_dm_top.dmi_rsp.resp;
+
+    always_ff @(negedge i_clk) begin
+        if (i_dmi_force) begin
+            force u_dut.u_dm_top.dmi_rst_n     = 1'b1;
+            force u_dut.u_dm_top.dmi_rsp_ready = 1'b1;
+            force u_dut.u_dm_top.dmi_req_valid = i_dmi_req_valid;
+            force u_dut.u_dm_top.dmi_req.op    = dm::dtm_op_e'(i_dmi_req_op);
+            force u_dut.u_dm_top.dmi_req.addr  = i_dmi_req_addr;
+            force u_dut.u_dm_top.dmi_req.data  = i_dmi_req_data;
+        end
+    end
+
+    // -------------------------------------------------------------------------
+    // DPI hooks for k10_tb.cpp
+    // -------------------------------------------------------------------------
+    // k10_tb_trace_reopen: called after VerilatedRestore — the tracer's file
+    // handle was opened by the process that wrote the checkpoint — and by
+    // --batch mode to give every test its own trace CSV.
+    // -------------------------------------------------------------------------
+    export "DPI-C" function k10_tb_trace_reopen;
+
+    function automatic void k10_tb_trace_reopen(input string path);
+        u_dut.u_top.u_core.u_tracer.trace_open(path);
+    endfunction
+
+    // -------------------------------------------------------------------------
+    // Lockstep co-simulation events (+cosim)
+    // -------------------------------------------------------------------------
+    // k10_tracer reports retirements; the ISS additionally needs to know
+    // when the CSR file takes an interrupt (cause and the EPC it saves) and
+    // when the hart enters debug mode, after which checking stops.
+    // -------------------------------------------------------------------------
+`ifdef VERILATOR
+    import "DPI-C" function void k10_cosim_interrupt(input int cause, input int epc);
+    import "DPI-C" function void k10_cosim_debug_entry();
+
+    bit r_cosim;
+    initial r_cosim = $test$plusargs("cosim");
+
+    always_ff @(posedge i_clk) begin
+        if (r_cosim && i_rst_n) begin
+            if (u_dut.u_top.u_core.w_trap_taken && !u_dut.u_top.u_core.w_exc_valid) begin
+                k10_cosim_interrupt(u_dut.u_top.u_core.u_csr.w_irq_cause,
+                                    u_dut.u_top.u_core.w_async_epc);
+            end
+            if (u_dut.u_top.u_core.w_debug_taken) begin
+                k10_cosim_debug_entry();
+            end
+        end
+    end
+`endif
+
     /* verilator lint_on SYNCASYNCNET */
 
 endmodule : k10_tb
@@ -0,0 +1,126 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Binary Instruction Trace Writer  (Verilator testbench only)
+// ============================================================================
+// See k10_trace_writer.h for the file format.  The DPI entry points at the
+// bottom are imported by k10_tracer.sv.
+// ============================================================================
+
+#include <cstdio>
+#include <cstring>
+
+#include "k10_trace_writer.h"
+#include "Vk10_tb__Dpi.h"
+
+bool K10TraceWriter::open(const std::string& path)
+{
+    close();
+
+    m_fp = std::fopen(path.c_str(), "wb");
+    if (!m_fp) return false;
+
+    char magic[8];
+    std::memcpy(magic, "K10TRACE", sizeof(magic));
+    const uint32_t version = K10_TRACE_VERSION;
+    const uint32_t rec_size = sizeof(K10TraceRecord);
+    std::fwrite(magic, sizeof(magic), 1, m_fp);
+    std::fwrite(&version, sizeof(version), 1, m_fp);
+    std::fwrite(&rec_size, sizeof(rec_size), 1, m_fp);
+
+    m_fill.reserve(BUFFER_RECORDS);
+    m_drain.reserve(BUFFER_RECORDS);
+    m_stop = false;
+    m_drain_ready = false;
+    m_thread = std::thread(&K10TraceWriter::run, this);
+    return true;
+}
+
+void K10TraceWriter::close()
+{
+    if (!m_fp) return;
+
+    if (!m_fill.empty()) hand_off();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+
+    std::fclose(m_fp);
+    m_fp = nullptr;
+}
+
+// Swap the fill buffer into the writer thread.  Blocks only while the
+// previous buffer is still being written.
+void K10TraceWriter::hand_off()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return !m_drain_ready; });
+    m_fill.swap(m_drain);
+    m_drain_ready = true;
+    lock.unlock();
+    m_cv.notify_all();
+}
+
+void K10TraceWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_cv.wait(lock, [this] { return m_drain_ready || m_stop; });
+        if (m_drain_ready) {
+            lock.unlock();
+            std::fwrite(m_drain.data(), sizeof(K10TraceRecord), m_drain.size(), m_fp);
+            m_drain.clear();
+            lock.lock();
+            m_drain_ready = false;
+            m_cv.notify_all();
+        } else if (m_stop) {
+            break;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// DPI entry points (imported by k10_tracer.sv under +trace_format=bin)
+// ----------------------------------------------------------------------------
+static K10TraceWriter g_trace_writer;
+
+void k10_trace_bin_open(const char* path)
+{
+    if (!g_trace_writer.open(path)) {
+        std::printf("[K10_TRACER] ERROR: Cannot open %s\n", path);
+    }
+}
+
+// SV "int"/"byte" arguments arrive signed; the records are raw bit patterns.
+void k10_trace_bin_commit(int pc, int instr, char rd, int rd_data, char flags)
+{
+    if (!g_trace_writer.is_open()) return;
+    K10TraceRecord rec;
+    rec.pc       = static_cast<uint32_t>(pc);
+    rec.instr    = static_cast<uint32_t>(instr);
+    rec.rd_data  = static_cast<uint32_t>(rd_data);
+    rec.rd       = static_cast<uint8_t>(rd);
+    rec.flags    = static_cast<uint8_t>(flags);
+    rec.reserved = 0;
+    g_trace_writer.push(rec);
+}
+
+void k10_trace_bin_close()
+{
+    g_trace_writer.close();
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 The Komandara Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ============================================================================
+// K10 — Binary Instruction Trace Writer  (Verilator testbench only)
+// ============================================================================
+// Back end of k10_tracer's +trace_format=bin mode.  The tracer pushes one
+// fixed-size record per retired instruction over DPI; records collect in a
+// fill buffer that is handed to a background thread for fwrite(), so the
+// simulation thread never blocks on file I/O unless the writer falls a
+// full buffer behind.
+//
+// File layout (little-endian):
+//   header : "K10TRACE" magic, uint32 version, uint32 record size
+//   records: K10TraceRecord[]
+//
+// scripts/k10_trace_bin2csv.py converts a file back to the riscv-dv CSV
+// produced by the text tracer.
+// ============================================================================
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct K10TraceRecord {
+    uint32_t pc;
+    uint32_t instr;
+    uint32_t rd_data;
+    uint8_t  rd;
+    uint8_t  flags;     // [0] rd written, [2:1] privilege mode
+    uint16_t reserved;
+};
+static_assert(sizeof(K10TraceRecord) == 16, "K10TraceRecord must stay 16 bytes");
+
+static constexpr uint32_t K10_TRACE_VERSION  = 1;
+static constexpr uint8_t  K10_TRACE_FLAG_RD  = 0x1;
+
+class K10TraceWriter {
+public:
+    static constexpr size_t BUFFER_RECORDS = 1u << 16;   // 1 MiB per buffer
+
+    K10TraceWriter() = default;
+    K10TraceWriter(const K10TraceWriter&) = delete;
+    K10TraceWriter& operator=(const K10TraceWriter&) = delete;
+    ~K10TraceWriter() { close(); }
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return m_fp != nullptr; }
+
+    void push(const K10TraceRecord& rec)
+    {
+        m_fill.push_back(rec);
+        if (m_fill.size() >= BUFFER_RECORDS) hand_off();
+    }
+
+private:
+    void hand_off();
+    void run();
+
+    FILE*                       m_fp = nullptr;
+    std::vector<K10TraceRecord> m_fill;
+    std::vector<K10TraceRecord> m_drain;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_cv;
+    bool                        m_drain_ready = false;
+    bool                        m_stop = false;
+    std::thread                 m_thread;
+};
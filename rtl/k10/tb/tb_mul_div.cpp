@@ -12,12 +12,49 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// ============================================================================
+// K10 — Standalone Mul/Div Testbench + Differential Fuzzer
+// ============================================================================
+// Two phases:
+//   1. Directed vectors (basic, signed, div-by-zero, overflow, riscv-dv
+//      regressions, back-to-back divides and multiplies).
+//   2. Randomised differential fuzzing.  N worker threads each own a
+//      private VerilatedContext + Vtb_mul_div, drive constrained-random and
+//      corner-case operands (0, ±1, INT_MIN, INT_MAX, ±2^k, 2^k-1, small
+//      values, random magnitudes) and check every result against the
+//      golden RISC-V functions below.
+//
+// Options:
+//   --threads <N>   worker threads (default: hardware concurrency)
+//   --ops <N>       total random operations (default 1000000; 0 = until
+//                   --seconds expires or Ctrl-C)
+//   --seconds <S>   stop the random phase after S seconds
+//   --seed <S>      base seed; thread t uses a seed derived from (S, t)
+//   --op <name>     restrict to one op (mul, mulh, mulhsu, mulhu, div,
+//                   divu, rem, remu); may be repeated
+//   --progress <S>  progress line every S seconds (default 10, 0 = off)
+//
+// The report gives ops/sec overall and per op, plus a histogram of
+// start-to-o_done cycles per op.  Failures print op, operands, DUT and
+// expected results, which is all that is needed to reproduce them as a
+// directed vector.
+// ============================================================================
+
 #include "Vtb_mul_div.h"
 #include "verilated.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
 #include <cstdio>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
 
 // MD operation encodings (from komandara_k10_pkg)
 enum MdOp {
@@ -29,110 +66,17 @@ enum MdOp {
     MD_DIVU   = 5,
     MD_REM    = 6,
     MD_REMU   = 7,
+    MD_NUM_OPS
 };
 
-static Vtb_mul_div* dut;
-static uint64_t sim_time = 0;
-static int pass_count = 0;
-static int fail_count = 0;
-
-static void tick() {
-    dut->i_clk = 0;
-    dut->eval();
-    sim_time++;
-    dut->i_clk = 1;
-    dut->eval();
-    sim_time++;
-}
-
-static void reset() {
-    dut->i_rst_n = 0;
-    dut->i_start = 0;
-    dut->i_op    = 0;
-    dut->i_a     = 0;
-    dut->i_b     = 0;
-    for (int i = 0; i < 5; i++) tick();
-    dut->i_rst_n = 1;
-    tick();
-}
-
-// Run a divide/remainder operation, mimicking pipeline behavior:
-//   - Hold i_start high during the entire computation
-//   - When o_done goes high, capture the result
-//   - Then deassert i_start (pipeline advances)
-//   - Return the captured result
-static uint32_t run_div_op(uint8_t op, uint32_t a, uint32_t b,
-                           int* cycles_out = nullptr) {
-    dut->i_op    = op;
-    dut->i_a     = a;
-    dut->i_b     = b;
-    dut->i_start = 1;
-
-    int cycles = 0;
-    uint32_t result = 0;
-    bool captured = false;
-
-    for (int i = 0; i < 200; i++) {
-        tick();
-        cycles++;
-
-        if (dut->o_done && !captured) {
-            result = dut->o_result;
-            captured = true;
-
-            // Check: when o_done is high, o_busy should be low
-            if (dut->o_busy) {
-                printf("  [WARN] o_busy still high when o_done asserted at cycle %d\n", cycles);
-            }
-            break;
-        }
-    }
-
-    if (!captured) {
-        printf("  [ERROR] Timeout: o_done never asserted after 200 cycles\n");
-        fail_count++;
-        dut->i_start = 0;
-        tick();
-        return 0xDEADBEEF;
-    }
-
-    // Deassert start (pipeline advances)
-    dut->i_start = 0;
-    tick();
-
-    if (cycles_out) *cycles_out = cycles;
-    return result;
-}
-
-// Run a multiply operation (single-cycle)
-static uint32_t run_mul_op(uint8_t op, uint32_t a, uint32_t b) {
-    dut->i_op    = op;
-    dut->i_a     = a;
-    dut->i_b     = b;
-    dut->i_start = 1;
-    tick();
-
-    uint32_t result = dut->o_result;
+static const char* const MD_OP_NAMES[MD_NUM_OPS] = {
+    "mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu"
+};
 
-    if (!dut->o_done) {
-        printf("  [ERROR] o_done not asserted for multiply\n");
-        fail_count++;
-    }
+static bool is_mul_op(unsigned op) { return op <= MD_MULHU; }
 
-    dut->i_start = 0;
-    tick();
-    return result;
-}
-
-static void check(const char* name, uint32_t got, uint32_t expected) {
-    if (got == expected) {
-        printf("  [PASS] %-40s got=0x%08x\n", name, got);
-        pass_count++;
-    } else {
-        printf("  [FAIL] %-40s got=0x%08x expected=0x%08x\n", name, got, expected);
-        fail_count++;
-    }
-}
+// o_done must arrive within this many cycles of i_start
+static constexpr int MAX_CYCLES = 200;
 
 // Compute expected RISC-V results
 static uint32_t riscv_div(int32_t a, int32_t b) {
@@ -157,146 +101,576 @@ static uint32_t riscv_remu(uint32_t a, uint32_t b) {
     return a % b;
 }
 
-int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    dut = new Vtb_mul_div;
+static uint32_t riscv_md(unsigned op, uint32_t a, uint32_t b) {
+    const int64_t  sa = (int32_t)a, sb = (int32_t)b;
+    const uint64_t ua = a,          ub = b;
+    switch (op) {
+        case MD_MUL:    return a * b;
+        case MD_MULH:   return (uint32_t)((uint64_t)(sa * sb) >> 32);
+        case MD_MULHSU: return (uint32_t)((uint64_t)(sa * (int64_t)ub) >> 32);
+        case MD_MULHU:  return (uint32_t)((ua * ub) >> 32);
+        case MD_DIV:    return riscv_div((int32_t)a, (int32_t)b);
+        case MD_DIVU:   return riscv_divu(a, b);
+        case MD_REM:    return riscv_rem((int32_t)a, (int32_t)b);
+        default:        return riscv_remu(a, b);
+    }
+}
 
-    printf("=== k10_mul_div standalone testbench ===\n\n");
+// ----------------------------------------------------------------------------
+// One k10_mul_div instance with its own context (safe to run per thread)
+// ----------------------------------------------------------------------------
+class MulDivHarness {
+public:
+    MulDivHarness() : m_dut(new Vtb_mul_div(&m_ctx)) {}
+    ~MulDivHarness() { m_dut->final(); }
+
+    int pass_count = 0;
+    int fail_count = 0;
+
+    void tick() {
+        m_dut->i_clk = 0;
+        m_dut->eval();
+        m_dut->i_clk = 1;
+        m_dut->eval();
+    }
+
+    void reset() {
+        m_dut->i_rst_n = 0;
+        m_dut->i_start = 0;
+        m_dut->i_op    = 0;
+        m_dut->i_a     = 0;
+        m_dut->i_b     = 0;
+        m_dut->i_advance = 0;
+        for (int i = 0; i < 5; i++) tick();
+        m_dut->i_rst_n = 1;
+        tick();
+    }
+
+    // Issue one operation the way the pipeline does: hold i_start until
+    // o_done, capture o_result, then drop i_start for one cycle.  Returns
+    // false on timeout; *cycles counts ticks from issue to o_done.
+    bool run_op(uint8_t op, uint32_t a, uint32_t b, uint32_t* result, int* cycles,
+                bool* busy_at_done) {
+        m_dut->i_op    = op;
+        m_dut->i_a     = a;
+        m_dut->i_b     = b;
+        m_dut->i_start = 1;
+
+        bool captured = false;
+        int n = 0;
+        while (n < MAX_CYCLES) {
+            tick();
+            n++;
+            if (m_dut->o_done) {
+                *result = m_dut->o_result;
+                *busy_at_done = m_dut->o_busy;
+                captured = true;
+                break;
+            }
+        }
+
+        // Deassert start (pipeline advances)
+        m_dut->i_start = 0;
+        tick();
+        *cycles = n;
+        return captured;
+    }
+
+    // Run a divide/remainder operation, mimicking pipeline behavior
+    uint32_t run_div_op(uint8_t op, uint32_t a, uint32_t b, int* cycles_out = nullptr) {
+        uint32_t result = 0;
+        int cycles = 0;
+        bool busy = false;
+        if (!run_op(op, a, b, &result, &cycles, &busy)) {
+            printf("  [ERROR] Timeout: o_done never asserted after %d cycles\n", MAX_CYCLES);
+            fail_count++;
+            return 0xDEADBEEF;
+        }
+        // Check: when o_done is high, o_busy should be low
+        if (busy) {
+            printf("  [WARN] o_busy still high when o_done asserted at cycle %d\n", cycles);
+        }
+        if (cycles_out) *cycles_out = cycles;
+        return result;
+    }
 
+    int mul_stages() const { return m_dut->o_mul_stages; }
+
+    // Run a multiply operation (MUL_STAGES cycles)
+    uint32_t run_mul_op(uint8_t op, uint32_t a, uint32_t b) {
+        uint32_t result = 0;
+        int cycles = 0;
+        bool busy = false;
+        if (!run_op(op, a, b, &result, &cycles, &busy) || cycles != mul_stages()) {
+            printf("  [ERROR] o_done not asserted after %d cycles for multiply\n",
+                   mul_stages());
+            fail_count++;
+        }
+        return result;
+    }
+
+    // Back-to-back multiplies the way the pipeline issues them: i_start stays
+    // high and i_advance pulses in each multiply's last EX cycle.  Multiply k
+    // is held for `hold` extra cycles after o_done (a MEM stall) when k is
+    // odd.  Returns false if one does not spend MUL_STAGES cycles in EX or
+    // its result changes while held.
+    bool run_mul_burst(const uint8_t* ops, const uint32_t* a, const uint32_t* b,
+                       uint32_t* results, int n, int hold) {
+        bool ok = true;
+        m_dut->i_start = 1;
+        for (int k = 0; k < n; k++) {
+            m_dut->i_op = ops[k];
+            m_dut->i_a  = a[k];
+            m_dut->i_b  = b[k];
+            m_dut->eval();
+            int cycles = 1;
+            while (!m_dut->o_done && cycles <= MAX_CYCLES) {
+                tick();
+                cycles++;
+            }
+            results[k] = m_dut->o_result;
+            for (int i = 0; (k & 1) && i < hold; i++) {
+                tick();
+                ok = ok && m_dut->o_done && m_dut->o_result == results[k];
+            }
+            m_dut->i_advance = 1;
+            tick();
+            m_dut->i_advance = 0;
+            ok = ok && cycles == mul_stages();
+        }
+        m_dut->i_start = 0;
+        tick();
+        return ok;
+    }
+
+    void check(const char* name, uint32_t got, uint32_t expected) {
+        if (got == expected) {
+            printf("  [PASS] %-40s got=0x%08x\n", name, got);
+            pass_count++;
+        } else {
+            printf("  [FAIL] %-40s got=0x%08x expected=0x%08x\n", name, got, expected);
+            fail_count++;
+        }
+    }
+
+private:
+    VerilatedContext             m_ctx;
+    std::unique_ptr<Vtb_mul_div> m_dut;
+};
+
+// ----------------------------------------------------------------------------
+// Phase 1: directed vectors
+// ----------------------------------------------------------------------------
+static void run_directed(MulDivHarness& h) {
     // ----------------------------------------------------------------
     // Test 1: Basic multiply operations
     // ----------------------------------------------------------------
     printf("--- Multiply Tests ---\n");
-    reset();
+    h.reset();
 
-    check("MUL  3 * 7",   run_mul_op(MD_MUL, 3, 7), 21);
-    check("MUL  -3 * 7",  run_mul_op(MD_MUL, -3u, 7), (uint32_t)(-21));
-    check("MUL  -3 * -7", run_mul_op(MD_MUL, -3u, -7u), 21);
+    h.check("MUL  3 * 7",   h.run_mul_op(MD_MUL, 3, 7), 21);
+    h.check("MUL  -3 * 7",  h.run_mul_op(MD_MUL, -3u, 7), (uint32_t)(-21));
+    h.check("MUL  -3 * -7", h.run_mul_op(MD_MUL, -3u, -7u), 21);
 
     // ----------------------------------------------------------------
     // Test 2: Basic unsigned division
     // ----------------------------------------------------------------
     printf("\n--- Unsigned Division Tests ---\n");
-    reset();
+    h.reset();
 
     uint32_t r;
     int cyc;
 
-    r = run_div_op(MD_DIVU, 10, 3, &cyc);
-    check("DIVU 10 / 3", r, 3);
+    r = h.run_div_op(MD_DIVU, 10, 3, &cyc);
+    h.check("DIVU 10 / 3", r, 3);
     printf("    (took %d cycles)\n", cyc);
 
-    r = run_div_op(MD_REMU, 10, 3, &cyc);
-    check("REMU 10 %% 3", r, 1);
+    r = h.run_div_op(MD_REMU, 10, 3, &cyc);
+    h.check("REMU 10 %% 3", r, 1);
 
-    r = run_div_op(MD_DIVU, 100, 10, &cyc);
-    check("DIVU 100 / 10", r, 10);
+    r = h.run_div_op(MD_DIVU, 100, 10, &cyc);
+    h.check("DIVU 100 / 10", r, 10);
 
-    r = run_div_op(MD_REMU, 100, 10, &cyc);
-    check("REMU 100 %% 10", r, 0);
+    r = h.run_div_op(MD_REMU, 100, 10, &cyc);
+    h.check("REMU 100 %% 10", r, 0);
 
     // ----------------------------------------------------------------
     // Test 3: Signed division
     // ----------------------------------------------------------------
     printf("\n--- Signed Division Tests ---\n");
-    reset();
+    h.reset();
 
-    r = run_div_op(MD_DIV, -10u, 3, &cyc);
-    check("DIV  -10 / 3", r, riscv_div(-10, 3));
+    r = h.run_div_op(MD_DIV, -10u, 3, &cyc);
+    h.check("DIV  -10 / 3", r, riscv_div(-10, 3));
 
-    r = run_div_op(MD_REM, -10u, 3, &cyc);
-    check("REM  -10 %% 3", r, riscv_rem(-10, 3));
+    r = h.run_div_op(MD_REM, -10u, 3, &cyc);
+    h.check("REM  -10 %% 3", r, riscv_rem(-10, 3));
 
-    r = run_div_op(MD_DIV, 10, -3u, &cyc);
-    check("DIV  10 / -3", r, riscv_div(10, -3));
+    r = h.run_div_op(MD_DIV, 10, -3u, &cyc);
+    h.check("DIV  10 / -3", r, riscv_div(10, -3));
 
-    r = run_div_op(MD_REM, 10, -3u, &cyc);
-    check("REM  10 %% -3", r, riscv_rem(10, -3));
+    r = h.run_div_op(MD_REM, 10, -3u, &cyc);
+    h.check("REM  10 %% -3", r, riscv_rem(10, -3));
 
-    r = run_div_op(MD_DIV, -10u, -3u, &cyc);
-    check("DIV  -10 / -3", r, riscv_div(-10, -3));
+    r = h.run_div_op(MD_DIV, -10u, -3u, &cyc);
+    h.check("DIV  -10 / -3", r, riscv_div(-10, -3));
 
-    r = run_div_op(MD_REM, -10u, -3u, &cyc);
-    check("REM  -10 %% -3", r, riscv_rem(-10, -3));
+    r = h.run_div_op(MD_REM, -10u, -3u, &cyc);
+    h.check("REM  -10 %% -3", r, riscv_rem(-10, -3));
 
     // ----------------------------------------------------------------
     // Test 4: Division by zero
     // ----------------------------------------------------------------
     printf("\n--- Division by Zero Tests ---\n");
-    reset();
+    h.reset();
 
-    r = run_div_op(MD_DIVU, 42, 0, &cyc);
-    check("DIVU 42 / 0", r, 0xFFFFFFFF);
+    r = h.run_div_op(MD_DIVU, 42, 0, &cyc);
+    h.check("DIVU 42 / 0", r, 0xFFFFFFFF);
 
-    r = run_div_op(MD_REMU, 42, 0, &cyc);
-    check("REMU 42 %% 0", r, 42);
+    r = h.run_div_op(MD_REMU, 42, 0, &cyc);
+    h.check("REMU 42 %% 0", r, 42);
 
-    r = run_div_op(MD_DIV, -42u, 0, &cyc);
-    check("DIV  -42 / 0", r, 0xFFFFFFFF);
+    r = h.run_div_op(MD_DIV, -42u, 0, &cyc);
+    h.check("DIV  -42 / 0", r, 0xFFFFFFFF);
 
-    r = run_div_op(MD_REM, -42u, 0, &cyc);
-    check("REM  -42 %% 0", r, (uint32_t)-42);
+    r = h.run_div_op(MD_REM, -42u, 0, &cyc);
+    h.check("REM  -42 %% 0", r, (uint32_t)-42);
 
     // ----------------------------------------------------------------
     // Test 5: Overflow (signed min / -1)
     // ----------------------------------------------------------------
     printf("\n--- Overflow Tests ---\n");
-    reset();
+    h.reset();
 
-    r = run_div_op(MD_DIV, 0x80000000, -1u, &cyc);
-    check("DIV  INT_MIN / -1", r, 0x80000000);
+    r = h.run_div_op(MD_DIV, 0x80000000, -1u, &cyc);
+    h.check("DIV  INT_MIN / -1", r, 0x80000000);
 
-    r = run_div_op(MD_REM, 0x80000000, -1u, &cyc);
-    check("REM  INT_MIN %% -1", r, 0);
+    r = h.run_div_op(MD_REM, 0x80000000, -1u, &cyc);
+    h.check("REM  INT_MIN %% -1", r, 0);
 
     // ----------------------------------------------------------------
     // Test 6: FAILING cases from RISC-DV trace
     // ----------------------------------------------------------------
     printf("\n--- RISC-DV Failing Cases ---\n");
-    reset();
+    h.reset();
 
     // Case 1: rem t3, s4, a6 — s4=0x0eca293d, a6=0xeca293d0
-    r = run_div_op(MD_REM, 0x0eca293d, 0xeca293d0, &cyc);
-    check("REM  0x0eca293d %% 0xeca293d0", r,
+    r = h.run_div_op(MD_REM, 0x0eca293d, 0xeca293d0, &cyc);
+    h.check("REM  0x0eca293d %% 0xeca293d0", r,
           riscv_rem((int32_t)0x0eca293d, (int32_t)0xeca293d0));
     printf("    Expected: 0x%08x\n", riscv_rem((int32_t)0x0eca293d, (int32_t)0xeca293d0));
 
     // Case 2: divu s9, t6, t1 — t6=0xf01b3076, t1=0x69cc592b
-    r = run_div_op(MD_DIVU, 0xf01b3076, 0x69cc592b, &cyc);
-    check("DIVU 0xf01b3076 / 0x69cc592b", r,
+    r = h.run_div_op(MD_DIVU, 0xf01b3076, 0x69cc592b, &cyc);
+    h.check("DIVU 0xf01b3076 / 0x69cc592b", r,
           riscv_divu(0xf01b3076, 0x69cc592b));
 
     // Case 4: divu s10, s3, s8
     // Need to find operands from trace — use a large/small case
-    r = run_div_op(MD_DIVU, 1, 2, &cyc);
-    check("DIVU 1 / 2", r, 0);
+    r = h.run_div_op(MD_DIVU, 1, 2, &cyc);
+    h.check("DIVU 1 / 2", r, 0);
 
-    r = run_div_op(MD_REMU, 1, 2, &cyc);
-    check("REMU 1 %% 2", r, 1);
+    r = h.run_div_op(MD_REMU, 1, 2, &cyc);
+    h.check("REMU 1 %% 2", r, 1);
 
     // ----------------------------------------------------------------
     // Test 7: Consecutive divisions (pipeline-like: start new div
     //         immediately after previous completes)
     // ----------------------------------------------------------------
     printf("\n--- Consecutive Division Tests ---\n");
-    reset();
+    h.reset();
 
-    r = run_div_op(MD_DIVU, 100, 7, &cyc);
-    check("DIVU 100 / 7 (1st)", r, riscv_divu(100, 7));
+    r = h.run_div_op(MD_DIVU, 100, 7, &cyc);
+    h.check("DIVU 100 / 7 (1st)", r, riscv_divu(100, 7));
 
-    r = run_div_op(MD_DIVU, 200, 13, &cyc);
-    check("DIVU 200 / 13 (2nd)", r, riscv_divu(200, 13));
+    r = h.run_div_op(MD_DIVU, 200, 13, &cyc);
+    h.check("DIVU 200 / 13 (2nd)", r, riscv_divu(200, 13));
 
-    r = run_div_op(MD_REM, 0x12345678, 0x0000ABCD, &cyc);
-    check("REM  0x12345678 %% 0xABCD (3rd)", r,
+    r = h.run_div_op(MD_REM, 0x12345678, 0x0000ABCD, &cyc);
+    h.check("REM  0x12345678 %% 0xABCD (3rd)", r,
           riscv_rem(0x12345678, 0x0000ABCD));
 
     // ----------------------------------------------------------------
-    // Summary
+    // Test 8: Back-to-back multiplies (i_start held, i_advance pulsed)
     // ----------------------------------------------------------------
-    printf("\n=== Summary: %d PASSED, %d FAILED ===\n", pass_count, fail_count);
+    printf("\n--- Back-to-back Multiply Tests (MUL_STAGES=%d) ---\n", h.mul_stages());
+    h.reset();
+
+    {
+        static const uint8_t  ops[] = {MD_MUL, MD_MULH, MD_MULHSU, MD_MULHU, MD_MUL, MD_MULH};
+        static const uint32_t a[]   = {7, 0x80000000, 0xFFFFFFFF, 0xFFFFFFFF, 0x12345678, 0xDEADBEEF};
+        static const uint32_t b[]   = {9, 0x80000000, 0xFFFFFFFF, 0xFFFFFFFF, 0x9ABCDEF0, 3};
+        constexpr int N = sizeof(ops) / sizeof(ops[0]);
+        uint32_t results[N];
+        const bool timing_ok = h.run_mul_burst(ops, a, b, results, N, 2);
+        for (int k = 0; k < N; k++) {
+            char name[64];
+            snprintf(name, sizeof(name), "%s 0x%08x * 0x%08x (#%d)",
+                     MD_OP_NAMES[ops[k]], a[k], b[k], k + 1);
+            h.check(name, results[k], riscv_md(ops[k], a[k], b[k]));
+        }
+        if (!timing_ok) {
+            printf("  [FAIL] back-to-back latency / held result\n");
+            h.fail_count++;
+        }
+    }
+
+}
+
+// ----------------------------------------------------------------------------
+// Phase 2: randomised differential fuzzing
+// ----------------------------------------------------------------------------
+struct OpStats {
+    uint64_t count = 0;
+    uint64_t fails = 0;
+    uint64_t cycles = 0;
+    uint64_t hist[MAX_CYCLES + 1] = {};    // [0] = timeouts
+
+    void merge(const OpStats& o) {
+        count  += o.count;
+        fails  += o.fails;
+        cycles += o.cycles;
+        for (int i = 0; i <= MAX_CYCLES; i++) hist[i] += o.hist[i];
+    }
+};
 
-    dut->final();
-    delete dut;
-    return fail_count > 0 ? 1 : 0;
+struct FuzzConfig {
+    unsigned threads = 0;
+    uint64_t ops = 1000000;
+    double   seconds = 0.0;
+    uint64_t seed = 1;
+    double   progress = 10.0;
+    std::vector<uint8_t> op_set;
+};
+
+static constexpr int MAX_REPORTED = 20;     // failures printed in full
+
+static std::atomic<bool>     g_stop{false};
+static std::atomic<uint64_t> g_done{0};
+static std::atomic<int>      g_reported{0};
+static std::mutex            g_print_mutex;
+
+static void on_sigint(int) { g_stop.store(true); }
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Edge values for both signed and unsigned interpretations
+static uint32_t corner_operand(std::mt19937_64& rng) {
+    static const uint32_t FIXED[] = {
+        0x00000000, 0x00000001, 0x00000002, 0x00000003,
+        0xFFFFFFFF, 0xFFFFFFFE, 0x80000000, 0x80000001,
+        0x7FFFFFFF, 0x7FFFFFFE, 0x0000FFFF, 0xFFFF0000,
+        0x55555555, 0xAAAAAAAA,
+    };
+    const uint64_t r = rng();
+    const unsigned k = (r >> 8) & 31;
+    switch (r & 3) {
+        case 0:  return FIXED[(r >> 16) % (sizeof(FIXED) / sizeof(FIXED[0]))];
+        case 1:  return 1u << k;
+        case 2:  return (1u << k) - 1u;
+        default: return 0u - (1u << k);
+    }
+}
+
+static uint32_t random_operand(std::mt19937_64& rng) {
+    const uint64_t r = rng();
+    const uint32_t v = (uint32_t)(r >> 32);
+    const unsigned shift = (r >> 8) & 31;
+    switch (r & 7) {
+        case 0: case 1: return corner_operand(rng);
+        case 2: case 3: return v;
+        case 4: case 5: return v >> shift;              // random magnitude
+        case 6:         return 0u - (v >> shift);       // negative, random magnitude
+        default:        return (uint32_t)((int32_t)((r >> 16) & 31) - 16);
+    }
+}
+
+static void fuzz_worker(unsigned tid, const FuzzConfig& cfg, uint64_t quota,
+                        OpStats* stats) {
+    MulDivHarness h;
+    h.reset();
+    std::mt19937_64 rng(splitmix64(cfg.seed ^ splitmix64(tid)));
+
+    constexpr uint64_t BATCH = 1024;
+    uint64_t n = 0;
+    while ((quota == 0 || n < quota) && !g_stop.load(std::memory_order_relaxed)) {
+        const uint64_t begin = n;
+        const uint64_t end = quota == 0 ? n + BATCH : std::min(n + BATCH, quota);
+        for (; n < end; n++) {
+            const uint8_t  op = cfg.op_set[rng() % cfg.op_set.size()];
+            const uint32_t a  = random_operand(rng);
+            const uint32_t b  = random_operand(rng);
+
+            uint32_t got = 0;
+            int cycles = 0;
+            bool busy = false;
+            const bool done = h.run_op(op, a, b, &got, &cycles, &busy);
+            const uint32_t exp = riscv_md(op, a, b);
+
+            OpStats& s = stats[op];
+            s.count++;
+            s.cycles += cycles;
+            s.hist[done ? cycles : 0]++;
+            if (done && !busy && got == exp) continue;
+
+            s.fails++;
+            if (g_reported.fetch_add(1) < MAX_REPORTED) {
+                std::lock_guard<std::mutex> lock(g_print_mutex);
+                printf("  [FAIL] %-6s a=0x%08x b=0x%08x got=0x%08x expected=0x%08x%s%s"
+                       " (thread %u)\n",
+                       MD_OP_NAMES[op], a, b, got, exp,
+                       done ? "" : " TIMEOUT", busy ? " BUSY_AT_DONE" : "", tid);
+            }
+            if (!done) h.reset();
+        }
+        g_done.fetch_add(end - begin, std::memory_order_relaxed);
+    }
+}
+
+static void print_report(const OpStats* total, double wall_s) {
+    uint64_t count = 0, fails = 0;
+    for (int op = 0; op < MD_NUM_OPS; op++) {
+        count += total[op].count;
+        fails += total[op].fails;
+    }
+    printf("\n--- Random Phase Report ---\n");
+    printf("  %lu ops in %.2f s = %.0f ops/s, %lu FAILED\n",
+           count, wall_s, wall_s > 0.0 ? count / wall_s : 0.0, fails);
+    printf("  %-6s %14s %12s %8s %7s %5s %5s\n",
+           "op", "count", "ops/s", "fails", "mean", "min", "max");
+
+    for (int op = 0; op < MD_NUM_OPS; op++) {
+        const OpStats& s = total[op];
+        if (s.count == 0) continue;
+        int lo = 0, hi = 0;
+        for (int c = 1; c <= MAX_CYCLES; c++) {
+            if (!s.hist[c]) continue;
+            if (!lo) lo = c;
+            hi = c;
+        }
+        printf("  %-6s %14lu %12.0f %8lu %7.2f %5d %5d\n",
+               MD_OP_NAMES[op], s.count, wall_s > 0.0 ? s.count / wall_s : 0.0,
+               s.fails, (double)s.cycles / s.count, lo, hi);
+    }
+
+    printf("\n--- Cycle Histogram (issue to o_done) ---\n");
+    for (int op = 0; op < MD_NUM_OPS; op++) {
+        const OpStats& s = total[op];
+        if (s.count == 0) continue;
+        printf("  %s:\n", MD_OP_NAMES[op]);
+        if (s.hist[0]) printf("    timeout %14lu\n", s.hist[0]);
+        for (int c = 1; c <= MAX_CYCLES; c++) {
+            if (!s.hist[c]) continue;
+            printf("    %3d cyc %14lu  %6.2f%%\n",
+                   c, s.hist[c], 100.0 * s.hist[c] / s.count);
+        }
+    }
+}
+
+static bool run_fuzz(const FuzzConfig& cfg) {
+    using Clock = std::chrono::steady_clock;
+
+    printf("\n--- Random Differential Fuzzing ---\n");
+    printf("  threads=%u ops=%lu%s seconds=%.0f seed=0x%lx ops:",
+           cfg.threads, cfg.ops, cfg.ops ? "" : " (unbounded)", cfg.seconds, cfg.seed);
+    for (uint8_t op : cfg.op_set) printf(" %s", MD_OP_NAMES[op]);
+    printf("\n");
+
+    std::vector<OpStats> stats((size_t)cfg.threads * MD_NUM_OPS);
+    std::vector<std::thread> workers;
+    const Clock::time_point start = Clock::now();
+    for (unsigned t = 0; t < cfg.threads; t++) {
+        const uint64_t quota = cfg.ops == 0 ? 0
+            : cfg.ops / cfg.threads + (t < cfg.ops % cfg.threads ? 1 : 0);
+        if (cfg.ops != 0 && quota == 0) continue;
+        workers.emplace_back(fuzz_worker, t, std::cref(cfg), quota, &stats[(size_t)t * MD_NUM_OPS]);
+    }
+
+    // Watch the deadline and print progress until every worker has
+    // drained its quota; the workers have no shared state besides g_done.
+    auto seconds_since = [&](Clock::time_point t0) {
+        return std::chrono::duration<double>(Clock::now() - t0).count();
+    };
+    Clock::time_point last = start;
+    const uint64_t target = cfg.ops;
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const uint64_t done = g_done.load(std::memory_order_relaxed);
+        if (cfg.seconds > 0.0 && seconds_since(start) >= cfg.seconds) g_stop.store(true);
+        if (cfg.progress > 0.0 && seconds_since(last) >= cfg.progress) {
+            last = Clock::now();
+            const double el = seconds_since(start);
+            std::lock_guard<std::mutex> lock(g_print_mutex);
+            printf("  [%8.0f s] %lu ops, %.0f ops/s, %d failures\n",
+                   el, done, done / el, g_reported.load());
+            fflush(stdout);
+        }
+        if (g_stop.load() || (target != 0 && done >= target)) break;
+    }
+    for (std::thread& w : workers) w.join();
+    const double wall_s = seconds_since(start);
+
+    OpStats total[MD_NUM_OPS];
+    for (unsigned t = 0; t < cfg.threads; t++) {
+        for (int op = 0; op < MD_NUM_OPS; op++) total[op].merge(stats[(size_t)t * MD_NUM_OPS + op]);
+    }
+    print_report(total, wall_s);
+
+    uint64_t fails = 0;
+    for (int op = 0; op < MD_NUM_OPS; op++) fails += total[op].fails;
+    return fails == 0;
+}
+
+static int parse_op(const char* name) {
+    for (int op = 0; op < MD_NUM_OPS; op++) {
+        if (strcmp(name, MD_OP_NAMES[op]) == 0) return op;
+    }
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    FuzzConfig cfg;
+    cfg.threads = std::thread::hardware_concurrency();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) cfg.threads = std::atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) cfg.ops = std::strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) cfg.seconds = std::atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) cfg.seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--progress") == 0 && i + 1 < argc) cfg.progress = std::atof(argv[++i]);
+        else if (strcmp(argv[i], "--op") == 0 && i + 1 < argc) {
+            const int op = parse_op(argv[++i]);
+            if (op < 0) {
+                fprintf(stderr, "ERROR: unknown op '%s'\n", argv[i]);
+                return 2;
+            }
+            cfg.op_set.push_back((uint8_t)op);
+        }
+    }
+    if (cfg.threads == 0) cfg.threads = 1;
+    if (cfg.op_set.empty()) {
+        for (int op = 0; op < MD_NUM_OPS; op++) cfg.op_set.push_back((uint8_t)op);
+    }
+    std::signal(SIGINT, on_sigint);
+
+    printf("=== k10_mul_div standalone testbench ===\n\n");
+
+    MulDivHarness h;
+    run_directed(h);
+    printf("\n=== Directed: %d PASSED, %d FAILED ===\n", h.pass_count, h.fail_count);
+
+    const bool fuzz_ok = run_fuzz(cfg);
+
+    // ----------------------------------------------------------------
+    // Summary
+    // ----------------------------------------------------------------
+    const bool ok = h.fail_count == 0 && fuzz_ok;
+    printf("\n=== Summary: %s ===\n", ok ? "PASSED" : "FAILED");
+    return ok ? 0 : 1;
 }
@@ -18,7 +18,10 @@
 
 module tb_mul_div
   import komandara_k10_pkg::*;
-(
+#(
+    parameter bit          FAST_DIV   = 1'b1,
+    parameter int unsigned MUL_STAGES = 1
+)(
     input  logic        i_clk,
     input  logic        i_rst_n,
 
@@ -26,22 +29,30 @@ module tb_mul_div
     input  logic [2:0]  i_op,       // md_op_e as 3-bit logic for Verilator
     input  logic [31:0] i_a,
     input  logic [31:0] i_b,
+    input  logic        i_advance,
 
+    output logic [7:0]  o_mul_stages,   // MUL_STAGES, for the latency checks
     output logic        o_busy,
     output logic        o_done,
     output logic [31:0] o_result
 );
 
-    k10_mul_div u_dut (
+    k10_mul_div #(
+        .FAST_DIV   (FAST_DIV),
+        .MUL_STAGES (MUL_STAGES)
+    ) u_dut (
         .i_clk    (i_clk),
         .i_rst_n  (i_rst_n),
         .i_start  (i_start),
         .i_op     (md_op_e'(i_op)),
         .i_a      (i_a),
         .i_b      (i_b),
+        .i_advance(i_advance),
         .o_busy   (o_busy),
         .o_done   (o_done),
         .o_result (o_result)
     );
 
+    assign o_mul_stages = 8'(MUL_STAGES);
+
 endmodule : tb_mul_div
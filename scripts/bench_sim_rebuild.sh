@@ -0,0 +1,105 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Verilator Rebuild-Time Benchmark
+# ============================================================================
+# Measures the edit-rebuild loop for each target through
+# scripts/k10_sim_build.sh: a cold build (empty model cache and empty
+# ccache), then a rebuild after a one-file change.  The change inserts a
+# comment line at the top of --file, which shifts every line number in it
+# the way a real edit does, and is reverted on exit.
+#
+# Everything is built under build/bench_rebuild/ with its own
+# K10_SIM_CACHE and CCACHE_DIR, so the normal caches are neither used nor
+# disturbed.
+#
+# Usage:
+#   ./scripts/bench_sim_rebuild.sh
+#   ./scripts/bench_sim_rebuild.sh --file rtl/k10/k10_fetch.sv --targets "sim sim_hier"
+#   K10_SIM_CCACHE=0 ./scripts/bench_sim_rebuild.sh      # without ccache
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+OUTPUT_DIR="${PROJECT_ROOT}/build/bench_rebuild"
+
+EDIT_FILE="rtl/k10/k10_lsu.sv"
+TARGETS="sim sim_hier"
+
+usage() {
+    echo "Usage: $0 [--file <rtl file>] [--targets \"sim sim_hier\"]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --file)    EDIT_FILE="$2"; shift 2 ;;
+        --targets) TARGETS="$2";   shift 2 ;;
+        -h|--help) usage ;;
+        *)         echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+EDIT_ABS="$(realpath "${PROJECT_ROOT}/${EDIT_FILE}" 2>/dev/null || realpath "${EDIT_FILE}")"
+if [[ ! -f "${EDIT_ABS}" ]]; then
+    echo "ERROR: --file ${EDIT_FILE} not found" >&2
+    exit 1
+fi
+
+for cmd in verilator fusesoc python3; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh" >&2
+        exit 1
+    fi
+done
+
+rm -rf "${OUTPUT_DIR}"
+mkdir -p "${OUTPUT_DIR}"
+BACKUP="${OUTPUT_DIR}/$(basename "${EDIT_ABS}").orig"
+restore() {
+    if [[ -f "${BACKUP}" ]]; then
+        cp -p "${BACKUP}" "${EDIT_ABS}"
+        rm -f "${BACKUP}"
+    fi
+}
+trap restore EXIT
+
+# Seconds taken by one k10_sim_build.sh call
+timed_build() {
+    local target="$1" log="$2" start end
+    start=$(date +%s.%N)
+    if ! "${SCRIPT_DIR}/k10_sim_build.sh" --target "${target}" > /dev/null 2> "${log}"; then
+        echo "ERROR: ${target} build failed, see ${log} and the build.log it names" >&2
+        exit 1
+    fi
+    end=$(date +%s.%N)
+    python3 -c "print(f'{${end} - ${start}:.1f}')"
+}
+
+echo "One-file change: ${EDIT_FILE}   ccache: $([[ "${K10_SIM_CCACHE:-1}" == "1" ]] && command -v ccache &>/dev/null && echo on || echo off)"
+printf "%-12s %-12s %-14s %s\n" "target" "cold [s]" "rebuild [s]" "speedup"
+
+for target in ${TARGETS}; do
+    export K10_SIM_CACHE="${OUTPUT_DIR}/${target}/sim_cache"
+    export CCACHE_DIR="${OUTPUT_DIR}/${target}/ccache"
+    mkdir -p "${K10_SIM_CACHE}" "${CCACHE_DIR}"
+
+    cold=$(timed_build "${target}" "${OUTPUT_DIR}/${target}_cold.log")
+
+    cp -p "${EDIT_ABS}" "${BACKUP}"
+    { echo "// bench_sim_rebuild.sh edit"; cat "${BACKUP}"; } > "${EDIT_ABS}"
+    rebuild=$(timed_build "${target}" "${OUTPUT_DIR}/${target}_rebuild.log")
+    restore
+
+    speedup=$(python3 -c "print(f'{${cold} / max(${rebuild}, 0.1):.1f}x')")
+    printf "%-12s %-12s %-14s %s\n" "${target}" "${cold}" "${rebuild}" "${speedup}"
+done
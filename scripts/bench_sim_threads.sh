@@ -0,0 +1,134 @@
+#!/usr/bin/env bash
+# Copyright 2025 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Verilator Thread-Count Benchmark
+# ============================================================================
+# Runs the same firmware image on the single-threaded `sim` model and on
+# `sim_mt` models built for each --threads count, and reports wall-clock
+# time and speedup over the first row.  Use it to pick --threads for a given
+# workload; the answer differs between short riscv-dv seeds and long
+# k10_c_benchmark runs.
+#
+# Models come from the shared build cache (scripts/k10_sim_build.sh, which
+# keys sim_mt builds on the thread count), and the image is loaded at run
+# time through +firmware=, so each model is built once and reused for every
+# run.  A run that exits non-zero, times out or does not print a PASS
+# banner stops the benchmark with ERROR: instead of being timed.
+#
+# Usage:
+#   ./scripts/bench_sim_threads.sh --hex build/selfcheck/k10_c_benchmark.hex
+#   ./scripts/bench_sim_threads.sh --hex <file> --threads "2 4 8" --runs 3
+#   ./scripts/bench_sim_threads.sh --hex <file> --targets "sim sim_mt_prof"
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+OUTPUT_DIR="${PROJECT_ROOT}/build/bench_threads"
+BOOT_ADDR=2147483648  # 0x80000000
+
+HEX_FILE=""
+TARGETS="sim sim_mt"
+THREADS_LIST="4"
+RUNS=1
+TIMEOUT=3600
+
+usage() {
+    echo "Usage: $0 --hex <file.hex> [--targets \"sim sim_mt\"] [--threads \"<N> ...\"]" >&2
+    echo "          [--runs <N>] [--timeout <s>]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --hex)     HEX_FILE="$2";     shift 2 ;;
+        --targets) TARGETS="$2";      shift 2 ;;
+        --threads) THREADS_LIST="$2"; shift 2 ;;
+        --runs)    RUNS="$2";         shift 2 ;;
+        --timeout) TIMEOUT="$2";      shift 2 ;;
+        -h|--help) usage ;;
+        *)         echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+if [[ -z "${HEX_FILE}" || ! -f "${HEX_FILE}" ]]; then
+    echo "ERROR: --hex <file> is required and must exist" >&2
+    usage
+fi
+HEX_ABS="$(realpath "${HEX_FILE}")"
+if ! [[ "${RUNS}" =~ ^[1-9][0-9]*$ ]]; then
+    echo "ERROR: --runs must be a positive number" >&2
+    exit 1
+fi
+for n in ${THREADS_LIST}; do
+    if ! [[ "${n}" =~ ^[1-9][0-9]*$ ]]; then
+        echo "ERROR: --threads values must be positive numbers" >&2
+        exit 1
+    fi
+done
+
+for cmd in verilator fusesoc python3; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh" >&2
+        exit 1
+    fi
+done
+
+mkdir -p "${OUTPUT_DIR}"
+
+# "<target> <threads>" per model: sim_mt* once per thread count
+CONFIGS=()
+for target in ${TARGETS}; do
+    case "${target}" in
+        sim_mt*) for n in ${THREADS_LIST}; do CONFIGS+=("${target} ${n}"); done ;;
+        *)       CONFIGS+=("${target} -") ;;
+    esac
+done
+
+BASE_TIME=""
+printf "%-14s %-8s %-10s %-12s %s\n" "target" "threads" "run" "wall [s]" "speedup"
+
+for config in "${CONFIGS[@]}"; do
+    read -r target threads <<< "${config}"
+    BUILD_ARGS=(--target "${target}" --boot-addr "${BOOT_ADDR}")
+    tag="${target}"
+    if [[ "${threads}" != "-" ]]; then
+        BUILD_ARGS+=(--threads "${threads}")
+        tag="${target}_t${threads}"
+    fi
+    SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" "${BUILD_ARGS[@]}")"
+    RUN_DIR="${OUTPUT_DIR}/${tag}"
+    mkdir -p "${RUN_DIR}"
+
+    for run in $(seq 1 "${RUNS}"); do
+        log="${OUTPUT_DIR}/${tag}_run${run}.log"
+        rc=0
+        pushd "${RUN_DIR}" > /dev/null
+        START=$(date +%s.%N)
+        timeout "${TIMEOUT}" "${SIM_EXE}" +firmware="${HEX_ABS}" > "${log}" 2>&1 || rc=$?
+        END=$(date +%s.%N)
+        popd > /dev/null
+
+        # Exit status 0 alone is not a pass: a SIM_CTRL FAIL also exits 0
+        if [[ ${rc} -ne 0 ]] || grep -q -e "TEST FAILED" -e "ERROR:" "${log}" ||
+           ! grep -q -e "TEST PASSED" -e "ECALL detected" "${log}"; then
+            echo "ERROR: ${tag} run ${run} failed (exit ${rc}), see ${log}" >&2
+            exit 1
+        fi
+
+        WALL=$(python3 -c "print(f'{${END} - ${START}:.3f}')")
+        if [[ -z "${BASE_TIME}" ]]; then
+            BASE_TIME="${WALL}"
+        fi
+        SPEEDUP=$(python3 -c "print(f'{${BASE_TIME} / ${WALL}:.2f}x')")
+        printf "%-14s %-8s %-10s %-12s %s\n" "${target}" "${threads}" "${run}" "${WALL}" "${SPEEDUP}"
+    done
+done
@@ -39,4 +39,8 @@ gdb_report_data_abort enable
 gdb_report_register_access_error enable
 
 init
-halt
+# -c "set K10_NO_HALT 1" before -f leaves a running core running, e.g. to
+# read the trace buffer over SBA (scripts/k10_tracebuf_dump.sh)
+if {![info exists K10_NO_HALT]} {
+    halt
+}
@@ -0,0 +1,42 @@
+# OpenOCD configuration for the K10 Verilator model
+# Connects to k10_tb.cpp --jtag-server <port> over the remote_bitbang driver
+#
+#   ./Vk10_tb +firmware=<hex> --jtag-server 9824
+#   openocd -f scripts/k10-sim-openocd.tcl
+#   riscv64-unknown-elf-gdb app.elf -ex "target extended-remote :3333"
+
+adapter driver remote_bitbang
+remote_bitbang host localhost
+remote_bitbang port 9824
+transport select jtag
+
+# Board Target Configuration
+set CPU_NAME k10_core
+set TAP_IDCODE 0x249511c3
+
+# The sim instantiates dmi_jtag directly: 5-bit IR with the default
+# idcode (0x01), dtmcs (0x10) and dmi (0x11) encodings, so no set_ir here
+jtag newtap $CPU_NAME cpu -irlen 5 -expected-id $TAP_IDCODE -ignore-version
+
+# Define the target CPU
+set TARGET_CPU $CPU_NAME.cpu
+target create $TARGET_CPU riscv -chain-position $TARGET_CPU
+
+# Every TCK edge costs a model eval; the adapter speed is not meaningful
+reset_config none
+
+# Simulation is slow; give abstract commands plenty of time
+riscv set_command_timeout_sec 120
+
+# Hardware configuration
+riscv set_prefer_sba on
+gdb_breakpoint_override hard
+gdb_report_data_abort enable
+gdb_report_register_access_error enable
+
+init
+# -c "set K10_NO_HALT 1" before -f leaves a running core running, e.g. to
+# read the trace buffer over SBA (scripts/k10_tracebuf_dump.sh)
+if {![info exists K10_NO_HALT]} {
+    halt
+}
@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+# ============================================================================
+# k10_cov_minimize.py — Rank regression seeds by coverage and minimize them
+# ============================================================================
+# Reads the per-run coverage.dat files of a regression (Verilator
+# --coverage format, written by the sim_cov model) and picks a small set of
+# runs whose union reaches every point the whole regression reached:
+# greedy set cover, each step taking the run with the most new points per
+# simulated cycle, then dropping runs whose points the others all cover.
+#
+# A point is a coverage.dat entry (line, branch, or a k10_cov.sv cover
+# property) with a count of at least --min-count.  Points are grouped by
+# their page (v_line/<module>, ...), and the k10_cov.sv points by their
+# cover property (cov_instr, cov_csr_rd, ...) for the per-group report.
+#
+# With --out-dir it writes:
+#   seeds.txt       "<test> <seed>" per kept run, in ranking order
+#                   (scripts/run_coverage_regression.sh --seeds replays it)
+#   ranking.txt     the report printed on stdout
+#
+# seeds.txt is the reproducible result.  A riscv-dv testlist cannot carry
+# it: run.py numbers the seeds of a test from one --start_seed, so the kept
+# seeds of a test, which are rarely consecutive, have no testlist form.
+#
+# Usage:
+#   python3 k10_cov_minimize.py --runs build/coverage/runs.csv \
+#       --out-dir build/coverage/min
+#   python3 k10_cov_minimize.py a/coverage.dat b/coverage.dat --uncovered
+#   python3 k10_cov_minimize.py --runs runs.csv --cost runs --min-count 4
+# ============================================================================
+
+import argparse
+import collections
+import csv
+import os
+import re
+import sys
+
+COV_SV = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                      "..", "rtl", "k10", "tb", "k10_cov.sv")
+
+
+class Run:
+    """One regression run: its name, cost and the points it reached."""
+
+    def __init__(self, test: str, seed: str, cycles: int, path: str):
+        self.test = test
+        self.seed = seed
+        self.cycles = cycles
+        self.path = path
+        self.points = set()
+
+    @property
+    def name(self) -> str:
+        return f"{self.test} {self.seed}" if self.seed else self.test
+
+
+class PointTable:
+    """Interns coverage point keys; keeps the fields used for grouping."""
+
+    def __init__(self):
+        self.ids = {}
+        self.fields = []
+
+    def add(self, key: str) -> int:
+        pid = self.ids.get(key)
+        if pid is None:
+            pid = len(self.fields)
+            self.ids[key] = pid
+            fields = {}
+            for kv in key.split("\x01"):
+                k, sep, v = kv.partition("\x02")
+                if sep:
+                    fields[k] = v
+            self.fields.append(fields)
+        return pid
+
+    def group(self, pid: int) -> str:
+        f = self.fields[pid]
+        page = f.get("page", "?")
+        if page.startswith("v_user"):
+            return "user/" + f.get("o", "?")
+        return page
+
+    def label(self, pid: int, names: dict) -> str:
+        f = self.fields[pid]
+        hier = f.get("h", "")
+        if f.get("page", "").startswith("v_user"):
+            m = re.search(r"(gen_\w+)\[(\d+)\]", hier)
+            if m and m.group(1) in names and int(m.group(2)) < len(names[m.group(1)]):
+                return f"{f.get('o', '?')} {names[m.group(1)][int(m.group(2))]}"
+            return f"{f.get('o', '?')} {hier.rsplit('.', 1)[-1]}"
+        return f"{f.get('f', '?')}:{f.get('l', '?')} {f.get('o', '')}".rstrip()
+
+
+def read_coverage(path: str, table: PointTable, min_count: int, universe: set) -> set:
+    """Points of one coverage.dat with count >= min_count; all go to universe."""
+    hit = set()
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            if not line.startswith("C '"):
+                continue
+            end = line.rfind("' ")
+            if end < 3:
+                continue
+            try:
+                count = int(line[end + 2:])
+            except ValueError:
+                continue
+            pid = table.add(line[3:end])
+            universe.add(pid)
+            if count >= min_count:
+                hit.add(pid)
+    return hit
+
+
+def enum_names(path: str) -> dict:
+    """Bin names of the gen_instr / gen_csr cover points, from k10_cov.sv."""
+    try:
+        with open(path) as f:
+            text = f.read()
+    except OSError:
+        return {}
+    names = {}
+    for gen, enum in (("gen_instr", "instr_class_e"), ("gen_csr", "csr_class_e")):
+        m = re.search(r"typedef enum int unsigned \{(.*?)\}\s*" + enum, text, re.S)
+        if m:
+            body = re.sub(r"//[^\n]*", "", m.group(1))
+            names[gen] = [n.strip() for n in body.split(",") if n.strip()]
+    return names
+
+
+def minimize(runs: list, cost) -> list:
+    """Greedy weighted set cover over runs, then a redundancy pass."""
+    target = set().union(*(r.points for r in runs))
+    covered = set()
+    chosen = []
+    pool = list(runs)
+    while covered != target:
+        best = max(pool, key=lambda r: (len(r.points - covered) / cost(r),
+                                        len(r.points - covered)))
+        new = len(best.points - covered)
+        if new == 0:
+            break
+        chosen.append((best, new))
+        covered |= best.points
+        pool.remove(best)
+
+    # A greedy pick can be made redundant by later ones: drop the most
+    # expensive such runs first.
+    refs = collections.Counter(p for r, _ in chosen for p in r.points)
+    for r, _ in sorted(chosen, key=lambda rn: -cost(rn[0])):
+        if all(refs[p] > 1 for p in r.points):
+            for p in r.points:
+                refs[p] -= 1
+            chosen = [(c, n) for c, n in chosen if c is not r]
+    return chosen
+
+
+def read_runs(args, table: PointTable, universe: set) -> tuple:
+    """Passing runs with their points, and the names of the failing ones."""
+    runs, failed = [], []
+    if args.runs:
+        with open(args.runs, newline="") as f:
+            rows = list(csv.DictReader(f))
+        base = os.path.dirname(os.path.abspath(args.runs))
+        for row in rows:
+            if row.get("status") != "PASS":
+                failed.append(f"{row.get('test')} {row.get('seed')}")
+                continue
+            cycles = int(row["cycles"]) if row.get("cycles", "").isdigit() else 0
+            path = row["coverage"]
+            if not os.path.isabs(path):
+                path = os.path.join(base, path)
+            runs.append(Run(row["test"], row["seed"], cycles, path))
+    for path in args.coverage:
+        runs.append(Run(path, "", 0, path))
+
+    for r in runs:
+        if not os.path.isfile(r.path):
+            print(f"ERROR: {r.path}: no such coverage file", file=sys.stderr)
+            sys.exit(1)
+        r.points = read_coverage(r.path, table, args.min_count, universe)
+    return runs, failed
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Rank regression seeds by coverage and minimize them")
+    parser.add_argument("coverage", nargs="*", help="coverage.dat files (one run each)")
+    parser.add_argument("--runs", help="runs.csv from run_coverage_regression.sh "
+                        "(test,seed,status,cycles,coverage)")
+    parser.add_argument("--out-dir", help="write seeds.txt and ranking.txt here")
+    parser.add_argument("--min-count", type=int, default=1,
+                        help="hits for a point to count as covered (default 1)")
+    parser.add_argument("--cost", choices=("cycles", "runs"), default="cycles",
+                        help="what a kept run costs (default cycles; runs without "
+                             "a cycle count cost the mean)")
+    parser.add_argument("--uncovered", action="store_true",
+                        help="also list the k10_cov.sv points no run reached")
+    args = parser.parse_args()
+
+    if not args.runs and not args.coverage:
+        print("ERROR: give --runs <csv> or coverage.dat files", file=sys.stderr)
+        sys.exit(1)
+    if args.runs and not os.path.isfile(args.runs):
+        print(f"ERROR: {args.runs}: no such file", file=sys.stderr)
+        sys.exit(1)
+    if args.min_count < 1:
+        print("ERROR: --min-count must be >= 1", file=sys.stderr)
+        sys.exit(1)
+
+    table = PointTable()
+    universe = set()
+    runs, failed = read_runs(args, table, universe)
+    if not runs:
+        print("ERROR: no passing run to rank", file=sys.stderr)
+        sys.exit(1)
+
+    known = [r.cycles for r in runs if r.cycles > 0]
+    mean = sum(known) / len(known) if known else 1
+
+    def cost(r: Run) -> float:
+        if args.cost == "runs":
+            return 1
+        return r.cycles if r.cycles > 0 else mean
+
+    chosen = minimize(runs, cost)
+    reached = set().union(*(r.points for r in runs))
+    owners = collections.Counter(p for r in runs for p in r.points)
+
+    report = []
+    total_cost = sum(cost(r) for r in runs)
+    kept_cost = sum(cost(r) for r, _ in chosen)
+    report.append(f"Runs: {len(runs)} passing" + (f", {len(failed)} failing (ignored)" if failed else ""))
+    report.append(f"Points: {len(reached)} of {len(universe)} reached "
+                  f"({100.0 * len(reached) / max(len(universe), 1):.1f}%), min count {args.min_count}")
+    report.append(f"Kept: {len(chosen)} runs, {100.0 * kept_cost / total_cost:.1f}% of the "
+                  f"{args.cost} of the full set")
+    report.append("")
+    report.append(f"{'rank':>4}  {'run':<44} {'new':>7} {'unique':>7} {'cum %':>7} {'cycles':>12}")
+    cum = set()
+    for rank, (r, _) in enumerate(chosen, 1):
+        new = len(r.points - cum)
+        cum |= r.points
+        unique = sum(1 for p in r.points if owners[p] == 1)
+        report.append(f"{rank:>4}  {r.name:<44} {new:>7} {unique:>7} "
+                      f"{100.0 * len(cum) / max(len(universe), 1):>6.1f}% {r.cycles or '-':>12}")
+
+    groups = collections.defaultdict(lambda: [0, 0])
+    for pid in universe:
+        g = groups[table.group(pid)]
+        g[1] += 1
+        if pid in reached:
+            g[0] += 1
+    report.append("")
+    report.append(f"{'group':<40} {'covered':>9} {'points':>8}")
+    for name in sorted(groups, key=lambda n: (not n.startswith("user/"), n)):
+        hit, total = groups[name]
+        report.append(f"{name:<40} {hit:>9} {total:>8}  {100.0 * hit / total:5.1f}%")
+
+    if args.uncovered:
+        names = enum_names(COV_SV)
+        report.append("")
+        report.append("Uncovered k10_cov.sv points:")
+        missed = sorted(table.label(p, names) for p in universe - reached
+                        if table.group(p).startswith("user/"))
+        report.extend("  " + label for label in missed)
+        if not missed:
+            report.append("  (none)")
+
+    for name in failed:
+        report.append(f"FAILING (not ranked): {name}")
+
+    text = "\n".join(report) + "\n"
+    sys.stdout.write(text)
+
+    if args.out_dir:
+        os.makedirs(args.out_dir, exist_ok=True)
+        with open(os.path.join(args.out_dir, "ranking.txt"), "w") as f:
+            f.write(text)
+        with open(os.path.join(args.out_dir, "seeds.txt"), "w") as f:
+            f.write(f"# {len(chosen)} of {len(runs)} runs reach the same {len(reached)} points\n")
+            for r, _ in chosen:
+                f.write(f"{r.name}\n")
+        print(f"Wrote {args.out_dir}/seeds.txt, ranking.txt")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,209 @@
+#!/usr/bin/env bash
+# Copyright 2025 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Cached Verilator Model Build
+# ============================================================================
+# Builds Vk10_tb once per distinct RTL/testbench content and reuses it.  The
+# model is built with an empty MEM_INIT; tests are loaded at run time with
+# --elf <file> (or +firmware=<hex>), so one build serves every seed of a
+# regression.
+#
+# The cache key is a SHA-256 over every file under rtl/ and 3rdParty/, the
+# *.core files, the FuseSoC target and parameters, and the verilator and
+# fusesoc versions.  Builds land in build/sim_cache/<target>-<key>/ and are
+# guarded by flock, so concurrent callers wait for one build instead of
+# racing it.
+#
+# Prints the absolute path of Vk10_tb on stdout; build output goes to
+# <cache dir>/build.log.
+#
+# The C++ compile runs with make -j (K10_SIM_JOBS, default nproc) and, when
+# ccache is installed, through it (OBJCACHE; K10_SIM_CCACHE=0 turns it off).
+# Objects are shared across cache directories, so a new key only recompiles
+# the generated files whose content changed.  With --target sim_hier
+# (Verilator hierarchical blocks) that is little more than the edited block.
+#
+# Usage:
+#   SIM_EXE="$(./scripts/k10_sim_build.sh)"
+#   SIM_EXE="$(./scripts/k10_sim_build.sh --target sim_mt --boot-addr 2147483648)"
+#   SIM_EXE="$(./scripts/k10_sim_build.sh --target sim_mt --threads 8)"
+#   SIM_EXE="$(./scripts/k10_sim_build.sh --branch-pred false)"   # baseline CPI
+#   SIM_EXE="$(./scripts/k10_sim_build.sh --fast-div false)"      # fixed-latency divide
+#   SIM_EXE="$(./scripts/k10_sim_build.sh --target sim_hier)"     # edit-rebuild loop
+#   SIM_EXE="$(./scripts/k10_sim_build.sh --harts 4)"             # 4-hart SoC
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+CACHE_ROOT="${K10_SIM_CACHE:-${PROJECT_ROOT}/build/sim_cache}"
+TARGET="sim"
+BOOT_ADDR=2147483648  # 0x80000000
+MEM_SIZE_KB=64
+BRANCH_PRED=true
+FAST_DIV=true
+MUL_STAGES=1
+PREFETCH_DEPTH=4
+ICACHE=false
+STORE_BUFFER=4
+TRACE_BUF=false
+N_HARTS=1
+THREADS=""          # sim_mt*: Verilator --threads (default 4)
+
+usage() {
+    echo "Usage: $0 [--target <sim|sim_mt|...>] [--boot-addr <N>] [--mem-size-kb <N>]" >&2
+    echo "          [--branch-pred <true|false>] [--prefetch-depth <N>] [--icache <true|false>]" >&2
+    echo "          [--store-buffer <N>] [--trace-buf <true|false>] [--mul-stages <1|2|3>]" >&2
+    echo "          [--fast-div <true|false>] [--harts <1..8>] [--threads <N>]   (sim_mt*)" >&2
+    echo "" >&2
+    echo "  Cache root: \$K10_SIM_CACHE (default build/sim_cache)" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --target)      TARGET="$2";      shift 2 ;;
+        --boot-addr)   BOOT_ADDR="$2";   shift 2 ;;
+        --mem-size-kb) MEM_SIZE_KB="$2"; shift 2 ;;
+        --branch-pred) BRANCH_PRED="$2"; shift 2 ;;
+        --prefetch-depth) PREFETCH_DEPTH="$2"; shift 2 ;;
+        --icache)      ICACHE="$2";      shift 2 ;;
+        --store-buffer) STORE_BUFFER="$2"; shift 2 ;;
+        --trace-buf)   TRACE_BUF="$2";   shift 2 ;;
+        --mul-stages)  MUL_STAGES="$2";  shift 2 ;;
+        --fast-div)    FAST_DIV="$2";    shift 2 ;;
+        --harts)       N_HARTS="$2";     shift 2 ;;
+        --threads)     THREADS="$2";     shift 2 ;;
+        -h|--help)     usage ;;
+        *)             echo "Unknown option: $1" >&2; usage ;;
+    esac
+done
+
+if [[ "${BRANCH_PRED}" != "true" && "${BRANCH_PRED}" != "false" ]]; then
+    echo "ERROR: --branch-pred must be true or false" >&2
+    exit 1
+fi
+if [[ "${ICACHE}" != "true" && "${ICACHE}" != "false" ]]; then
+    echo "ERROR: --icache must be true or false" >&2
+    exit 1
+fi
+if [[ "${TRACE_BUF}" != "true" && "${TRACE_BUF}" != "false" ]]; then
+    echo "ERROR: --trace-buf must be true or false" >&2
+    exit 1
+fi
+if ! [[ "${PREFETCH_DEPTH}" =~ ^[0-9]+$ ]] || (( PREFETCH_DEPTH < 2 )) || \
+   (( (PREFETCH_DEPTH & (PREFETCH_DEPTH - 1)) != 0 )); then
+    echo "ERROR: --prefetch-depth must be a power of 2, >= 2" >&2
+    exit 1
+fi
+if [[ "${FAST_DIV}" != "true" && "${FAST_DIV}" != "false" ]]; then
+    echo "ERROR: --fast-div must be true or false" >&2
+    exit 1
+fi
+if ! [[ "${MUL_STAGES}" =~ ^[123]$ ]]; then
+    echo "ERROR: --mul-stages must be 1, 2 or 3" >&2
+    exit 1
+fi
+if ! [[ "${STORE_BUFFER}" =~ ^[0-9]+$ ]]; then
+    echo "ERROR: --store-buffer must be a number of entries (0 = off)" >&2
+    exit 1
+fi
+if ! [[ "${N_HARTS}" =~ ^[1-8]$ ]]; then
+    echo "ERROR: --harts must be 1..8" >&2
+    exit 1
+fi
+case "${TARGET}" in
+    sim_mt*) THREADS="${THREADS:-4}" ;;
+    *)       if [[ -n "${THREADS}" ]]; then
+                 echo "ERROR: --threads only applies to the sim_mt targets" >&2
+                 exit 1
+             fi ;;
+esac
+if [[ -n "${THREADS}" ]] && ! [[ "${THREADS}" =~ ^[1-9][0-9]*$ ]]; then
+    echo "ERROR: --threads must be a positive number" >&2
+    exit 1
+fi
+
+for cmd in verilator fusesoc sha256sum; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh" >&2
+        exit 1
+    fi
+done
+
+# ---------------------------------------------------------------------------
+# Cache key
+# ---------------------------------------------------------------------------
+KEY="$(
+    cd "${PROJECT_ROOT}"
+    {
+        find rtl 3rdParty -type f -print0 | sort -z | xargs -0 sha256sum
+        sha256sum ./*.core
+        echo "target=${TARGET} boot_addr=${BOOT_ADDR} mem_size_kb=${MEM_SIZE_KB} branch_pred=${BRANCH_PRED} prefetch_depth=${PREFETCH_DEPTH} icache=${ICACHE} store_buffer=${STORE_BUFFER} trace_buf=${TRACE_BUF} fast_div=${FAST_DIV} mul_stages=${MUL_STAGES} n_harts=${N_HARTS} threads=${THREADS}"
+        verilator --version
+        fusesoc --version 2>&1
+    } | sha256sum | cut -c1-16
+)"
+
+CACHE_DIR="${CACHE_ROOT}/${TARGET}-${KEY}"
+SIM_EXE="${CACHE_DIR}/${TARGET}-verilator/Vk10_tb"
+mkdir -p "${CACHE_ROOT}"
+
+# ---------------------------------------------------------------------------
+# Build (once per key)
+# ---------------------------------------------------------------------------
+export MAKEFLAGS="-j${K10_SIM_JOBS:-$(nproc)}"
+if [[ "${K10_SIM_CCACHE:-1}" == "1" ]] && command -v ccache &>/dev/null; then
+    # Paths under the cache root are hashed relative to the build directory,
+    # so <target>-<key> directories hit each other's objects.
+    export OBJCACHE=ccache
+    export CCACHE_BASEDIR="${CACHE_ROOT}"
+    export CCACHE_NOHASHDIR=1
+fi
+
+exec 9> "${CACHE_ROOT}/.lock"
+flock 9
+
+if [[ ! -f "${CACHE_DIR}/.complete" ]]; then
+    echo "[k10_sim_build] Building ${TARGET} model (key ${KEY})..." >&2
+    rm -rf "${CACHE_DIR}"
+    mkdir -p "${CACHE_DIR}"
+    # sim_mt* read the thread count from K10_SIM_THREADS (komandara_k10.core)
+    if ! (cd "${PROJECT_ROOT}" && \
+          K10_SIM_THREADS="${THREADS}" \
+          fusesoc --cores-root=. run --target="${TARGET}" --build \
+              --build-root="${CACHE_DIR}" \
+              komandara:core:k10 \
+              --BOOT_ADDR="${BOOT_ADDR}" \
+              --MEM_SIZE_KB="${MEM_SIZE_KB}" \
+              --BRANCH_PRED="${BRANCH_PRED}" \
+              --PREFETCH_DEPTH="${PREFETCH_DEPTH}" \
+              --ICACHE="${ICACHE}" \
+              --STORE_BUFFER="${STORE_BUFFER}" \
+              --TRACE_BUF="${TRACE_BUF}" \
+              --FAST_DIV="${FAST_DIV}" \
+              --MUL_STAGES="${MUL_STAGES}" \
+              --N_HARTS="${N_HARTS}") \
+          > "${CACHE_DIR}/build.log" 2>&1; then
+        echo "ERROR: Verilator build failed, see ${CACHE_DIR}/build.log" >&2
+        exit 1
+    fi
+    if [[ ! -x "${SIM_EXE}" ]]; then
+        echo "ERROR: ${SIM_EXE} not found, see ${CACHE_DIR}/build.log" >&2
+        exit 1
+    fi
+    touch "${CACHE_DIR}/.complete"
+else
+    echo "[k10_sim_build] Reusing cached ${TARGET} model (key ${KEY})" >&2
+fi
+
+flock -u 9
+echo "${SIM_EXE}"
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# ============================================================================
+# k10_trace_bin2csv.py — Convert a K10 binary trace to riscv-dv CSV
+# ============================================================================
+# Reads the file written by k10_tracer in +trace_format=bin mode (see
+# rtl/k10/tb/k10_trace_writer.h) and writes the same CSV the text tracer
+# produces, so instr_trace_compare.py can consume it unchanged:
+#   - the first 200 retired instructions are all logged,
+#   - after that only instructions that write a GPR (rd != x0).
+#
+# Usage:
+#   python3 k10_trace_bin2csv.py k10_trace.bin k10_trace.csv
+#   python3 k10_trace_bin2csv.py k10_trace.bin k10_trace.csv --full-count 0
+# ============================================================================
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"K10TRACE"
+HEADER = struct.Struct("<8sII")
+RECORD = struct.Struct("<IIIBBH")   # pc, instr, rd_data, rd, flags, reserved
+FLAG_RD = 0x1
+CSV_HEADER = "pc,instr,gpr,csr,binary,mode,instr_str,operand,pad\n"
+
+ABI_NAMES = [
+    "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+    "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+    "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6",
+]
+
+
+def convert(bin_path: str, csv_path: str, full_count: int = 200) -> int:
+    with open(bin_path, "rb") as f:
+        data = f.read()
+
+    if len(data) < HEADER.size:
+        raise ValueError(f"{bin_path}: file too short for a trace header")
+    magic, version, rec_size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"{bin_path}: bad magic {magic!r}")
+    if version != 1 or rec_size != RECORD.size:
+        raise ValueError(f"{bin_path}: unsupported version {version} / record size {rec_size}")
+
+    body = memoryview(data)[HEADER.size:]
+    if len(body) % RECORD.size != 0:
+        print(f"WARNING: {bin_path}: trailing partial record ignored", file=sys.stderr)
+
+    count = 0
+    with open(csv_path, "w") as out:
+        out.write(CSV_HEADER)
+        for pc, instr, rd_data, rd, flags, _ in RECORD.iter_unpack(
+                body[:len(body) - len(body) % RECORD.size]):
+            count += 1
+            mode = (flags >> 1) & 0x3
+            mode_str = "3" if mode == 3 else "0"
+            writes_gpr = bool(flags & FLAG_RD) and rd != 0
+            if writes_gpr:
+                out.write(f"{pc:08x},,\"{ABI_NAMES[rd & 0x1f]}:{rd_data:08x}\",,"
+                          f"{instr:08x},{mode_str},,,\n")
+            elif count <= full_count:
+                out.write(f"{pc:08x},,,,{instr:08x},{mode_str},,,\n")
+    return count
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Convert a K10 binary trace to riscv-dv CSV")
+    parser.add_argument("bin_file", help="binary trace from +trace_format=bin")
+    parser.add_argument("csv_file", help="output riscv-dv CSV")
+    parser.add_argument("--full-count", type=int, default=200,
+                        help="log every instruction for the first N retires (default 200)")
+    args = parser.parse_args()
+
+    try:
+        n = convert(args.bin_file, args.csv_file, args.full_count)
+    except (OSError, ValueError) as exc:
+        print(f"ERROR: {exc}", file=sys.stderr)
+        sys.exit(1)
+    print(f"Converted {n} records -> {args.csv_file}")
+
+
+if __name__ == "__main__":
+    main()
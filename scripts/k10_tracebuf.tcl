@@ -0,0 +1,87 @@
+# OpenOCD helpers for the K10 commit trace buffer (rtl/k10/periph/k10_trace_buf.sv)
+#
+# Source after a K10 target config; everything goes over system bus access
+# (riscv set_prefer_sba on), so the core does not have to be halted:
+#
+#   openocd -c "set K10_NO_HALT 1" -f scripts/k10-genesys2-openocd.tcl \
+#           -f scripts/k10_tracebuf.tcl -c "k10_tracebuf_status" -c shutdown
+#
+# or from a telnet session: source scripts/k10_tracebuf.tcl
+#
+# Needs OpenOCD 0.12+ (read_memory).
+
+if {![info exists K10_TRACE_BASE]} {
+    set K10_TRACE_BASE 0x40010000
+}
+
+set K10_TRACE_CTRL_EN        0x001
+set K10_TRACE_CTRL_WRAP      0x002
+set K10_TRACE_CTRL_START_PC  0x004
+set K10_TRACE_CTRL_STOP_PC   0x008
+set K10_TRACE_CTRL_STOP_TRAP 0x010
+set K10_TRACE_CTRL_CLEAR     0x100
+
+proc k10_tracebuf_rd {off} {
+    global K10_TRACE_BASE
+    return [lindex [read_memory [expr {$K10_TRACE_BASE + $off}] 32 1] 0]
+}
+
+proc k10_tracebuf_wr {off value} {
+    global K10_TRACE_BASE
+    mww [expr {$K10_TRACE_BASE + $off}] $value
+}
+
+proc k10_tracebuf_status {} {
+    set ctrl   [k10_tracebuf_rd 0x00]
+    set status [k10_tracebuf_rd 0x04]
+    set wptr   [k10_tracebuf_rd 0x08]
+    set depth  [k10_tracebuf_rd 0x0C]
+    set states {idle armed recording stopping stopping}
+    set state  [lindex $states [expr {$status & 0x7}]]
+    echo [format "K10_TRACEBUF ctrl=0x%03x state=%s wptr=%u depth=%u wrapped=%d full=%d overflow=%d" \
+        $ctrl $state $wptr $depth [expr {($status >> 4) & 1}] \
+        [expr {($status >> 5) & 1}] [expr {($status >> 6) & 1}]]
+}
+
+# Clear and start recording.  flags: CTRL bits other than EN / CLEAR
+# (default: ring mode); set START_PC / STOP_PC before for the pc triggers.
+proc k10_tracebuf_start {{flags 0x002} {start_pc 0} {stop_pc 0}} {
+    global K10_TRACE_CTRL_EN K10_TRACE_CTRL_CLEAR
+    k10_tracebuf_wr 0x10 $start_pc
+    k10_tracebuf_wr 0x14 $stop_pc
+    k10_tracebuf_wr 0x00 [expr {$flags | $K10_TRACE_CTRL_EN | $K10_TRACE_CTRL_CLEAR}]
+}
+
+# Stop recording and wait until the hardware has written out its pending
+# records (STATUS.state back to idle).
+proc k10_tracebuf_stop {} {
+    global K10_TRACE_CTRL_EN
+    set ctrl [k10_tracebuf_rd 0x00]
+    k10_tracebuf_wr 0x00 [expr {$ctrl & ~$K10_TRACE_CTRL_EN}]
+    for {set i 0} {$i < 100} {incr i} {
+        if {([k10_tracebuf_rd 0x04] & 0x7) == 0} {
+            return
+        }
+    }
+    echo "K10_TRACEBUF WARNING: still not idle after stop"
+}
+
+# Write the ring to <file> (raw little-endian words, DATA[0] first) and
+# its WPTR / DEPTH / STATUS to <file>.meta for k10_tracebuf_decode.py.
+# Stop first for a consistent snapshot.
+proc k10_tracebuf_dump {file} {
+    global K10_TRACE_BASE
+    set status [k10_tracebuf_rd 0x04]
+    set wptr   [k10_tracebuf_rd 0x08]
+    set depth  [k10_tracebuf_rd 0x0C]
+    set words  [expr {$wptr < $depth ? $wptr : $depth}]
+    if {$words > 0} {
+        dump_image $file [expr {$K10_TRACE_BASE + 0x8000}] [expr {$words * 4}]
+    } else {
+        close [open $file w]
+    }
+    set meta [open "$file.meta" w]
+    puts $meta "wptr=$wptr depth=$depth status=$status"
+    close $meta
+    echo "K10_TRACEBUF dumped $words words to $file (wptr=$wptr)"
+}
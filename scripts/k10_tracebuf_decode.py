@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+# ============================================================================
+# k10_tracebuf_decode.py — Decode a K10 commit trace buffer dump
+# ============================================================================
+# Reads the raw ring written by k10_tracebuf_dump.sh (k10_tracebuf_dump in
+# scripts/k10_tracebuf.tcl) and its .meta file, puts the words in write
+# order and decodes the record stream described in
+# rtl/k10/periph/k10_trace_buf.sv.  Decoding starts at the first SYNC.
+#
+# Without an ELF every record is listed with the branch targets it
+# implies.  With --elf, sequential runs are expanded into PCs (instruction
+# lengths come from the ELF's code), so the last retired instructions
+# (--tail) and a per-function retire profile (--profile) can be printed.
+#
+# Usage:
+#   python3 k10_tracebuf_decode.py trace.bin
+#   python3 k10_tracebuf_decode.py trace.bin --elf fw.elf --tail 100 --profile
+#   python3 k10_tracebuf_decode.py trace.bin --wptr 12345 --no-records
+# ============================================================================
+
+import argparse
+import bisect
+import collections
+import struct
+import sys
+
+INT_NAMES = {3: "msi", 7: "mti", 11: "mei"}
+EXC_NAMES = {
+    0: "instr_misaligned", 1: "instr_fault", 2: "illegal", 3: "breakpoint",
+    4: "load_misaligned", 5: "load_fault", 6: "store_misaligned",
+    7: "store_fault", 8: "ecall_u", 11: "ecall_m",
+}
+
+
+class Elf:
+    """Executable sections and function symbols of a little-endian ELF32."""
+
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF32 file")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize)
+                    for i in range(shnum)]
+
+        self.code = []     # (start, end, bytes)
+        syms = {}
+        for _, sh_type, flags, addr, off, size, link, _, _, entsize in sections:
+            if sh_type == 1 and flags & 0x4:          # PROGBITS, EXECINSTR
+                self.code.append((addr, addr + size, data[off:off + size]))
+            elif sh_type == 2 and entsize:            # SYMTAB
+                strtab = sections[link]
+                for i in range(size // entsize):
+                    name, value, _, info, _, shndx = struct.unpack_from(
+                        "<IIIBBH", data, off + i * entsize)
+                    if info & 0xF != 2 or shndx == 0:  # STT_FUNC, defined
+                        continue
+                    end = data.index(b"\0", strtab[4] + name)
+                    syms[value] = data[strtab[4] + name:end].decode(errors="replace")
+        self.sym_addrs = sorted(syms)
+        self.sym_names = [syms[a] for a in self.sym_addrs]
+
+    def ilen(self, pc: int):
+        for start, end, code in self.code:
+            if start <= pc < end:
+                return 2 if code[pc - start] & 0x3 != 0x3 else 4
+        return None
+
+    def symbol(self, pc: int) -> str:
+        i = bisect.bisect_right(self.sym_addrs, pc) - 1
+        if i < 0:
+            return "?"
+        off = pc - self.sym_addrs[i]
+        return self.sym_names[i] + (f"+0x{off:x}" if off else "")
+
+    def function(self, pc: int) -> str:
+        i = bisect.bisect_right(self.sym_addrs, pc) - 1
+        return self.sym_names[i] if i >= 0 else "?"
+
+
+def load_words(path: str, wptr):
+    with open(path, "rb") as f:
+        data = f.read()
+    if wptr is None:
+        try:
+            with open(path + ".meta") as f:
+                meta = dict(kv.split("=", 1) for kv in f.read().split())
+            wptr = int(meta["wptr"], 0)
+            depth = int(meta["depth"], 0)
+        except (OSError, KeyError, ValueError):
+            raise ValueError(f"{path}.meta missing or malformed; pass --wptr")
+    else:
+        depth = len(data) // 4
+    words = list(struct.unpack(f"<{len(data) // 4}I", data[:len(data) // 4 * 4]))
+    if wptr > depth and len(words) == depth:
+        start = wptr % depth
+        words = words[start:] + words[:start]
+    return words[:wptr], wptr > depth
+
+
+def sext(value: int, bits: int) -> int:
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def trap_name(irq: int, cause: int) -> str:
+    return (INT_NAMES if irq else EXC_NAMES).get(cause, f"{'int' if irq else 'exc'}{cause}")
+
+
+class Decoder:
+    def __init__(self, elf, tail: int, records: bool):
+        self.elf = elf
+        self.records = records
+        self.tail = collections.deque(maxlen=tail) if tail else None
+        self.profile = collections.Counter()
+        self.pc = None          # PC of the last commit (None: unknown)
+        self.anchor = None
+        self.last_br = None
+        self.cycle = None
+        self.first_cycle = None
+        self.commits = 0
+        self.lost_pcs = 0
+        self.note = ""
+
+    def out(self, idx: int, text: str) -> None:
+        if self.records:
+            print(f"{idx:6d}  {text}")
+
+    def where(self, pc) -> str:
+        if pc is None:
+            return "?"
+        return f"0x{pc:08x}" + (f" <{self.elf.symbol(pc)}>" if self.elf else "")
+
+    def commit(self, pc) -> None:
+        self.commits += 1
+        self.pc = pc
+        if pc is None:
+            self.lost_pcs += 1
+            return
+        if self.elf:
+            self.profile[self.elf.function(pc)] += 1
+        if self.tail is not None:
+            self.tail.append((pc, self.note))
+            self.note = ""
+
+    def step(self, n: int) -> None:
+        if not self.elf:
+            self.commits += n
+            self.pc = None
+            return
+        for _ in range(n):
+            ilen = self.elf.ilen(self.pc) if self.pc is not None else None
+            self.commit(self.pc + ilen if ilen else None)
+
+    def branch(self, nseq: int, delta: int) -> None:
+        self.step(nseq)
+        self.anchor = (self.anchor + 2 * delta) & 0xFFFF_FFFF
+        self.commit(self.anchor)
+
+    def repeat(self, n: int) -> None:
+        nseq, delta = self.last_br
+        if not self.elf:
+            self.commits += n * (nseq + 1)
+            self.anchor = (self.anchor + 2 * delta * n) & 0xFFFF_FFFF
+            self.pc = self.anchor
+            return
+        if delta != 0:
+            for _ in range(n):
+                self.branch(nseq, delta)
+            return
+        # A loop (same body every time): expand one iteration, count the
+        # rest, and expand enough final iterations to fill the tail.
+        keep = min(n, 1 + (self.tail.maxlen // (nseq + 1) if self.tail is not None else 0))
+        before, commits, lost = self.profile.copy(), self.commits, self.lost_pcs
+        self.branch(nseq, delta)
+        for name, count in (self.profile - before).items():
+            self.profile[name] += count * (n - keep)
+        self.commits += (self.commits - commits) * (n - keep)
+        self.lost_pcs += (self.lost_pcs - lost) * (n - keep)
+        for _ in range(keep - 1):
+            self.branch(nseq, delta)
+
+    def decode(self, words) -> None:
+        synced = False
+        for idx, w in enumerate(words):
+            if w >> 31:
+                self.anchor = (w << 1) & 0xFFFF_FFFF
+                self.commit(self.anchor)
+                self.last_br = None
+                synced = True
+                self.out(idx, f"SYNC    {self.where(self.anchor)}")
+            elif w >> 28 == 0x6:
+                trap, irq, cause = (w >> 27) & 1, (w >> 26) & 1, (w >> 21) & 0x1F
+                priv, dbg = "MU"[((w >> 19) & 3) != 3], (w >> 18) & 1
+                text = f"priv={priv}" + (" debug" if dbg else "")
+                if trap:
+                    text = f"trap {trap_name(irq, cause)} " + text
+                    self.note = f"<- {trap_name(irq, cause)}"
+                self.out(idx, f"EVENT   {text}")
+            elif w >> 28 == 0x7:
+                cycle = (w & 0x0FFF_FFFF) << 4
+                if self.cycle is None:
+                    self.cycle = self.first_cycle = cycle
+                else:
+                    self.cycle += (cycle - self.cycle) & 0xFFFF_FFFF
+                self.out(idx, f"TIME    cycle={self.cycle}")
+            elif not synced:
+                continue
+            elif w >> 30 == 0:
+                nseq, delta = (w >> 21) & 0x1FF, sext(w & 0x1F_FFFF, 21)
+                self.branch(nseq, delta)
+                self.last_br = (nseq, delta)
+                self.out(idx, f"BRANCH  +{nseq} -> {self.where(self.anchor)}")
+            elif w >> 28 == 0x4:
+                n = w & 0x0FFF_FFFF
+                self.step(n)
+                self.out(idx, f"SEQ     +{n}")
+            elif w >> 28 == 0x5:
+                n = w & 0x0FFF_FFFF
+                if self.last_br is None:
+                    self.out(idx, f"REPEAT  x{n} (no BRANCH to repeat)")
+                    continue
+                self.repeat(n)
+                self.out(idx, f"REPEAT  x{n} -> {self.where(self.anchor)}")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Decode a K10 commit trace buffer dump")
+    parser.add_argument("dump", help="raw ring from k10_tracebuf_dump.sh (<prefix>.bin)")
+    parser.add_argument("--wptr", type=lambda s: int(s, 0),
+                        help="WPTR at dump time (default: read <dump>.meta)")
+    parser.add_argument("--elf", help="firmware ELF: expand sequential runs, symbolize")
+    parser.add_argument("--tail", type=int, default=0,
+                        help="print the last N retired PCs (needs --elf)")
+    parser.add_argument("--profile", action="store_true",
+                        help="print retired instructions per function (needs --elf)")
+    parser.add_argument("--no-records", action="store_true",
+                        help="do not list the individual records")
+    args = parser.parse_args()
+
+    try:
+        words, wrapped = load_words(args.dump, args.wptr)
+        elf = Elf(args.elf) if args.elf else None
+    except (OSError, ValueError) as exc:
+        print(f"ERROR: {exc}", file=sys.stderr)
+        sys.exit(1)
+
+    dec = Decoder(elf, args.tail if elf else 0, not args.no_records)
+    dec.decode(words)
+
+    span = ""
+    if dec.cycle is not None and dec.cycle != dec.first_cycle:
+        span = f", {dec.cycle - dec.first_cycle} cycles between first and last TIME"
+    print(f"# {len(words)} words{' (wrapped)' if wrapped else ''}, "
+          f"{dec.commits} retired instructions{span}")
+    if elf and dec.lost_pcs:
+        print(f"# {dec.lost_pcs} PCs not recovered (code outside the ELF)")
+
+    if dec.tail:
+        print(f"\n# Last {len(dec.tail)} retired instructions")
+        for pc, note in dec.tail:
+            print(f"0x{pc:08x}  {elf.symbol(pc):40s} {note}")
+
+    if args.profile and elf:
+        total = sum(dec.profile.values()) or 1
+        print("\n# Retired instructions per function")
+        for name, count in dec.profile.most_common():
+            print(f"{count:12d}  {100.0 * count / total:6.2f}%  {name}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,105 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Commit Trace Buffer Dump
+# ============================================================================
+# Reads the k10_trace_buf ring (TRACE_BUF=true builds) over JTAG system bus
+# access and decodes it with scripts/k10_tracebuf_decode.py.  The core is
+# not halted: by default recording is stopped for a consistent snapshot and
+# the core keeps running.
+#
+#   <out>.bin / .bin.meta  raw ring and WPTR / DEPTH / STATUS
+#   <out>.txt              decoded records (plus the last --tail retired
+#                          PCs and a per-function profile with --elf)
+#
+# Usage:
+#   ./scripts/k10_tracebuf_dump.sh --elf build/sw/k10_c_selftest.elf
+#   ./scripts/k10_tracebuf_dump.sh --rearm            # dump, then record again
+#   ./scripts/k10_tracebuf_dump.sh --live             # do not stop recording
+#   ./scripts/k10_tracebuf_dump.sh --sim              # Vk10_tb --jtag-server
+#   ./scripts/k10_tracebuf_dump.sh --start-only --stop-trap
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+OPENOCD_CFG="${SCRIPT_DIR}/k10-genesys2-openocd.tcl"
+OUT="${PROJECT_ROOT}/build/tracebuf/trace"
+ELF=""
+TAIL=64
+STOP=1
+REARM=0
+START_ONLY=0
+START_FLAGS=2          # WRAP
+START_PC=0
+STOP_PC=0
+
+usage() {
+    echo "Usage: $0 [--sim] [--out <prefix>] [--elf <file>] [--tail <N>] [--live] [--rearm]" >&2
+    echo "       $0 --start-only [--no-wrap] [--start-pc <addr>] [--stop-pc <addr>] [--stop-trap]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --sim)        OPENOCD_CFG="${SCRIPT_DIR}/k10-sim-openocd.tcl"; shift ;;
+        --out)        OUT="$2";   shift 2 ;;
+        --elf)        ELF="$2";   shift 2 ;;
+        --tail)       TAIL="$2";  shift 2 ;;
+        --live)       STOP=0;     shift ;;
+        --rearm)      REARM=1;    shift ;;
+        --start-only) START_ONLY=1; shift ;;
+        --no-wrap)    START_FLAGS=$((START_FLAGS & ~2)); shift ;;
+        --start-pc)   START_PC="$2"; START_FLAGS=$((START_FLAGS | 4));  shift 2 ;;
+        --stop-pc)    STOP_PC="$2";  START_FLAGS=$((START_FLAGS | 8));  shift 2 ;;
+        --stop-trap)  START_FLAGS=$((START_FLAGS | 16)); shift ;;
+        -h|--help)    usage ;;
+        *)            echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+for cmd in openocd python3; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh"
+        exit 1
+    fi
+done
+
+START_CMD="k10_tracebuf_start ${START_FLAGS} ${START_PC} ${STOP_PC}"
+OPENOCD=(openocd -c "set K10_NO_HALT 1" -f "${OPENOCD_CFG}"
+         -f "${SCRIPT_DIR}/k10_tracebuf.tcl")
+
+if [[ ${START_ONLY} -eq 1 ]]; then
+    "${OPENOCD[@]}" -c "${START_CMD}" -c "k10_tracebuf_status" -c "shutdown" 2>&1 |
+        grep "K10_TRACEBUF" || { echo "ERROR: OpenOCD failed" >&2; exit 1; }
+    exit 0
+fi
+
+mkdir -p "$(dirname "${OUT}")"
+CMDS=(-c "k10_tracebuf_status")
+[[ ${STOP} -eq 1 ]]  && CMDS+=(-c "k10_tracebuf_stop")
+CMDS+=(-c "k10_tracebuf_dump ${OUT}.bin")
+[[ ${REARM} -eq 1 ]] && CMDS+=(-c "${START_CMD}")
+CMDS+=(-c "shutdown")
+
+echo "=== Reading trace buffer over SBA ($(basename "${OPENOCD_CFG}")) ==="
+if ! "${OPENOCD[@]}" "${CMDS[@]}" > "${OUT}_openocd.log" 2>&1; then
+    echo "ERROR: OpenOCD failed, see ${OUT}_openocd.log" >&2
+    exit 1
+fi
+grep "K10_TRACEBUF" "${OUT}_openocd.log" || true
+
+DECODE=(python3 "${SCRIPT_DIR}/k10_tracebuf_decode.py" "${OUT}.bin")
+if [[ -n "${ELF}" ]]; then
+    DECODE+=(--elf "${ELF}" --tail "${TAIL}" --profile)
+fi
+"${DECODE[@]}" > "${OUT}.txt"
+echo "Decoded trace: ${OUT}.txt"
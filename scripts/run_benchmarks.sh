@@ -0,0 +1,206 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Benchmark Runner (CoreMark, Dhrystone, Embench)
+# ============================================================================
+# Builds the sw/k10/test bench_* targets, runs each one on the Verilator
+# model or on a Genesys2 board, and appends one CSV row per benchmark to the
+# results file, keyed by the current commit:
+#
+#   commit,dirty,date,target,bench,cycles,instret,iterations,score,unit,status
+#
+# The rows come from the "K10_BENCH name=... status=..." line each benchmark
+# prints (sw/k10/test/bench/k10_bench.h).  A benchmark that prints none
+# (hang, trap, timeout) gets status=NORESULT.  Raw logs are kept under
+# build/bench/<target>/<commit>/.
+#
+#   sim       empty-MEM_INIT model from scripts/k10_sim_build.sh, ELF loaded
+#             with --elf, output through SIM_CHAR_OUT (K10_REAL_HW_LOGS=OFF)
+#   genesys2  board already programmed (./build.sh genesys2 &&
+#             ./scripts/fpga_run.sh); each ELF is loaded over JTAG with
+#             OpenOCD (scripts/k10-genesys2-openocd.tcl) and the result read
+#             from the UART device (K10_REAL_HW_LOGS=ON)
+#
+# Benchmark sources are fetched by scripts/setup_tools.sh (tools/coremark,
+# tools/embench-iot; Dhrystone goes in tools/dhrystone by hand).  Suites
+# whose sources are missing are skipped at configure time.
+#
+# Usage:
+#   ./scripts/run_benchmarks.sh
+#   ./scripts/run_benchmarks.sh --target genesys2 --uart /dev/ttyUSB1
+#   ./scripts/run_benchmarks.sh --only coremark --coremark-iterations 100
+#   ./scripts/run_benchmarks.sh --results build/bench/nightly.csv
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+BOOT_ADDR=2147483648  # 0x80000000
+
+TARGET="sim"
+UART_DEV="/dev/ttyUSB1"
+UART_BAUD=115200
+TIMEOUT=600
+ONLY=""
+RESULTS="${PROJECT_ROOT}/build/bench/results.csv"
+CMAKE_ARGS=()
+BUILD_ARGS=()
+
+usage() {
+    echo "Usage: $0 [--target <sim|genesys2>] [--only <regex>] [--results <csv>]" >&2
+    echo "          [--timeout <s>] [--uart <dev>] [--baud <N>]" >&2
+    echo "          [--coremark-iterations <N>] [--dhrystone-runs <N>] [--embench-cpu-mhz <N>]" >&2
+    echo "          [--coremark-dir <dir>] [--dhrystone-dir <dir>] [--embench-dir <dir>]" >&2
+    echo "          [--branch-pred|--prefetch-depth|--icache|--store-buffer|--mul-stages|--fast-div <V>]   (sim)" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --target)   TARGET="$2";   shift 2 ;;
+        --only)     ONLY="$2";     shift 2 ;;
+        --results)  RESULTS="$2";  shift 2 ;;
+        --timeout)  TIMEOUT="$2";  shift 2 ;;
+        --uart)     UART_DEV="$2"; shift 2 ;;
+        --baud)     UART_BAUD="$2"; shift 2 ;;
+        --coremark-iterations) CMAKE_ARGS+=("-DK10_COREMARK_ITERATIONS=$2"); shift 2 ;;
+        --dhrystone-runs)      CMAKE_ARGS+=("-DK10_DHRYSTONE_RUNS=$2");      shift 2 ;;
+        --embench-cpu-mhz)     CMAKE_ARGS+=("-DK10_EMBENCH_CPU_MHZ=$2");     shift 2 ;;
+        --coremark-dir)  CMAKE_ARGS+=("-DK10_COREMARK_DIR=$(realpath "$2")");  shift 2 ;;
+        --dhrystone-dir) CMAKE_ARGS+=("-DK10_DHRYSTONE_DIR=$(realpath "$2")"); shift 2 ;;
+        --embench-dir)   CMAKE_ARGS+=("-DK10_EMBENCH_DIR=$(realpath "$2")");   shift 2 ;;
+        # Model configuration, passed through to k10_sim_build.sh
+        --branch-pred|--prefetch-depth|--icache|--store-buffer|--mul-stages|--fast-div)
+                    BUILD_ARGS+=("$1" "$2"); shift 2 ;;
+        -h|--help)  usage ;;
+        *)          echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+case "${TARGET}" in
+    sim)      REAL_HW=OFF; TOOLS=(riscv32-unknown-elf-gcc cmake verilator fusesoc) ;;
+    genesys2) REAL_HW=ON;  TOOLS=(riscv32-unknown-elf-gcc cmake openocd stty) ;;
+    *)        echo "ERROR: --target must be sim or genesys2" >&2; exit 1 ;;
+esac
+
+for cmd in "${TOOLS[@]}"; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh"
+        exit 1
+    fi
+done
+
+COMMIT="$(git -C "${PROJECT_ROOT}" rev-parse --short=12 HEAD)"
+DIRTY=0
+if ! git -C "${PROJECT_ROOT}" diff --quiet HEAD -- rtl sw 2>/dev/null; then
+    DIRTY=1
+fi
+DATE="$(date -u +%Y-%m-%dT%H:%M:%SZ)"
+LOG_DIR="${PROJECT_ROOT}/build/bench/${TARGET}/${COMMIT}"
+mkdir -p "${LOG_DIR}" "$(dirname "${RESULTS}")"
+
+# ---------------------------------------------------------------------------
+# Step 1: Build the benchmarks
+# ---------------------------------------------------------------------------
+echo "=== [1/3] Building benchmarks (K10_REAL_HW_LOGS=${REAL_HW}) ==="
+SW_BUILD="${PROJECT_ROOT}/build/bench/sw-${TARGET}"
+cmake -S "${PROJECT_ROOT}/sw/k10" -B "${SW_BUILD}" \
+    -DCMAKE_TOOLCHAIN_FILE="${PROJECT_ROOT}/sw/k10/riscv32.cmake" \
+    -DK10_REAL_HW_LOGS="${REAL_HW}" "${CMAKE_ARGS[@]}" > "${LOG_DIR}/cmake.log"
+grep -- "skipping" "${LOG_DIR}/cmake.log" || true
+cmake --build "${SW_BUILD}" --target k10_benchmarks -j"$(nproc)" >> "${LOG_DIR}/cmake.log"
+
+ELFS=()
+for elf in "${SW_BUILD}"/bench/*.elf; do
+    [[ -f "${elf}" ]] || continue
+    name="$(basename "${elf}" .elf)"
+    if [[ -n "${ONLY}" ]] && ! [[ "${name}" =~ ${ONLY} ]]; then
+        continue
+    fi
+    ELFS+=("${elf}")
+done
+if [[ ${#ELFS[@]} -eq 0 ]]; then
+    echo "ERROR: no benchmarks built. Run scripts/setup_tools.sh, or pass --*-dir." >&2
+    exit 1
+fi
+
+# ---------------------------------------------------------------------------
+# Step 2: Run them
+# ---------------------------------------------------------------------------
+run_sim() {
+    local elf="$1" log="$2"
+    # +finish_on_ecall=0: the ECALL after main() ends the run through
+    # trap_handler() / SIM_CTRL, which carries the verdict.
+    timeout "${TIMEOUT}" "${SIM_EXE}" +trace_format=none +finish_on_ecall=0 \
+        +max_cycles=0 --elf "${elf}" > "${log}" 2>&1 || true
+}
+
+run_genesys2() {
+    local elf="$1" log="$2" cat_pid
+    stty -F "${UART_DEV}" "${UART_BAUD}" raw -echo
+    cat "${UART_DEV}" > "${log}" &
+    cat_pid=$!
+    openocd -f "${SCRIPT_DIR}/k10-genesys2-openocd.tcl" \
+        -c "load_image ${elf}" \
+        -c "resume ${BOOT_ADDR}" \
+        -c "shutdown" > "${log%.log}_openocd.log" 2>&1 || true
+
+    local waited=0
+    while ! grep -q "^K10_BENCH name=" "${log}" && [[ ${waited} -lt ${TIMEOUT} ]]; do
+        sleep 1
+        waited=$((waited + 1))
+    done
+    kill "${cat_pid}" 2>/dev/null || true
+    wait "${cat_pid}" 2>/dev/null || true
+}
+
+if [[ "${TARGET}" == "sim" ]]; then
+    echo "=== [2/3] Building Verilator simulation (cached) ==="
+    SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" --boot-addr "${BOOT_ADDR}" "${BUILD_ARGS[@]}")"
+else
+    echo "=== [2/3] Genesys2 over ${UART_DEV} (board must already be programmed) ==="
+fi
+
+if [[ ! -f "${RESULTS}" ]]; then
+    echo "commit,dirty,date,target,bench,cycles,instret,iterations,score,unit,status" > "${RESULTS}"
+fi
+
+# Value of key=<value> in the K10_BENCH line
+field() { sed -n "s/.* $1=\([^ ]*\).*/\1/p" <<< "${line}"; }
+
+FAILED=0
+for elf in "${ELFS[@]}"; do
+    name="$(basename "${elf}" .elf)"
+    log="${LOG_DIR}/${name}.log"
+    echo "  running ${name}..."
+    "run_${TARGET}" "${elf}" "${log}"
+
+    line="$(tr -d '\r' < "${log}" | grep -m1 "^K10_BENCH name=" || true)"
+    if [[ -z "${line}" ]]; then
+        echo "${COMMIT},${DIRTY},${DATE},${TARGET},${name},,,,,,NORESULT" >> "${RESULTS}"
+        echo "  FAIL ${name}  (no K10_BENCH line, see ${log})"
+        FAILED=1
+        continue
+    fi
+
+    status="$(field status)"
+    echo "${COMMIT},${DIRTY},${DATE},${TARGET},$(field name),$(field cycles),$(field instret),$(field iterations),$(field score),$(field unit),${status}" >> "${RESULTS}"
+    printf "  %-4s %-24s %12s cycles  %s %s\n" \
+        "${status}" "$(field name)" "$(field cycles)" "$(field score)" "$(field unit)"
+    [[ "${status}" == "PASS" ]] || FAILED=1
+done
+
+# ---------------------------------------------------------------------------
+# Step 3: Summary
+# ---------------------------------------------------------------------------
+echo ""
+echo "=== [3/3] Results for ${COMMIT}$([[ ${DIRTY} -eq 1 ]] && echo " (dirty)") appended to ${RESULTS} ==="
+exit ${FAILED}
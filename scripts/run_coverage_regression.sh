@@ -0,0 +1,198 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Coverage Regression, Merge and Seed Minimization
+# ============================================================================
+# Runs riscv-dv seeds through scripts/run_riscv_dv.sh --coverage, --jobs at
+# a time, all on one sim_cov model.  Every run writes its own coverage.dat
+# (line coverage plus the rtl/k10/tb/k10_cov.sv cover points) once, at the
+# end of the simulation; the files are merged with verilator_coverage and
+# ranked by scripts/k10_cov_minimize.py, which writes the smallest set of
+# seeds it finds that reaches the same merged coverage:
+#
+#   <output>/runs.csv             test,seed,status,cycles,coverage
+#   <output>/<test>/seed_<S>/     run_riscv_dv.sh output, coverage.dat
+#   <output>/merged.dat           every passing run, merged
+#   <output>/min/seeds.txt        "<test> <seed>" per kept run (--seeds input)
+#   <output>/min/ranking.txt      seed ranking and per-group coverage
+#
+# min/seeds.txt is the minimized regression: replay it with --seeds.
+#
+# Failing runs are listed and left out of the merge and the ranking.
+# Exit status is 1 if any run failed.
+#
+# Usage:
+#   ./scripts/run_coverage_regression.sh --iterations 8 --jobs 16
+#   ./scripts/run_coverage_regression.sh --tests "k10_rand_instr_test" --iterations 64
+#   ./scripts/run_coverage_regression.sh --seeds build/coverage/min/seeds.txt
+#   ./scripts/run_coverage_regression.sh --iterations 4 --annotate
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+BOOT_ADDR=2147483648  # 0x80000000
+TESTLIST="${PROJECT_ROOT}/rtl/k10/tb/testlist.yaml"
+OUTPUT_DIR="${PROJECT_ROOT}/build/coverage"
+
+TESTS=""
+ITERATIONS=4
+SEED=""
+SEEDS_FILE=""
+JOBS="$(nproc)"
+ANNOTATE=0
+
+usage() {
+    echo "Usage: $0 [--tests \"<name> ...\"] [--iterations <N>] [--seed <N>] [--seeds <file>]" >&2
+    echo "          [--jobs <N>] [--output <dir>] [--annotate]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --tests)      TESTS="$2";       shift 2 ;;
+        --iterations) ITERATIONS="$2";  shift 2 ;;
+        --seed)       SEED="$2";        shift 2 ;;
+        --seeds)      SEEDS_FILE="$(realpath "$2")"; shift 2 ;;
+        --jobs)       JOBS="$2";        shift 2 ;;
+        --output)     OUTPUT_DIR="$(realpath -m "$2")"; shift 2 ;;
+        --annotate)   ANNOTATE=1;       shift ;;
+        -h|--help)    usage ;;
+        *)            echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+if ! [[ "${ITERATIONS}" =~ ^[1-9][0-9]*$ ]]; then
+    echo "ERROR: --iterations must be a positive number" >&2
+    exit 1
+fi
+if ! [[ "${JOBS}" =~ ^[1-9][0-9]*$ ]]; then
+    echo "ERROR: --jobs must be a positive number" >&2
+    exit 1
+fi
+if [[ -n "${SEED}" ]] && ! [[ "${SEED}" =~ ^[0-9]+$ ]]; then
+    echo "ERROR: --seed must be a number" >&2
+    exit 1
+fi
+if [[ -n "${SEEDS_FILE}" && -n "${TESTS}" ]]; then
+    echo "ERROR: --seeds cannot be combined with --tests" >&2
+    exit 1
+fi
+
+for cmd in verilator verilator_coverage fusesoc python3; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh" >&2
+        exit 1
+    fi
+done
+
+# ---------------------------------------------------------------------------
+# Runs: "<test> <seed>" pairs, from --seeds or tests x iterations
+# ---------------------------------------------------------------------------
+RUNS=()
+if [[ -n "${SEEDS_FILE}" ]]; then
+    while read -r t s _; do
+        [[ -z "${t}" || "${t}" == \#* ]] && continue
+        if ! [[ "${s}" =~ ^[0-9]+$ ]]; then
+            echo "ERROR: ${SEEDS_FILE}: bad line \"${t} ${s}\"" >&2
+            exit 1
+        fi
+        RUNS+=("${t} ${s}")
+    done < "${SEEDS_FILE}"
+else
+    if [[ -z "${TESTS}" ]]; then
+        TESTS="$(grep '^- test:' "${TESTLIST}" | awk '{print $3}')"
+    fi
+    BASE_SEED="${SEED:-$(( (RANDOM << 15) | RANDOM ))}"
+    for t in ${TESTS}; do
+        for i in $(seq 0 $((ITERATIONS - 1))); do
+            RUNS+=("${t} $((BASE_SEED + i))")
+        done
+    done
+fi
+if [[ ${#RUNS[@]} -eq 0 ]]; then
+    echo "ERROR: no runs selected" >&2
+    exit 1
+fi
+
+mkdir -p "${OUTPUT_DIR}"
+
+# ---------------------------------------------------------------------------
+# Step 1: sim_cov model, built once for every job
+# ---------------------------------------------------------------------------
+echo "=== [1/4] Building the sim_cov model (cached) ==="
+"${SCRIPT_DIR}/k10_sim_build.sh" --target sim_cov --boot-addr "${BOOT_ADDR}" > /dev/null
+
+# ---------------------------------------------------------------------------
+# Step 2: Run every seed, JOBS at a time
+# ---------------------------------------------------------------------------
+echo "=== [2/4] Running ${#RUNS[@]} seeds, ${JOBS} at a time ==="
+for run in "${RUNS[@]}"; do
+    read -r t s <<< "${run}"
+    dir="${OUTPUT_DIR}/${t}/seed_${s}"
+    while [[ "$(jobs -rp | wc -l)" -ge "${JOBS}" ]]; do
+        wait -n || true
+    done
+    rm -rf "${dir}"
+    mkdir -p "${dir}"
+    ( if "${SCRIPT_DIR}/run_riscv_dv.sh" --test "${t}" --seed "${s}" --coverage \
+             --output "${dir}" > "${dir}/run.log" 2>&1; then echo 0; else echo $?; fi \
+          > "${dir}/run.log.status" ) &
+done
+wait
+
+RUNS_CSV="${OUTPUT_DIR}/runs.csv"
+echo "test,seed,status,cycles,coverage" > "${RUNS_CSV}"
+PASSED_DATS=()
+FAILED=0
+for run in "${RUNS[@]}"; do
+    read -r t s <<< "${run}"
+    dir="${OUTPUT_DIR}/${t}/seed_${s}"
+    cov="${dir}/coverage.dat"
+    cycles="$(tr -d '\r' < "${dir}/k10_sim.log" 2>/dev/null |
+              sed -n 's/.*Simulation finished after \([0-9]*\) cycles.*/\1/p' | tail -1)"
+    status=FAIL
+    if [[ "$(cat "${dir}/run.log.status" 2>/dev/null)" == "0" && -f "${cov}" ]]; then
+        status=PASS
+        PASSED_DATS+=("${cov}")
+    else
+        echo "  FAIL ${t} seed ${s}  (${dir}/run.log)"
+        FAILED=1
+    fi
+    echo "${t},${s},${status},${cycles},${cov}" >> "${RUNS_CSV}"
+done
+echo "  ${#PASSED_DATS[@]} of ${#RUNS[@]} runs passed; see ${RUNS_CSV}"
+if [[ ${#PASSED_DATS[@]} -eq 0 ]]; then
+    echo "ERROR: no passing run to merge" >&2
+    exit 1
+fi
+
+# ---------------------------------------------------------------------------
+# Step 3: Merge
+# ---------------------------------------------------------------------------
+echo "=== [3/4] Merging coverage ==="
+verilator_coverage --write "${OUTPUT_DIR}/merged.dat" "${PASSED_DATS[@]}" \
+    > "${OUTPUT_DIR}/merge.log"
+if [[ "${ANNOTATE}" -eq 1 ]]; then
+    rm -rf "${OUTPUT_DIR}/annotated"
+    verilator_coverage --annotate "${OUTPUT_DIR}/annotated" --annotate-min 1 \
+        "${OUTPUT_DIR}/merged.dat" >> "${OUTPUT_DIR}/merge.log"
+    echo "  Annotated sources: ${OUTPUT_DIR}/annotated/"
+fi
+echo "  Merged: ${OUTPUT_DIR}/merged.dat"
+
+# ---------------------------------------------------------------------------
+# Step 4: Rank seeds, write the minimized set
+# ---------------------------------------------------------------------------
+echo "=== [4/4] Ranking seeds ==="
+python3 "${SCRIPT_DIR}/k10_cov_minimize.py" --runs "${RUNS_CSV}" \
+    --out-dir "${OUTPUT_DIR}/min"
+exit ${FAILED}
@@ -0,0 +1,141 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Genesys2 Fmax Sweep
+# ============================================================================
+# Implements genesys2_synth once per (CLK_FREQ_MHZ, MUL_STAGES) pair, runs
+# scripts/vivado_signoff_reports.tcl on each implementation and appends one
+# CSV row per configuration to the results file, keyed by the current
+# commit:
+#
+#   commit,dirty,date,clk_mhz,mul_stages,core_wns_ns,wns_ns,whs_ns,fmax_mhz,dsp,status
+#
+# core_wns_ns is the setup slack of the core clock (PLL CLKOUT0) and
+# fmax_mhz = 1000 / (period - core_wns_ns), an estimate of the clock the
+# same placement would close at.  wns_ns / whs_ns cover every clock.
+# status is MET (WNS >= 0 and WHS >= 0), VIOLATED, or FAILED when the
+# build or the report step did not finish.  Each configuration builds in
+# build/fmax/clk<F>_mul<S>/, with its reports under rpt/.
+#
+# Usage:
+#   ./scripts/run_fmax_sweep.sh
+#   ./scripts/run_fmax_sweep.sh --clk "50 75 100" --mul-stages "1 3"
+#   ./scripts/run_fmax_sweep.sh --clk 80 --mul-stages 2 --mem-init build/sw/k10_c_selftest.hex
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+BOOT_ADDR=2147483648  # 0x80000000
+CLKS="50 75 100"
+MUL_STAGES_LIST="1 2 3"
+MEM_INIT=""
+TRACE_BUF=false
+RESULTS="${PROJECT_ROOT}/build/fmax/results.csv"
+
+usage() {
+    echo "Usage: $0 [--clk \"<MHz> ...\"] [--mul-stages \"<1|2|3> ...\"] [--results <csv>]" >&2
+    echo "          [--mem-init <hex>] [--trace-buf <true|false>]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --clk)        CLKS="$2";            shift 2 ;;
+        --mul-stages) MUL_STAGES_LIST="$2"; shift 2 ;;
+        --results)    RESULTS="$2";         shift 2 ;;
+        --mem-init)   MEM_INIT="$(realpath "$2")"; shift 2 ;;
+        --trace-buf)  TRACE_BUF="$2";       shift 2 ;;
+        -h|--help)    usage ;;
+        *)            echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+for f in ${CLKS}; do
+    if ! [[ "${f}" =~ ^[0-9]+$ ]]; then
+        echo "ERROR: --clk takes whole MHz values" >&2
+        exit 1
+    fi
+done
+for s in ${MUL_STAGES_LIST}; do
+    if ! [[ "${s}" =~ ^[123]$ ]]; then
+        echo "ERROR: --mul-stages values must be 1, 2 or 3" >&2
+        exit 1
+    fi
+done
+
+for cmd in fusesoc vivado; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh and the Vivado settings64.sh" >&2
+        exit 1
+    fi
+done
+
+COMMIT="$(git -C "${PROJECT_ROOT}" rev-parse --short=12 HEAD)"
+DIRTY=0
+if ! git -C "${PROJECT_ROOT}" diff --quiet HEAD -- rtl 2>/dev/null; then
+    DIRTY=1
+fi
+DATE="$(date -u +%Y-%m-%dT%H:%M:%SZ)"
+mkdir -p "$(dirname "${RESULTS}")"
+if [[ ! -f "${RESULTS}" ]]; then
+    echo "commit,dirty,date,clk_mhz,mul_stages,core_wns_ns,wns_ns,whs_ns,fmax_mhz,dsp,status" > "${RESULTS}"
+fi
+
+# Value of key=<value> in fmax.txt
+field() { sed -n "s/.*\b$1=\([^ ]*\).*/\1/p" "${rpt_dir}/fmax.txt"; }
+
+FAILED=0
+for clk in ${CLKS}; do
+    for stages in ${MUL_STAGES_LIST}; do
+        cfg="clk${clk}_mul${stages}"
+        build_root="${PROJECT_ROOT}/build/fmax/${cfg}"
+        rpt_dir="${build_root}/rpt"
+        xpr="${build_root}/genesys2_synth-vivado/komandara_core_k10_0.1.0.xpr"
+        echo "=== ${cfg}: implementing (log: ${build_root}/build.log) ==="
+
+        rm -rf "${build_root}"
+        mkdir -p "${build_root}"
+        if ! (cd "${PROJECT_ROOT}" && \
+              fusesoc --cores-root=. run --target=genesys2_synth --build \
+                  --build-root="${build_root}" \
+                  komandara:core:k10 \
+                  --BOOT_ADDR="${BOOT_ADDR}" \
+                  --MEM_INIT="${MEM_INIT}" \
+                  --TRACE_BUF="${TRACE_BUF}" \
+                  --MUL_STAGES="${stages}" \
+                  --CLK_FREQ_MHZ="${clk}") \
+              > "${build_root}/build.log" 2>&1 || \
+           ! vivado -mode batch -nojournal -log "${build_root}/signoff.log" \
+                  -source "${SCRIPT_DIR}/vivado_signoff_reports.tcl" \
+                  -tclargs "${xpr}" "${rpt_dir}" > /dev/null 2>&1 || \
+           [[ ! -f "${rpt_dir}/fmax.txt" ]]; then
+            echo "${COMMIT},${DIRTY},${DATE},${clk},${stages},,,,,,FAILED" >> "${RESULTS}"
+            echo "  FAILED ${cfg}  (see ${build_root}/build.log, signoff.log)"
+            FAILED=1
+            continue
+        fi
+
+        wns="$(field wns_ns)"
+        whs="$(field whs_ns)"
+        status=MET
+        if awk -v w="${wns}" -v h="${whs}" 'BEGIN { exit !(w < 0 || h < 0) }'; then
+            status=VIOLATED
+        fi
+        echo "${COMMIT},${DIRTY},${DATE},${clk},${stages},$(field core_wns_ns),${wns},${whs},$(field fmax_mhz),$(field dsp),${status}" >> "${RESULTS}"
+        printf "  %-8s %-12s core WNS %8s ns  Fmax %8s MHz  %s DSP48E1\n" \
+            "${status}" "${cfg}" "$(field core_wns_ns)" "$(field fmax_mhz)" "$(field dsp)"
+    done
+done
+
+echo ""
+echo "=== Results for ${COMMIT}$([[ ${DIRTY} -eq 1 ]] && echo " (dirty)") appended to ${RESULTS} ==="
+exit ${FAILED}
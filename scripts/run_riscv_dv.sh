@@ -13,16 +13,24 @@
 # Runs the complete verification pipeline:
 #
 #   1. Generate random test program with RISC-DV (or use a manual test ELF)
-#   2. Compile assembly → ELF → hex
-#   3. Run Spike ISS with --log-commits → convert to CSV
-#   4. Build & run K10 Verilator simulation → CSV
-#   5. Compare K10 trace CSV vs Spike trace CSV
+#      and compile it to an ELF
+#   2. Run Spike ISS with --log-commits → convert to CSV
+#   3. Run K10 Verilator simulation on the same ELF (--elf) → CSV
+#   4. Compare K10 trace CSV vs Spike trace CSV
+#
+# The Verilator model is built once per RTL content (scripts/k10_sim_build.sh)
+# and every test ELF is loaded into it at run time with --elf.  With
+# --jobs N, --all and --iterations N run up to N tests / seeds at a time,
+# each going through steps 1-4 in its own output directory.
 #
 # Usage:
 #   ./scripts/run_riscv_dv.sh                                  # default: k10_arithmetic_basic_test
 #   ./scripts/run_riscv_dv.sh --test k10_arithmetic_basic_test
 #   ./scripts/run_riscv_dv.sh --asm sw/k10/test/smoke_test.S   # hand-written test
 #   ./scripts/run_riscv_dv.sh --manuel-test smoke_test         # manual test via CMake
+#   ./scripts/run_riscv_dv.sh --all --jobs 8                   # whole testlist, 8 at a time
+#   ./scripts/run_riscv_dv.sh --iterations 32 --jobs 8         # 32 seeds of one test
+#   ./scripts/run_riscv_dv.sh --seed 7 --coverage              # + <output>/coverage.dat
 #
 # Prerequisites:
 #   source scripts/env.sh
@@ -55,6 +63,8 @@ MANUAL_C_TEST=0
 # Special modes
 RUN_ALL=0
 RUN_APP=0
+JOBS=1
+COVERAGE=0
 
 # BRAM config
 BOOT_ADDR=2147483648  # 0x80000000
@@ -63,7 +73,7 @@ BOOT_ADDR=2147483648  # 0x80000000
 # Parse arguments
 # ---------------------------------------------------------------------------
 usage() {
-    echo "Usage: $0 [--test <name>] [--asm <file.S>] [--manuel-test <name>] [--all] [--app] [--iterations <N>] [--seed <N>] [--output <dir>]"
+    echo "Usage: $0 [--test <name>] [--asm <file.S>] [--manuel-test <name>] [--all] [--app] [--iterations <N>] [--seed <N>] [--jobs <N>] [--output <dir>] [--coverage]"
     echo ""
     echo "  --test        RISC-DV test name (default: k10_arithmetic_basic_test)"
     echo "  --asm         Use a hand-written assembly file instead of RISC-DV"
@@ -71,9 +81,11 @@ usage() {
     echo "                (alias: --manual-test)"
     echo "  --all         Run all 13 RISC-DV tests sequentially"
     echo "  --app         Build and run the C test application (sw/k10/)"
-    echo "  --iterations  Number of test iterations (default: 1)"
+    echo "  --iterations  Number of seeds to run (default: 1); seed i uses <seed>+i"
     echo "  --seed        Random seed for test generation"
+    echo "  --jobs        Tests / seeds to run concurrently with --all or --iterations (default: 1)"
     echo "  --output      Output directory (default: build/riscv_dv)"
+    echo "  --coverage    Simulate on the sim_cov model and write <output>/coverage.dat"
     exit 1
 }
 
@@ -86,7 +98,9 @@ while [[ $# -gt 0 ]]; do
         --app)        RUN_APP=1;        shift ;;
         --iterations) ITERATIONS="$2";  shift 2 ;;
         --seed)       SEED="$2";        shift 2 ;;
+        --jobs)       JOBS="$2";        shift 2 ;;
         --output)     OUTPUT_DIR="$2";  shift 2 ;;
+        --coverage)   COVERAGE=1;       shift ;;
         -h|--help)    usage ;;
         *)            echo "Unknown option: $1"; usage ;;
     esac
@@ -96,6 +110,64 @@ if [[ "${OUTPUT_DIR}" != /* ]]; then
     OUTPUT_DIR="${PROJECT_ROOT}/${OUTPUT_DIR}"
 fi
 
+# Model for step 3, and the flags every --all / --iterations job inherits
+SIM_BUILD_ARGS=(--boot-addr "${BOOT_ADDR}")
+JOB_ARGS=()
+if [[ "${COVERAGE}" -eq 1 ]]; then
+    SIM_BUILD_ARGS+=(--target sim_cov)
+    JOB_ARGS+=(--coverage)
+fi
+
+# ---------------------------------------------------------------------------
+# Job pool for --all / --iterations: each job is a full invocation of this
+# script; its output goes to <log> and its exit status to <log>.status
+# ---------------------------------------------------------------------------
+POOL_NAMES=()
+POOL_LOGS=()
+PASS_COUNT=0
+FAIL_COUNT=0
+FAIL_TESTS=""
+
+pool_start() {
+    local name="$1" log="$2"
+    shift 2
+    while [[ "$(jobs -rp | wc -l)" -ge "${JOBS}" ]]; do
+        wait -n || true
+    done
+    mkdir -p "$(dirname "${log}")"
+    ( if "$@" > "${log}" 2>&1; then echo 0; else echo $?; fi > "${log}.status" ) &
+    POOL_NAMES+=("${name}")
+    POOL_LOGS+=("${log}")
+}
+
+pool_finish() {
+    wait
+    local i
+    for i in "${!POOL_NAMES[@]}"; do
+        if [[ "$(cat "${POOL_LOGS[$i]}.status" 2>/dev/null)" == "0" ]]; then
+            PASS_COUNT=$((PASS_COUNT + 1))
+            echo "  PASS ${POOL_NAMES[$i]}"
+        else
+            FAIL_COUNT=$((FAIL_COUNT + 1))
+            FAIL_TESTS="${FAIL_TESTS} ${POOL_NAMES[$i]}"
+            echo "  FAIL ${POOL_NAMES[$i]}  (${POOL_LOGS[$i]})"
+        fi
+    done
+}
+
+print_summary() {
+    echo ""
+    echo "====================================================="
+    echo "=== All Tests Complete ==="
+    echo "  PASSED: ${PASS_COUNT}"
+    echo "  FAILED: ${FAIL_COUNT}"
+    if [[ ${FAIL_COUNT} -gt 0 ]]; then
+        echo "  Failed tests:${FAIL_TESTS}"
+        exit 1
+    fi
+    exit 0
+}
+
 # ---------------------------------------------------------------------------
 # --app mode: Build & run C test suite, then exit
 # ---------------------------------------------------------------------------
@@ -110,27 +182,14 @@ if [[ "${RUN_APP}" -eq 1 ]]; then
     cmake --build "${APP_BUILD}" 2>&1
 
     APP_ELF="${APP_BUILD}/k10_c_selftest.elf"
-    APP_HEX="${OUTPUT_DIR}/k10_c_selftest.hex"
-    APP_BYTE_HEX="${OUTPUT_DIR}/k10_c_selftest_byte.hex"
     mkdir -p "${OUTPUT_DIR}"
 
-    echo "  Converting ELF → hex..."
-    riscv32-unknown-elf-objcopy --change-addresses=-0x80000000 -O verilog \
-        "${APP_ELF}" "${APP_BYTE_HEX}"
-    python3 "${PROJECT_ROOT}/scripts/verilog_byte2word.py" \
-        "${APP_BYTE_HEX}" "${APP_HEX}"
-
-    echo "  Building Verilator model..."
-    pushd "${PROJECT_ROOT}" > /dev/null
-    fusesoc --cores-root=. run --target=sim --build \
-        komandara:core:k10 \
-        --MEM_INIT="$(realpath "${APP_HEX}")" \
-        --BOOT_ADDR="${BOOT_ADDR}" 2>&1
-    popd > /dev/null
-
-    SIM_DIR="${PROJECT_ROOT}/build/komandara_core_k10_0.1.0/sim-verilator"
+    echo "  Building Verilator model (cached)..."
+    SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" --boot-addr "${BOOT_ADDR}")"
+
     echo "  Running simulation..."
-    timeout 60 "${SIM_DIR}/Vk10_tb" --trace +finish_on_ecall=0 2>&1 || true
+    timeout 60 "${SIM_EXE}" --trace +finish_on_ecall=0 \
+        --elf "$(realpath "${APP_ELF}")" 2>&1 || true
 
     if [[ -f "k10_sim.fst" ]]; then
         cp k10_sim.fst "${OUTPUT_DIR}/k10_sim.fst"
@@ -153,16 +212,24 @@ if [[ "${RUN_ALL}" -eq 1 ]]; then
     TESTLIST="${PROJECT_ROOT}/rtl/k10/tb/testlist.yaml"
     ALL_TESTS=$(grep '^- test:' "${TESTLIST}" | awk '{print $3}')
 
-    PASS_COUNT=0
-    FAIL_COUNT=0
-    FAIL_TESTS=""
+    if [[ "${JOBS}" -gt 1 ]]; then
+        # Build the shared model up front so the jobs start simulating at once
+        "${SCRIPT_DIR}/k10_sim_build.sh" "${SIM_BUILD_ARGS[@]}" > /dev/null
+        echo "Running $(echo ${ALL_TESTS} | wc -w) tests, ${JOBS} at a time..."
+        for t in ${ALL_TESTS}; do
+            pool_start "${t}" "${OUTPUT_DIR}/${t}/run.log" \
+                "$0" --test "${t}" --output "${OUTPUT_DIR}/${t}" "${JOB_ARGS[@]}"
+        done
+        pool_finish
+        print_summary
+    fi
 
     for t in ${ALL_TESTS}; do
         echo ""
         echo "====================================================="
         echo "Running: ${t}"
         echo "====================================================="
-        if "$0" --test "${t}" --output "${OUTPUT_DIR}/${t}"; then
+        if "$0" --test "${t}" --output "${OUTPUT_DIR}/${t}" "${JOB_ARGS[@]}"; then
             PASS_COUNT=$((PASS_COUNT + 1))
         else
             FAIL_COUNT=$((FAIL_COUNT + 1))
@@ -170,16 +237,23 @@ if [[ "${RUN_ALL}" -eq 1 ]]; then
         fi
     done
 
-    echo ""
-    echo "====================================================="
-    echo "=== All Tests Complete ==="
-    echo "  PASSED: ${PASS_COUNT}"
-    echo "  FAILED: ${FAIL_COUNT}"
-    if [[ ${FAIL_COUNT} -gt 0 ]]; then
-        echo "  Failed tests:${FAIL_TESTS}"
-        exit 1
-    fi
-    exit 0
+    print_summary
+fi
+
+# ---------------------------------------------------------------------------
+# --iterations N: one job per seed, each in <output>/seed_<seed>
+# ---------------------------------------------------------------------------
+if [[ "${ITERATIONS}" -gt 1 && -z "${ASM_FILE}" && -z "${MANUAL_TEST}" ]]; then
+    BASE_SEED="${SEED:-$(( (RANDOM << 15) | RANDOM ))}"
+    "${SCRIPT_DIR}/k10_sim_build.sh" "${SIM_BUILD_ARGS[@]}" > /dev/null
+    echo "Running ${ITERATIONS} seeds of ${TEST_NAME} from seed ${BASE_SEED}, ${JOBS} at a time..."
+    for i in $(seq 0 $((ITERATIONS - 1))); do
+        s=$((BASE_SEED + i))
+        pool_start "${TEST_NAME}_seed_${s}" "${OUTPUT_DIR}/seed_${s}/run.log" \
+            "$0" --test "${TEST_NAME}" --seed "${s}" --output "${OUTPUT_DIR}/seed_${s}" "${JOB_ARGS[@]}"
+    done
+    pool_finish
+    print_summary
 fi
 
 # ---------------------------------------------------------------------------
@@ -223,7 +297,7 @@ if [[ -n "${MANUAL_TEST}" ]]; then
     MANUAL_DIR="${PROJECT_ROOT}/sw/k10/test"
     MANUAL_BUILD="${MANUAL_DIR}/build"
 
-    echo "=== [1/5] Building manual tests with CMake ==="
+    echo "=== [1/4] Building manual tests with CMake ==="
     cmake -B "${MANUAL_BUILD}" -S "${MANUAL_DIR}" \
         -DCMAKE_TOOLCHAIN_FILE="${PROJECT_ROOT}/sw/k10/riscv32.cmake" \
         2>&1 | tee "${OUTPUT_DIR}/manual_cmake_configure.log"
@@ -248,7 +322,7 @@ elif [[ -n "${ASM_FILE}" ]]; then
     TEST_NAME="$(basename "${ASM_FILE}" .S)"
     ELF_FILE="${OUTPUT_DIR}/${TEST_NAME}.o"
 
-    echo "=== [1/5] Compiling assembly: ${ASM_FILE} ==="
+    echo "=== [1/4] Compiling assembly: ${ASM_FILE} ==="
     riscv32-unknown-elf-gcc \
         -static -mcmodel=medany \
         -fvisibility=hidden -nostdlib -nostartfiles \
@@ -258,7 +332,7 @@ elif [[ -n "${ASM_FILE}" ]]; then
         "${ASM_FILE}" -o "${ELF_FILE}"
 else
     # RISC-DV random generation mode
-    echo "=== [1/5] Generating test with RISC-DV: ${TEST_NAME} ==="
+    echo "=== [1/4] Generating test with RISC-DV: ${TEST_NAME} ==="
 
     SEED_OPT=""
     if [[ -n "${SEED}" ]]; then
@@ -269,7 +343,7 @@ else
         --custom_target "${PROJECT_ROOT}/rtl/k10/tb" \
         --test "${TEST_NAME}" \
         --steps gen,gcc_compile \
-        --iterations "${ITERATIONS}" \
+        --iterations 1 \
         --simulator pyflow \
         --isa "${ISA}" \
         --mabi "${ABI}" \
@@ -288,29 +362,10 @@ fi
 echo "  ELF: ${ELF_FILE}"
 
 # ---------------------------------------------------------------------------
-# Step 2: Create hex file for BRAM
+# Step 2: Run Spike simulation → CSV
 # ---------------------------------------------------------------------------
 echo ""
-echo "=== [2/5] Converting ELF → hex for Verilator ==="
-
-# objcopy produces byte-addressed verilog hex;
-# strip the 0x80000000 base and convert to 32-bit words for $readmemh
-BYTE_HEX="${OUTPUT_DIR}/${TEST_NAME}_byte.hex"
-WORD_HEX="${OUTPUT_DIR}/${TEST_NAME}.hex"
-
-riscv32-unknown-elf-objcopy --change-addresses=-0x80000000 -O verilog \
-    "${ELF_FILE}" "${BYTE_HEX}"
-
-python3 "${PROJECT_ROOT}/scripts/verilog_byte2word.py" \
-    "${BYTE_HEX}" "${WORD_HEX}"
-
-echo "  HEX: ${WORD_HEX}"
-
-# ---------------------------------------------------------------------------
-# Step 3: Run Spike simulation → CSV
-# ---------------------------------------------------------------------------
-echo ""
-echo "=== [3/5] Running Spike ISS simulation ==="
+echo "=== [2/4] Running Spike ISS simulation ==="
 SPIKE_LOG="${OUTPUT_DIR}/${TEST_NAME}_spike.log"
 SPIKE_CSV="${OUTPUT_DIR}/${TEST_NAME}_spike.csv"
 
@@ -329,43 +384,32 @@ else
 fi
 
 # ---------------------------------------------------------------------------
-# Step 4: Build & run K10 Verilator simulation → CSV
+# Step 3: Run K10 Verilator simulation → CSV
 # ---------------------------------------------------------------------------
 echo ""
-echo "=== [4/5] Building & running K10 Verilator simulation ==="
+echo "=== [3/4] Running K10 Verilator simulation ==="
 
-VERILATOR_BUILD="${OUTPUT_DIR}/verilator_build"
+SIM_RUN_DIR="${OUTPUT_DIR}/k10_run"
 K10_CSV="${OUTPUT_DIR}/${TEST_NAME}_k10.csv"
 
-HEX_ABS="$(realpath "${WORD_HEX}")"
+ELF_ABS="$(realpath "${ELF_FILE}")"
 
-# Build with FuseSoC
-pushd "${PROJECT_ROOT}" > /dev/null
+# One model for every test and seed; a no-op when the cache is warm
+SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" "${SIM_BUILD_ARGS[@]}")"
 
-rm -rf "${VERILATOR_BUILD}"
-fusesoc --cores-root=. run --target=sim --build \
-    --build-root="${VERILATOR_BUILD}" \
-    komandara:core:k10 \
-    --MEM_INIT="${HEX_ABS}" \
-    --BOOT_ADDR="${BOOT_ADDR}" \
-    2>&1 | tee "${OUTPUT_DIR}/verilator_build.log"
-
-popd > /dev/null
-
-# Run simulation
+# Run simulation in a per-test directory (the model writes into its cwd)
 echo "  Running simulation..."
-pushd "${VERILATOR_BUILD}/sim-verilator" > /dev/null
+rm -rf "${SIM_RUN_DIR}"
+mkdir -p "${SIM_RUN_DIR}"
+pushd "${SIM_RUN_DIR}" > /dev/null
 
-SIM_EXE="./Vk10_tb"
-if [[ ! -x "${SIM_EXE}" ]]; then
-    echo "ERROR: Verilator executable Vk10_tb not found"
-    exit 1
-fi
-
-SIM_ARGS=()
+SIM_ARGS=("+max_cycles=${MAX_CYCLES}" --elf "${ELF_ABS}")
 if [[ "${MANUAL_C_TEST}" -eq 1 ]]; then
     SIM_ARGS+=("+finish_on_ecall=0")
 fi
+if [[ "${COVERAGE}" -eq 1 ]]; then
+    SIM_ARGS+=(--coverage "${OUTPUT_DIR}/coverage.dat")
+fi
 timeout 60 "${SIM_EXE}" "${SIM_ARGS[@]}" 2>&1 | tee "${OUTPUT_DIR}/k10_sim.log"
 
 if [[ -f "k10_trace.csv" ]]; then
@@ -384,10 +428,10 @@ popd > /dev/null
 echo "  K10 CSV: ${K10_CSV} ($(wc -l < "${K10_CSV}") lines)"
 
 # ---------------------------------------------------------------------------
-# Step 5: Compare traces
+# Step 4: Compare traces
 # ---------------------------------------------------------------------------
 echo ""
-echo "=== [5/5] Comparing traces: Spike vs K10 ==="
+echo "=== [4/4] Comparing traces: Spike vs K10 ==="
 COMPARE_LOG="${OUTPUT_DIR}/${TEST_NAME}_compare.log"
 
 if [[ "${MANUAL_NO_SPIKE}" -eq 1 ]]; then
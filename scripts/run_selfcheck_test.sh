@@ -15,9 +15,16 @@
 #
 # No Spike comparison — the test is verified entirely within the K10 RTL.
 #
+# The Verilator model comes from the shared build cache
+# (scripts/k10_sim_build.sh) and each test ELF is loaded with --elf.
+# Several tests can be given; --jobs N runs up to N of them at a time, each
+# logging to build/selfcheck/<test>_run.log.
+#
 # Usage:
 #   ./scripts/run_selfcheck_test.sh sw/k10/test/unaligned_test.S
 #   ./scripts/run_selfcheck_test.sh sw/k10/test/smoke_test.S
+#   ./scripts/run_selfcheck_test.sh --jobs 4 sw/k10/test/*.S
+#   ./scripts/run_selfcheck_test.sh --icache true sw/k10/test/fence_i_test.S
 # ============================================================================
 
 set -euo pipefail
@@ -29,14 +36,25 @@ ISA="rv32imac_zicsr_zifencei"
 ABI="ilp32"
 BOOT_ADDR=2147483648  # 0x80000000
 
-if [[ $# -lt 1 ]]; then
-    echo "Usage: $0 <assembly_file.S>"
+JOBS=1
+BUILD_ARGS=()
+ASM_FILES=()
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --jobs) JOBS="$2"; shift 2 ;;
+        # Model configuration, passed through to k10_sim_build.sh
+        --branch-pred|--prefetch-depth|--icache|--store-buffer)
+                BUILD_ARGS+=("$1" "$2"); shift 2 ;;
+        *)      ASM_FILES+=("$1"); shift ;;
+    esac
+done
+
+if [[ ${#ASM_FILES[@]} -lt 1 ]]; then
+    echo "Usage: $0 [--jobs <N>] [--branch-pred|--prefetch-depth|--icache|--store-buffer <V>]"
+    echo "          <assembly_file.S> [<assembly_file.S> ...]"
     exit 1
 fi
 
-ASM_FILE="$1"
-TEST_NAME="$(basename "${ASM_FILE}" .S)"
-
 # Environment check
 for cmd in riscv32-unknown-elf-gcc verilator fusesoc; do
     if ! command -v "$cmd" &>/dev/null; then
@@ -48,86 +66,98 @@ done
 mkdir -p "${OUTPUT_DIR}"
 
 # ---------------------------------------------------------------------------
-# Step 1: Compile assembly → ELF → hex
-# ---------------------------------------------------------------------------
-echo "=== [1/3] Compiling: ${ASM_FILE} ==="
-RISCV_DV="${PROJECT_ROOT}/tools/riscv-dv"
-ELF_FILE="${OUTPUT_DIR}/${TEST_NAME}.o"
-
-riscv32-unknown-elf-gcc \
-    -static -mcmodel=medany \
-    -fvisibility=hidden -nostdlib -nostartfiles \
-    -march="${ISA}" -mabi="${ABI}" \
-    -I"${RISCV_DV}/user_extension" \
-    -T"${RISCV_DV}/scripts/link.ld" \
-    "${ASM_FILE}" -o "${ELF_FILE}"
-
-echo "  ELF: ${ELF_FILE}"
-
-# Convert to hex
-BYTE_HEX="${OUTPUT_DIR}/${TEST_NAME}_byte.hex"
-WORD_HEX="${OUTPUT_DIR}/${TEST_NAME}.hex"
-
-riscv32-unknown-elf-objcopy --change-addresses=-0x80000000 -O verilog \
-    "${ELF_FILE}" "${BYTE_HEX}"
-
-python3 "${PROJECT_ROOT}/scripts/verilog_byte2word.py" \
-    "${BYTE_HEX}" "${WORD_HEX}"
-
-echo "  HEX: ${WORD_HEX}"
-
-# ---------------------------------------------------------------------------
-# Step 2: Build Verilator model
+# Build (or reuse) the Verilator model once for all tests
 # ---------------------------------------------------------------------------
-echo ""
-echo "=== [2/3] Building Verilator simulation ==="
-VERILATOR_BUILD="${OUTPUT_DIR}/verilator_build"
-HEX_ABS="$(realpath "${WORD_HEX}")"
-
-pushd "${PROJECT_ROOT}" > /dev/null
-rm -rf "${VERILATOR_BUILD}"
-fusesoc --cores-root=. run --target=sim --build \
-    --build-root="${VERILATOR_BUILD}" \
-    komandara:core:k10 \
-    --MEM_INIT="${HEX_ABS}" \
-    --BOOT_ADDR="${BOOT_ADDR}" \
-    2>&1 | tee "${OUTPUT_DIR}/verilator_build.log"
-popd > /dev/null
+echo "=== Building Verilator simulation (cached) ==="
+SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" --boot-addr "${BOOT_ADDR}" "${BUILD_ARGS[@]}")"
+
+run_test() {
+    local ASM_FILE="$1"
+    local TEST_NAME
+    TEST_NAME="$(basename "${ASM_FILE}" .S)"
+
+    # -----------------------------------------------------------------------
+    # Step 1: Compile assembly → ELF
+    # -----------------------------------------------------------------------
+    echo "=== [1/2] Compiling: ${ASM_FILE} ==="
+    RISCV_DV="${PROJECT_ROOT}/tools/riscv-dv"
+    ELF_FILE="${OUTPUT_DIR}/${TEST_NAME}.o"
+
+    riscv32-unknown-elf-gcc \
+        -static -mcmodel=medany \
+        -fvisibility=hidden -nostdlib -nostartfiles \
+        -march="${ISA}" -mabi="${ABI}" \
+        -I"${RISCV_DV}/user_extension" \
+        -T"${RISCV_DV}/scripts/link.ld" \
+        "${ASM_FILE}" -o "${ELF_FILE}"
+
+    echo "  ELF: ${ELF_FILE}"
+
+    # -----------------------------------------------------------------------
+    # Step 2: Run simulation
+    # -----------------------------------------------------------------------
+    echo ""
+    echo "=== [2/2] Running K10 simulation: ${TEST_NAME} ==="
+    ELF_ABS="$(realpath "${ELF_FILE}")"
+    SIM_RUN_DIR="${OUTPUT_DIR}/${TEST_NAME}_run"
+    mkdir -p "${SIM_RUN_DIR}"
+    pushd "${SIM_RUN_DIR}" > /dev/null
+
+    SIM_LOG="${OUTPUT_DIR}/${TEST_NAME}_sim.log"
+    # Self-checking: nobody reads the instruction trace, so skip it
+    timeout 60 "${SIM_EXE}" +trace_format=none --elf "${ELF_ABS}" 2>&1 | tee "${SIM_LOG}"
+
+    popd > /dev/null
+
+    # -----------------------------------------------------------------------
+    # Check result
+    # -----------------------------------------------------------------------
+    echo ""
+    if grep -q "simulation PASSED" "${SIM_LOG}"; then
+        echo "=== ✅ ${TEST_NAME}: ALL TESTS PASSED ==="
+        return 0
+    elif grep -q "ECALL detected" "${SIM_LOG}" && ! grep -q "ERROR: Timeout" "${SIM_LOG}"; then
+        echo "=== ✅ ${TEST_NAME}: ALL TESTS PASSED ==="
+        return 0
+    elif grep -q "TEST FAILED" "${SIM_LOG}"; then
+        echo "=== ❌ ${TEST_NAME}: TEST FAILED ==="
+        grep "TEST FAILED" "${SIM_LOG}"
+        return 1
+    else
+        echo "=== ❌ ${TEST_NAME}: TIMEOUT or UNKNOWN RESULT ==="
+        return 1
+    fi
+}
 
 # ---------------------------------------------------------------------------
-# Step 3: Run simulation
+# One test: stream to the terminal.  Several: run them through a job pool.
 # ---------------------------------------------------------------------------
-echo ""
-echo "=== [3/3] Running K10 simulation: ${TEST_NAME} ==="
-pushd "${VERILATOR_BUILD}/sim-verilator" > /dev/null
-
-SIM_EXE="./Vk10_tb"
-if [[ ! -x "${SIM_EXE}" ]]; then
-    echo "ERROR: Verilator executable not found"
-    exit 1
+if [[ ${#ASM_FILES[@]} -eq 1 ]]; then
+    run_test "${ASM_FILES[0]}"
+    exit $?
 fi
 
-SIM_LOG="${OUTPUT_DIR}/${TEST_NAME}_sim.log"
-timeout 60 "${SIM_EXE}" 2>&1 | tee "${SIM_LOG}"
-SIM_EXIT=${PIPESTATUS[0]}
-
-popd > /dev/null
-
-# ---------------------------------------------------------------------------
-# Check result
-# ---------------------------------------------------------------------------
-echo ""
-if grep -q "simulation PASSED" "${SIM_LOG}"; then
-    echo "=== ✅ ${TEST_NAME}: ALL TESTS PASSED ==="
-    exit 0
-elif grep -q "ECALL detected" "${SIM_LOG}" && ! grep -q "ERROR: Timeout" "${SIM_LOG}"; then
-    echo "=== ✅ ${TEST_NAME}: ALL TESTS PASSED ==="
-    exit 0
-elif grep -q "TEST FAILED" "${SIM_LOG}"; then
-    echo "=== ❌ ${TEST_NAME}: TEST FAILED ==="
-    grep "TEST FAILED" "${SIM_LOG}"
-    exit 1
-else
-    echo "=== ❌ ${TEST_NAME}: TIMEOUT or UNKNOWN RESULT ==="
-    exit 1
-fi
+for asm in "${ASM_FILES[@]}"; do
+    while [[ "$(jobs -rp | wc -l)" -ge "${JOBS}" ]]; do
+        wait -n || true
+    done
+    name="$(basename "${asm}" .S)"
+    # No "if" around run_test: errexit must stay active inside the job, and
+    # a job that dies early simply leaves no status file (= FAIL).
+    rm -f "${OUTPUT_DIR}/${name}_run.status"
+    ( run_test "${asm}" > "${OUTPUT_DIR}/${name}_run.log" 2>&1
+      echo $? > "${OUTPUT_DIR}/${name}_run.status" ) &
+done
+wait
+
+FAILED=0
+for asm in "${ASM_FILES[@]}"; do
+    name="$(basename "${asm}" .S)"
+    if [[ "$(cat "${OUTPUT_DIR}/${name}_run.status" 2>/dev/null)" == "0" ]]; then
+        echo "  PASS ${name}"
+    else
+        echo "  FAIL ${name}  (${OUTPUT_DIR}/${name}_run.log)"
+        FAILED=1
+    fi
+done
+exit ${FAILED}
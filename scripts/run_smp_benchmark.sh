@@ -0,0 +1,149 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — Multi-Hart (N_HARTS) Speedup and Contention Benchmark
+# ============================================================================
+# Builds sw/k10/test/k10_smp_benchmark.c and runs it on one Verilator model
+# per hart count (scripts/k10_sim_build.sh --harts N).  For each kernel the
+# program times hart 0 alone and then every hart on its slice of the same
+# work, and prints the I-fetch / LSU wait cycles of each hart's slice.  One
+# CSV row per (kernel, harts) is appended to the results file, keyed by the
+# current commit:
+#
+#   commit,dirty,date,kernel,harts,ref_cycles,par_cycles,speedup,if_wait,lsu_wait,status
+#
+# if_wait / lsu_wait are summed over the harts of the parallel run; their
+# growth over the 1-hart row is the cost of sharing the instruction and
+# data buses.  status is PASS, FAIL (checksum mismatch, no [PASS]) or NORESULT
+# (no "SMP" line: hang, timeout).  Logs are kept under build/smp/<commit>/.
+#
+# Usage:
+#   ./scripts/run_smp_benchmark.sh
+#   ./scripts/run_smp_benchmark.sh --harts "1 2 4 8" --icache true
+#   ./scripts/run_smp_benchmark.sh --results build/smp/nightly.csv
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+BOOT_ADDR=2147483648  # 0x80000000
+
+HARTS_LIST="1 2 4"
+TIMEOUT=600
+RESULTS="${PROJECT_ROOT}/build/smp/results.csv"
+BUILD_ARGS=()
+
+usage() {
+    echo "Usage: $0 [--harts \"<N> ...\"] [--results <csv>] [--timeout <s>]" >&2
+    echo "          [--branch-pred|--prefetch-depth|--icache|--store-buffer|--mul-stages|--fast-div <V>]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --harts)    HARTS_LIST="$2"; shift 2 ;;
+        --results)  RESULTS="$2";    shift 2 ;;
+        --timeout)  TIMEOUT="$2";    shift 2 ;;
+        # Model configuration, passed through to k10_sim_build.sh
+        --branch-pred|--prefetch-depth|--icache|--store-buffer|--mul-stages|--fast-div)
+                    BUILD_ARGS+=("$1" "$2"); shift 2 ;;
+        -h|--help)  usage ;;
+        *)          echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+for n in ${HARTS_LIST}; do
+    if ! [[ "${n}" =~ ^[1-8]$ ]]; then
+        echo "ERROR: --harts values must be 1..8" >&2
+        exit 1
+    fi
+done
+
+for cmd in riscv32-unknown-elf-gcc cmake verilator fusesoc; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh" >&2
+        exit 1
+    fi
+done
+
+COMMIT="$(git -C "${PROJECT_ROOT}" rev-parse --short=12 HEAD)"
+DIRTY=0
+if ! git -C "${PROJECT_ROOT}" diff --quiet HEAD -- rtl sw 2>/dev/null; then
+    DIRTY=1
+fi
+DATE="$(date -u +%Y-%m-%dT%H:%M:%SZ)"
+LOG_DIR="${PROJECT_ROOT}/build/smp/${COMMIT}"
+mkdir -p "${LOG_DIR}" "$(dirname "${RESULTS}")"
+
+# ---------------------------------------------------------------------------
+# Step 1: Build the benchmark
+# ---------------------------------------------------------------------------
+echo "=== [1/3] Building k10_smp_benchmark ==="
+SW_BUILD="${PROJECT_ROOT}/build/smp/sw"
+cmake -S "${PROJECT_ROOT}/sw/k10" -B "${SW_BUILD}" \
+    -DCMAKE_TOOLCHAIN_FILE="${PROJECT_ROOT}/sw/k10/riscv32.cmake" \
+    -DK10_REAL_HW_LOGS=OFF > "${LOG_DIR}/cmake.log"
+cmake --build "${SW_BUILD}" --target manual_k10_smp_benchmark -j"$(nproc)" >> "${LOG_DIR}/cmake.log"
+ELF="${SW_BUILD}/k10_smp_benchmark.elf"
+
+# ---------------------------------------------------------------------------
+# Step 2: One model and one run per hart count
+# ---------------------------------------------------------------------------
+echo "=== [2/3] Running on 1..N-hart models (Verilator, cached) ==="
+if [[ ! -f "${RESULTS}" ]]; then
+    echo "commit,dirty,date,kernel,harts,ref_cycles,par_cycles,speedup,if_wait,lsu_wait,status" > "${RESULTS}"
+fi
+
+# Value of key=<value> in ${line}
+field() { sed -n "s/.* $1=\([^ ]*\).*/\1/p" <<< "${line}"; }
+
+FAILED=0
+printf "  %-8s %-6s %12s %12s %8s %12s %12s  %s\n" \
+    "kernel" "harts" "1-hart cyc" "N-hart cyc" "speedup" "if_wait" "lsu_wait" "status"
+for n in ${HARTS_LIST}; do
+    SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" --boot-addr "${BOOT_ADDR}" --harts "${n}" "${BUILD_ARGS[@]}")"
+    log="${LOG_DIR}/harts${n}.log"
+    # +finish_on_ecall=0: main() ends the run through SIM_CTRL
+    { timeout "${TIMEOUT}" "${SIM_EXE}" +trace_format=none +finish_on_ecall=0 \
+        +max_cycles=0 --elf "${ELF}" 2>&1 || true; } | tr -d '\r' > "${log}"
+
+    status=FAIL
+    if grep -q "\[PASS\]" "${log}"; then
+        status=PASS
+    fi
+    for kernel in compute stream; do
+        line="$(grep -m1 "^SMP ${kernel} harts=" "${log}" || true)"
+        if [[ -z "${line}" ]]; then
+            echo "${COMMIT},${DIRTY},${DATE},${kernel},${n},,,,,,NORESULT" >> "${RESULTS}"
+            echo "  NORESULT ${kernel} on ${n} harts (see ${log})"
+            FAILED=1
+            continue
+        fi
+        ref="$(field ref_cycles)"
+        par="$(field par_cycles)"
+        read -r if_wait lsu_wait < <(grep "^SMP ${kernel} hart=" "${log}" |
+            awk '{ for (i = 1; i <= NF; i++) { split($i, kv, "=");
+                     if (kv[1] == "if_wait") f += kv[2]; if (kv[1] == "lsu_wait") l += kv[2] } }
+                 END { print f + 0, l + 0 }')
+        speedup="$(awk -v r="${ref}" -v p="${par}" 'BEGIN { printf "%.2f", p ? r / p : 0 }')"
+        echo "${COMMIT},${DIRTY},${DATE},${kernel},${n},${ref},${par},${speedup},${if_wait},${lsu_wait},${status}" >> "${RESULTS}"
+        printf "  %-8s %-6s %12s %12s %7sx %12s %12s  %s\n" \
+            "${kernel}" "${n}" "${ref}" "${par}" "${speedup}" "${if_wait}" "${lsu_wait}" "${status}"
+    done
+    [[ "${status}" == "PASS" ]] || FAILED=1
+done
+
+# ---------------------------------------------------------------------------
+# Step 3: Summary
+# ---------------------------------------------------------------------------
+echo ""
+echo "=== [3/3] Results for ${COMMIT}$([[ ${DIRTY} -eq 1 ]] && echo " (dirty)") appended to ${RESULTS} ==="
+exit ${FAILED}
@@ -0,0 +1,117 @@
+#!/usr/bin/env bash
+# Copyright 2026 The Komandara Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+
+# ============================================================================
+# K10 — WFI Fast-Forward Equivalence Check
+# ============================================================================
+# Builds sw/k10/test/k10_wfi_ff_test.c and runs it twice on the same
+# Verilator model: stepped, and with k10_tb --fast-forward.  The program
+# sleeps in WFI until a timer compare several times and prints SIM_STATUS,
+# mcycle and mtime after every wake-up.  Both runs must pass, the
+# fast-forward run must actually skip cycles, and the "WFI_FF" lines and
+# the final cycle count of the two runs must be identical.  Logs are kept
+# under build/wfi_ff/.
+#
+# Usage:
+#   ./scripts/run_wfi_ff_check.sh
+#   ./scripts/run_wfi_ff_check.sh --store-buffer 0 --icache true
+# ============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+OUTPUT_DIR="${PROJECT_ROOT}/build/wfi_ff"
+BOOT_ADDR=2147483648  # 0x80000000
+TIMEOUT=600
+
+BUILD_ARGS=()
+
+usage() {
+    echo "Usage: $0 [--timeout <s>]" >&2
+    echo "          [--branch-pred|--prefetch-depth|--icache|--store-buffer|--mul-stages|--fast-div <V>]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --timeout)  TIMEOUT="$2"; shift 2 ;;
+        # Model configuration, passed through to k10_sim_build.sh
+        --branch-pred|--prefetch-depth|--icache|--store-buffer|--mul-stages|--fast-div)
+                    BUILD_ARGS+=("$1" "$2"); shift 2 ;;
+        -h|--help)  usage ;;
+        *)          echo "ERROR: unknown option $1" >&2; usage ;;
+    esac
+done
+
+for cmd in riscv32-unknown-elf-gcc cmake verilator fusesoc; do
+    if ! command -v "$cmd" &>/dev/null; then
+        echo "ERROR: $cmd not found. Run: source scripts/env.sh" >&2
+        exit 1
+    fi
+done
+
+mkdir -p "${OUTPUT_DIR}"
+
+# ---------------------------------------------------------------------------
+# Step 1: Build the test program and the model
+# ---------------------------------------------------------------------------
+echo "=== [1/3] Building k10_wfi_ff_test and the Verilator model (cached) ==="
+SW_BUILD="${OUTPUT_DIR}/sw"
+cmake -S "${PROJECT_ROOT}/sw/k10" -B "${SW_BUILD}" \
+    -DCMAKE_TOOLCHAIN_FILE="${PROJECT_ROOT}/sw/k10/riscv32.cmake" \
+    -DK10_REAL_HW_LOGS=OFF > "${OUTPUT_DIR}/cmake.log"
+cmake --build "${SW_BUILD}" --target manual_k10_wfi_ff_test -j"$(nproc)" >> "${OUTPUT_DIR}/cmake.log"
+ELF="${SW_BUILD}/k10_wfi_ff_test.elf"
+SIM_EXE="$("${SCRIPT_DIR}/k10_sim_build.sh" --boot-addr "${BOOT_ADDR}" "${BUILD_ARGS[@]}")"
+
+# ---------------------------------------------------------------------------
+# Step 2: Stepped and fast-forwarded runs
+# ---------------------------------------------------------------------------
+echo "=== [2/3] Running stepped and with --fast-forward ==="
+run() {
+    local name="$1"; shift
+    local log="${OUTPUT_DIR}/${name}.log"
+    local rc=0
+    timeout "${TIMEOUT}" "${SIM_EXE}" +trace_format=none +max_cycles=0 \
+        --elf "${ELF}" "$@" > "${log}.raw" 2>&1 || rc=$?
+    tr -d '\r' < "${log}.raw" > "${log}"
+    rm -f "${log}.raw"
+    if [[ ${rc} -ne 0 ]] || ! grep -q "\[PASS\]" "${log}"; then
+        echo "ERROR: ${name} run failed (exit ${rc}), see ${log}" >&2
+        exit 1
+    fi
+}
+run stepped
+run fast_forward --fast-forward
+
+skipped="$(sed -n 's/.*Fast-forward: \([0-9]*\) cycles skipped.*/\1/p' "${OUTPUT_DIR}/fast_forward.log")"
+if [[ -z "${skipped}" || "${skipped}" -eq 0 ]]; then
+    echo "ERROR: --fast-forward skipped no cycles, see ${OUTPUT_DIR}/fast_forward.log" >&2
+    exit 1
+fi
+
+# ---------------------------------------------------------------------------
+# Step 3: Compare
+# ---------------------------------------------------------------------------
+echo "=== [3/3] Comparing (${skipped} cycles skipped) ==="
+for name in stepped fast_forward; do
+    grep -e "^WFI_FF " -e "Simulation finished after" "${OUTPUT_DIR}/${name}.log" \
+        > "${OUTPUT_DIR}/${name}.cmp" || true
+done
+if [[ "$(grep -c "^WFI_FF " "${OUTPUT_DIR}/stepped.cmp")" -eq 0 ]]; then
+    echo "ERROR: no WFI_FF lines in ${OUTPUT_DIR}/stepped.log" >&2
+    exit 1
+fi
+if ! diff -u "${OUTPUT_DIR}/stepped.cmp" "${OUTPUT_DIR}/fast_forward.cmp"; then
+    echo "ERROR: --fast-forward changes what firmware reads (see diff above)" >&2
+    exit 1
+fi
+cat "${OUTPUT_DIR}/stepped.cmp"
+echo "=== PASS: fast-forwarded run matches the stepped run ==="
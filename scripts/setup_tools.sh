@@ -134,7 +134,7 @@ ok "tools/ directory ready"
 # ---------------------------------------------------------------------------
 # 1. Python Packages
 # ---------------------------------------------------------------------------
-step "1/5 — Installing Python Packages"
+step "1/6 — Installing Python Packages"
 
 pip install --upgrade pip setuptools wheel 2>&1 | tail -1
 pip install -r "${PROJECT_ROOT}/python-requirements.txt" 2>&1 | tail -3
@@ -145,7 +145,7 @@ ok "Python packages installed"
 # ---------------------------------------------------------------------------
 VERILATOR_PREFIX="${TOOLS_DIR}/verilator"
 
-step "2/5 — Verilator (${VERILATOR_VERSION})"
+step "2/6 — Verilator (${VERILATOR_VERSION})"
 
 if [[ -x "${VERILATOR_PREFIX}/bin/verilator" ]]; then
     ok "Verilator already installed — skipping"
@@ -190,7 +190,7 @@ ok "Verilator verification passed"
 # ---------------------------------------------------------------------------
 SPIKE_PREFIX="${TOOLS_DIR}/spike"
 
-step "3/5 — Spike (riscv-isa-sim)"
+step "3/6 — Spike (riscv-isa-sim)"
 
 if [[ -x "${SPIKE_PREFIX}/bin/spike" ]]; then
     ok "Spike already installed — skipping"
@@ -224,7 +224,7 @@ ok "Spike verification passed"
 # ---------------------------------------------------------------------------
 RISCV_TC_PREFIX="${TOOLS_DIR}/riscv-toolchain"
 
-step "4/5 — RISC-V GNU Toolchain (riscv32-unknown-elf)"
+step "4/6 — RISC-V GNU Toolchain (riscv32-unknown-elf)"
 
 if [[ -x "${RISCV_TC_PREFIX}/bin/riscv32-unknown-elf-gcc" ]]; then
     ok "RISC-V toolchain already installed — skipping"
@@ -261,7 +261,7 @@ ok "RISC-V toolchain verification passed"
 # ---------------------------------------------------------------------------
 RISCV_DV_DIR="${TOOLS_DIR}/riscv-dv"
 
-step "5/5 — RISC-V DV"
+step "5/6 — RISC-V DV"
 
 if [[ -d "${RISCV_DV_DIR}" ]]; then
     ok "riscv-dv already cloned — skipping"
@@ -280,6 +280,40 @@ fi
 
 ok "riscv-dv ready"
 
+# ---------------------------------------------------------------------------
+# 6. Benchmark sources (sw/k10/test/bench, scripts/run_benchmarks.sh)
+# ---------------------------------------------------------------------------
+COREMARK_DIR="${TOOLS_DIR}/coremark"
+EMBENCH_DIR="${TOOLS_DIR}/embench-iot"
+DHRYSTONE_DIR="${TOOLS_DIR}/dhrystone"
+
+step "6/6 — Benchmark Sources (CoreMark, Embench)"
+
+if [[ -d "${COREMARK_DIR}" ]]; then
+    ok "coremark already cloned — skipping"
+else
+    info "Cloning coremark..."
+    git clone --depth 1 \
+        https://github.com/eembc/coremark.git "${COREMARK_DIR}"
+    ok "coremark cloned to ${COREMARK_DIR}"
+fi
+
+if [[ -d "${EMBENCH_DIR}" ]]; then
+    ok "embench-iot already cloned — skipping"
+else
+    info "Cloning embench-iot..."
+    git clone --depth 1 \
+        https://github.com/embench/embench-iot.git "${EMBENCH_DIR}"
+    ok "embench-iot cloned to ${EMBENCH_DIR}"
+fi
+
+# Dhrystone 2.1 has no canonical repository to clone from.
+if [[ -f "${DHRYSTONE_DIR}/dhry_1.c" ]]; then
+    ok "Dhrystone sources found in ${DHRYSTONE_DIR}"
+else
+    info "Dhrystone: place dhry.h, dhry_1.c, dhry_2.c (C, version 2.1) in ${DHRYSTONE_DIR}"
+fi
+
 # ---------------------------------------------------------------------------
 # Verify env.sh exists
 # ---------------------------------------------------------------------------
@@ -306,6 +340,7 @@ printf "  %-25s %s\n" "Verilator:" "$("${VERILATOR_PREFIX}/bin/verilator" --vers
 printf "  %-25s %s\n" "Spike:" "$("${SPIKE_PREFIX}/bin/spike" --help 2>&1 | head -1 || true)"
 printf "  %-25s %s\n" "RISC-V GCC:" "$("${RISCV_TC_PREFIX}/bin/riscv32-unknown-elf-gcc" --version | head -1 || true)"
 printf "  %-25s %s\n" "riscv-dv:" "${RISCV_DV_DIR}"
+printf "  %-25s %s\n" "Benchmarks:" "${COREMARK_DIR}, ${EMBENCH_DIR}"
 printf "  %-25s %s\n" "Python venv:" "${VIRTUAL_ENV}"
 printf "  %-25s %s\n" "FuseSoC:" "$(fusesoc --version 2>/dev/null || echo 'not found')"
 echo ""
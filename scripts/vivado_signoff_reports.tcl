@@ -11,5 +11,34 @@ report_clock_interaction -file "$rpt_dir/clock_interaction.rpt"
 report_cdc -details -file "$rpt_dir/cdc.rpt"
 report_drc -file "$rpt_dir/drc.rpt"
 report_methodology -file "$rpt_dir/methodology.rpt"
+report_utilization -file "$rpt_dir/utilization.rpt"
+
+# One-line summary for scripts/run_fmax_sweep.sh: worst setup / hold slack
+# over the design, and setup slack, period and the Fmax it implies
+# (1000 / (period - WNS)) for the core clock (PLL CLKOUT0).
+proc worst_slack {args} {
+    set path [lindex [get_timing_paths {*}$args -max_paths 1 -nworst 1] 0]
+    if {$path eq ""} {
+        return "NA"
+    }
+    return [get_property SLACK $path]
+}
+
+set core_clk [get_clocks -of_objects [get_pins -hier -filter {NAME =~ *u_sys_pll/CLKOUT0}]]
+set period   [get_property PERIOD $core_clk]
+set core_wns [worst_slack -delay_type max -group $core_clk]
+set fmax     "NA"
+if {$core_wns ne "NA"} {
+    set fmax [format "%.2f" [expr {1000.0 / ($period - $core_wns)}]]
+}
+set dsps [llength [get_cells -hier -filter {PRIMITIVE_TYPE =~ ARITHMETIC.DSP.*}]]
+
+set summary [format "clock=%s period_ns=%.3f core_wns_ns=%s wns_ns=%s whs_ns=%s fmax_mhz=%s dsp=%d" \
+    [get_property NAME $core_clk] $period $core_wns \
+    [worst_slack -delay_type max] [worst_slack -delay_type min] $fmax $dsps]
+set fh [open "$rpt_dir/fmax.txt" w]
+puts $fh $summary
+close $fh
+puts "K10_FMAX $summary"
 
 exit
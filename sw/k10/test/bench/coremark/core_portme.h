@@ -0,0 +1,86 @@
+/* ============================================================================
+ * K10 CoreMark Port — configuration
+ * ============================================================================
+ * The CoreMark sources themselves are not in this tree; core_*.c and
+ * coremark.h are compiled from K10_COREMARK_DIR (tools/coremark, cloned by
+ * scripts/setup_tools.sh).  Timing uses mcycle, so one tick is one cycle
+ * and CoreMark/MHz is iterations * 10^6 / ticks.
+ *
+ * Build-time knobs (sw/k10/test/CMakeLists.txt):
+ *   ITERATIONS  fixed iteration count (K10_COREMARK_ITERATIONS); CoreMark
+ *               asks for a 10 s run for a publishable score, which a
+ *               Verilator run does not reach: sim results are for tracking
+ *               the core from commit to commit only.
+ *   FLAGS_STR   compiler flags echoed in the report
+ * ============================================================================ */
+
+#ifndef CORE_PORTME_H
+#define CORE_PORTME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HAS_FLOAT       0
+#define HAS_TIME_H      0
+#define USE_CLOCK       0
+#define HAS_STDIO       0
+#define HAS_PRINTF      0
+#define MAIN_HAS_NOARGC 1
+#define MAIN_HAS_NORETURN 0
+
+#ifndef COMPILER_VERSION
+#ifdef __GNUC__
+#define COMPILER_VERSION "GCC"__VERSION__
+#else
+#define COMPILER_VERSION "unknown"
+#endif
+#endif
+#ifndef FLAGS_STR
+#define FLAGS_STR "unknown"
+#endif
+#define COMPILER_FLAGS  FLAGS_STR
+#define MEM_LOCATION    "STATIC"
+
+typedef int16_t   ee_s16;
+typedef uint16_t  ee_u16;
+typedef int32_t   ee_s32;
+typedef uint8_t   ee_u8;
+typedef uint32_t  ee_u32;
+typedef uintptr_t ee_ptr_int;
+typedef size_t    ee_size_t;
+
+#define align_mem(x) (void *)(4 + (((ee_ptr_int)(x) - 1) & ~3))
+
+#define CORETIMETYPE ee_u32
+typedef ee_u32 CORE_TICKS;
+
+#define SEED_METHOD SEED_VOLATILE
+#define MEM_METHOD  MEM_STATIC
+
+#define MULTITHREAD 1
+#define USE_PTHREAD 0
+#define USE_FORK    0
+#define USE_SOCKET  0
+
+typedef struct CORE_PORTABLE_S {
+    ee_u8 portable_id;
+} core_portable;
+
+void portable_init(core_portable *p, int *argc, char *argv[]);
+void portable_fini(core_portable *p);
+
+#if !defined(PROFILE_RUN) && !defined(PERFORMANCE_RUN) && !defined(VALIDATION_RUN)
+#if (TOTAL_DATA_SIZE == 1200)
+#define PROFILE_RUN 1
+#elif (TOTAL_DATA_SIZE == 2000)
+#define PERFORMANCE_RUN 1
+#else
+#define VALIDATION_RUN 1
+#endif
+#endif
+
+extern ee_u32 default_num_contexts;
+
+int ee_printf(const char *fmt, ...);
+
+#endif // CORE_PORTME_H
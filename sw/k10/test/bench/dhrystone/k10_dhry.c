@@ -0,0 +1,62 @@
+/* ============================================================================
+ * K10 Dhrystone 2.1 Port
+ * ============================================================================
+ * See k10_dhry.h.  Built without the prelude: this file does not include
+ * dhry.h and only names the globals of dhry_1.c it checks.
+ * ============================================================================ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "k10_bench.h"
+
+#ifndef K10_DHRY_RUNS
+#define K10_DHRY_RUNS 2000
+#endif
+
+// Globals of dhry_1.c whose final values the benchmark prints as "should be".
+extern int  Int_Glob;
+extern char Ch_1_Glob;
+extern char Ch_2_Glob;
+extern int  Arr_1_Glob[50];
+extern int  Arr_2_Glob[50][50];
+
+static k10_bench_counters_t s_begin;
+static k10_bench_counters_t s_end;
+
+// Returns seconds at 1 MHz (whole cycles / 10^6) for dhry_1.c's own printout.
+long k10_dhry_time(void)
+{
+    static int calls;
+
+    if (calls++ == 0) {
+        k10_bench_snapshot(&s_begin);
+        return 0;
+    }
+    k10_bench_snapshot(&s_end);
+
+    const uint64_t cycles = s_end.cycles - s_begin.cycles;
+    const int pass = Int_Glob == 5 && Ch_1_Glob == 'A' && Ch_2_Glob == 'B' &&
+                     Arr_1_Glob[8] == 7 && Arr_2_Glob[8][7] == K10_DHRY_RUNS + 10;
+    k10_bench_report("dhrystone", &s_begin, &s_end, K10_DHRY_RUNS,
+                     cycles ? (uint64_t)K10_DHRY_RUNS * 1000000000ULL / (cycles * 1757U) : 0,
+                     "DMIPS/MHz", pass);
+    return (long)(cycles / 1000000U);
+}
+
+// ============================================================================
+// malloc for the two records dhry_1.c allocates: a bump allocator over a
+// static pool, nothing is ever freed.
+// ============================================================================
+
+static uint8_t s_heap[256] __attribute__((aligned(8)));
+static size_t  s_heap_used;
+
+void *malloc(size_t size)
+{
+    size = (size + 7U) & ~(size_t)7U;
+    if (size > sizeof(s_heap) - s_heap_used) return NULL;
+    void *p = &s_heap[s_heap_used];
+    s_heap_used += size;
+    return p;
+}
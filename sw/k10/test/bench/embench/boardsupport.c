@@ -0,0 +1,24 @@
+/* ============================================================================
+ * K10 Embench Board Support
+ * ============================================================================
+ * See boardsupport.h.
+ * ============================================================================ */
+
+#include "support.h"
+
+k10_bench_counters_t k10_embench_start;
+k10_bench_counters_t k10_embench_stop;
+
+void initialise_board(void)
+{
+}
+
+void __attribute__((noinline)) start_trigger(void)
+{
+    k10_bench_snapshot(&k10_embench_start);
+}
+
+void __attribute__((noinline)) stop_trigger(void)
+{
+    k10_bench_snapshot(&k10_embench_stop);
+}
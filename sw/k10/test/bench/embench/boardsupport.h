@@ -0,0 +1,31 @@
+/* ============================================================================
+ * K10 Embench Board Support — configuration
+ * ============================================================================
+ * Included by Embench's support.h (HAVE_BOARDSUPPORT_H).  CPU_MHZ scales
+ * every kernel's repeat count (Embench 1.0 calls it CPU_MHZ, later
+ * releases GLOBAL_SCALE_FACTOR); K10_EMBENCH_CPU_MHZ sets it, 1 by default
+ * so a kernel stays within a few million cycles on the Verilator model.
+ *
+ * start_trigger() / stop_trigger() snapshot mcycle / minstret into
+ * k10_embench_start / k10_embench_stop for k10_embench_main.c.
+ * ============================================================================ */
+
+#ifndef K10_BOARDSUPPORT_H
+#define K10_BOARDSUPPORT_H
+
+#include "k10_bench.h"
+
+#ifndef CPU_MHZ
+#define CPU_MHZ 1
+#endif
+#ifndef GLOBAL_SCALE_FACTOR
+#define GLOBAL_SCALE_FACTOR CPU_MHZ
+#endif
+#ifndef WARMUP_HEAT
+#define WARMUP_HEAT 1
+#endif
+
+extern k10_bench_counters_t k10_embench_start;
+extern k10_bench_counters_t k10_embench_stop;
+
+#endif // K10_BOARDSUPPORT_H
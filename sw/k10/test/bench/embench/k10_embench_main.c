@@ -0,0 +1,33 @@
+/* ============================================================================
+ * K10 Embench Main
+ * ============================================================================
+ * Replaces Embench's support/main.c: the same sequence (initialise, warm
+ * caches, one timed benchmark(), verify), followed by the K10_BENCH line.
+ * score is the cycle count of the timed call; K10_EMBENCH_NAME names the
+ * kernel.
+ * ============================================================================ */
+
+#include "support.h"
+
+#ifndef K10_EMBENCH_NAME
+#define K10_EMBENCH_NAME "embench"
+#endif
+
+int main(void)
+{
+    volatile int result;
+
+    initialise_board();
+    initialise_benchmark();
+    warm_caches(WARMUP_HEAT);
+
+    start_trigger();
+    result = benchmark();
+    stop_trigger();
+
+    const int correct = verify_benchmark(result);
+    k10_bench_report(K10_EMBENCH_NAME, &k10_embench_start, &k10_embench_stop,
+                     CPU_MHZ, (k10_embench_stop.cycles - k10_embench_start.cycles) * 1000U,
+                     "cycles", correct);
+    return !correct;
+}
@@ -0,0 +1,239 @@
+/* ============================================================================
+ * K10 Benchmark Support
+ * ============================================================================
+ * See k10_bench.h.
+ * ============================================================================ */
+
+#include "k10.h"
+#include "k10_bench.h"
+
+static int s_reported;
+static int s_pass;
+
+void k10_bench_snapshot(k10_bench_counters_t *c)
+{
+    uint32_t cy_hi, cy_lo, ir_hi, ir_lo;
+    do {
+        cy_hi = read_csr(mcycleh);
+        ir_hi = read_csr(minstreth);
+        cy_lo = read_csr(mcycle);
+        ir_lo = read_csr(minstret);
+    } while (read_csr(mcycleh) != cy_hi || read_csr(minstreth) != ir_hi);
+    c->cycles  = ((uint64_t)cy_hi << 32) | cy_lo;
+    c->instret = ((uint64_t)ir_hi << 32) | ir_lo;
+}
+
+// ============================================================================
+// printf subset: %c %s %d %i %u %x %X %p %f %%, flags '-' '0', width,
+// precision, length l / ll / z
+// ============================================================================
+
+static int put_pad(int n, char c)
+{
+    int out = 0;
+    while (n-- > 0) {
+        k10_putchar(c);
+        out++;
+    }
+    return out;
+}
+
+static int put_field(const char *s, int len, int width, int left, char pad)
+{
+    int out = 0;
+    // Zero padding goes between the sign and the digits.
+    if (pad == '0' && len > 0 && *s == '-') {
+        k10_putchar(*s++);
+        len--;
+        width--;
+        out++;
+    }
+    if (!left) out += put_pad(width - len, pad);
+    for (int i = 0; i < len; i++) k10_putchar(s[i]);
+    out += len;
+    if (left) out += put_pad(width - len, ' ');
+    return out;
+}
+
+static int fmt_u64(char *buf, uint64_t v, unsigned base, int upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[24];
+    int n = 0;
+    do {
+        tmp[n++] = digits[v % base];
+        v /= base;
+    } while (v);
+    for (int i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+    return n;
+}
+
+int k10_bench_vprintf(const char *fmt, va_list ap)
+{
+    int out = 0;
+    char buf[48];
+
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            k10_putchar(*fmt);
+            out++;
+            continue;
+        }
+        fmt++;
+
+        int left = 0;
+        char pad = ' ';
+        for (;; fmt++) {
+            if (*fmt == '-')      left = 1;
+            else if (*fmt == '0') pad  = '0';
+            else if (*fmt != '+' && *fmt != ' ' && *fmt != '#') break;
+        }
+        if (left) pad = ' ';
+
+        int width = 0;
+        if (*fmt == '*') {
+            width = va_arg(ap, int);
+            fmt++;
+        }
+        while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+
+        int prec = -1;
+        if (*fmt == '.') {
+            prec = 0;
+            fmt++;
+            while (*fmt >= '0' && *fmt <= '9') prec = prec * 10 + (*fmt++ - '0');
+        }
+
+        int lng = 0;
+        while (*fmt == 'l' || *fmt == 'z' || *fmt == 'h') {
+            if (*fmt == 'l') lng++;
+            fmt++;
+        }
+
+        uint64_t u;
+        int len;
+        switch (*fmt) {
+        case 'c':
+            buf[0] = (char)va_arg(ap, int);
+            out += put_field(buf, 1, width, left, ' ');
+            break;
+        case 's': {
+            const char *s = va_arg(ap, const char *);
+            if (!s) s = "(null)";
+            len = 0;
+            while (s[len] && (prec < 0 || len < prec)) len++;
+            out += put_field(s, len, width, left, ' ');
+            break;
+        }
+        case 'd':
+        case 'i': {
+            int64_t v = lng >= 2 ? va_arg(ap, long long)
+                      : lng == 1 ? va_arg(ap, long) : va_arg(ap, int);
+            len = 0;
+            if (v < 0) {
+                buf[len++] = '-';
+                u = (uint64_t)0 - (uint64_t)v;
+            } else {
+                u = (uint64_t)v;
+            }
+            len += fmt_u64(buf + len, u, 10, 0);
+            out += put_field(buf, len, width, left, pad);
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X':
+            u = lng >= 2 ? va_arg(ap, unsigned long long)
+              : lng == 1 ? va_arg(ap, unsigned long) : va_arg(ap, unsigned);
+            len = fmt_u64(buf, u, *fmt == 'u' ? 10 : 16, *fmt == 'X');
+            out += put_field(buf, len, width, left, pad);
+            break;
+        case 'p':
+            buf[0] = '0';
+            buf[1] = 'x';
+            len = 2 + fmt_u64(buf + 2, (uintptr_t)va_arg(ap, void *), 16, 0);
+            out += put_field(buf, len, width, left, ' ');
+            break;
+        case 'f': {
+            double v = va_arg(ap, double);
+            if (prec < 0) prec = 6;
+            if (prec > 9) prec = 9;
+            len = 0;
+            if (v < 0) {
+                buf[len++] = '-';
+                v = -v;
+            }
+            uint64_t scale = 1;
+            for (int i = 0; i < prec; i++) scale *= 10;
+            // Rounded once, so 0.96 at %.1f prints 1.0, not 0.10.
+            u = (uint64_t)(v * (double)scale + 0.5);
+            len += fmt_u64(buf + len, u / scale, 10, 0);
+            if (prec > 0) {
+                char frac[12];
+                int n = fmt_u64(frac, u % scale, 10, 0);
+                buf[len++] = '.';
+                for (int i = n; i < prec; i++) buf[len++] = '0';
+                for (int i = 0; i < n; i++) buf[len++] = frac[i];
+            }
+            out += put_field(buf, len, width, left, pad);
+            break;
+        }
+        case '%':
+            k10_putchar('%');
+            out++;
+            break;
+        default:
+            if (!*fmt) return out;
+            k10_putchar('%');
+            k10_putchar(*fmt);
+            out += 2;
+            break;
+        }
+    }
+    return out;
+}
+
+int k10_bench_printf(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    const int out = k10_bench_vprintf(fmt, ap);
+    va_end(ap);
+    return out;
+}
+
+// ============================================================================
+// Result line and end of run
+// ============================================================================
+
+void k10_bench_report(const char *name, const k10_bench_counters_t *begin,
+                      const k10_bench_counters_t *end, uint32_t iterations,
+                      uint64_t score_milli, const char *unit, int pass)
+{
+    k10_bench_printf("K10_BENCH name=%s cycles=%llu instret=%llu iterations=%u "
+                     "score=%llu.%03u unit=%s status=%s\n",
+                     name,
+                     (unsigned long long)(end->cycles - begin->cycles),
+                     (unsigned long long)(end->instret - begin->instret),
+                     (unsigned)iterations,
+                     (unsigned long long)(score_milli / 1000),
+                     (unsigned)(score_milli % 1000),
+                     unit, pass ? "PASS" : "FAIL");
+    s_reported = 1;
+    s_pass     = pass;
+}
+
+uint32_t trap_handler(uint32_t mcause, uint32_t mepc)
+{
+    if (mcause == 11 && s_reported) {   // ECALL after main() returned
+        if (s_pass) sim_pass();
+        else        sim_fail();
+    } else {
+        k10_bench_printf("K10_BENCH trap mcause=0x%08x mepc=0x%08x\n",
+                         (unsigned)mcause, (unsigned)mepc);
+        sim_fail();
+    }
+    for (;;) {
+    }
+    return mepc;
+}
@@ -0,0 +1,41 @@
+/* ============================================================================
+ * K10 Benchmark Support
+ * ============================================================================
+ * Shared by the CoreMark, Dhrystone and Embench ports in this directory:
+ * 64-bit mcycle / minstret snapshots, a small printf for the benchmarks'
+ * own output, and the result line scripts/run_benchmarks.sh parses:
+ *
+ *   K10_BENCH name=<bench> cycles=<n> instret=<n> iterations=<n>
+ *             score=<n.nnn> unit=<unit> status=PASS|FAIL
+ *
+ * (printed as one line).  Scores are passed in thousandths and printed in
+ * integer fixed point, so no float formatting is linked for the report.
+ *
+ * A benchmark reports once and returns from main().  The ECALL in
+ * startup.S then lands in trap_handler() here, which ends the run through
+ * sim_pass() / sim_fail() with the reported status.  Simulations therefore
+ * need +finish_on_ecall=0; any other trap fails the run.
+ * ============================================================================ */
+
+#ifndef K10_BENCH_H
+#define K10_BENCH_H
+
+#include <stdarg.h>
+#include <stdint.h>
+
+typedef struct {
+    uint64_t cycles;
+    uint64_t instret;
+} k10_bench_counters_t;
+
+void k10_bench_snapshot(k10_bench_counters_t *c);
+
+int k10_bench_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+int k10_bench_vprintf(const char *fmt, va_list ap);
+
+// end - begin, printed as a K10_BENCH line; pass != 0 reports PASS.
+void k10_bench_report(const char *name, const k10_bench_counters_t *begin,
+                      const k10_bench_counters_t *end, uint32_t iterations,
+                      uint64_t score_milli, const char *unit, int pass);
+
+#endif // K10_BENCH_H
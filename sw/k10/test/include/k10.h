@@ -16,6 +16,7 @@
 #define K10_TIMER_BASE     0x40000000U
 #define K10_SIM_CTRL_BASE  0x40001000U
 #define K10_UART_BASE      0x40002000U
+#define K10_TRACE_BASE     0x40010000U   // only with TRACE_BUF=true
 
 // ============================================================================
 // Timer Registers (k10_timer)
@@ -26,6 +27,10 @@
 #define TIMER_MTIMECMP_LO  (*(volatile uint32_t *)(K10_TIMER_BASE + 0x08))
 #define TIMER_MTIMECMP_HI  (*(volatile uint32_t *)(K10_TIMER_BASE + 0x0C))
 
+// mtimecmp of hart h (N_HARTS > 1); hart 0's aliases the registers above
+#define TIMER_MTIMECMP_LO_HART(h) (*(volatile uint32_t *)(K10_TIMER_BASE + 0x40 + 8 * (h)))
+#define TIMER_MTIMECMP_HI_HART(h) (*(volatile uint32_t *)(K10_TIMER_BASE + 0x44 + 8 * (h)))
+
 // ============================================================================
 // Sim Controller Registers (k10_sim_ctrl)
 // ============================================================================
@@ -34,6 +39,10 @@
 #define SIM_CHAR_OUT       (*(volatile uint32_t *)(K10_SIM_CTRL_BASE + 0x04))
 #define SIM_MSIP           (*(volatile uint32_t *)(K10_SIM_CTRL_BASE + 0x08))
 #define SIM_STATUS         (*(volatile uint32_t *)(K10_SIM_CTRL_BASE + 0x0C))
+#define SIM_NHARTS         (*(volatile uint32_t *)(K10_SIM_CTRL_BASE + 0x10))
+
+// Software interrupt of hart h; hart 0's aliases SIM_MSIP
+#define SIM_MSIP_HART(h)   (*(volatile uint32_t *)(K10_SIM_CTRL_BASE + 0x40 + 4 * (h)))
 
 // ============================================================================
 // UART Registers (k10_uart)
@@ -45,6 +54,33 @@
 #define UART_BAUD_DIV      (*(volatile uint32_t *)(K10_UART_BASE + 0x0C))
 #define UART_IRQ_CLR       (*(volatile uint32_t *)(K10_UART_BASE + 0x10))
 
+// ============================================================================
+// Commit Trace Buffer Registers (k10_trace_buf, TRACE_BUF=true builds)
+// ============================================================================
+// Normally driven from OpenOCD (scripts/k10_tracebuf_dump.sh); firmware can
+// use them to bracket a region of interest.
+
+#define TRACE_CTRL         (*(volatile uint32_t *)(K10_TRACE_BASE + 0x00))
+#define TRACE_STATUS       (*(volatile uint32_t *)(K10_TRACE_BASE + 0x04))
+#define TRACE_WPTR         (*(volatile uint32_t *)(K10_TRACE_BASE + 0x08))
+#define TRACE_DEPTH        (*(volatile uint32_t *)(K10_TRACE_BASE + 0x0C))
+#define TRACE_START_PC     (*(volatile uint32_t *)(K10_TRACE_BASE + 0x10))
+#define TRACE_STOP_PC      (*(volatile uint32_t *)(K10_TRACE_BASE + 0x14))
+#define TRACE_CYCLE        (*(volatile uint32_t *)(K10_TRACE_BASE + 0x18))
+#define TRACE_DATA         ((volatile uint32_t *)(K10_TRACE_BASE + 0x8000))
+
+#define TRACE_CTRL_EN        (1U << 0)
+#define TRACE_CTRL_WRAP      (1U << 1)
+#define TRACE_CTRL_START_PC  (1U << 2)
+#define TRACE_CTRL_STOP_PC   (1U << 3)
+#define TRACE_CTRL_STOP_TRAP (1U << 4)
+#define TRACE_CTRL_CLEAR     (1U << 8)
+
+#define TRACE_STATUS_STATE    0x7U      // 0 idle, 1 armed, 2 recording, 3/4 stopping
+#define TRACE_STATUS_WRAPPED  (1U << 4)
+#define TRACE_STATUS_FULL     (1U << 5)
+#define TRACE_STATUS_OVERFLOW (1U << 6)
+
 // ============================================================================
 // CSR Helpers
 // ============================================================================
@@ -61,6 +97,92 @@
 #define clear_csr(csr, val) ({ unsigned long __v = (unsigned long)(val); \
     __asm__ volatile ("csrc " #csr ", %0" :: "rK"(__v)); })
 
+static inline uint32_t k10_hart_id(void) { return read_csr(mhartid); }
+
+// ============================================================================
+// Hardware Performance Counters (k10_csr)
+// ============================================================================
+// mhpmcounter3 .. mhpmcounter(3 + K10_HPM_COUNTERS - 1) are implemented.
+// Select what a counter counts with k10_hpm_set_event(); it then adds one
+// in every cycle its event is active.  Event numbers match hpm_event_e in
+// komandara_k10_pkg.sv.
+
+#define K10_HPM_COUNTERS        8
+#define K10_HPM_FIRST           3
+
+#define K10_HPM_EV_NONE         0
+#define K10_HPM_EV_LOAD_USE     1   // load-use bubble cycles
+#define K10_HPM_EV_BRANCH_FLUSH 2   // EX redirects: taken branches / jumps not predicted
+#define K10_HPM_EV_MD_BUSY      3   // cycles stalled on mul/div
+#define K10_HPM_EV_IF_WAIT      4   // cycles decode starved by instruction fetch
+#define K10_HPM_EV_LSU_WAIT     5   // cycles stalled on the data bus
+#define K10_HPM_EV_LSU_SPLIT    6   // misaligned accesses split in two
+#define K10_HPM_EV_TRAP_FLUSH   7   // traps, mret, dret, debug entry
+#define K10_HPM_EV_BRANCH       8   // branches / jumps executed
+#define K10_HPM_EV_BP_HIT       9   // ... predicted correctly (direction and target)
+#define K10_HPM_EV_BP_MISPREDICT 10 // ... predicted wrongly (redirected from EX)
+
+#define MCOUNTINHIBIT_CY        (1U << 0)
+#define MCOUNTINHIBIT_IR        (1U << 2)
+#define MCOUNTINHIBIT_HPM(n)    (1U << (n))
+#define MCOUNTINHIBIT_ALL       0xFFFFFFFDU
+
+// CSR numbers are instruction immediates, so counter n is dispatched here;
+// out-of-range n reads 0 / is ignored.
+#define K10_HPM_CASES(X) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10)
+
+static inline uint32_t k10_hpm_read_lo(unsigned n) {
+    switch (n) {
+#define X(i) case i: return read_csr(mhpmcounter##i);
+    K10_HPM_CASES(X)
+#undef X
+    default: return 0;
+    }
+}
+
+static inline uint32_t k10_hpm_read_hi(unsigned n) {
+    switch (n) {
+#define X(i) case i: return read_csr(mhpmcounter##i##h);
+    K10_HPM_CASES(X)
+#undef X
+    default: return 0;
+    }
+}
+
+// 64-bit read, retried if the low word wrapped between the two reads
+static inline uint64_t k10_hpm_read(unsigned n) {
+    uint32_t hi, lo;
+    do {
+        hi = k10_hpm_read_hi(n);
+        lo = k10_hpm_read_lo(n);
+    } while (hi != k10_hpm_read_hi(n));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline void k10_hpm_write(unsigned n, uint64_t val) {
+    switch (n) {
+#define X(i) case i: write_csr(mhpmcounter##i, 0); \
+                     write_csr(mhpmcounter##i##h, (uint32_t)(val >> 32)); \
+                     write_csr(mhpmcounter##i, (uint32_t)val); break;
+    K10_HPM_CASES(X)
+#undef X
+    default: break;
+    }
+}
+
+static inline void k10_hpm_set_event(unsigned n, uint32_t event) {
+    switch (n) {
+#define X(i) case i: write_csr(mhpmevent##i, event); break;
+    K10_HPM_CASES(X)
+#undef X
+    default: break;
+    }
+}
+
+// mcountinhibit by number: older assemblers do not know the name
+static inline void k10_hpm_inhibit(uint32_t mask)   { set_csr(0x320, mask); }
+static inline void k10_hpm_uninhibit(uint32_t mask) { clear_csr(0x320, mask); }
+
 // ============================================================================
 // Interrupt Constants
 // ============================================================================
@@ -0,0 +1,148 @@
+#include "k10.h"
+
+uint32_t trap_handler(uint32_t mcause, uint32_t mepc) {
+    (void)mcause;
+    return mepc + 4; // Just return to next instruction
+}
+
+// Branch-heavy companion to k10_c_benchmark: short loops, data-dependent
+// conditional branches and calls/returns, with little arithmetic between
+// them.  Compare CPI with and without BRANCH_PRED.
+#define ARRAY_SIZE   64
+#define NUM_SEARCHES 128
+
+static uint32_t data[ARRAY_SIZE];
+static uint32_t lcg_state = 12345;
+
+static uint32_t lcg_next(void) {
+    lcg_state = lcg_state * 1103515245u + 12345u;
+    return lcg_state >> 8;
+}
+
+// Insertion sort: inner-loop exits depend on the data
+static void insertion_sort(uint32_t *v, int n) {
+    for (int i = 1; i < n; i++) {
+        uint32_t key = v[i];
+        int j = i - 1;
+        while (j >= 0 && v[j] > key) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = key;
+    }
+}
+
+// Binary search: one unpredictable branch per step
+static __attribute__((noinline)) int bsearch_u32(const uint32_t *v, int n, uint32_t key) {
+    int lo = 0, hi = n - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        if (v[mid] == key) return mid;
+        if (v[mid] < key) lo = mid + 1;
+        else              hi = mid - 1;
+    }
+    return -1;
+}
+
+// Bit-serial popcount: a taken/not-taken pattern per bit
+static __attribute__((noinline)) uint32_t popcount_loop(uint32_t x) {
+    uint32_t n = 0;
+    while (x) {
+        if (x & 1u) n++;
+        x >>= 1;
+    }
+    return n;
+}
+
+static const struct {
+    uint32_t    event;
+    const char *name;
+} hpm_events[] = {
+    { K10_HPM_EV_BRANCH,        "Branches / jumps  : " },
+    { K10_HPM_EV_BP_HIT,        "Predicted         : " },
+    { K10_HPM_EV_BP_MISPREDICT, "Mispredicted      : " },
+    { K10_HPM_EV_BRANCH_FLUSH,  "Branch flushes    : " },
+    { K10_HPM_EV_IF_WAIT,       "I-fetch wait      : " },
+    { K10_HPM_EV_LOAD_USE,      "Load-use stalls   : " },
+};
+#define NUM_HPM_EVENTS (sizeof(hpm_events) / sizeof(hpm_events[0]))
+
+int main(void) {
+    k10_puts("=== K10 Branch Benchmark ===\n");
+
+    for (int i = 0; i < ARRAY_SIZE; i++) {
+        data[i] = lcg_next() & 0xFFFF;
+    }
+
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
+    for (unsigned i = 0; i < NUM_HPM_EVENTS; i++) {
+        k10_hpm_set_event(K10_HPM_FIRST + i, hpm_events[i].event);
+        k10_hpm_write(K10_HPM_FIRST + i, 0);
+    }
+    k10_hpm_uninhibit(MCOUNTINHIBIT_ALL);
+
+    uint32_t start_cycles = read_csr(mcycle);
+    uint32_t start_instret = read_csr(minstret);
+
+    insertion_sort(data, ARRAY_SIZE);
+
+    uint32_t found = 0;
+    for (int i = 0; i < NUM_SEARCHES; i++) {
+        // Half of the keys come from the array, half are random
+        uint32_t key = (i & 1) ? data[(i * 7) % ARRAY_SIZE] : (lcg_next() & 0xFFFF);
+        if (bsearch_u32(data, ARRAY_SIZE, key) >= 0) found++;
+    }
+
+    uint32_t bits = 0;
+    for (int i = 0; i < ARRAY_SIZE; i++) {
+        bits += popcount_loop(data[i]);
+    }
+
+    uint32_t end_cycles = read_csr(mcycle);
+    uint32_t end_instret = read_csr(minstret);
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
+
+    // Self-check: sorted, and every in-array key was found
+    for (int i = 1; i < ARRAY_SIZE; i++) {
+        if (data[i - 1] > data[i]) {
+            k10_puts("FAIL: array not sorted\n");
+            sim_fail();
+        }
+    }
+    if (found < NUM_SEARCHES / 2) {
+        k10_puts("FAIL: binary search missed a key\n");
+        sim_fail();
+    }
+
+    uint32_t delta_cycles = end_cycles - start_cycles;
+    uint32_t delta_instret = end_instret - start_instret;
+
+    k10_puts("\n--- Results ---\n");
+    k10_puts("Keys found        : "); k10_put_dec(found); k10_puts("\n");
+    k10_puts("Bits set          : "); k10_put_dec(bits); k10_puts("\n");
+    k10_puts("Total Cycles      : "); k10_put_dec(delta_cycles); k10_puts("\n");
+    k10_puts("Total Instructions: "); k10_put_dec(delta_instret); k10_puts("\n");
+
+    uint32_t cpi_x1000 = (delta_cycles * 1000) / delta_instret;
+    uint32_t cpi_int = cpi_x1000 / 1000;
+    uint32_t cpi_frac = cpi_x1000 % 1000;
+
+    k10_puts("CPI               : ");
+    k10_put_dec(cpi_int);
+    k10_puts(".");
+    if (cpi_frac < 10) k10_puts("00");
+    else if (cpi_frac < 100) k10_puts("0");
+    k10_put_dec(cpi_frac);
+    k10_puts("\n");
+
+    k10_puts("\n--- Branch Events ---\n");
+    for (unsigned i = 0; i < NUM_HPM_EVENTS; i++) {
+        k10_puts(hpm_events[i].name);
+        k10_put_dec((uint32_t)k10_hpm_read(K10_HPM_FIRST + i));
+        k10_puts("\n");
+    }
+    k10_puts("-----------------\n");
+
+    sim_pass();
+    return 0;
+}
@@ -35,11 +35,34 @@ void multiply_matrices() {
     }
 }
 
+// Stall breakdown: one counter per event, mhpmcounter3.. in this order
+static const struct {
+    uint32_t    event;
+    const char *name;
+} hpm_events[] = {
+    { K10_HPM_EV_LOAD_USE,      "Load-use stalls   : " },
+    { K10_HPM_EV_BRANCH_FLUSH,  "Branch flushes    : " },
+    { K10_HPM_EV_MD_BUSY,       "Mul/div busy      : " },
+    { K10_HPM_EV_IF_WAIT,       "I-fetch wait      : " },
+    { K10_HPM_EV_LSU_WAIT,      "LSU bus wait      : " },
+    { K10_HPM_EV_LSU_SPLIT,     "Misaligned splits : " },
+    { K10_HPM_EV_BRANCH,        "Branches / jumps  : " },
+    { K10_HPM_EV_BP_MISPREDICT, "Mispredicts       : " },
+};
+#define NUM_HPM_EVENTS (sizeof(hpm_events) / sizeof(hpm_events[0]))
+
 int main(void) {
     k10_puts("=== K10 CPI Performance Benchmark ===\n");
     
     init_matrices();
 
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
+    for (unsigned i = 0; i < NUM_HPM_EVENTS; i++) {
+        k10_hpm_set_event(K10_HPM_FIRST + i, hpm_events[i].event);
+        k10_hpm_write(K10_HPM_FIRST + i, 0);
+    }
+    k10_hpm_uninhibit(MCOUNTINHIBIT_ALL);
+
     uint32_t start_cycles = read_csr(mcycle);
     uint32_t start_instret = read_csr(minstret);
 
@@ -48,6 +71,7 @@ int main(void) {
 
     uint32_t end_cycles = read_csr(mcycle);
     uint32_t end_instret = read_csr(minstret);
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
 
     uint32_t delta_cycles = end_cycles - start_cycles;
     uint32_t delta_instret = end_instret - start_instret;
@@ -67,6 +91,13 @@ int main(void) {
     else if (cpi_frac < 100) k10_puts("0");
     k10_put_dec(cpi_frac);
     k10_puts("\n");
+
+    k10_puts("\n--- Cycle Breakdown (events over the whole run) ---\n");
+    for (unsigned i = 0; i < NUM_HPM_EVENTS; i++) {
+        k10_puts(hpm_events[i].name);
+        k10_put_dec((uint32_t)k10_hpm_read(K10_HPM_FIRST + i));
+        k10_puts("\n");
+    }
     k10_puts("-----------------\n");
 
     sim_pass();
@@ -0,0 +1,228 @@
+#include "k10.h"
+
+uint32_t trap_handler(uint32_t mcause, uint32_t mepc) {
+    (void)mcause;
+    return mepc + 4; // Just return to next instruction
+}
+
+// Parallel workload for N_HARTS > 1 SoCs (also runs on one hart).  Two
+// kernels over a shared array: "compute" does register-bound mixing rounds
+// per item, "stream" sums a few passes over the array and is bound by the
+// shared BRAM.  Hart 0 times each kernel alone while the other harts sleep
+// in WFI, then again with every hart working on its slice.  It wakes the
+// others through their SIM_MSIP and they report back with amoadd; each
+// slice checksum is folded into a shared total with an LR/SC loop and
+// checked against the single-hart run.
+//
+// Per hart it prints the cycles, I-fetch wait and LSU wait of its slice.
+// The waits grow with the hart count as the harts share the instruction
+// and data buses.  scripts/run_smp_benchmark.sh runs it with 1, 2 and 4
+// harts and tabulates the result.
+
+#define MAX_HARTS     8
+#define N_ITEMS       512
+#define MIX_ROUNDS    16
+#define STREAM_PASSES 8
+
+enum { CMD_NONE, CMD_COMPUTE, CMD_STREAM, CMD_EXIT };
+
+typedef struct {
+    uint32_t cycles;
+    uint32_t if_wait;
+    uint32_t lsu_wait;
+} slice_stats_t;
+
+static uint32_t data[N_ITEMS];
+static uint32_t out[N_ITEMS];
+
+static volatile uint32_t g_cmd;
+static volatile uint32_t g_nharts;
+static uint32_t g_done;       // amoadd: secondary harts finished
+static uint32_t g_checksum;   // LR/SC: sum of the slice checksums
+static slice_stats_t g_stats[MAX_HARTS];
+
+static uint32_t mix(uint32_t x) {
+    for (int r = 0; r < MIX_ROUNDS; r++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        x *= 0x9E3779B1u;
+    }
+    return x;
+}
+
+static uint32_t compute_kernel(uint32_t lo, uint32_t hi) {
+    uint32_t sum = 0;
+    for (uint32_t i = lo; i < hi; i++) {
+        out[i] = mix(data[i]);
+        sum += out[i];
+    }
+    return sum;
+}
+
+static uint32_t stream_kernel(uint32_t lo, uint32_t hi) {
+    uint32_t sum = 0;
+    for (int p = 0; p < STREAM_PASSES; p++) {
+        for (uint32_t i = lo; i < hi; i++) {
+            sum += data[i] ^ (uint32_t)p;
+        }
+    }
+    return sum;
+}
+
+// Fold a slice checksum into g_checksum with lr.w / sc.w
+static void checksum_add(uint32_t v) {
+    uint32_t old, tmp;
+    __asm__ volatile ("1: lr.w  %0, (%2)\n"
+                      "   add   %1, %0, %3\n"
+                      "   sc.w  %1, %1, (%2)\n"
+                      "   bnez  %1, 1b"
+                      : "=&r"(old), "=&r"(tmp) : "r"(&g_checksum), "r"(v) : "memory");
+}
+
+// Run one kernel on hart h's slice of n, recording its cycles and waits
+static void run_slice(uint32_t cmd, uint32_t h, uint32_t n) {
+    uint32_t lo = N_ITEMS * h / n;
+    uint32_t hi = N_ITEMS * (h + 1) / n;
+
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
+    k10_hpm_write(K10_HPM_FIRST + 0, 0);
+    k10_hpm_write(K10_HPM_FIRST + 1, 0);
+    k10_hpm_uninhibit(MCOUNTINHIBIT_ALL);
+    uint32_t start = read_csr(mcycle);
+
+    uint32_t sum = (cmd == CMD_COMPUTE) ? compute_kernel(lo, hi) : stream_kernel(lo, hi);
+
+    uint32_t end = read_csr(mcycle);
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
+
+    g_stats[h].cycles   = end - start;
+    g_stats[h].if_wait  = (uint32_t)k10_hpm_read(K10_HPM_FIRST + 0);
+    g_stats[h].lsu_wait = (uint32_t)k10_hpm_read(K10_HPM_FIRST + 1);
+    checksum_add(sum);
+}
+
+static void hpm_setup(void) {
+    k10_hpm_inhibit(MCOUNTINHIBIT_ALL);
+    k10_hpm_set_event(K10_HPM_FIRST + 0, K10_HPM_EV_IF_WAIT);
+    k10_hpm_set_event(K10_HPM_FIRST + 1, K10_HPM_EV_LSU_WAIT);
+}
+
+// Secondary harts (startup.S): sleep until hart 0 raises our MSIP
+void hart_main(uint32_t h) {
+    hpm_setup();
+    set_csr(mie, MIE_MSIE);     // wake-up only: mstatus.MIE stays clear
+    while (1) {
+        while ((read_csr(mip) & MIE_MSIE) == 0) {
+            __asm__ volatile ("wfi");
+        }
+        SIM_MSIP_HART(h) = 0;
+        while (read_csr(mip) & MIE_MSIE) {
+        }
+
+        uint32_t cmd = g_cmd;
+        if (cmd == CMD_EXIT) break;
+        run_slice(cmd, h, g_nharts);
+        __atomic_fetch_add(&g_done, 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void put_row(const char *label, uint32_t v) {
+    k10_puts(label);
+    k10_put_dec(v);
+    k10_puts("\n");
+}
+
+// x1000 fixed-point ratio a / b, printed as d.ddd
+static void put_ratio(uint32_t a, uint32_t b) {
+    uint32_t r = (a * 1000u) / (b ? b : 1);
+    k10_put_dec(r / 1000);
+    k10_puts(".");
+    if (r % 1000 < 10) k10_puts("00");
+    else if (r % 1000 < 100) k10_puts("0");
+    k10_put_dec(r % 1000);
+}
+
+static int run_kernel(uint32_t cmd, const char *name, uint32_t n) {
+    // Reference: hart 0 alone, the other harts asleep
+    g_checksum = 0;
+    run_slice(cmd, 0, 1);
+    uint32_t ref_cycles = g_stats[0].cycles;
+    uint32_t ref_if = g_stats[0].if_wait;
+    uint32_t ref_lsu = g_stats[0].lsu_wait;
+    uint32_t ref_sum = g_checksum;
+
+    // Parallel: every hart on its slice
+    g_checksum = 0;
+    g_done = 0;
+    g_cmd = cmd;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    uint32_t start = read_csr(mcycle);
+    for (uint32_t h = 1; h < n; h++) {
+        SIM_MSIP_HART(h) = 1;
+    }
+    run_slice(cmd, 0, n);
+    while (__atomic_load_n(&g_done, __ATOMIC_ACQUIRE) != n - 1) {
+    }
+    uint32_t par_cycles = read_csr(mcycle) - start;
+
+    k10_puts("\n--- "); k10_puts(name); k10_puts(" ---\n");
+    put_row("1-hart cycles      : ", ref_cycles);
+    put_row("1-hart I-fetch wait: ", ref_if);
+    put_row("1-hart LSU wait    : ", ref_lsu);
+    put_row("All-hart cycles    : ", par_cycles);
+    k10_puts("Speedup            : "); put_ratio(ref_cycles, par_cycles); k10_puts("x\n");
+    for (uint32_t h = 0; h < n; h++) {
+        k10_puts("SMP ");
+        k10_puts(name);
+        k10_puts(" hart=");     k10_put_dec(h);
+        k10_puts(" cycles=");   k10_put_dec(g_stats[h].cycles);
+        k10_puts(" if_wait=");  k10_put_dec(g_stats[h].if_wait);
+        k10_puts(" lsu_wait="); k10_put_dec(g_stats[h].lsu_wait);
+        k10_puts("\n");
+    }
+    k10_puts("SMP "); k10_puts(name);
+    k10_puts(" harts=");       k10_put_dec(n);
+    k10_puts(" ref_cycles=");  k10_put_dec(ref_cycles);
+    k10_puts(" par_cycles=");  k10_put_dec(par_cycles);
+    k10_puts("\n");
+
+    if (g_checksum != ref_sum) {
+        k10_puts("FAIL: parallel checksum differs from the 1-hart run\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    k10_puts("=== K10 SMP Benchmark ===\n");
+
+    uint32_t n = SIM_NHARTS;
+    if (n == 0 || n > MAX_HARTS) {
+        k10_puts("FAIL: SIM_NHARTS out of range\n");
+        sim_fail();
+    }
+    g_nharts = n;
+    put_row("Harts              : ", n);
+
+    uint32_t x = 12345;
+    for (int i = 0; i < N_ITEMS; i++) {
+        x = x * 1103515245u + 12345u;
+        data[i] = x;
+    }
+    hpm_setup();
+
+    int ok = run_kernel(CMD_COMPUTE, "compute", n) &&
+             run_kernel(CMD_STREAM, "stream", n);
+
+    g_cmd = CMD_EXIT;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (uint32_t h = 1; h < n; h++) {
+        SIM_MSIP_HART(h) = 1;
+    }
+    k10_puts("-----------------\n");
+
+    if (!ok) sim_fail();
+    sim_pass();
+    return 0;
+}
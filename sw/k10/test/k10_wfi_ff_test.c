@@ -0,0 +1,53 @@
+#include "k10.h"
+
+uint32_t trap_handler(uint32_t mcause, uint32_t mepc) {
+    (void)mcause;
+    return mepc + 4;
+}
+
+// Sleeps in WFI until the next timer compare, SLEEPS times, with the timer
+// interrupt enabled in mie but mstatus.MIE clear: the hart wakes up and
+// carries on after the wfi without taking a trap.  After every wake-up it
+// prints the free-running counters firmware can see.  A run with
+// k10_tb --fast-forward must print exactly the same lines as a stepped
+// run; scripts/run_wfi_ff_check.sh compares the two.
+
+#define SLEEPS      4
+#define SLEEP_TICKS 200000u
+
+static void put_field(const char *name, uint32_t val) {
+    k10_putchar(' ');
+    k10_puts(name);
+    k10_putchar('=');
+    k10_put_dec(val);
+}
+
+int main(void) {
+    clear_csr(mstatus, MSTATUS_MIE);
+    write_csr(mie, MIE_MTIE);
+
+    for (uint32_t i = 0; i < SLEEPS; i++) {
+        uint32_t cmp = TIMER_MTIME_LO + SLEEP_TICKS;
+        TIMER_MTIMECMP_HI = 0xFFFFFFFFu;
+        TIMER_MTIMECMP_LO = cmp;
+        TIMER_MTIMECMP_HI = 0;
+
+        __asm__ volatile ("wfi");
+
+        uint32_t status = SIM_STATUS;
+        uint32_t mcycle = read_csr(mcycle);
+        uint32_t mtime  = TIMER_MTIME_LO;
+        TIMER_MTIMECMP_HI = 0xFFFFFFFFu;
+
+        TEST_ASSERT(mtime >= cmp, "woke before mtimecmp");
+        k10_puts("WFI_FF");
+        put_field("sleep", i);
+        put_field("sim_status", status);
+        put_field("mcycle", mcycle);
+        put_field("mtime", mtime);
+        k10_putchar('\n');
+    }
+
+    sim_pass();
+    return 0;
+}